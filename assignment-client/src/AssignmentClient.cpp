@@ -15,9 +15,16 @@
 
 #include <assert.h>
 
+#ifndef Q_OS_WIN
+#include <csignal>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
 #include <QJsonDocument>
 #include <QProcess>
 #include <QSharedMemory>
+#include <QSocketNotifier>
 #include <QThread>
 #include <QTimer>
 
@@ -30,6 +37,7 @@
 #include <LogUtils.h>
 #include <LimitedNodeList.h>
 #include <NodeList.h>
+#include <PathUtils.h>
 #include <udt/PacketHeaders.h>
 #include <SharedUtil.h>
 #include <ShutdownEventListener.h>
@@ -44,6 +52,18 @@
 
 const QString ASSIGNMENT_CLIENT_TARGET_NAME = "assignment-client";
 const long long ASSIGNMENT_REQUEST_INTERVAL_MSECS = 1 * 1000;
+const int TRACE_CAPTURE_MSECS = 30 * 1000;
+
+#ifndef Q_OS_WIN
+// the handler only writes to one end of this pair, which wakes the event loop through a QSocketNotifier on the other
+static int traceCaptureSignalFDs[2] { -1, -1 };
+
+static void traceCaptureSignalHandler(int) {
+    char byte = 1;
+    auto written = ::write(traceCaptureSignalFDs[0], &byte, sizeof(byte));
+    Q_UNUSED(written);
+}
+#endif
 
 AssignmentClient::AssignmentClient(Assignment::Type requestAssignmentType, QString assignmentPool,
                                    quint16 listenPort, QUuid walletUUID, QString assignmentServerHostname,
@@ -136,6 +156,27 @@ AssignmentClient::AssignmentClient(Assignment::Type requestAssignmentType, QStri
     packetReceiver.registerListener(PacketType::StopNode,
         PacketReceiver::makeUnsourcedListenerReference<AssignmentClient>(this, &AssignmentClient::handleStopNodePacket));
 
+#ifndef Q_OS_WIN
+    // SIGUSR1 captures a trace of the running assignment
+    if (::socketpair(AF_UNIX, SOCK_STREAM, 0, traceCaptureSignalFDs) == 0) {
+        auto traceCaptureNotifier = new QSocketNotifier(traceCaptureSignalFDs[1], QSocketNotifier::Read, this);
+        connect(traceCaptureNotifier, &QSocketNotifier::activated, this, [this] {
+            char byte;
+            auto numRead = ::read(traceCaptureSignalFDs[1], &byte, sizeof(byte));
+            Q_UNUSED(numRead);
+            captureTrace();
+        });
+
+        struct sigaction traceCaptureAction {};
+        traceCaptureAction.sa_handler = traceCaptureSignalHandler;
+        sigemptyset(&traceCaptureAction.sa_mask);
+        traceCaptureAction.sa_flags = SA_RESTART;
+        sigaction(SIGUSR1, &traceCaptureAction, nullptr);
+    } else {
+        qCWarning(assignment_client) << "Can't create the trace capture socket pair, SIGUSR1 won't capture traces";
+    }
+#endif
+
 #if defined(WEBRTC_DATA_CHANNELS)
     auto webrtcSocket = nodeList->getWebRTCSocket();
 
@@ -170,10 +211,42 @@ void AssignmentClient::stopAssignmentClient() {
 }
 
 AssignmentClient::~AssignmentClient() {
+#ifndef Q_OS_WIN
+    signal(SIGUSR1, SIG_IGN);
+    for (auto& fd : traceCaptureSignalFDs) {
+        if (fd != -1) {
+            ::close(fd);
+            fd = -1;
+        }
+    }
+#endif
+
     // remove the NodeList from the DependencyManager
     DependencyManager::destroy<NodeList>();
 }
 
+void AssignmentClient::captureTrace() {
+    auto tracer = DependencyManager::get<tracing::Tracer>();
+    if (tracer->isEnabled()) {
+        qCDebug(assignment_client) << "Already capturing a trace";
+        return;
+    }
+
+    // binary tracing only records into per-thread rings, so that the capture doesn't slow down an overloaded assignment
+    auto filename = PathUtils::getAppLocalDataFilePath(QString("traces/%1-%2-{DATE}-{TIME}.json.gz")
+        .arg(_currentAssignment ? _currentAssignment->getTypeName() : _requestAssignment.getTypeName())
+        .arg(QCoreApplication::applicationPid()));
+    qCDebug(assignment_client) << "Capturing a trace of the next" << TRACE_CAPTURE_MSECS / 1000 << "seconds to" << filename;
+    tracer->startBinaryTracing();
+
+    QTimer::singleShot(TRACE_CAPTURE_MSECS, this, [filename] {
+        auto tracer = DependencyManager::get<tracing::Tracer>();
+        tracer->stopTracing();
+        tracer->serialize(filename);
+        qCDebug(assignment_client) << "Finished capturing trace" << filename;
+    });
+}
+
 void AssignmentClient::aboutToQuit() {
     crash::annotations::setShutdownState(true);
     stopAssignmentClient();
@@ -44,6 +44,7 @@ private slots:
     void stopAssignmentClient();
     void handleCreateAssignmentPacket(QSharedPointer<ReceivedMessage> message);
     void handleStopNodePacket(QSharedPointer<ReceivedMessage> message);
+    void captureTrace();
 #if defined(WEBRTC_DATA_CHANNELS)
     void handleWebRTCSignalingPacket(QSharedPointer<ReceivedMessage> message);
     void sendSignalingMessageToUserClient(const QJsonObject& json);
@@ -0,0 +1,258 @@
+//
+//  NodeWorkScheduler.cpp
+//  assignment-client/src
+//
+//  Created on 2026-10-16.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "NodeWorkScheduler.h"
+
+#include <assert.h>
+#include <algorithm>
+
+#include <SharedUtil.h>
+#include <ThreadHelpers.h>
+
+void NodeWorkScheduler::Worker::run() {
+    setThreadName(_scheduler._threadName.toStdString());
+
+    while (true) {
+        {
+            Lock lock(_scheduler._mutex);
+            _scheduler._workerCondition.wait(lock, [&] {
+                return stop || _scheduler._generation != _generation;
+            });
+            if (stop) {
+                return;
+            }
+            _generation = _scheduler._generation;
+        }
+
+        _scheduler.process(_index);
+
+        {
+            Lock lock(_scheduler._mutex);
+            assert(_scheduler._numFinished < (int)_scheduler._workers.size());
+            ++_scheduler._numFinished;
+        }
+        _scheduler._runCondition.notify_one();
+    }
+}
+
+void NodeWorkScheduler::run(ConstIter begin, ConstIter end, CostHistory& history, Task task) {
+    assert(!_workers.empty());
+
+    auto startUsecs = usecTimestampNow();
+
+    // estimate what each node will cost from the last run, new nodes are assumed to be average
+    static const uint64_t UNKNOWN_COST = 0;
+    std::vector<Item> items;
+    uint64_t knownCost = 0;
+    int numKnown = 0;
+    std::for_each(begin, end, [&](const SharedNodePointer& node) {
+        auto cost = history._costs.find(node->getLocalID());
+        if (cost != history._costs.end()) {
+            // anything that was timed costs at least 1 so that cheap nodes are still spread out
+            items.push_back({ node, std::max(cost->second, (uint64_t)1) });
+            knownCost += items.back().cost;
+            ++numKnown;
+        } else {
+            items.push_back({ node, UNKNOWN_COST });
+        }
+    });
+
+    uint64_t averageCost = numKnown > 0 ? std::max(knownCost / numKnown, (uint64_t)1) : 1;
+    for (auto& item : items) {
+        if (item.cost == UNKNOWN_COST) {
+            item.cost = averageCost;
+        }
+    }
+
+    // deal the nodes out most expensive first, each to the worker with the least work so far,
+    // which leaves each worker's queue sorted from most to least expensive
+    std::stable_sort(items.begin(), items.end(), [](const Item& a, const Item& b) {
+        return a.cost > b.cost;
+    });
+
+    std::vector<uint64_t> loads(_workers.size(), 0);
+    for (auto& item : items) {
+        auto leastLoaded = std::min_element(loads.begin(), loads.end()) - loads.begin();
+        loads[leastLoaded] += item.cost;
+        _workers[leastLoaded]->queue.push_back(std::move(item));
+    }
+
+    _task = std::move(task);
+
+    {
+        Lock lock(_mutex);
+
+        // run
+        _numFinished = 0;
+        ++_generation;
+        _workerCondition.notify_all();
+
+        // wait
+        _runCondition.wait(lock, [&] {
+            assert(_numFinished <= (int)_workers.size());
+            return _numFinished == (int)_workers.size();
+        });
+    }
+
+    _task = nullptr;
+
+    gatherRun(history, startUsecs, usecTimestampNow());
+}
+
+bool NodeWorkScheduler::pop(int worker, SharedNodePointer& node) {
+    {
+        Worker& self = *_workers[worker];
+        Lock lock(self.mutex);
+        if (!self.queue.empty()) {
+            node = std::move(self.queue.front().node);
+            self.queue.pop_front();
+            return true;
+        }
+    }
+
+    // out of work - steal the cheapest node left on another worker,
+    // so that the owner keeps the expensive ones it is about to start on
+    int numWorkers = (int)_workers.size();
+    for (int i = 1; i < numWorkers; ++i) {
+        Worker& victim = *_workers[(worker + i) % numWorkers];
+        Lock lock(victim.mutex);
+        if (!victim.queue.empty()) {
+            node = std::move(victim.queue.back().node);
+            victim.queue.pop_back();
+            ++_workers[worker]->numSteals;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void NodeWorkScheduler::process(int worker) {
+    Worker& self = *_workers[worker];
+
+    SharedNodePointer node;
+    while (pop(worker, node)) {
+        auto start = usecTimestampNow();
+        _task(worker, node);
+        auto cost = usecTimestampNow() - start;
+
+        self.costs.emplace_back(node->getLocalID(), cost);
+        self.busyUsecs += cost;
+        ++self.numTasks;
+    }
+
+    self.finishUsecs = usecTimestampNow();
+}
+
+void NodeWorkScheduler::gatherRun(CostHistory& history, uint64_t startUsecs, uint64_t endUsecs) {
+    // only the nodes of this run are kept, so the history forgets nodes that have gone
+    std::unordered_map<Node::LocalID, uint64_t> costs;
+    uint64_t firstFinishUsecs = endUsecs;
+    uint64_t lastFinishUsecs = startUsecs;
+
+    for (size_t i = 0; i < _workers.size(); ++i) {
+        Worker& worker = *_workers[i];
+        assert(worker.queue.empty());
+
+        for (const auto& cost : worker.costs) {
+            costs[cost.first] = cost.second;
+        }
+
+        _workerStats[i].busyUsecs += worker.busyUsecs;
+        _workerStats[i].numTasks += worker.numTasks;
+        _workerStats[i].numSteals += worker.numSteals;
+
+        firstFinishUsecs = std::min(firstFinishUsecs, worker.finishUsecs);
+        lastFinishUsecs = std::max(lastFinishUsecs, worker.finishUsecs);
+
+        worker.costs.clear();
+        worker.busyUsecs = 0;
+        worker.numTasks = 0;
+        worker.numSteals = 0;
+    }
+
+    history._costs.swap(costs);
+
+    // the tail is how long the first worker to run out of nodes sat idle waiting on the last one
+    uint64_t tailUsecs = lastFinishUsecs > firstFinishUsecs ? lastFinishUsecs - firstFinishUsecs : 0;
+    _runUsecs += endUsecs - startUsecs;
+    _tailUsecs += tailUsecs;
+    _maxTailUsecs = std::max(_maxTailUsecs, tailUsecs);
+    ++_numRuns;
+}
+
+QJsonObject NodeWorkScheduler::sampleStats() {
+    QJsonObject stats;
+
+    stats["runs"] = _numRuns;
+    stats["avg_run_usecs"] = _numRuns > 0 ? (qint64)(_runUsecs / _numRuns) : 0;
+    stats["avg_tail_usecs"] = _numRuns > 0 ? (qint64)(_tailUsecs / _numRuns) : 0;
+    stats["max_tail_usecs"] = (qint64)_maxTailUsecs;
+
+    QJsonObject workerStats;
+    for (size_t i = 0; i < _workerStats.size(); ++i) {
+        QJsonObject worker;
+        worker["utilization_%"] = _runUsecs > 0 ? (100.0 * _workerStats[i].busyUsecs) / _runUsecs : 0.0;
+        worker["nodes"] = _workerStats[i].numTasks;
+        worker["steals"] = _workerStats[i].numSteals;
+        workerStats[QString("thread_%1").arg(i)] = worker;
+
+        _workerStats[i] = WorkerStats();
+    }
+    stats["threads"] = workerStats;
+
+    _runUsecs = 0;
+    _tailUsecs = 0;
+    _maxTailUsecs = 0;
+    _numRuns = 0;
+
+    return stats;
+}
+
+void NodeWorkScheduler::resize(int numWorkers) {
+    int oldNumWorkers = (int)_workers.size();
+
+    if (numWorkers > oldNumWorkers) {
+        uint64_t generation;
+        {
+            Lock lock(_mutex);
+            generation = _generation;
+        }
+
+        // start new workers, waiting for the next run
+        for (int i = oldNumWorkers; i < numWorkers; ++i) {
+            auto worker = new Worker(*this, i, generation);
+            _workers.emplace_back(worker);
+            worker->start();
+        }
+    } else if (numWorkers < oldNumWorkers) {
+        auto extraBegin = _workers.begin() + numWorkers;
+
+        // mark workers to stop...
+        {
+            Lock lock(_mutex);
+            for (auto worker = extraBegin; worker != _workers.end(); ++worker) {
+                (*worker)->stop = true;
+            }
+        }
+        _workerCondition.notify_all();
+
+        // ...wait for them to finish...
+        for (auto worker = extraBegin; worker != _workers.end(); ++worker) {
+            (*worker)->wait();
+        }
+
+        // ...and erase them
+        _workers.erase(extraBegin, _workers.end());
+    }
+
+    _workerStats.assign(numWorkers, WorkerStats());
+}
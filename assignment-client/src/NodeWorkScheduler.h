@@ -0,0 +1,128 @@
+//
+//  NodeWorkScheduler.h
+//  assignment-client/src
+//
+//  Created on 2026-10-16.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_NodeWorkScheduler_h
+#define hifi_NodeWorkScheduler_h
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <QJsonObject>
+#include <QThread>
+
+#include <NodeList.h>
+
+// Work-stealing executor for the per-node jobs of the mixer slave pools.
+//   Each run hands every node of the range to one of a fixed set of worker threads. Nodes are dealt out up front,
+//   most expensive first, by what they cost in the previous run of the same job, and a worker that runs out of
+//   nodes steals the cheapest ones left on the other workers.
+//   NodeWorkScheduler is not thread-safe! It should be instantiated and used from a single thread.
+class NodeWorkScheduler {
+    using Mutex = std::mutex;
+    using Lock = std::unique_lock<Mutex>;
+    using ConditionVariable = std::condition_variable;
+
+public:
+    using ConstIter = NodeList::const_iterator;
+    using Task = std::function<void(int worker, const SharedNodePointer& node)>;
+
+    // what each node cost the last time a job ran, used to balance the next run of that job
+    class CostHistory {
+    private:
+        friend class NodeWorkScheduler;
+        std::unordered_map<Node::LocalID, uint64_t> _costs; // usecs
+    };
+
+    NodeWorkScheduler(const QString& threadName) : _threadName(threadName) {}
+    ~NodeWorkScheduler() { resize(0); }
+
+    // starts or stops worker threads, which are numbered [0, numWorkers)
+    void resize(int numWorkers);
+    int numWorkers() const { return (int)_workers.size(); }
+
+    // runs the task for each node in [begin, end) across the workers, returns once all of them are done
+    void run(ConstIter begin, ConstIter end, CostHistory& history, Task task);
+
+#ifdef DEBUG_EVENT_QUEUE
+    QThread* getWorkerThread(int worker) { return _workers[worker].get(); }
+#endif
+
+    // per-worker utilization and end of run tail latency since the last call
+    QJsonObject sampleStats();
+
+private:
+    struct Item {
+        SharedNodePointer node;
+        uint64_t cost;
+    };
+
+    class Worker : public QThread {
+    public:
+        Worker(NodeWorkScheduler& scheduler, int index, uint64_t generation) :
+            _scheduler(scheduler), _index(index), _generation(generation) {}
+
+        void run() override final;
+
+        Mutex mutex;
+        std::deque<Item> queue; // guarded by mutex, most expensive first
+        bool stop { false }; // guarded by the scheduler _mutex
+
+        // run state, only touched by this worker while a run is in progress
+        std::vector<std::pair<Node::LocalID, uint64_t>> costs;
+        uint64_t busyUsecs { 0 };
+        uint64_t finishUsecs { 0 };
+        int numTasks { 0 };
+        int numSteals { 0 };
+
+    private:
+        NodeWorkScheduler& _scheduler;
+        const int _index;
+        uint64_t _generation;
+    };
+
+    bool pop(int worker, SharedNodePointer& node);
+    void process(int worker);
+    void gatherRun(CostHistory& history, uint64_t startUsecs, uint64_t endUsecs);
+
+    const QString _threadName;
+    std::vector<std::unique_ptr<Worker>> _workers;
+
+    // synchronization state
+    Mutex _mutex;
+    ConditionVariable _workerCondition;
+    ConditionVariable _runCondition;
+    uint64_t _generation { 0 }; // guarded by _mutex
+    int _numFinished { 0 }; // guarded by _mutex
+
+    // run state
+    Task _task;
+
+    // stats, accumulated between calls to sampleStats
+    struct WorkerStats {
+        uint64_t busyUsecs { 0 };
+        int numTasks { 0 };
+        int numSteals { 0 };
+    };
+    std::vector<WorkerStats> _workerStats;
+    uint64_t _runUsecs { 0 };
+    uint64_t _tailUsecs { 0 };
+    uint64_t _maxTailUsecs { 0 };
+    int _numRuns { 0 };
+};
+
+#endif // hifi_NodeWorkScheduler_h
@@ -283,6 +283,7 @@ void AudioMixer::sendStatsPacket() {
     statsObject["useDynamicJitterBuffers"] = _numStaticJitterFrames == DISABLE_STATIC_JITTER_FRAMES;
 
     statsObject["threads"] = _slavePool.numThreads();
+    statsObject["slave_scheduler"] = _slavePool.sampleSchedulerStats();
 
     statsObject["trailing_mix_ratio"] = _trailingMixRatio;
     statsObject["throttling_ratio"] = _throttlingRatio;
@@ -290,6 +291,8 @@ void AudioMixer::sendStatsPacket() {
     statsObject["avg_streams_per_frame"] = (float)_stats.sumStreams / (float)_numStatFrames;
     statsObject["avg_listeners_per_frame"] = (float)_stats.sumListeners / (float)_numStatFrames;
     statsObject["avg_listeners_(silent)_per_frame"] = (float)_stats.sumListenersSilent / (float)_numStatFrames;
+    statsObject["avg_shared_mixes_per_frame"] = (float)_stats.sharedMixes / (float)_numStatFrames;
+    statsObject["avg_shared_encodes_per_frame"] = (float)_stats.sharedEncodes / (float)_numStatFrames;
 
     statsObject["silent_packets_per_frame"] = (float)_numSilentPackets / (float)_numStatFrames;
 
@@ -460,11 +463,14 @@ void AudioMixer::start() {
         if (_throttlingRatio > EPSILON) {
             numToRetain = nodeList->size() * (1.0f - _throttlingRatio);
         }
+        // queue this frame's mixed audio so that it goes out in as few send calls as possible
+        nodeList->beginSendBatch();
         nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
             // mix across slave threads
             auto mixTimer = _mixTiming.timer();
             _slavePool.mix(cbegin, cend, frame, numToRetain);
         });
+        nodeList->endSendBatch();
 
         // gather stats
         _slavePool.each([&](AudioMixerSlave& slave) {
@@ -104,6 +104,12 @@ public:
         // once you have encoded, you need to flush eventually.
         _shouldFlushEncoder = true;
     }
+    // the payload of a stateless encoder can be shared with other listeners that hear the same mix in the same codec
+    bool hasStatelessEncoder() const { return !_encoder || _encoder->isStateless(); }
+    void useSharedEncoding(const QByteArray& sharedEncodedBuffer, QByteArray& encodedBuffer) {
+        encodedBuffer = sharedEncodedBuffer;
+        _shouldFlushEncoder = true;
+    }
     void encodeFrameOfZeros(QByteArray& encodedZeros);
     bool shouldFlushEncoder() { return _shouldFlushEncoder; }
 
@@ -163,6 +169,10 @@ public:
     bool getHasReceivedFirstMix() const { return _hasReceivedFirstMix; }
     void setHasReceivedFirstMix(bool hasReceivedFirstMix) { _hasReceivedFirstMix = hasReceivedFirstMix; }
 
+    // whether the last mix sent was another listener's, in which case this listener's HRTFs weren't rendered
+    bool getMixWasShared() const { return _mixWasShared; }
+    void setMixWasShared(bool mixWasShared) { _mixWasShared = mixWasShared; }
+
     // end of methods called non-concurrently from single AudioMixerSlave
 
 signals:
@@ -223,6 +233,7 @@ private:
     std::vector<QUuid> _soloedNodes;
 
     bool _hasReceivedFirstMix { false };
+    bool _mixWasShared { false };
 };
 
 #endif // hifi_AudioMixerClientData_h
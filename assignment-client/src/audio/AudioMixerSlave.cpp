@@ -12,6 +12,8 @@
 #include "AudioMixerSlave.h"
 
 #include <algorithm>
+#include <cmath>
+#include <limits>
 
 #include <glm/glm.hpp>
 #include <glm/gtx/norm.hpp>
@@ -68,6 +70,7 @@ void AudioMixerSlave::configureMix(ConstIter begin, ConstIter end, unsigned int
     _end = end;
     _frame = frame;
     _numToRetain = numToRetain;
+    _sharedMixes.clear();
 }
 
 void AudioMixerSlave::mix(const SharedNodePointer& node) {
@@ -97,15 +100,23 @@ void AudioMixerSlave::mix(const SharedNodePointer& node) {
         ++stats.sumListeners;
 
         // mix the audio
-        bool mixHasAudio = prepareMix(node);
+        SharedMix& mix = prepareMix(node);
 
         // send audio packet
-        if (mixHasAudio || data->shouldFlushEncoder()) {
+        if (mix.hasAudio || data->shouldFlushEncoder()) {
             QByteArray encodedBuffer;
-            if (mixHasAudio) {
-                // encode the audio
-                QByteArray decodedBuffer(reinterpret_cast<char*>(_bufferSamples), AudioConstants::NETWORK_FRAME_BYTES_STEREO);
-                data->encode(decodedBuffer, encodedBuffer);
+            if (mix.hasAudio) {
+                // encode the audio, once per codec if it can be shared
+                if (!data->hasStatelessEncoder()) {
+                    data->encode(mix.decoded, encodedBuffer);
+                } else if (!mix.encoded.isNull() && mix.encodedCodecName == data->getCodecName()) {
+                    data->useSharedEncoding(mix.encoded, encodedBuffer);
+                    ++stats.sharedEncodes;
+                } else {
+                    data->encode(mix.decoded, encodedBuffer);
+                    mix.encodedCodecName = data->getCodecName();
+                    mix.encoded = encodedBuffer;
+                }
             } else {
                 // time to flush (resets shouldFlush until the next encode)
                 data->encodeFrameOfZeros(encodedBuffer);
@@ -306,7 +317,7 @@ float approximateVolume(const MixableStream& stream, const AvatarAudioStream* li
     return stream.positionalStream->getLastPopOutputTrailingLoudness() * gain;
 };
 
-bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
+AudioMixerSlave::SharedMix& AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
     AvatarAudioStream* listenerAudioStream = static_cast<AudioMixerClientData*>(listener->getLinkedData())->getAvatarAudioStream();
     AudioMixerClientData* listenerData = static_cast<AudioMixerClientData*>(listener->getLinkedData());
 
@@ -467,6 +478,30 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
     // clear the newly ignored, un-ignored, ignoring, and un-ignoring streams now that we've processed them
     listenerData->clearStagedIgnoreChanges();
 
+    // a listener that hears the same streams as one mixed before it this frame, at about the same gains and relative
+    // positions, sends that mix rather than rendering its own
+    auto sharedMix = _sharedMixes.emplace(takeMixKey(), SharedMix());
+    if (!sharedMix.second) {
+        stats.hrtfRenders -= (int)_hrtfSources.size();
+        _hrtfSources.clear();
+        _hrtfInputs.clear();
+        listenerData->setMixWasShared(true);
+        ++stats.sharedMixes;
+        return sharedMix.first->second;
+    }
+
+    if (listenerData->getMixWasShared()) {
+        // the HRTFs weren't rendered while the mix was shared, so reset them to avoid replaying their old tails
+        for (auto* streamsVector : { &streams.active, &streams.inactive, &streams.skipped }) {
+            for (auto& stream : *streamsVector) {
+                resetHRTFState(stream);
+            }
+        }
+        listenerData->setMixWasShared(false);
+    }
+
+    renderQueuedHRTFs();
+
 #ifdef HIFI_AUDIO_MIXER_DEBUG
     auto mixEnd = p_high_resolution_clock::now();
     auto mixTime = std::chrono::duration_cast<std::chrono::nanoseconds>(mixEnd - mixStart);
@@ -486,7 +521,10 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
     // use the per listener AudioLimiter to render the mixed data
     listenerData->audioLimiter.render(_mixSamples, _bufferSamples, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
 
-    return hasAudio;
+    SharedMix& mix = sharedMix.first->second;
+    mix.decoded = QByteArray(reinterpret_cast<char*>(_bufferSamples), AudioConstants::NETWORK_FRAME_BYTES_STEREO);
+    mix.hasAudio = hasAudio;
+    return mix;
 }
 
 void AudioMixerSlave::addStream(AudioMixerClientData::MixableStream& mixableStream,
@@ -510,8 +548,6 @@ void AudioMixerSlave::addStream(AudioMixerClientData::MixableStream& mixableStre
                                                    relativePosition, distance));
     float azimuth = isEcho ? 0.0f : computeAzimuth(listeningNodeStream, listeningNodeStream, relativePosition);
 
-    const int HRTF_DATASET_INDEX = 1;
-
     if (!streamToAdd->lastPopSucceeded()) {
         bool forceSilentBlock = true;
 
@@ -536,10 +572,8 @@ void AudioMixerSlave::addStream(AudioMixerClientData::MixableStream& mixableStre
             // (this is not done for stereo streams since they do not go through the HRTF)
             if (!streamToAdd->isStereo() && !isEcho) {
                 static int16_t silentMonoBlock[AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL] = {};
-                mixableStream.hrtf->render(silentMonoBlock, _mixSamples, HRTF_DATASET_INDEX, azimuth, distance, gain,
-                                           AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
-
-                ++stats.hrtfRenders;
+                queueHRTFRender(*mixableStream.hrtf, silentMonoBlock, azimuth, distance, gain);
+                addMixInput(streamToAdd, SILENT_HRTF_INPUT, gain * mixableStream.hrtf->getGainAdjustment(), azimuth, distance);
             }
 
             return;
@@ -555,6 +589,7 @@ void AudioMixerSlave::addStream(AudioMixerClientData::MixableStream& mixableStre
 
         // stereo sources are not passed through HRTF
         mixableStream.hrtf->mixStereo(_bufferSamples, _mixSamples, gain, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+        addMixInput(streamToAdd, STEREO_INPUT, gain * mixableStream.hrtf->getGainAdjustment(), 0.0f, 0.0f);
 
         ++stats.manualStereoMixes;
     } else if (isEcho) {
@@ -563,16 +598,76 @@ void AudioMixerSlave::addStream(AudioMixerClientData::MixableStream& mixableStre
 
         // echo sources are not passed through HRTF
         mixableStream.hrtf->mixMono(_bufferSamples, _mixSamples, gain, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+        addMixInput(streamToAdd, ECHO_INPUT, gain * mixableStream.hrtf->getGainAdjustment(), 0.0f, 0.0f);
 
         ++stats.manualEchoMixes;
     } else {
 
         streamPopOutput.readSamples(_bufferSamples, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
 
-        mixableStream.hrtf->render(_bufferSamples, _mixSamples, HRTF_DATASET_INDEX, azimuth, distance, gain,
-                                   AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
-        ++stats.hrtfRenders;
+        queueHRTFRender(*mixableStream.hrtf, _bufferSamples, azimuth, distance, gain);
+        addMixInput(streamToAdd, HRTF_INPUT, gain * mixableStream.hrtf->getGainAdjustment(), azimuth, distance);
+    }
+}
+
+// steps of about 0.25dB, 1 degree and 4% of the distance
+const float MIX_INPUT_GAIN_STEPS_PER_DOUBLING = 24.0f;
+const float MIX_INPUT_AZIMUTH_STEPS_PER_RADIAN = 180.0f / PI;
+const float MIX_INPUT_DISTANCE_STEPS_PER_DOUBLING = 16.0f;
+const int SILENT_MIX_INPUT_GAIN = std::numeric_limits<int>::min();
+
+void AudioMixerSlave::addMixInput(const PositionalAudioStream* stream, MixInputType type, float gain, float azimuth,
+                                  float distance) {
+    MixInput input;
+    input.stream = stream;
+    input.type = type;
+    input.gain = gain > 0.0f ? (int)lroundf(log2f(gain) * MIX_INPUT_GAIN_STEPS_PER_DOUBLING) : SILENT_MIX_INPUT_GAIN;
+    input.azimuth = (int)lroundf(azimuth * MIX_INPUT_AZIMUTH_STEPS_PER_RADIAN);
+    input.distance = distance > 0.0f ? (int)lroundf(log2f(distance) * MIX_INPUT_DISTANCE_STEPS_PER_DOUBLING) : 0;
+    _mixInputs.push_back(input);
+}
+
+std::string AudioMixerSlave::takeMixKey() {
+    // each listener adds its streams in its own order
+    std::sort(_mixInputs.begin(), _mixInputs.end(), [](const MixInput& a, const MixInput& b) {
+        return a.stream < b.stream || (a.stream == b.stream && a.type < b.type);
+    });
+
+    std::string key;
+    key.reserve(_mixInputs.size() * sizeof(MixInput));
+    for (const auto& input : _mixInputs) {
+        key.append(reinterpret_cast<const char*>(&input.stream), sizeof(input.stream));
+        key.append(reinterpret_cast<const char*>(&input.type), sizeof(input.type));
+        key.append(reinterpret_cast<const char*>(&input.gain), sizeof(input.gain));
+        key.append(reinterpret_cast<const char*>(&input.azimuth), sizeof(input.azimuth));
+        key.append(reinterpret_cast<const char*>(&input.distance), sizeof(input.distance));
     }
+    _mixInputs.clear();
+    return key;
+}
+
+void AudioMixerSlave::queueHRTFRender(AudioHRTF& hrtf, const int16_t* input, float azimuth, float distance, float gain) {
+    // copy the input, the caller's buffer is re-used for the next stream
+    _hrtfInputs.insert(_hrtfInputs.end(), input, input + AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+
+    // the input is pointed at once the batch is rendered, since _hrtfInputs may still reallocate
+    _hrtfSources.push_back({ &hrtf, nullptr, azimuth, distance, gain, LPF_DISTANCE_REF });
+
+    ++stats.hrtfRenders;
+}
+
+void AudioMixerSlave::renderQueuedHRTFs() {
+    const int HRTF_DATASET_INDEX = 1;
+
+    for (size_t i = 0; i < _hrtfSources.size(); ++i) {
+        _hrtfSources[i].input = &_hrtfInputs[i * AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL];
+    }
+
+    AudioHRTF::renderBatch(_hrtfSources.data(), (int)_hrtfSources.size(), _mixSamples, HRTF_DATASET_INDEX,
+                           AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+
+    _hrtfSources.clear();
+    _hrtfInputs.clear();
 }
 
 void AudioMixerSlave::updateHRTFParameters(AudioMixerClientData::MixableStream& mixableStream,
@@ -17,6 +17,10 @@
 #include <tbb/concurrent_vector.h>
 #endif
 
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 #include <AABox.h>
 #include <AudioHRTF.h>
 #include <AudioRingBuffer.h>
@@ -56,8 +60,18 @@ public:
     AudioMixerStats stats;
 
 private:
-    // create mix, returns true if mix has audio
-    bool prepareMix(const SharedNodePointer& listener);
+    // a mix limited for sending, which every listener that would hear the same mix this frame sends
+    struct SharedMix {
+        QByteArray decoded;
+        bool hasAudio { false };
+
+        // the payload of the first listener with a stateless encoder to send it, for others in the same codec
+        QString encodedCodecName;
+        QByteArray encoded;
+    };
+
+    // create mix, or find the mix another listener that hears the same streams had this frame
+    SharedMix& prepareMix(const SharedNodePointer& listener);
     void addStream(AudioMixerClientData::MixableStream& mixableStream,
                    AvatarAudioStream& listeningNodeStream,
                    float masterAvatarGain,
@@ -69,11 +83,34 @@ private:
                               float masterInjectorGain);
     void resetHRTFState(AudioMixerClientData::MixableStream& mixableStream);
 
+    // mono HRTF renders are queued while the streams are processed, then rendered into the mix as one batch
+    void queueHRTFRender(AudioHRTF& hrtf, const int16_t* input, float azimuth, float distance, float gain);
+    void renderQueuedHRTFs();
+
     void addStreams(Node& listener, AudioMixerClientData& listenerData);
 
+    // what each stream adds to the mix, quantized finely enough that listeners with the same inputs can't hear the
+    // difference between their mixes
+    enum MixInputType { HRTF_INPUT, SILENT_HRTF_INPUT, STEREO_INPUT, ECHO_INPUT };
+    struct MixInput {
+        const PositionalAudioStream* stream;
+        int type;
+        int gain;
+        int azimuth;
+        int distance;
+    };
+    void addMixInput(const PositionalAudioStream* stream, MixInputType type, float gain, float azimuth, float distance);
+    std::string takeMixKey();
+
     // mixing buffers
     float _mixSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
     int16_t _bufferSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
+    std::vector<AudioHRTF::RenderSource> _hrtfSources;
+    std::vector<int16_t> _hrtfInputs;
+    std::vector<MixInput> _mixInputs;
+
+    // the mixes of this frame by their inputs, only shared between the listeners of this slave so that it needs no lock
+    std::unordered_map<std::string, SharedMix> _sharedMixes;
 
     // frame state
     ConstIter _begin;
@@ -12,50 +12,20 @@
 #ifndef hifi_AudioMixerSlavePool_h
 #define hifi_AudioMixerSlavePool_h
 
-#include <condition_variable>
-#include <mutex>
+#include <memory>
 #include <vector>
 
+#include <QJsonObject>
 #include <QThread>
 #include <shared/QtHelpers.h>
-#include <TBBHelpers.h>
 
+#include "../NodeWorkScheduler.h"
 #include "AudioMixerSlave.h"
 
-class AudioMixerSlavePool;
-
-class AudioMixerSlaveThread : public QThread, public AudioMixerSlave {
-    Q_OBJECT
-    using ConstIter = NodeList::const_iterator;
-    using Mutex = std::mutex;
-    using Lock = std::unique_lock<Mutex>;
-
-public:
-    AudioMixerSlaveThread(AudioMixerSlavePool& pool, AudioMixerSlave::SharedData& sharedData)
-        : AudioMixerSlave(sharedData), _pool(pool) {}
-
-    void run() override final;
-
-private:
-    friend class AudioMixerSlavePool;
-
-    void wait();
-    void notify(bool stopping);
-    bool try_pop(SharedNodePointer& node);
-
-    AudioMixerSlavePool& _pool;
-    void (AudioMixerSlave::*_function)(const SharedNodePointer& node) { nullptr };
-    bool _stop { false };
-};
-
 // Slave pool for audio mixers
+//   Each slave holds the mixing state of one NodeWorkScheduler worker thread.
 //   AudioMixerSlavePool is not thread-safe! It should be instantiated and used from a single thread.
 class AudioMixerSlavePool {
-    using Queue = tbb::concurrent_queue<SharedNodePointer>;
-    using Mutex = std::mutex;
-    using Lock = std::unique_lock<Mutex>;
-    using ConditionVariable = std::condition_variable;
-
 public:
     using ConstIter = NodeList::const_iterator;
 
@@ -76,34 +46,24 @@ public:
     void queueStats(QJsonObject& stats);
 #endif
 
+    // thread utilization and tail latency since the last call
+    QJsonObject sampleSchedulerStats() { return _scheduler.sampleStats(); }
+
     void setNumThreads(int numThreads);
     int numThreads() { return _numThreads; }
 
 private:
-    void run(ConstIter begin, ConstIter end);
+    void run(ConstIter begin, ConstIter end, NodeWorkScheduler::CostHistory& history,
+             void (AudioMixerSlave::*function)(const SharedNodePointer& node));
     void resize(int numThreads);
 
-    std::vector<std::unique_ptr<AudioMixerSlaveThread>> _slaves;
-
-    friend void AudioMixerSlaveThread::wait();
-    friend void AudioMixerSlaveThread::notify(bool stopping);
-    friend bool AudioMixerSlaveThread::try_pop(SharedNodePointer& node);
-
-    // synchronization state
-    Mutex _mutex;
-    ConditionVariable _slaveCondition;
-    ConditionVariable _poolCondition;
-    void (AudioMixerSlave::*_function)(const SharedNodePointer& node);
-    std::function<void(AudioMixerSlave&)> _configure;
+    std::vector<std::unique_ptr<AudioMixerSlave>> _slaves;
+    NodeWorkScheduler _scheduler { "AudioMixerSlaveThread" };
     int _numThreads { 0 };
-    int _numStarted { 0 }; // guarded by _mutex
-    int _numFinished { 0 }; // guarded by _mutex
-    int _numStopped { 0 }; // guarded by _mutex
-
-    // frame state
-    Queue _queue;
-    ConstIter _begin;
-    ConstIter _end;
+
+    // what each node cost last frame, per job
+    NodeWorkScheduler::CostHistory _processPacketsCosts;
+    NodeWorkScheduler::CostHistory _mixCosts;
 
     AudioMixerSlave::SharedData& _workerSharedData;
 };
@@ -15,6 +15,8 @@ void AudioMixerStats::reset() {
     sumStreams = 0;
     sumListeners = 0;
     sumListenersSilent = 0;
+    sharedMixes = 0;
+    sharedEncodes = 0;
 
     totalMixes = 0;
 
@@ -45,6 +47,8 @@ void AudioMixerStats::accumulate(const AudioMixerStats& otherStats) {
     sumStreams += otherStats.sumStreams;
     sumListeners += otherStats.sumListeners;
     sumListenersSilent += otherStats.sumListenersSilent;
+    sharedMixes += otherStats.sharedMixes;
+    sharedEncodes += otherStats.sharedEncodes;
 
     totalMixes += otherStats.totalMixes;
 
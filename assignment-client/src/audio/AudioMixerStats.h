@@ -20,6 +20,8 @@ struct AudioMixerStats {
     int sumStreams { 0 };
     int sumListeners { 0 };
     int sumListenersSilent { 0 };
+    int sharedMixes { 0 };
+    int sharedEncodes { 0 };
 
     int totalMixes { 0 };
 
@@ -334,12 +334,15 @@ void AvatarMixer::start() {
         // this is where we need to put the real work...
         {
             auto start = usecTimestampNow();
+            // queue this frame's avatar data so that it goes out in as few send calls as possible
+            nodeList->beginSendBatch();
             nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
                 auto start = usecTimestampNow();
                 _slavePool.broadcastAvatarData(cbegin, cend, _lastFrameTimestamp, _maxKbpsPerNode, _throttlingRatio);
                 auto end = usecTimestampNow();
                 _broadcastAvatarDataInner += (end - start);
             }, &lockWait, &nodeTransform, &functor);
+            nodeList->endSendBatch();
             auto end = usecTimestampNow();
             _broadcastAvatarDataElapsedTime += (end - start);
 
@@ -767,6 +770,7 @@ void AvatarMixer::sendStatsPacket() {
 
     statsObject["broadcast_loop_rate"] = _loopRate.rate();
     statsObject["threads"] = _slavePool.numThreads();
+    statsObject["slave_scheduler"] = _slavePool.sampleSchedulerStats();
     statsObject["trailing_mix_ratio"] = _trailingMixRatio;
     statsObject["throttling_ratio"] = _throttlingRatio;
 
@@ -852,6 +856,7 @@ void AvatarMixer::sendStatsPacket() {
     slavesAggregatObject["sent_5_averageTraitsBytes"] = TIGHT_LOOP_STAT(aggregateStats.numTraitsBytesSent);
     slavesAggregatObject["sent_6_averageIdentityBytes"] = TIGHT_LOOP_STAT(aggregateStats.numIdentityBytesSent);
     slavesAggregatObject["sent_7_averageHeroAvatars"] = TIGHT_LOOP_STAT(aggregateStats.numHeroesIncluded);
+    slavesAggregatObject["sent_8_averageSharedEncodes"] = TIGHT_LOOP_STAT(aggregateStats.numSharedEncodes);
 
     slavesAggregatObject["timing_1_processIncomingPackets"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.processIncomingPacketsElapsedTime);
     slavesAggregatObject["timing_2_ignoreCalculation"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.ignoreCalculationElapsedTime);
@@ -24,6 +24,7 @@
 
 #include "MixerAvatar.h"
 #include <AssociatedTraitValues.h>
+#include <AvatarEncodingCache.h>
 #include <NodeData.h>
 #include <NumericalConstants.h>
 #include <udt/PacketHeaders.h>
@@ -53,6 +54,9 @@ public:
     const MixerAvatar* getConstAvatarData() const { return _avatar.get(); }
     MixerAvatarSharedPointer getAvatarSharedPointer() const { return _avatar; }
 
+    // shared by the slaves broadcasting this avatar to other nodes
+    AvatarEncodingCache& getEncodingCache() const { return _encodingCache; }
+
     uint16_t getLastBroadcastSequenceNumber(NLPacket::LocalID nodeID) const;
     void setLastBroadcastSequenceNumber(NLPacket::LocalID nodeID, uint16_t sequenceNumber)
         { _lastBroadcastSequenceNumbers[nodeID] = sequenceNumber; }
@@ -167,6 +171,7 @@ private:
     PacketQueue _packetQueue;
 
     MixerAvatarSharedPointer _avatar { new MixerAvatar() };
+    mutable AvatarEncodingCache _encodingCache;
 
     uint16_t _lastReceivedSequenceNumber { 0 };
     std::unordered_map<NLPacket::LocalID, uint16_t> _lastBroadcastSequenceNumbers;
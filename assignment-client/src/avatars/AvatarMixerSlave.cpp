@@ -580,11 +580,33 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
             AvatarDataPacket::SendStatus sendStatus;
             sendStatus.sendUUID = true;
 
+            bool isFirstEncode = true;
+
             do {
                 auto startSerialize = chrono::high_resolution_clock::now();
-                QByteArray bytes = sourceAvatar->toByteArray(detail, lastEncodeForOther, lastSentJointsForOther,
-                    sendStatus, dropFaceTracking, distanceAdjust, destinationPosition,
-                    &lastSentJointsForOther, avatarSpaceAvailable);
+                QByteArray bytes;
+                if (isFirstEncode && detail != AvatarData::NoData) {
+                    // most listeners want one of a few encodings of this avatar, so encode for a whole packet to share
+                    // it with the others this frame - and rather than split it, start a new packet if needed
+                    bool isShared = false;
+                    bytes = sourceNodeData->getEncodingCache().encode(*sourceAvatar, _lastFrameTimestamp, detail,
+                        lastEncodeForOther, destinationPosition, lastSentJointsForOther, sendStatus, avatarPacketCapacity,
+                        isShared);
+                    if (isShared) {
+                        ++_stats.numSharedEncodes;
+                    }
+                    if (bytes.size() > avatarSpaceAvailable) {
+                        nodeList->sendPacket(std::move(avatarPacket), *destinationNode);
+                        ++numPacketsSent;
+                        avatarPacket = NLPacket::create(PacketType::BulkAvatarData);
+                        avatarSpaceAvailable = avatarPacketCapacity;
+                    }
+                } else {
+                    bytes = sourceAvatar->toByteArray(detail, lastEncodeForOther, lastSentJointsForOther,
+                        sendStatus, dropFaceTracking, distanceAdjust, destinationPosition,
+                        &lastSentJointsForOther, avatarSpaceAvailable);
+                }
+                isFirstEncode = false;
                 auto endSerialize = chrono::high_resolution_clock::now();
                 _stats.toByteArrayElapsedTime +=
                     (quint64)chrono::duration_cast<chrono::microseconds>(endSerialize - startSerialize).count();
@@ -39,6 +39,7 @@ public:
     quint64 packetSendingElapsedTime { 0 };
     quint64 toByteArrayElapsedTime { 0 };
     quint64 jobElapsedTime { 0 };
+    int numSharedEncodes { 0 };
 
     void reset() {
         // receiving job stats
@@ -65,6 +66,7 @@ public:
         packetSendingElapsedTime = 0;
         toByteArrayElapsedTime = 0;
         jobElapsedTime = 0;
+        numSharedEncodes = 0;
     }
 
     AvatarMixerSlaveStats& operator+=(const AvatarMixerSlaveStats& rhs) {
@@ -89,6 +91,7 @@ public:
         packetSendingElapsedTime += rhs.packetSendingElapsedTime;
         toByteArrayElapsedTime += rhs.toByteArrayElapsedTime;
         jobElapsedTime += rhs.jobElapsedTime;
+        numSharedEncodes += rhs.numSharedEncodes;
         return *this;
     }
 };
@@ -14,100 +14,30 @@
 #include <assert.h>
 #include <algorithm>
 
-void AvatarMixerSlaveThread::run() {
-    while (true) {
-        wait();
-
-        // iterate over all available nodes
-        SharedNodePointer node;
-        while (try_pop(node)) {
-            (this->*_function)(node);
-        }
-
-        bool stopping = _stop;
-        notify(stopping);
-        if (stopping) {
-            return;
-        }
-    }
-}
-
-void AvatarMixerSlaveThread::wait() {
-    {
-        Lock lock(_pool._mutex);
-        _pool._slaveCondition.wait(lock, [&] {
-            assert(_pool._numStarted <= _pool._numThreads);
-            return _pool._numStarted != _pool._numThreads;
-        });
-        ++_pool._numStarted;
-    }
-    if (_pool._configure) {
-        _pool._configure(*this);
-    }
-    _function = _pool._function;
-}
-
-void AvatarMixerSlaveThread::notify(bool stopping) {
-    {
-        Lock lock(_pool._mutex);
-        assert(_pool._numFinished < _pool._numThreads);
-        ++_pool._numFinished;
-        if (stopping) {
-            ++_pool._numStopped;
-        }
+void AvatarMixerSlavePool::processIncomingPackets(ConstIter begin, ConstIter end) {
+    for (auto& slave : _slaves) {
+        slave->configure(begin, end);
     }
-    _pool._poolCondition.notify_one();
-}
 
-bool AvatarMixerSlaveThread::try_pop(SharedNodePointer& node) {
-    return _pool._queue.try_pop(node);
-}
-
-void AvatarMixerSlavePool::processIncomingPackets(ConstIter begin, ConstIter end) {
-    _function = &AvatarMixerSlave::processIncomingPackets;
-    _configure = [=](AvatarMixerSlave& slave) { 
-        slave.configure(begin, end);
-    };
-    run(begin, end);
+    run(begin, end, _processIncomingPacketsCosts, &AvatarMixerSlave::processIncomingPackets);
 }
 
 void AvatarMixerSlavePool::broadcastAvatarData(ConstIter begin, ConstIter end, 
                                                p_high_resolution_clock::time_point lastFrameTimestamp,
                                                float maxKbpsPerNode, float throttlingRatio) {
-    _function = &AvatarMixerSlave::broadcastAvatarData;
-    _configure = [=](AvatarMixerSlave& slave) { 
-        slave.configureBroadcast(begin, end, lastFrameTimestamp, maxKbpsPerNode, throttlingRatio,
+    for (auto& slave : _slaves) {
+        slave->configureBroadcast(begin, end, lastFrameTimestamp, maxKbpsPerNode, throttlingRatio,
             _priorityReservedFraction);
-   };
-    run(begin, end);
-}
+    }
 
-void AvatarMixerSlavePool::run(ConstIter begin, ConstIter end) {
-    _begin = begin;
-    _end = end;
+    run(begin, end, _broadcastAvatarDataCosts, &AvatarMixerSlave::broadcastAvatarData);
+}
 
-    // fill the queue
-    std::for_each(_begin, _end, [&](const SharedNodePointer& node) {
-        _queue.push(node);
+void AvatarMixerSlavePool::run(ConstIter begin, ConstIter end, NodeWorkScheduler::CostHistory& history,
+                               void (AvatarMixerSlave::*function)(const SharedNodePointer& node)) {
+    _scheduler.run(begin, end, history, [&](int worker, const SharedNodePointer& node) {
+        (_slaves[worker].get()->*function)(node);
     });
-
-    {
-        Lock lock(_mutex);
-
-        // run
-        _numStarted = _numFinished = 0;
-        _slaveCondition.notify_all();
-
-        // wait
-        _poolCondition.wait(lock, [&] {
-            assert(_numFinished <= _numThreads);
-            return _numFinished == _numThreads;
-        });
-
-        assert(_numStarted == _numThreads);
-    }
-
-    assert(_queue.empty());
 }
 
 
@@ -119,13 +49,10 @@ void AvatarMixerSlavePool::each(std::function<void(AvatarMixerSlave& slave)> fun
 
 #ifdef DEBUG_EVENT_QUEUE
 void AvatarMixerSlavePool::queueStats(QJsonObject& stats) {
-    unsigned i = 0;
-    for (auto& slave : _slaves) {
-        int queueSize = ::hifi::qt::getEventQueueSize(slave.get());
+    for (int i = 0; i < _scheduler.numWorkers(); ++i) {
+        int queueSize = ::hifi::qt::getEventQueueSize(_scheduler.getWorkerThread(i));
         QString queueName = QString("avatar_thread_event_queue_%1").arg(i);
         stats[queueName] = queueSize;
-
-        i++;
     }
 }
 #endif // DEBUG_EVENT_QUEUE
@@ -155,49 +82,17 @@ void AvatarMixerSlavePool::resize(int numThreads) {
 
     qDebug("%s: set %d threads (was %d)", __FUNCTION__, numThreads, _numThreads);
 
-    Lock lock(_mutex);
+    // stop any extra worker threads before their slaves go away
+    _scheduler.resize(numThreads);
 
     if (numThreads > _numThreads) {
-        // start new slaves
         for (int i = 0; i < numThreads - _numThreads; ++i) {
-            auto slave = new AvatarMixerSlaveThread(*this, _slaveSharedData);
-            slave->start();
-            _slaves.emplace_back(slave);
+            _slaves.emplace_back(new AvatarMixerSlave(_slaveSharedData));
         }
     } else if (numThreads < _numThreads) {
-        auto extraBegin = _slaves.begin() + numThreads;
-
-        // mark slaves to stop...
-        auto slave = extraBegin;
-        while (slave != _slaves.end()) {
-            (*slave)->_stop = true;
-            ++slave;
-        }
-
-        // ...cycle them until they do stop...
-        _numStopped = 0;
-        while (_numStopped != (_numThreads - numThreads)) {
-            _numStarted = _numFinished = _numStopped;
-            _slaveCondition.notify_all();
-            _poolCondition.wait(lock, [&] {
-                assert(_numFinished <= _numThreads);
-                return _numFinished == _numThreads;
-            });
-        }
-
-        // ...wait for threads to finish...
-        slave = extraBegin;
-        while (slave != _slaves.end()) {
-            QThread* thread = reinterpret_cast<QThread*>(slave->get());
-            static const int MAX_THREAD_WAIT_TIME = 10;
-            thread->wait(MAX_THREAD_WAIT_TIME);
-            ++slave;
-        }
-
-        // ...and erase them
-        _slaves.erase(extraBegin, _slaves.end());
+        _slaves.erase(_slaves.begin() + numThreads, _slaves.end());
     }
 
-    _numThreads = _numStarted = _numFinished = numThreads;
+    _numThreads = numThreads;
     assert(_numThreads == (int)_slaves.size());
 }
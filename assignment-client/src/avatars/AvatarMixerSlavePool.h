@@ -12,53 +12,22 @@
 #ifndef hifi_AvatarMixerSlavePool_h
 #define hifi_AvatarMixerSlavePool_h
 
-#include <condition_variable>
-#include <mutex>
+#include <memory>
 #include <vector>
 
+#include <QJsonObject>
 #include <QThread>
 
-#include <TBBHelpers.h>
 #include <NodeList.h>
 #include <shared/QtHelpers.h>
 
+#include "../NodeWorkScheduler.h"
 #include "AvatarMixerSlave.h"
 
-
-class AvatarMixerSlavePool;
-
-class AvatarMixerSlaveThread : public QThread, public AvatarMixerSlave {
-    Q_OBJECT
-    using ConstIter = NodeList::const_iterator;
-    using Mutex = std::mutex;
-    using Lock = std::unique_lock<Mutex>;
-
-public:
-    AvatarMixerSlaveThread(AvatarMixerSlavePool& pool, SlaveSharedData* slaveSharedData) :
-        AvatarMixerSlave(slaveSharedData), _pool(pool) {};
-
-    void run() override final;
-
-private:
-    friend class AvatarMixerSlavePool;
-
-    void wait();
-    void notify(bool stopping);
-    bool try_pop(SharedNodePointer& node);
-
-    AvatarMixerSlavePool& _pool;
-    void (AvatarMixerSlave::*_function)(const SharedNodePointer& node) { nullptr };
-    bool _stop { false };
-};
-
 // Slave pool for avatar mixers
+//   Each slave holds the state of one NodeWorkScheduler worker thread.
 //   AvatarMixerSlavePool is not thread-safe! It should be instantiated and used from a single thread.
 class AvatarMixerSlavePool {
-    using Queue = tbb::concurrent_queue<SharedNodePointer>;
-    using Mutex = std::mutex;
-    using Lock = std::unique_lock<Mutex>;
-    using ConditionVariable = std::condition_variable;
-
 public:
     using ConstIter = NodeList::const_iterator;
 
@@ -78,6 +47,9 @@ public:
     void queueStats(QJsonObject& stats);
 #endif
 
+    // thread utilization and tail latency since the last call
+    QJsonObject sampleSchedulerStats() { return _scheduler.sampleStats(); }
+
     void setNumThreads(int numThreads);
     int numThreads() const { return _numThreads; }
 
@@ -85,34 +57,20 @@ public:
     float getPriorityReservedFraction() const { return  _priorityReservedFraction; }
 
 private:
-    void run(ConstIter begin, ConstIter end);
+    void run(ConstIter begin, ConstIter end, NodeWorkScheduler::CostHistory& history,
+             void (AvatarMixerSlave::*function)(const SharedNodePointer& node));
     void resize(int numThreads);
 
-    std::vector<std::unique_ptr<AvatarMixerSlaveThread>> _slaves;
-
-    friend void AvatarMixerSlaveThread::wait();
-    friend void AvatarMixerSlaveThread::notify(bool stopping);
-    friend bool AvatarMixerSlaveThread::try_pop(SharedNodePointer& node);
-
-    // synchronization state
-    Mutex _mutex;
-    ConditionVariable _slaveCondition;
-    ConditionVariable _poolCondition;
-    void (AvatarMixerSlave::*_function)(const SharedNodePointer& node);
-    std::function<void(AvatarMixerSlave&)> _configure;
+    std::vector<std::unique_ptr<AvatarMixerSlave>> _slaves;
+    NodeWorkScheduler _scheduler { "AvatarMixerSlaveThread" };
 
     // Set from Domain Settings:
     float _priorityReservedFraction { 0.4f };
     int _numThreads { 0 };
 
-    int _numStarted { 0 }; // guarded by _mutex
-    int _numFinished { 0 }; // guarded by _mutex
-    int _numStopped { 0 }; // guarded by _mutex
-
-    // frame state
-    Queue _queue;
-    ConstIter _begin;
-    ConstIter _end;
+    // what each node cost last frame, per job
+    NodeWorkScheduler::CostHistory _processIncomingPacketsCosts;
+    NodeWorkScheduler::CostHistory _broadcastAvatarDataCosts;
 
     SlaveSharedData* _slaveSharedData;
 };
@@ -14,9 +14,14 @@
 #include <QtCore/QCoreApplication>
 #include <QtCore/QJsonObject>
 #include <QBuffer>
+
+#include <algorithm>
+
 #include <LogHandler.h>
 #include <MessagesClient.h>
 #include <NodeList.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
 #include <udt/PacketHeaders.h>
 
 const QString MESSAGES_MIXER_LOGGING_NAME = "messages-mixer";
@@ -35,20 +40,15 @@ MessagesMixer::MessagesMixer(ReceivedMessage& message) : ThreadedAssignment(mess
 }
 
 void MessagesMixer::nodeKilled(SharedNodePointer killedNode) {
-    for (auto& channel : _channelSubscribers) {
-        channel.remove(killedNode->getUUID());
+    auto localID = killedNode->getLocalID();
+    for (auto& channel : _channels) {
+        auto& subscribers = channel.subscribers;
+        subscribers.erase(std::remove(subscribers.begin(), subscribers.end(), localID), subscribers.end());
     }
 }
 
 void MessagesMixer::handleMessages(QSharedPointer<ReceivedMessage> receivedMessage, SharedNodePointer senderNode) {
-    QString channel, message;
-    QByteArray data;
-    QUuid senderID;
-    bool isText;
     auto senderUUID = senderNode->getUUID();
-    MessagesClient::decodeMessagesPacket(receivedMessage, channel, isText, message, data, senderID);
-
-    auto nodeList = DependencyManager::get<NodeList>();
 
     auto itr = _allSubscribers.find(senderUUID);
     if (itr == _allSubscribers.end()) {
@@ -59,30 +59,83 @@ void MessagesMixer::handleMessages(QSharedPointer<ReceivedMessage> receivedMessa
         *itr += 1;
     }
 
-    nodeList->eachMatchingNode(
-        [&](const SharedNodePointer& node)->bool {
-        return node->getActiveSocket() && _channelSubscribers[channel].contains(node->getUUID());
-    },
-        [&](const SharedNodePointer& node) {
-        auto packetList = isText ? MessagesClient::encodeMessagesPacket(channel, message, senderID) :
-                                   MessagesClient::encodeMessagesDataPacket(channel, data, senderID);
-        nodeList->sendPacketList(std::move(packetList), *node);
-    });
+    QString channelName, message;
+    QByteArray data;
+    QUuid senderID;
+    bool isText;
+    MessagesClient::decodeMessagesPacket(receivedMessage, channelName, isText, message, data, senderID);
+
+    auto channelItr = _channels.find(channelName);
+    if (channelItr == _channels.end()) {
+        // nobody has subscribed to this channel
+        return;
+    }
+    auto& channel = channelItr.value();
+    ++channel.messagesIn;
+
+    // encode the message once for all of the subscribers
+    auto payload = MessagesClient::encodeMessagesPayload(channelName, isText, isText ? message.toUtf8() : data, senderID);
+
+    if (channel.isCoalesced) {
+        auto pending = std::find_if(channel.pending.begin(), channel.pending.end(), [&](const PendingMessage& other) {
+            return other.senderUUID == senderUUID;
+        });
+        if (pending != channel.pending.end()) {
+            pending->payload = std::move(payload);
+            ++channel.messagesCoalesced;
+        } else {
+            channel.pending.push_back({ senderUUID, std::move(payload) });
+        }
+    } else {
+        sendToSubscribers(channel, payload);
+    }
+}
+
+void MessagesMixer::sendToSubscribers(Channel& channel, const QByteArray& payload) {
+    auto nodeList = DependencyManager::get<NodeList>();
+
+    for (auto localID : channel.subscribers) {
+        auto node = nodeList->nodeWithLocalID(localID);
+        if (node && node->getActiveSocket()) {
+            // each reliable connection sequences its own packets, so only the payload can be shared
+            auto packetList = NLPacketList::create(PacketType::MessagesData, QByteArray(), true, true);
+            packetList->write(payload);
+            nodeList->sendPacketList(std::move(packetList), *node);
+
+            ++channel.messagesOut;
+            channel.bytesOut += payload.size();
+        }
+    }
+}
+
+void MessagesMixer::flushCoalescedMessages() {
+    for (auto& channel : _channels) {
+        for (const auto& pending : channel.pending) {
+            sendToSubscribers(channel, pending.payload);
+        }
+        channel.pending.clear();
+    }
 }
 
 void MessagesMixer::handleMessagesSubscribe(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
-    auto senderUUID = senderNode->getUUID();
-    QString channel = QString::fromUtf8(message->getMessage());
+    auto localID = senderNode->getLocalID();
+    QString channelName = QString::fromUtf8(message->getMessage());
 
-    _channelSubscribers[channel] << senderUUID;
+    auto& channel = _channels[channelName];
+    channel.isCoalesced = _coalescedChannels.contains(channelName);
+    if (std::find(channel.subscribers.begin(), channel.subscribers.end(), localID) == channel.subscribers.end()) {
+        channel.subscribers.push_back(localID);
+    }
 }
 
 void MessagesMixer::handleMessagesUnsubscribe(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
-    auto senderUUID = senderNode->getUUID();
-    QString channel = QString::fromUtf8(message->getMessage());
+    auto localID = senderNode->getLocalID();
+    QString channelName = QString::fromUtf8(message->getMessage());
 
-    if (_channelSubscribers.contains(channel)) {
-        _channelSubscribers[channel].remove(senderUUID);
+    auto channelItr = _channels.find(channelName);
+    if (channelItr != _channels.end()) {
+        auto& subscribers = channelItr->subscribers;
+        subscribers.erase(std::remove(subscribers.begin(), subscribers.end(), localID), subscribers.end());
     }
 }
 
@@ -99,6 +152,40 @@ void MessagesMixer::sendStatsPacket() {
     });
 
     statsObject["messages"] = messagesMixerObject;
+
+    // add throughput stats for each channel, forgetting the channels that nobody is subscribed to any more
+    auto now = usecTimestampNow();
+    float elapsedSeconds = _lastStatsUsecs > 0 ? (float)(now - _lastStatsUsecs) / USECS_PER_SECOND : 0.0f;
+    _lastStatsUsecs = now;
+
+    QJsonObject channelsObject;
+    for (auto channelItr = _channels.begin(); channelItr != _channels.end();) {
+        auto& channel = channelItr.value();
+
+        QJsonObject channelStats;
+        channelStats["subscribers"] = (int)channel.subscribers.size();
+        channelStats["coalesced"] = channel.isCoalesced;
+        if (elapsedSeconds > 0.0f) {
+            channelStats["messages_in_per_second"] = channel.messagesIn / elapsedSeconds;
+            channelStats["messages_out_per_second"] = channel.messagesOut / elapsedSeconds;
+            channelStats["messages_coalesced_per_second"] = channel.messagesCoalesced / elapsedSeconds;
+            channelStats["outbound_kbps"] = (channel.bytesOut * BITS_IN_BYTE) / (elapsedSeconds * BYTES_PER_KILOBYTE);
+        }
+        channelsObject[channelItr.key()] = channelStats;
+
+        channel.messagesIn = 0;
+        channel.messagesOut = 0;
+        channel.messagesCoalesced = 0;
+        channel.bytesOut = 0;
+
+        if (channel.subscribers.empty() && channel.pending.empty()) {
+            channelItr = _channels.erase(channelItr);
+        } else {
+            ++channelItr;
+        }
+    }
+    statsObject["channels"] = channelsObject;
+
     ThreadedAssignment::addPacketStatsAndSendStatsPacket(statsObject);
 }
 
@@ -127,6 +214,36 @@ void MessagesMixer::parseDomainServerSettings(const QJsonObject& domainSettings)
     const QString NODE_MESSAGES_PER_SECOND_KEY = "max_node_messages_per_second";
     QJsonValue maxMessagesPerSecondValue = messagesMixerGroupObject.value(NODE_MESSAGES_PER_SECOND_KEY);
     _maxMessagesPerSecond = maxMessagesPerSecondValue.toInt(DEFAULT_NODE_MESSAGES_PER_SECOND);
+
+    // relay whatever was held back under the old settings before changing which channels are coalesced
+    flushCoalescedMessages();
+
+    const QString COALESCED_CHANNELS_KEY = "coalesced_channels";
+    _coalescedChannels.clear();
+    auto coalescedChannels =
+        messagesMixerGroupObject.value(COALESCED_CHANNELS_KEY).toString().split(',', QString::SkipEmptyParts);
+    for (const auto& channelName : coalescedChannels) {
+        _coalescedChannels.insert(channelName.trimmed());
+    }
+    for (auto channelItr = _channels.begin(); channelItr != _channels.end(); ++channelItr) {
+        channelItr->isCoalesced = _coalescedChannels.contains(channelItr.key());
+    }
+
+    const QString COALESCE_INTERVAL_KEY = "coalesce_interval_ms";
+    int coalesceInterval = messagesMixerGroupObject.value(COALESCE_INTERVAL_KEY).toInt(DEFAULT_COALESCE_INTERVAL_MSECS);
+
+    if (_coalescedChannels.isEmpty()) {
+        if (_coalesceTimer) {
+            _coalesceTimer->stop();
+        }
+    } else {
+        if (!_coalesceTimer) {
+            _coalesceTimer = new QTimer(this);
+            connect(_coalesceTimer, &QTimer::timeout, this, &MessagesMixer::flushCoalescedMessages);
+        }
+        _coalesceTimer->start(std::max(coalesceInterval, 1));
+        qDebug() << "Coalescing messages every" << coalesceInterval << "ms on channels" << coalescedChannels;
+    }
 }
 
 void MessagesMixer::processMaxMessagesContainer() {
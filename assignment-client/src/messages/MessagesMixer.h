@@ -15,8 +15,11 @@
 #ifndef hifi_MessagesMixer_h
 #define hifi_MessagesMixer_h
 
+#include <vector>
+
 #include <QtCore/QSharedPointer>
 
+#include <Node.h>
 #include <ThreadedAssignment.h>
 
 /// Handles assignments of type MessagesMixer - distribution of avatar data to various clients
@@ -41,10 +44,39 @@ private slots:
     void stopMaxMessagesProcessor();
     void processMaxMessagesContainer();
 
+    void flushCoalescedMessages();
+
 private:
-    QHash<QString, QSet<QUuid>> _channelSubscribers;
+    struct PendingMessage {
+        QUuid senderUUID;
+        QByteArray payload;
+    };
+
+    struct Channel {
+        std::vector<Node::LocalID> subscribers;
+        bool isCoalesced { false };
+        std::vector<PendingMessage> pending; // the latest message from each sender in this tick, if coalesced
+
+        // stats, since the last stats packet
+        int messagesIn { 0 };
+        int messagesOut { 0 };
+        int messagesCoalesced { 0 };
+        quint64 bytesOut { 0 };
+    };
+
+    // sends a single encoded message to every subscriber of the channel
+    void sendToSubscribers(Channel& channel, const QByteArray& payload);
+
+    QHash<QString, Channel> _channels;
     QHash<QUuid, int> _allSubscribers;
 
+    // channels on which only the latest message from each sender is relayed every coalescing interval
+    QSet<QString> _coalescedChannels;
+    QTimer* _coalesceTimer { nullptr };
+    const int DEFAULT_COALESCE_INTERVAL_MSECS = 50;
+
+    quint64 _lastStatsUsecs { 0 };
+
     const int DEFAULT_NODE_MESSAGES_PER_SECOND = 1000;
     int _maxMessagesPerSecond { 0 };
 
@@ -0,0 +1,232 @@
+//
+//  OctreeSendPool.cpp
+//  assignment-client/src/octree
+//
+//  Created on 2026-10-16.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreeSendPool.h"
+
+#include <assert.h>
+#include <algorithm>
+#include <chrono>
+
+#include <QtCore/QCoreApplication>
+
+#include <SharedUtil.h>
+#include <ThreadHelpers.h>
+
+#include "OctreeSendThread.h"
+#include "OctreeServerConsts.h"
+
+void OctreeSendPool::Worker::run() {
+    setThreadName(QString("Octree Send Worker %1").arg(_index).toStdString());
+
+    Lock lock(mutex);
+    while (!stop) {
+        // deliver the queued signals for this worker's clients in between their runs
+        lock.unlock();
+        QCoreApplication::processEvents();
+        lock.lock();
+
+        giveBack(lock);
+
+        Job job;
+        if (stop || !takeDueJob(lock, job)) {
+            continue;
+        }
+
+        lock.unlock();
+        quint64 start = usecTimestampNow();
+        bool keepRunning = job.sendThread->process();
+        quint64 end = usecTimestampNow();
+        lock.lock();
+
+        busyUsecs += end - start;
+        ++numRuns;
+        if (start > job.dueUsecs + OCTREE_SEND_INTERVAL_USECS) {
+            ++numLateRuns;
+        }
+        quint64 late = start > job.dueUsecs ? start - job.dueUsecs : 0;
+        lateUsecs += late;
+        maxLateUsecs = std::max(maxLateUsecs, late);
+
+        if (keepRunning) {
+            const quint64 MIN_USECS_BETWEEN_RUNS = 1;
+            job.dueUsecs = std::max(start + OCTREE_SEND_INTERVAL_USECS, end + MIN_USECS_BETWEEN_RUNS);
+            job.isBehind = job.sendThread->hasPendingSends();
+            jobs.push_back(job);
+        } else {
+            // the client is gone, hand it back to be deleted
+            job.sendThread->moveToThread(job.homeThread);
+            lock.unlock();
+            emit job.sendThread->finished();
+            lock.lock();
+        }
+    }
+}
+
+bool OctreeSendPool::Worker::takeDueJob(Lock& lock, Job& job) {
+    if (jobs.empty()) {
+        condition.wait(lock);
+        return false;
+    }
+
+    quint64 now = usecTimestampNow();
+    auto soonest = std::min_element(jobs.begin(), jobs.end(), [](const Job& a, const Job& b) {
+        return a.dueUsecs < b.dueUsecs;
+    });
+    if (soonest->dueUsecs > now) {
+        quint64 usecsToSleep = soonest->dueUsecs - now;
+        OctreeSendThread::_usleepTime += usecsToSleep;
+        ++OctreeSendThread::_usleepCalls;
+        condition.wait_for(lock, std::chrono::microseconds(usecsToSleep));
+        return false;
+    }
+
+    // of the clients that are due, those that have waited a whole interval go first,
+    // then those that still had data to send, then the rest in the order they became due
+    auto rank = [now](const Job& job) {
+        bool isOverdue = job.dueUsecs + OCTREE_SEND_INTERVAL_USECS < now;
+        return isOverdue ? 0 : (job.isBehind ? 1 : 2);
+    };
+    auto next = soonest;
+    for (auto it = jobs.begin(); it != jobs.end(); ++it) {
+        if (it->dueUsecs <= now && (rank(*it) < rank(*next) ||
+                                    (rank(*it) == rank(*next) && it->dueUsecs < next->dueUsecs))) {
+            next = it;
+        }
+    }
+
+    job = *next;
+    *next = jobs.back();
+    jobs.pop_back();
+    return true;
+}
+
+void OctreeSendPool::Worker::giveBack(Lock& lock) {
+    if (removing.empty()) {
+        return;
+    }
+
+    for (auto sendThread : removing) {
+        auto it = std::find_if(jobs.begin(), jobs.end(), [&](const Job& job) {
+            return job.sendThread == sendThread;
+        });
+        // a client that has already stopped running went back on its own
+        if (it != jobs.end()) {
+            it->sendThread->moveToThread(it->homeThread);
+            jobs.erase(it);
+        }
+    }
+    removing.clear();
+    condition.notify_all();
+}
+
+void OctreeSendPool::start(int numWorkers) {
+    assert(_workers.empty());
+
+    for (int i = 0; i < numWorkers; ++i) {
+        auto worker = new Worker(i);
+        _workers.emplace_back(worker);
+        worker->start();
+    }
+    _lastSampleUsecs = usecTimestampNow();
+}
+
+void OctreeSendPool::stop() {
+    // mark workers to stop...
+    for (auto& worker : _workers) {
+        {
+            Lock lock(worker->mutex);
+            worker->stop = true;
+        }
+        worker->condition.notify_all();
+    }
+
+    // ...wait for them to finish...
+    for (auto& worker : _workers) {
+        worker->wait();
+    }
+
+    // ...and erase them
+    _workers.clear();
+    _workerOf.clear();
+}
+
+void OctreeSendPool::add(OctreeSendThread* sendThread) {
+    assert(!_workers.empty());
+    assert(_workerOf.find(sendThread) == _workerOf.end());
+
+    auto worker = std::min_element(_workers.begin(), _workers.end(), [](const auto& a, const auto& b) {
+        return a->numClients < b->numClients;
+    })->get();
+    ++worker->numClients;
+    _workerOf[sendThread] = worker;
+
+    Job job { sendThread, QThread::currentThread(), usecTimestampNow(), false };
+    sendThread->moveToThread(worker);
+    {
+        Lock lock(worker->mutex);
+        worker->jobs.push_back(job);
+    }
+    worker->condition.notify_all();
+}
+
+void OctreeSendPool::remove(OctreeSendThread* sendThread) {
+    auto it = _workerOf.find(sendThread);
+    if (it == _workerOf.end()) {
+        return;
+    }
+    Worker* worker = it->second;
+    --worker->numClients;
+    _workerOf.erase(it);
+
+    // the worker gives the client back once it isn't running it
+    Lock lock(worker->mutex);
+    worker->removing.push_back(sendThread);
+    worker->condition.notify_all();
+    worker->condition.wait(lock, [&] {
+        return worker->stop || std::find(worker->removing.begin(), worker->removing.end(), sendThread) ==
+            worker->removing.end();
+    });
+}
+
+QJsonObject OctreeSendPool::sampleStats() {
+    quint64 now = usecTimestampNow();
+    quint64 sampleUsecs = std::max(now - _lastSampleUsecs, (quint64)1);
+    _lastSampleUsecs = now;
+
+    QJsonObject stats;
+    QJsonObject workerStats;
+    int numClients = 0;
+    for (size_t i = 0; i < _workers.size(); ++i) {
+        Worker& worker = *_workers[i];
+        Lock lock(worker.mutex);
+
+        QJsonObject workerObject;
+        workerObject["clients"] = worker.numClients;
+        workerObject["utilization_%"] = (100.0 * worker.busyUsecs) / sampleUsecs;
+        workerObject["runs"] = worker.numRuns;
+        workerObject["late_runs"] = worker.numLateRuns;
+        workerObject["avg_late_usecs"] = worker.numRuns > 0 ? (qint64)(worker.lateUsecs / worker.numRuns) : 0;
+        workerObject["max_late_usecs"] = (qint64)worker.maxLateUsecs;
+        workerStats[QString("thread_%1").arg(i)] = workerObject;
+        numClients += worker.numClients;
+
+        worker.busyUsecs = 0;
+        worker.lateUsecs = 0;
+        worker.maxLateUsecs = 0;
+        worker.numRuns = 0;
+        worker.numLateRuns = 0;
+    }
+    stats["workers"] = (int)_workers.size();
+    stats["clients"] = numClients;
+    stats["threads"] = workerStats;
+
+    return stats;
+}
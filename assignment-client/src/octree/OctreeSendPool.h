@@ -0,0 +1,97 @@
+//
+//  OctreeSendPool.h
+//  assignment-client/src/octree
+//
+//  Created on 2026-10-16.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_OctreeSendPool_h
+#define hifi_OctreeSendPool_h
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <QJsonObject>
+#include <QThread>
+
+class OctreeSendThread;
+
+// Fixed set of worker threads that run the OctreeSendThread of every client, in place of a thread per client.
+//   Each OctreeSendThread is moved to the worker with the fewest clients, so that the queued signals that change its
+//   state are still delivered on the thread that runs it, in between its runs. A worker runs each of its clients once
+//   per send interval and sleeps until the next one is due. When several are due at once, those that still had data
+//   to send go first, unless another has been waiting for a whole interval.
+//   OctreeSendPool is not thread-safe! It should be instantiated and used from a single thread.
+class OctreeSendPool {
+    using Mutex = std::mutex;
+    using Lock = std::unique_lock<Mutex>;
+    using ConditionVariable = std::condition_variable;
+
+public:
+    ~OctreeSendPool() { stop(); }
+
+    void start(int numWorkers);
+    // stops the workers once the server is shutting down, leaving the clients that are still on them to be deleted
+    void stop();
+    int numWorkers() const { return (int)_workers.size(); }
+
+    // starts running a client on one of the workers
+    void add(OctreeSendThread* sendThread);
+    // stops running a client and gives it back to the calling thread, so that it can be deleted
+    void remove(OctreeSendThread* sendThread);
+
+    // per-worker utilization and lateness since the last call
+    QJsonObject sampleStats();
+
+private:
+    struct Job {
+        OctreeSendThread* sendThread;
+        QThread* homeThread; // where the client goes back to once it stops running
+        quint64 dueUsecs;
+        bool isBehind; // whether it still had data to send at the end of its last run
+    };
+
+    class Worker : public QThread {
+    public:
+        Worker(int index) : _index(index) {}
+
+        void run() override final;
+
+        // guarded by mutex
+        Mutex mutex;
+        ConditionVariable condition;
+        std::vector<Job> jobs;
+        std::vector<OctreeSendThread*> removing;
+        bool stop { false };
+
+        // stats, guarded by mutex
+        quint64 busyUsecs { 0 };
+        quint64 lateUsecs { 0 };
+        quint64 maxLateUsecs { 0 };
+        int numRuns { 0 };
+        int numLateRuns { 0 };
+
+        int numClients { 0 }; // only used by the pool
+
+    private:
+        bool takeDueJob(Lock& lock, Job& job);
+        void giveBack(Lock& lock);
+
+        const int _index;
+    };
+
+    std::vector<std::unique_ptr<Worker>> _workers;
+    std::unordered_map<OctreeSendThread*, Worker*> _workerOf;
+    quint64 _lastSampleUsecs { 0 };
+};
+
+#endif // hifi_OctreeSendPool_h
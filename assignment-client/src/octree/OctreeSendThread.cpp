@@ -11,9 +11,6 @@
 
 #include "OctreeSendThread.h"
 
-#include <chrono>
-#include <thread>
-
 #include <NodeList.h>
 #include <NumericalConstants.h>
 #include <udt/PacketHeaders.h>
@@ -33,7 +30,7 @@ OctreeSendThread::OctreeSendThread(OctreeServer* myServer, const SharedNodePoint
 {
     QString safeServerName("Octree");
 
-    // set our QThread object name so we can identify this thread while debugging
+    // set our object name so we can identify this client while debugging
     setObjectName(QString("Octree Send Thread (%1)").arg(uuidStringWithoutCurlyBraces(_nodeUuid)));
 
     if (_myServer) {
@@ -41,7 +38,7 @@ OctreeSendThread::OctreeSendThread(OctreeServer* myServer, const SharedNodePoint
     }
 
     qDebug() << qPrintable(safeServerName)  << "server [" << _myServer << "]: client connected "
-                                            "- starting sending thread [" << this << "]";
+                                            "- starting sending [" << this << "]";
 
     OctreeServer::clientConnected();
 }
@@ -55,7 +52,7 @@ OctreeSendThread::~OctreeSendThread() {
     }
 
     qDebug() << qPrintable(safeServerName)  << "server [" << _myServer << "]: client disconnected "
-                                            "- ending sending thread [" << this << "]";
+                                            "- ending sending [" << this << "]";
 
     OctreeServer::clientDisconnected();
     OctreeServer::stopTrackingThread(this);
@@ -73,8 +70,6 @@ bool OctreeSendThread::process() {
 
     OctreeServer::didProcess(this);
 
-    quint64  start = usecTimestampNow();
-
     // we'd better have a server at this point, or we're in trouble
     assert(_myServer);
 
@@ -97,29 +92,8 @@ bool OctreeSendThread::process() {
         }
     }
 
-    if (_isShuttingDown) {
-        return false; // exit early if we're shutting down
-    }
-
-    // Only sleep if we're still running and we got the lock last time we tried, otherwise try to get the lock asap
-    if (isStillRunning()) {
-        // dynamically sleep until we need to fire off the next set of octree elements
-        int elapsed = (usecTimestampNow() - start);
-        int usecToSleep =  OCTREE_SEND_INTERVAL_USECS - elapsed;
-
-        if (usecToSleep <= 0) {
-            const int MIN_USEC_TO_SLEEP = 1;
-            usecToSleep = MIN_USEC_TO_SLEEP;
-        }
-
-        {
-            PerformanceWarning warn(false,"OctreeSendThread... usleep()",false,&_usleepTime,&_usleepCalls);
-            std::this_thread::sleep_for(std::chrono::microseconds(usecToSleep));
-        }
-
-    }
-
-    return isStillRunning();  // keep running till they terminate us
+    // the pool runs us again at the next send interval
+    return !_isShuttingDown;
 }
 
 AtomicUIntStat OctreeSendThread::_usleepTime { 0 };
@@ -411,7 +385,8 @@ int OctreeSendThread::packetDistributor(SharedNodePointer node, OctreeQueryNode*
 
     // if we've sent everything, then we want to remember that we've sent all
     // the octree elements from the current view frustum
-    if (!hasSomethingToSend(nodeData)) {
+    _hasPendingSends = hasSomethingToSend(nodeData);
+    if (!_hasPendingSends) {
         nodeData->setViewSent(true);
 
         // If this was a full scene then make sure we really send out a stats packet at this point so that
@@ -438,6 +413,7 @@ bool OctreeSendThread::traverseTreeAndSendContents(SharedNodePointer node, Octre
     params.trackSend = [this](const QUuid& dataID, quint64 dataEdited) {
         _myServer->trackSend(dataID, dataEdited, _nodeUuid);
     };
+    params.useEncodingCache = true;
 
     bool somethingToSend = true; // assume we have something
     bool hadSomething = hasSomethingToSend(nodeData);
@@ -5,7 +5,7 @@
 //  Created by Brad Hefta-Gaub on 8/21/13.
 //  Copyright 2013 High Fidelity, Inc.
 //
-//  Threaded or non-threaded object for sending octree data packets to a client
+//  Object for sending octree data packets to a client, run by the server's OctreeSendPool
 //
 //  Distributed under the Apache License, Version 2.0.
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
@@ -16,7 +16,8 @@
 
 #include <atomic>
 
-#include <GenericThread.h>
+#include <QtCore/QObject>
+
 #include <Node.h>
 #include <OctreePacketData.h>
 #include "OctreeQueryNode.h"
@@ -26,8 +27,8 @@ class OctreeServer;
 
 using AtomicUIntStat = std::atomic<uintmax_t>;
 
-/// Threaded processor for sending octree packets to a single client
-class OctreeSendThread : public GenericThread {
+/// Processor for sending octree packets to a single client, one send interval at a time
+class OctreeSendThread : public QObject {
     Q_OBJECT
 public:
     OctreeSendThread(OctreeServer* myServer, const SharedNodePointer& node);
@@ -36,6 +37,11 @@ public:
     void setIsShuttingDown();
     bool isShuttingDown() { return _isShuttingDown; }
 
+    /// Sends what this client should get in one send interval, returns false once the client is gone
+    virtual bool process();
+    /// Whether the client had more to send than fit in the last interval
+    bool hasPendingSends() const { return _hasPendingSends; }
+
     QUuid getNodeUuid() const { return _nodeUuid; }
 
     static AtomicUIntStat _totalBytes;
@@ -48,10 +54,10 @@ public:
     static AtomicUIntStat _usleepTime;
     static AtomicUIntStat _usleepCalls;
 
-protected:
-    /// Implements generic processing behavior for this thread.
-    virtual bool process() override;
+signals:
+    void finished();
 
+protected:
     virtual bool traverseTreeAndSendContents(SharedNodePointer node, OctreeQueryNode* nodeData,
             bool viewFrustumChanged, bool isFullScene);
     virtual bool traverseTreeAndBuildNextPacketPayload(EncodeBitstreamParams& params, const QJsonObject& jsonFilters) = 0;
@@ -73,7 +79,8 @@ private:
     int _truePacketsSent { 0 }; // available for debug stats
     int _trueBytesSent { 0 }; // available for debug stats
     int _packetsSentThisInterval { 0 }; // used for bandwidth throttle condition
-    bool _isShuttingDown { false };
+    std::atomic<bool> _isShuttingDown { false };
+    bool _hasPendingSends { false };
 };
 
 #endif // hifi_OctreeSendThread_h
@@ -91,6 +91,7 @@ int OctreeServer::_noProcessWait = 0;
 
 static const QString PERSIST_FILE_DOWNLOAD_PATH = "/models.json.gz";
 static const double NANOSECONDS_PER_SECOND = 1000000.0;;
+static const uint64_t BYTES_PER_MEGABYTE = 1024 * 1024;
 
 
 void OctreeServer::resetSendingStats() {
@@ -315,6 +316,7 @@ bool OctreeServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
         } else if (url.path() == "/resetStats") {
             _octreeInboundPacketProcessor->resetStats();
             _tree->resetEditStats();
+            _tree->resetLockWaitHistograms();
             resetSendingStats();
             showStats = true;
         } else if ((url.path() == PERSIST_FILE_DOWNLOAD_PATH) || (url.path() == PERSIST_FILE_DOWNLOAD_PATH + "/")) {
@@ -370,6 +372,11 @@ bool OctreeServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
             statsString += getFileLoadTime();
             statsString += "\r\n";
 
+            auto loadStats = getLoadStats();
+            statsString += QString("%1 File Load Read %2 items (%3 per second) using %4 threads, peak memory %5 MB\r\n")
+                .arg(getMyServerName()).arg(loadStats.numItems).arg(getFileLoadItemsPerSecond(), 0, 'f', 0)
+                .arg(loadStats.numThreads).arg(getLoadPeakMemoryBytes() / BYTES_PER_MEGABYTE);
+
             if (_persistFileDownload) {
                 statsString += QString("Persist file: <a href='%1'>Click to Download</a>\r\n").arg(PERSIST_FILE_DOWNLOAD_PATH);
             } else {
@@ -706,6 +713,10 @@ bool OctreeServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
         statsString += QString("            Average Filter Time: %1 usecs\r\n")
             .arg(locale.toString((uint)averageFilterTime).rightJustified(COLUMN_WIDTH, ' '));
 
+        const LockWaitHistograms& lockWaitHistograms = _tree->getLockWaitHistograms();
+        statsString += QString("          Tree Read Lock Waits: %1\r\n").arg(lockWaitHistograms.read.toString());
+        statsString += QString("         Tree Write Lock Waits: %1\r\n").arg(lockWaitHistograms.write.toString());
+
 
         int senderNumber = 0;
         NodeToSenderStatsMap allSenderStats = _octreeInboundPacketProcessor->getSingleSenderStats();
@@ -878,9 +889,9 @@ void OctreeServer::parsePayload() {
 OctreeServer::UniqueSendThread OctreeServer::createSendThread(const SharedNodePointer& node) {
     auto sendThread = newSendThread(node);
 
-    // we want to be notified when the thread finishes
-    connect(sendThread.get(), &GenericThread::finished, this, &OctreeServer::removeSendThread);
-    sendThread->initialize(true);
+    // we want to be notified when the client is done
+    connect(sendThread.get(), &OctreeSendThread::finished, this, &OctreeServer::removeSendThread);
+    _sendPool.add(sendThread.get());
 
     return sendThread;
 }
@@ -888,8 +899,12 @@ OctreeServer::UniqueSendThread OctreeServer::createSendThread(const SharedNodePo
 void OctreeServer::removeSendThread() {
     // If the object has been deleted since the event was queued, sender() will return nullptr
     if (auto sendThread = qobject_cast<OctreeSendThread*>(sender())) {
-        // This deletes the unique_ptr, so sendThread is destructed after that line
-        _sendThreads.erase(sendThread->getNodeUuid());
+        auto it = _sendThreads.find(sendThread->getNodeUuid());
+        if (it != _sendThreads.end() && it->second.get() == sendThread) {
+            _sendPool.remove(sendThread);
+            // This deletes the unique_ptr, so sendThread is destructed after that line
+            _sendThreads.erase(it);
+        }
     }
 }
 
@@ -904,7 +919,8 @@ void OctreeServer::handleOctreeQueryPacket(QSharedPointer<ReceivedMessage> messa
         if (it == _sendThreads.end()) {
             _sendThreads.emplace(senderNode->getUUID(), createSendThread(senderNode));
         } else if (it->second->isShuttingDown()) {
-            _sendThreads.erase(it); // Remove right away and wait on thread to be
+            _sendPool.remove(it->second.get()); // Remove right away and wait on the pool to be done with it
+            _sendThreads.erase(it);
 
             _sendThreads.emplace(senderNode->getUUID(), createSendThread(senderNode));
         }
@@ -1060,6 +1076,15 @@ void OctreeServer::readConfiguration() {
 
         qDebug() << "persistInterval=" << _persistInterval.count();
 
+        _persistCompactionInterval = OctreePersistThread::DEFAULT_COMPACTION_INTERVAL;
+        result = -1;
+        readOptionInt(QString("persistCompactionInterval"), settingsSectionObject, result);
+        if (result != -1) {
+            _persistCompactionInterval = std::chrono::milliseconds(result);
+        }
+
+        qDebug() << "persistCompactionInterval=" << _persistCompactionInterval.count();
+
         readOptionBool(QString("persistFileDownload"), settingsSectionObject, _persistFileDownload);
         qDebug() << "persistFileDownload=" << _persistFileDownload;
 
@@ -1132,6 +1157,10 @@ void OctreeServer::domainSettingsRequestComplete() {
 
     readConfiguration();
 
+    // clients are sent to by a fixed pool of threads however many there are
+    _sendPool.start(std::max(1, QThread::idealThreadCount()));
+    qDebug(octree_server) << "Sending to clients on" << _sendPool.numWorkers() << "threads";
+
     // if we want Persistence, set up the local file and persist thread
     if (_wantPersist) {
         static const QString ENTITY_PERSIST_EXTENSION = ".json.gz";
@@ -1190,7 +1219,7 @@ void OctreeServer::domainSettingsRequestComplete() {
 
         // now set up PersistThread
         _persistManager = new OctreePersistThread(_tree, _persistAbsoluteFilePath, _persistInterval, _debugTimestampNow,
-                                                 _persistAsFileType);
+                                                 _persistAsFileType, _persistCompactionInterval);
         _persistManager->moveToThread(&_persistThread);
         connect(&_persistThread, &QThread::finished, _persistManager, &QObject::deleteLater);
         connect(&_persistThread, &QThread::started, _persistManager, [this] {
@@ -1299,11 +1328,11 @@ void OctreeServer::aboutToFinish() {
     for (auto& it : _sendThreads) {
         auto& sendThread = *it.second;
         sendThread.setIsShuttingDown();
-        sendThread.terminate();
     }
 
-    // Clear will destruct all the unique_ptr to OctreeSendThreads which will call the GenericThread's dtor
-    // which waits on the thread to be done before returning
+    // Stopping the pool waits on any client being sent to, so that clear can then destruct all the unique_ptr
+    // to OctreeSendThreads
+    _sendPool.stop();
     _sendThreads.clear(); // Cleans up all the send threads.
 
     if (_persistManager) {
@@ -1401,6 +1430,11 @@ double OctreeServer::getFileLoadTimeSeconds() {
     return getLoadElapsedTime() / NANOSECONDS_PER_SECOND;
 }
 
+double OctreeServer::getFileLoadItemsPerSecond() {
+    auto loadStats = getLoadStats();
+    return loadStats.usecs > 0 ? (double)loadStats.numItems * USECS_PER_SECOND / loadStats.usecs : 0.0;
+}
+
 QString OctreeServer::getConfiguration() {
     QString result;
     for (int i = 1; i < _argc; i++) {
@@ -1436,8 +1470,13 @@ void OctreeServer::sendStatsPacket() {
     statsArray1["4. persistFileLoadTime"] = getFileLoadTime();
     statsArray1["5. clients"] = getCurrentClientCount();
     statsArray1["6. threads"] = threadsStats;
+    statsArray1["7. sendPool"] = _sendPool.sampleStats();
     statsArray1["uptime_seconds"] = getUptimeSeconds();
     statsArray1["persistFileLoadTime_seconds"] = getFileLoadTimeSeconds();
+    statsArray1["persistFileLoadItems"] = getLoadStats().numItems;
+    statsArray1["persistFileLoadItems_per_second"] = getFileLoadItemsPerSecond();
+    statsArray1["persistFileLoadThreads"] = getLoadStats().numThreads;
+    statsArray1["persistFileLoadPeakMemory_MB"] = (double)(getLoadPeakMemoryBytes() / BYTES_PER_MEGABYTE);
 
     // Octree Stats
     QJsonObject octreeStats;
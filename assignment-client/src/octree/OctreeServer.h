@@ -24,6 +24,7 @@
 #include <ThreadedAssignment.h>
 
 #include "OctreePersistThread.h"
+#include "OctreeSendPool.h"
 #include "OctreeSendThread.h"
 #include "OctreeServerConsts.h"
 #include "OctreeInboundPacketProcessor.h"
@@ -64,6 +65,8 @@ public:
     bool isInitialLoadComplete() const { return (_persistManager) ? _persistManager->isInitialLoadComplete() : true; }
     bool isPersistEnabled() const { return (_persistManager) ? true : false; }
     quint64 getLoadElapsedTime() const { return (_persistManager) ? _persistManager->getLoadElapsedTime() : 0; }
+    Octree::ReadStats getLoadStats() const { return (_persistManager) ? _persistManager->getLoadStats() : Octree::ReadStats(); }
+    uint64_t getLoadPeakMemoryBytes() const { return (_persistManager) ? _persistManager->getLoadPeakMemoryBytes() : 0; }
     QString getPersistFilename() const { return (_persistManager) ? _persistManager->getPersistFilename() : ""; }
     QString getPersistFileMimeType() const { return (_persistManager) ? _persistManager->getPersistFileMimeType() : "text/plain"; }
     QByteArray getPersistFileContents() const { return (_persistManager) ? _persistManager->getPersistFileContents() : QByteArray(); }
@@ -162,6 +165,7 @@ protected:
     double getUptimeSeconds();
     QString getFileLoadTime();
     double getFileLoadTimeSeconds();
+    double getFileLoadItemsPerSecond();
     QString getConfiguration();
     QString getStatusLink();
 
@@ -197,6 +201,7 @@ protected:
     QThread _persistThread;
 
     std::chrono::milliseconds _persistInterval;
+    std::chrono::milliseconds _persistCompactionInterval;
     bool _persistFileDownload;
     int _maxBackupVersions;
 
@@ -205,6 +210,7 @@ protected:
     QString _safeServerName;
     
     SendThreads _sendThreads;
+    OctreeSendPool _sendPool;
 
     static int _clientCount;
     static SimpleMovingAverage _averageLoopTime;
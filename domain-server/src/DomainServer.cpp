@@ -1289,8 +1289,11 @@ void DomainServer::processListRequestPacket(QSharedPointer<ReceivedMessage> mess
         safeInterestSet.remove(NodeType::Agent);
     }
 
-    // update the NodeInterestSet in case there have been any changes
-    nodeData->setNodeInterestSet(safeInterestSet);
+    // update the NodeInterestSet in case there have been any changes, after which the node needs the whole domain list
+    if (safeInterestSet != nodeData->getNodeInterestSet()) {
+        nodeData->setNodeInterestSet(safeInterestSet);
+        nodeData->setDomainListResyncVersion(++_domainListVersion);
+    }
 
     // update the connecting hostname in case it has changed
     nodeData->setPlaceName(nodeRequestData.placeName);
@@ -1298,6 +1301,12 @@ void DomainServer::processListRequestPacket(QSharedPointer<ReceivedMessage> mess
     // client-side send time of last connect/domain list request
     nodeData->setLastDomainCheckinTimestamp(nodeRequestData.lastPingTimestamp);
 
+    // the version of the domain list the node has, which it can be sent the changes since
+    nodeData->setDomainListVersion(nodeRequestData.domainListVersion);
+
+    // list this node again for the others if its sockets have changed, or it has been given other permissions
+    updateListedNode(sendingNode);
+
     sendDomainListToNode(sendingNode, message->getFirstPacketReceiveTime(), message->getSenderSockAddr(), false);
 }
 
@@ -1363,6 +1372,9 @@ QUrl DomainServer::oauthAuthorizationURL(const QUuid& stateUUID) {
 void DomainServer::handleConnectedNode(SharedNodePointer newNode, quint64 requestReceiveTime) {
     DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(newNode->getLinkedData());
 
+    // the node is sent the whole domain list on connecting, and can't be sent changes since any version from before
+    nodeData->setDomainListResyncVersion(++_domainListVersion);
+
     // reply back to the user with a PacketType::DomainList
     sendDomainListToNode(newNode, requestReceiveTime, nodeData->getSendingSockAddr(), true);
 
@@ -1376,6 +1388,8 @@ void DomainServer::handleConnectedNode(SharedNodePointer newNode, quint64 reques
         newNode->setIsReplicated(true);
     }
 
+    updateListedNode(newNode);
+
     // send out this node to our other connected nodes
     broadcastNewNode(newNode);
 }
@@ -1391,6 +1405,14 @@ void DomainServer::sendDomainListToNode(const SharedNodePointer& node, quint64 r
     DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
     auto limitedNodeList = DependencyManager::get<LimitedNodeList>();
 
+    // a node that has a version of the domain list from since it last needed the whole list, and not so old that the
+    // nodes removed since have been forgotten, is sent only what has changed since - any other is sent the whole list
+    quint64 baseVersion = nodeData->getDomainListVersion();
+    if (newConnection || baseVersion < nodeData->getDomainListResyncVersion()
+        || baseVersion < _oldestDomainListDeltaVersion || baseVersion > _domainListVersion) {
+        baseVersion = 0;
+    }
+
     extendedHeaderStream << limitedNodeList->getSessionUUID();
     extendedHeaderStream << limitedNodeList->getSessionLocalID();
     extendedHeaderStream << node->getUUID();
@@ -1401,11 +1423,34 @@ void DomainServer::sendDomainListToNode(const SharedNodePointer& node, quint64 r
     extendedHeaderStream << quint64(duration_cast<microseconds>(system_clock::now().time_since_epoch()).count());
     extendedHeaderStream << quint64(duration_cast<microseconds>(p_high_resolution_clock::now().time_since_epoch()).count()) - requestPacketReceiveTime;
     extendedHeaderStream << newConnection;
+    extendedHeaderStream << _domainListVersion;
+    extendedHeaderStream << baseVersion;
+    // the packets are sent unreliably, so number them, for the node to know when it has had all those of a list
+    extendedHeaderStream << ++_numDomainListsSent;
+    extendedHeaderStream << quint16(1);
+
+    auto domainListPackets = createDomainListPackets(node, extendedHeader, baseVersion);
+    if (domainListPackets->getNumPackets() > 1) {
+        // the number of packets is last in the header, and the same size whatever it is, so the list splits the same again
+        extendedHeaderStream.device()->seek(extendedHeader.size() - sizeof(quint16));
+        extendedHeaderStream << quint16(domainListPackets->getNumPackets());
+        domainListPackets = createDomainListPackets(node, extendedHeader, baseVersion);
+    }
+
+    // write the PacketList to this node
+    limitedNodeList->sendPacketList(std::move(domainListPackets), *node);
+}
+
+std::unique_ptr<NLPacketList> DomainServer::createDomainListPackets(const SharedNodePointer& node,
+                                                                    const QByteArray& extendedHeader, quint64 baseVersion) {
     auto domainListPackets = NLPacketList::create(PacketType::DomainList, extendedHeader);
 
     // always send the node their own UUID back
     QDataStream domainListStream(domainListPackets.get());
 
+    DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
+    auto limitedNodeList = DependencyManager::get<LimitedNodeList>();
+
     // store the nodeInterestSet on this DomainServerNodeData, in case it has changed
     auto& nodeInterestSet = nodeData->getNodeInterestSet();
 
@@ -1413,12 +1458,31 @@ void DomainServer::sendDomainListToNode(const SharedNodePointer& node, quint64 r
 
         // DTLSServerSession* dtlsSession = _isUsingDTLS ? _dtlsSessions[senderSockAddr] : NULL;
         if (nodeData->isAuthenticated()) {
+            if (baseVersion != 0) {
+                // the nodes removed since go first, in case any of them has been added again since
+                for (auto it = _removedListedNodes.rbegin(); it != _removedListedNodes.rend() && it->version > baseVersion; ++it) {
+                    if (it->uuid != node->getUUID() && nodeInterestSet.contains(it->type)) {
+                        domainListPackets->startSegment();
+                        domainListStream << quint8(LimitedNodeList::RemovedNode) << it->uuid;
+                        domainListPackets->endSegment();
+                    }
+                }
+            }
+
             // if this authenticated node has any interest types, send back those nodes as well
-            limitedNodeList->eachNode([this, node, &domainListPackets, &domainListStream](const SharedNodePointer& otherNode) {
+            limitedNodeList->eachNode([this, node, baseVersion, &domainListPackets, &domainListStream](const SharedNodePointer& otherNode) {
                 if (otherNode->getUUID() != node->getUUID() && isInInterestSet(node, otherNode)) {
+                    // a node that has the domain list as of the base version only needs the nodes listed since
+                    auto otherNodeData = static_cast<DomainServerNodeData*>(otherNode->getLinkedData());
+                    if (baseVersion != 0 && otherNodeData && otherNodeData->getListedVersion() <= baseVersion) {
+                        return;
+                    }
+
                     // since we're about to add a node to the packet we start a segment
                     domainListPackets->startSegment();
 
+                    domainListStream << quint8(LimitedNodeList::ListedNode);
+
                     // don't send avatar nodes to other avatars, that will come from avatar mixer
                     domainListStream << *otherNode.data();
 
@@ -1435,8 +1499,23 @@ void DomainServer::sendDomainListToNode(const SharedNodePointer& node, quint64 r
     // send an empty list to the node, in case there were no other nodes
     domainListPackets->closeCurrentPacket(true);
 
-    // write the PacketList to this node
-    limitedNodeList->sendPacketList(std::move(domainListPackets), *node);
+    return domainListPackets;
+}
+
+void DomainServer::updateListedNode(const SharedNodePointer& node) {
+    DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
+    if (!nodeData) {
+        return;
+    }
+
+    QByteArray listedEntry;
+    QDataStream listedEntryStream(&listedEntry, QIODevice::WriteOnly);
+    listedEntryStream << *node.data();
+
+    // the nodes that have this one already only need sending it again if it has changed
+    if (listedEntry != nodeData->getListedEntry()) {
+        nodeData->setListedEntry(listedEntry, ++_domainListVersion);
+    }
 }
 
 QUuid DomainServer::connectionSecretForNodes(const SharedNodePointer& nodeA, const SharedNodePointer& nodeB) {
@@ -3300,6 +3379,9 @@ void DomainServer::updateReplicationNodes(ReplicationServerDirection direction)
 
                         // manually activate the public socket for the replication node
                         node->activatePublicSocket();
+
+                        // it never checks in, so list it now, for the nodes that are only sent what changed
+                        updateListedNode(node);
                     }
                 }
 
@@ -3465,6 +3547,16 @@ void DomainServer::nodeKilled(SharedNodePointer node) {
             }
         }
 
+        // the nodes that were sent this one hear it's gone when they next check in, if not from broadcastNodeDisconnect()
+        if (nodeData->getListedVersion() != 0) {
+            const size_t MAX_REMOVED_LISTED_NODES = 1000;
+            _removedListedNodes.push_back({ node->getUUID(), node->getType(), ++_domainListVersion });
+            while (_removedListedNodes.size() > MAX_REMOVED_LISTED_NODES) {
+                _oldestDomainListDeltaVersion = _removedListedNodes.front().version;
+                _removedListedNodes.pop_front();
+            }
+        }
+
         if (node->getType() == NodeType::Agent) {
             // if this node was an Agent ask DomainServerNodeData to remove the interpolation we potentially stored
             nodeData->removeOverrideForKey(USERNAME_UUID_REPLACEMENT_STATS_KEY,
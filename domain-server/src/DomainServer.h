@@ -42,6 +42,7 @@
 #include "PendingAssignedNodeData.h"
 #include "DomainServerExporter.h"
 
+#include <deque>
 #include <memory>
 #include <QLoggingCategory>
 
@@ -204,6 +205,9 @@ private:
     void broadcastNodeDisconnect(const SharedNodePointer& disconnnectedNode);
 
     void sendDomainListToNode(const SharedNodePointer& node, quint64 requestPacketReceiveTime, const SockAddr& senderSockAddr, bool newConnection);
+    std::unique_ptr<NLPacketList> createDomainListPackets(const SharedNodePointer& node, const QByteArray& extendedHeader,
+                                                          quint64 baseVersion);
+    void updateListedNode(const SharedNodePointer& node);
 
     bool isInInterestSet(const SharedNodePointer& nodeA, const SharedNodePointer& nodeB);
 
@@ -277,6 +281,20 @@ private:
     QQueue<SharedAssignmentPointer> _unfulfilledAssignments;
     TransactionHash _pendingAssignmentCredits;
 
+    // bumped whenever a node is added to, changed in or removed from the domain list, so that a node that says which
+    // version it has can be sent only what has changed since
+    quint64 _domainListVersion { 0 };
+    // the nodes removed from the domain list, oldest first
+    struct RemovedListedNode {
+        QUuid uuid;
+        NodeType_t type;
+        quint64 version;
+    };
+    std::deque<RemovedListedNode> _removedListedNodes;
+    // changes can't be sent since any older version, as the nodes removed before it have been forgotten
+    quint64 _oldestDomainListDeltaVersion { 0 };
+    quint32 _numDomainListsSent { 0 };
+
     bool _isUsingDTLS { false };
 
     bool _oauthEnable { false };
@@ -77,7 +77,21 @@ public:
 
     bool hasCheckedIn() const { return _hasCheckedIn; }
     void setHasCheckedIn(bool hasCheckedIn) { _hasCheckedIn = hasCheckedIn; }
-    
+
+    // this node's entry in the domain list as last sent, and the version of the domain list it was last changed in
+    const QByteArray& getListedEntry() const { return _listedEntry; }
+    quint64 getListedVersion() const { return _listedVersion; }
+    void setListedEntry(const QByteArray& listedEntry, quint64 listedVersion) {
+        _listedEntry = listedEntry;
+        _listedVersion = listedVersion;
+    }
+
+    // the version of the domain list this node says it has, and the least that can be sent changes since
+    quint64 getDomainListVersion() const { return _domainListVersion; }
+    void setDomainListVersion(quint64 domainListVersion) { _domainListVersion = domainListVersion; }
+    quint64 getDomainListResyncVersion() const { return _domainListResyncVersion; }
+    void setDomainListResyncVersion(quint64 domainListResyncVersion) { _domainListResyncVersion = domainListResyncVersion; }
+
 private:
     QJsonObject overrideValuesIfNeeded(const QJsonObject& newStats);
     QJsonArray overrideValuesIfNeeded(const QJsonArray& newStats);
@@ -104,6 +118,11 @@ private:
     bool _wasAssigned { false };
 
     bool _hasCheckedIn { false };
+
+    QByteArray _listedEntry;
+    quint64 _listedVersion { 0 };
+    quint64 _domainListVersion { 0 };
+    quint64 _domainListResyncVersion { 0 };
 };
 
 #endif // hifi_DomainServerNodeData_h
@@ -59,6 +59,10 @@ NodeConnectionData NodeConnectionData::fromDataStream(QDataStream& dataStream, c
     newHeader.publicSockAddr.setType(publicSocketType);
     newHeader.localSockAddr.setType(localSocketType);
 
+    if (!isConnectRequest) {
+        dataStream >> newHeader.domainListVersion;
+    }
+
     // For WebRTC connections, the user client's signaling channel WebSocket address is used instead of the actual data 
     // channel's address.
     if (senderSockAddr.getType() == SocketType::WebRTC) {
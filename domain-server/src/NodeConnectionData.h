@@ -37,6 +37,7 @@ public:
     quint32 connectReason;
     quint64 previousConnectionUpTime;
     QByteArray protocolVersion;
+    quint64 domainListVersion { 0 }; // the version of the domain list a list request's sender has, or 0 for none
 };
 
 
@@ -5510,9 +5510,7 @@ bool Application::exportEntities(const QString& filename, float x, float y, floa
     AACube boundingCube(minCorner, cubeSize);
     QVector<QUuid> entities;
     auto entityTree = getEntities()->getTree();
-    entityTree->withReadLock([&] {
-        entityTree->evalEntitiesInCube(boundingCube, PickFilter(), entities);
-    });
+    entityTree->evalEntitiesInCube(boundingCube, PickFilter(), entities);
     return exportEntities(filename, entities, &center);
 }
 
@@ -15,6 +15,9 @@
 
 #include <QScriptEngine>
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
 #include "AvatarLogging.h"
 
 #if defined(__GNUC__) && !defined(__clang__)
@@ -296,6 +299,16 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
     render::Transaction renderTransaction;
     workload::Transaction workloadTransaction;
 
+    // avatars to commit once their joints are updated, in sorted order
+    struct SimulatedAvatar {
+        std::shared_ptr<OtherAvatar> avatar;
+        bool inView;
+    };
+    std::vector<SimulatedAvatar> simulatedAvatars;
+    std::vector<SimulatedAvatar> concurrentAvatars;
+    simulatedAvatars.reserve(avatarMap.size());
+    concurrentAvatars.reserve(avatarMap.size());
+
     for (int p = kHero; p < NumVariants; p++) {
         auto& priorityQueue = avatarPriorityQueues[p];
         // Sorting the current queue HERE as part of the measured timing.
@@ -340,17 +353,13 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
                     avatar->_transit.reset();
                     avatar->setIsNewAvatar(false);
                 }
-                avatar->simulate(deltaTime, inView);
-                if (avatar->getSkeletonModel()->isLoaded() && avatar->getWorkloadRegion() == workload::Region::R1) {
-                    _myAvatar->addAvatarHandsToFlow(avatar);
-                }
-                if (_drawOtherAvatarSkeletons) {
-                    avatar->debugJointData();
+                avatar->beginSimulate(deltaTime, inView);
+                if (avatar->canSimulateJointsConcurrently()) {
+                    concurrentAvatars.push_back({ avatar, inView });
+                } else {
+                    avatar->simulateJoints(deltaTime, inView);
                 }
-                avatar->setEnableMeshVisible(!_drawOtherAvatarSkeletons);
-                avatar->updateRenderItem(renderTransaction);
-                avatar->updateSpaceProxy(workloadTransaction);
-                avatar->setLastRenderUpdateTime(startTime);
+                simulatedAvatars.push_back({ avatar, inView });
 
             } else {
                 // we've spent our time budget for this priority bucket
@@ -386,6 +395,33 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
         }
     }
 
+    // the joints of each avatar only depend on its own state, so they're updated across the thread pool...
+    {
+        PROFILE_RANGE(simulation, "updateJoints");
+        auto simulateJoints = [&](const tbb::blocked_range<size_t>& range) {
+            for (size_t i = range.begin(); i < range.end(); ++i) {
+                concurrentAvatars[i].avatar->simulateJoints(deltaTime, concurrentAvatars[i].inView);
+            }
+        };
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, concurrentAvatars.size()), simulateJoints);
+    }
+
+    // ...and the rest, which touches the scene, the children and other avatars, is done here
+    for (const auto& simulated : simulatedAvatars) {
+        const auto& avatar = simulated.avatar;
+        avatar->endSimulate(deltaTime, simulated.inView);
+        if (avatar->getSkeletonModel()->isLoaded() && avatar->getWorkloadRegion() == workload::Region::R1) {
+            _myAvatar->addAvatarHandsToFlow(avatar);
+        }
+        if (_drawOtherAvatarSkeletons) {
+            avatar->debugJointData();
+        }
+        avatar->setEnableMeshVisible(!_drawOtherAvatarSkeletons);
+        avatar->updateRenderItem(renderTransaction);
+        avatar->updateSpaceProxy(workloadTransaction);
+        avatar->setLastRenderUpdateTime(startTime);
+    }
+
     if (_shouldRender) {
         qApp->getMain3DScene()->enqueueTransaction(renderTransaction);
     }
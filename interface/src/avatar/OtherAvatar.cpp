@@ -252,6 +252,12 @@ void OtherAvatar::setCollisionWithOtherAvatarsFlags() {
 }
 
 void OtherAvatar::simulate(float deltaTime, bool inView) {
+    beginSimulate(deltaTime, inView);
+    simulateJoints(deltaTime, inView);
+    endSimulate(deltaTime, inView);
+}
+
+void OtherAvatar::beginSimulate(float deltaTime, bool inView) {
     PROFILE_RANGE(simulation, "simulate");
 
     _globalPosition = _transit.isActive() ? _transit.getCurrentPosition() : _serverPosition;
@@ -263,40 +269,54 @@ void OtherAvatar::simulate(float deltaTime, bool inView) {
     if (inView) {
         _simulationInViewRate.increment();
     }
+}
 
-    PerformanceTimer perfTimer("simulate");
-    {
-        PROFILE_RANGE(simulation, "updateJoints");
-        if (inView) {
-            Head* head = getHead();
-            if (_hasNewJointData || _transit.isActive()) {
-                _skeletonModel->getRig().copyJointsFromJointData(_jointData);
-                glm::mat4 rootTransform = glm::scale(_skeletonModel->getScale()) * glm::translate(_skeletonModel->getOffset());
-                _skeletonModel->getRig().computeExternalPoses(rootTransform);
-                _jointDataSimulationRate.increment();
-
-                head->simulate(deltaTime);
-                _skeletonModel->simulate(deltaTime, true);
-
-                locationChanged(); // joints changed, so if there are any children, update them.
-                _hasNewJointData = false;
-
-                glm::vec3 headPosition = getWorldPosition();
-                if (!_skeletonModel->getHeadPosition(headPosition)) {
-                    headPosition = getWorldPosition();
-                }
-                head->setPosition(headPosition);
-            } else {
-                head->simulate(deltaTime);
-                _skeletonModel->simulate(deltaTime, false);
+bool OtherAvatar::canSimulateJointsConcurrently() const {
+    return _skeletonModel->canSimulateConcurrently();
+}
+
+void OtherAvatar::simulateJoints(float deltaTime, bool inView) {
+    PROFILE_RANGE(simulation, "updateJoints");
+    if (inView) {
+        Head* head = getHead();
+        if (_hasNewJointData || _transit.isActive()) {
+            _skeletonModel->getRig().copyJointsFromJointData(_jointData);
+            glm::mat4 rootTransform = glm::scale(_skeletonModel->getScale()) * glm::translate(_skeletonModel->getOffset());
+            _skeletonModel->getRig().computeExternalPoses(rootTransform);
+            _jointDataSimulationRate.increment();
+
+            head->simulate(deltaTime);
+            _skeletonModel->simulate(deltaTime, true);
+
+            _jointsChanged = true;
+            _hasNewJointData = false;
+
+            glm::vec3 headPosition = getWorldPosition();
+            if (!_skeletonModel->getHeadPosition(headPosition)) {
+                headPosition = getWorldPosition();
             }
-            head->setScale(getModelScale());
-            relayJointDataToChildren();
+            head->setPosition(headPosition);
         } else {
-            // a non-full update is still required so that the position, rotation, scale and bounds of the skeletonModel are updated.
+            head->simulate(deltaTime);
             _skeletonModel->simulate(deltaTime, false);
         }
-        _skeletonModelSimulationRate.increment();
+        head->setScale(getModelScale());
+    } else {
+        // a non-full update is still required so that the position, rotation, scale and bounds of the skeletonModel are updated.
+        _skeletonModel->simulate(deltaTime, false);
+    }
+    _skeletonModelSimulationRate.increment();
+}
+
+void OtherAvatar::endSimulate(float deltaTime, bool inView) {
+    PerformanceTimer perfTimer("simulate");
+
+    if (_jointsChanged) {
+        locationChanged(); // joints changed, so if there are any children, update them.
+        _jointsChanged = false;
+    }
+    if (inView) {
+        relayJointDataToChildren();
     }
 
     // update animation for display name fade in/out
@@ -64,6 +64,14 @@ public:
     void setCollisionWithOtherAvatarsFlags() override;
 
     void simulate(float deltaTime, bool inView) override;
+
+    // simulate in three phases, so that the joints of many avatars can be updated concurrently: the first and last
+    // phases run on the main thread, the joints may be updated on any thread if canSimulateJointsConcurrently()
+    void beginSimulate(float deltaTime, bool inView);
+    bool canSimulateJointsConcurrently() const;
+    void simulateJoints(float deltaTime, bool inView);
+    void endSimulate(float deltaTime, bool inView);
+
     void debugJointData() const;
     friend AvatarManager;
 
@@ -91,6 +99,7 @@ protected:
     uint8_t _workloadRegion { workload::Region::INVALID };
     BodyLOD _bodyLOD { BodyLOD::Sphere };
     bool _needsDetailedRebuild { false };
+    bool _jointsChanged { false }; // by simulateJoints, for endSimulate to tell the children
 };
 
 using OtherAvatarPointer = std::shared_ptr<OtherAvatar>;
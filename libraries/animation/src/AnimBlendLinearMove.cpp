@@ -53,9 +53,9 @@ const AnimPoseVec& AnimBlendLinearMove::evaluate(const AnimVariantMap& animVars,
     _desiredSpeed = animVars.lookup(_desiredSpeedVar, _desiredSpeed);
 
     float speed = 0.0f;
-    if (_alphaVar.contains("Lateral")) {
+    if (_alphaVar.getName().contains("Lateral")) {
         speed = animVars.lookup("moveLateralSpeed", speed);
-    } else if (_alphaVar.contains("Backward")) {
+    } else if (_alphaVar.getName().contains("Backward")) {
         speed = animVars.lookup("moveBackwardSpeed", speed);
     } else {
         //this is forward movement
@@ -86,12 +86,12 @@ protected:
     QString _baseURL;
     float _baseFrame;
 
-    QString _startFrameVar;
-    QString _endFrameVar;
-    QString _timeScaleVar;
-    QString _loopFlagVar;
-    QString _mirrorFlagVar;
-    QString _frameVar;
+    AnimVariantKey _startFrameVar;
+    AnimVariantKey _endFrameVar;
+    AnimVariantKey _timeScaleVar;
+    AnimVariantKey _loopFlagVar;
+    AnimVariantKey _mirrorFlagVar;
+    AnimVariantKey _frameVar;
 
     // no copies
     AnimClip(const AnimClip&) = delete;
@@ -571,7 +571,7 @@ void AnimExpression::evalUnaryMinus(const AnimVariantMap& map, std::stack<OpCode
 
     switch (rhs.type) {
     case OpCode::Identifier: {
-        const AnimVariant& var = map.get(rhs.strVal);
+        const AnimVariant& var = map.get(rhs.var);
         switch (var.getType()) {
         case AnimVariant::Type::Bool:
             qCWarning(animation) << "AnimExpression: type missmatch for unary minus, expected a number not a bool";
@@ -615,7 +615,7 @@ AnimExpression::OpCode AnimExpression::coerseToValue(const AnimVariantMap& map,
     switch (opCode.type) {
     case OpCode::Identifier:
         {
-            const AnimVariant& var = map.get(opCode.strVal);
+            const AnimVariant& var = map.get(opCode.var);
             switch (var.getType()) {
             case AnimVariant::Type::Bool:
                 return OpCode((bool)var.getBool());
@@ -651,7 +651,7 @@ void AnimExpression::dumpOpCodes() const {
     QString tmp;
     for (auto& op : _opCodes) {
         switch (op.type) {
-        case OpCode::Identifier: tmp += QString(" %1").arg(op.strVal); break;
+        case OpCode::Identifier: tmp += QString(" %1").arg(op.var.getName()); break;
         case OpCode::Bool: tmp += QString(" %1").arg(op.intVal ? "true" : "false"); break;
         case OpCode::Int: tmp += QString(" %1").arg(op.intVal); break;
         case OpCode::Float: tmp += QString(" %1").arg(op.floatVal); break;
@@ -83,8 +83,8 @@ protected:
             UnaryMinus
         };
         explicit OpCode(Type type) : type {type} {}
-        explicit OpCode(const QStringRef& strRef) : type {Type::Identifier}, strVal {strRef.toString()} {}
-        explicit OpCode(const QString& str) : type {Type::Identifier}, strVal {str} {}
+        explicit OpCode(const QStringRef& strRef) : type {Type::Identifier}, var {strRef.toString()} {}
+        explicit OpCode(const QString& str) : type {Type::Identifier}, var {str} {}
         explicit OpCode(int val) : type {Type::Int}, intVal {val} {}
         explicit OpCode(bool val) : type {Type::Bool}, intVal {(int)val} {}
         explicit OpCode(float val) : type {Type::Float}, floatVal {val} {}
@@ -93,14 +93,14 @@ protected:
             if (type == Int || type == Bool) {
                 return intVal != 0;
             } else if (type == Identifier) {
-                return map.lookup(strVal, false);
+                return map.lookup(var, false);
             } else {
                 return true;
             }
         }
 
         Type type {Int};
-        QString strVal;
+        AnimVariantKey var; // resolved once, when the expression is compiled
         int intVal {0};
         float floatVal {0.0f};
     };
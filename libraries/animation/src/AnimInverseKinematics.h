@@ -165,13 +165,13 @@ protected:
         AnimInverseKinematics::IKTargetVar& operator=(const AnimInverseKinematics::IKTargetVar&) = default;
 
         QString jointName;
-        QString positionVar;
-        QString rotationVar;
-        QString typeVar;
-        QString weightVar;
-        QString poleVectorEnabledVar;
-        QString poleReferenceVectorVar;
-        QString poleVectorVar;
+        AnimVariantKey positionVar;
+        AnimVariantKey rotationVar;
+        AnimVariantKey typeVar;
+        AnimVariantKey weightVar;
+        AnimVariantKey poleVectorEnabledVar;
+        AnimVariantKey poleReferenceVectorVar;
+        AnimVariantKey poleVectorVar;
         float weight;
         float flexCoefficients[MAX_FLEX_COEFFICIENTS];
         size_t numFlexCoefficients;
@@ -201,7 +201,7 @@ protected:
     float _maxErrorOnLastSolve { FLT_MAX };
     bool _previousEnableDebugIKTargets { false };
     SolutionSource _solutionSource { SolutionSource::RelaxToUnderPoses };
-    QString _solutionSourceVar;
+    AnimVariantKey _solutionSourceVar;
 
     JointChainInfoVec _prevJointChainInfoVec;
 };
@@ -67,7 +67,7 @@ protected:
             friend AnimStateMachine;
             Transition(const QString& var, State::Pointer state) : _var(var), _state(state) {}
         protected:
-            QString _var;
+            AnimVariantKey _var;
             State::Pointer _state;
         };
 
@@ -100,9 +100,9 @@ protected:
         InterpType _interpType;
         EasingType _easingType;
 
-        QString _interpTargetVar;
-        QString _interpDurationVar;
-        QString _interpTypeVar;
+        AnimVariantKey _interpTargetVar;
+        AnimVariantKey _interpDurationVar;
+        AnimVariantKey _interpTypeVar;
 
         std::vector<Transition> _transitions;
 
@@ -147,7 +147,7 @@ protected:
     State::Pointer _previousState;
     std::vector<State::Pointer> _states;
 
-    QString _currentStateVar;
+    AnimVariantKey _currentStateVar;
 
 private:
     Q_DISABLE_COPY(AnimStateMachine)
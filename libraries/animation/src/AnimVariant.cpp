@@ -11,6 +11,10 @@
 
 #include "AnimVariant.h" // which has AnimVariant/AnimVariantMap
 
+#include <atomic>
+#include <mutex>
+
+#include <QHash>
 #include <QScriptEngine>
 #include <QScriptValueIterator>
 #include <QThread>
@@ -18,6 +22,64 @@
 
 const AnimVariant AnimVariant::False = AnimVariant();
 
+namespace {
+
+// every name that has been given a slot, shared by all threads
+struct SlotRegistry {
+    std::mutex mutex;
+    QHash<QString, int> slots;
+    std::vector<QString> names;
+};
+
+std::atomic<int> numSlots { 0 };
+
+SlotRegistry& getSlotRegistry() {
+    static SlotRegistry registry;
+    return registry;
+}
+
+}
+
+int AnimVariantKey::slotOf(const QString& name) {
+    if (name.isEmpty()) {
+        return INVALID_SLOT;
+    }
+
+    // names are looked up far more often than they are added, so each thread keeps the slots it has already seen
+    thread_local QHash<QString, int> cachedSlots;
+    auto cached = cachedSlots.constFind(name);
+    if (cached != cachedSlots.constEnd()) {
+        return cached.value();
+    }
+
+    int slot;
+    {
+        SlotRegistry& registry = getSlotRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        auto iter = registry.slots.constFind(name);
+        if (iter != registry.slots.constEnd()) {
+            slot = iter.value();
+        } else {
+            slot = (int)registry.names.size();
+            registry.slots.insert(name, slot);
+            registry.names.push_back(name);
+            numSlots.store(slot + 1, std::memory_order_release);
+        }
+    }
+    cachedSlots.insert(name, slot);
+    return slot;
+}
+
+int AnimVariantKey::getNumSlots() {
+    return numSlots.load(std::memory_order_acquire);
+}
+
+QString AnimVariantKey::nameOf(int slot) {
+    SlotRegistry& registry = getSlotRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    return slot >= 0 && slot < (int)registry.names.size() ? registry.names[slot] : QString();
+}
+
 QScriptValue AnimVariantMap::animVariantMapToScriptValue(QScriptEngine* engine, const QStringList& names, bool useNames) const {
     if (QThread::currentThread() != engine->thread()) {
         qCWarning(animation) << "Cannot create Javacript object from non-script thread" << QThread::currentThread();
@@ -52,25 +114,34 @@ QScriptValue AnimVariantMap::animVariantMapToScriptValue(QScriptEngine* engine,
     };
     if (useNames) { // copy only the requested names
         for (const QString& name : names) {
-            auto search = _map.find(name);
-            if (search != _map.end()) {
-                setOne(name, search->second);
-            } else if (_triggers.count(name) == 1) {
-                target.setProperty(name, true);
+            auto value = find(name);
+            if (value) {
+                setOne(name, *value);
             } // scripts are allowed to request names that do not exist
         }
 
     } else {  // copy all of them
-        for (auto& pair : _map) {
-            setOne(pair.first, pair.second);
+        for (int slot = 0; slot < (int)_slots.size(); ++slot) {
+            if (_slots[slot].isSet) {
+                setOne(AnimVariantKey::nameOf(slot), _slots[slot].value);
+            }
         }
     }
     return target;
 }
 
 void AnimVariantMap::copyVariantsFrom(const AnimVariantMap& other) {
-    for (auto& pair : other._map) {
-        _map[pair.first] = pair.second;
+    if (other._slots.size() > _slots.size()) {
+        _slots.resize(other._slots.size());
+    }
+    for (int slot = 0; slot < (int)other._slots.size(); ++slot) {
+        if (other._slots[slot].isSet) {
+            if (!_slots[slot].isSet) {
+                _slots[slot].isSet = true;
+                ++_numSet;
+            }
+            _slots[slot].value = other._slots[slot].value;
+        }
     }
 }
 
@@ -128,21 +199,26 @@ void AnimVariantMap::animVariantMapFromScriptValue(const QScriptValue& source) {
 
 std::map<QString, QString> AnimVariantMap::toDebugMap() const {
     std::map<QString, QString> result;
-    for (auto& pair : _map) {
-        switch (pair.second.getType()) {
+    for (int slot = 0; slot < (int)_slots.size(); ++slot) {
+        if (!_slots[slot].isSet) {
+            continue;
+        }
+        QString name = AnimVariantKey::nameOf(slot);
+        const AnimVariant& variant = _slots[slot].value;
+        switch (variant.getType()) {
         case AnimVariant::Type::Bool:
-            result[pair.first] = QString("%1").arg(pair.second.getBool());
+            result[name] = QString("%1").arg(variant.getBool());
             break;
         case AnimVariant::Type::Int:
-            result[pair.first] = QString("%1").arg(pair.second.getInt());
+            result[name] = QString("%1").arg(variant.getInt());
             break;
         case AnimVariant::Type::Float:
-            result[pair.first] = QString::number(pair.second.getFloat(), 'f', 3);
+            result[name] = QString::number(variant.getFloat(), 'f', 3);
             break;
         case AnimVariant::Type::Vec3: {
             // To prevent filling up debug stats, don't show vec3 values
-            glm::vec3 value = pair.second.getVec3();
-            result[pair.first] = QString("(%1, %2, %3)").
+            glm::vec3 value = variant.getVec3();
+            result[name] = QString("(%1, %2, %3)").
                 arg(QString::number(value.x, 'f', 3)).
                 arg(QString::number(value.y, 'f', 3)).
                 arg(QString::number(value.z, 'f', 3));
@@ -150,8 +226,8 @@ std::map<QString, QString> AnimVariantMap::toDebugMap() const {
         }
         case AnimVariant::Type::Quat: {
             // To prevent filling up the anim stats, don't show quat values
-            glm::quat value = pair.second.getQuat();
-            result[pair.first] = QString("(%1, %2, %3, %4)").
+            glm::quat value = variant.getQuat();
+            result[name] = QString("(%1, %2, %3, %4)").
                 arg(QString::number(value.x, 'f', 3)).
                 arg(QString::number(value.y, 'f', 3)).
                 arg(QString::number(value.z, 'f', 3)).
@@ -160,7 +236,7 @@ std::map<QString, QString> AnimVariantMap::toDebugMap() const {
         }
         case AnimVariant::Type::String:
             // To prevent filling up anim stats, don't show string values
-            result[pair.first] = pair.second.getString();
+            result[name] = variant.getString();
             break;
         default:
             // invalid AnimVariant::Type
@@ -11,12 +11,14 @@
 #ifndef hifi_AnimVariant_h
 #define hifi_AnimVariant_h
 
+#include <algorithm>
 #include <cassert>
 #include <functional>
 #include <glm/glm.hpp>
 #include <glm/gtx/quaternion.hpp>
 #include <map>
 #include <set>
+#include <vector>
 #include <QScriptValue>
 #include <StreamUtils.h>
 #include <GLMHelpers.h>
@@ -114,118 +116,108 @@ protected:
     } _val;
 };
 
+// Name of an anim var, interned to a slot index so that looking it up in an AnimVariantMap is an array access.
+//   Slots are handed out the first time each name is seen and never reused, so that the anim nodes can resolve the
+//   names of their vars once, when the anim graph is loaded. Keys can still be made from any string, e.g. the names
+//   that come from scripts, at the cost of a lookup in a per-thread cache.
+class AnimVariantKey {
+public:
+    static const int INVALID_SLOT = -1;
+
+    AnimVariantKey() {}
+    AnimVariantKey(const QString& name) : _name(name), _slot(slotOf(name)) {}
+    AnimVariantKey(const char* name) : AnimVariantKey(QString(name)) {}
+
+    bool isEmpty() const { return _slot == INVALID_SLOT; }
+    int getSlot() const { return _slot; }
+    const QString& getName() const { return _name; }
+
+    // the slot of a name, which is handed out on first use, or INVALID_SLOT for an empty name
+    static int slotOf(const QString& name);
+    static QString nameOf(int slot);
+    static int getNumSlots();
+
+private:
+    QString _name;
+    int _slot { INVALID_SLOT };
+};
+
 class AnimVariantMap {
 public:
 
-    bool lookup(const QString& key, bool defaultValue) const {
-        // check triggers first, then map
-        if (key.isEmpty()) {
-            return defaultValue;
-        } else if (_triggers.find(key) != _triggers.end()) {
-            return true;
-        } else {
-            auto iter = _map.find(key);
-            return iter != _map.end() ? iter->second.getBool() : defaultValue;
-        }
+    bool lookup(const AnimVariantKey& key, bool defaultValue) const {
+        auto value = find(key);
+        return value ? value->getBool() : defaultValue;
     }
 
-    int lookup(const QString& key, int defaultValue) const {
-        if (key.isEmpty()) {
-            return defaultValue;
-        } else {
-            auto iter = _map.find(key);
-            return iter != _map.end() ? iter->second.getInt() : defaultValue;
-        }
+    int lookup(const AnimVariantKey& key, int defaultValue) const {
+        auto value = find(key);
+        return value ? value->getInt() : defaultValue;
     }
 
-    float lookup(const QString& key, float defaultValue) const {
-        if (key.isEmpty()) {
-            return defaultValue;
-        } else {
-            auto iter = _map.find(key);
-            return iter != _map.end() ? iter->second.getFloat() : defaultValue;
-        }
+    float lookup(const AnimVariantKey& key, float defaultValue) const {
+        auto value = find(key);
+        return value ? value->getFloat() : defaultValue;
     }
 
-    const glm::vec3& lookupRaw(const QString& key, const glm::vec3& defaultValue) const {
-        if (key.isEmpty()) {
-            return defaultValue;
-        } else {
-            auto iter = _map.find(key);
-            return iter != _map.end() ? iter->second.getVec3() : defaultValue;
-        }
+    const glm::vec3& lookupRaw(const AnimVariantKey& key, const glm::vec3& defaultValue) const {
+        auto value = find(key);
+        return value ? value->getVec3() : defaultValue;
     }
 
-    glm::vec3 lookupRigToGeometry(const QString& key, const glm::vec3& defaultValue) const {
-        if (key.isEmpty()) {
-            return defaultValue;
-        } else {
-            auto iter = _map.find(key);
-            return iter != _map.end() ? transformPoint(_rigToGeometryMat, iter->second.getVec3()) : defaultValue;
-        }
+    glm::vec3 lookupRigToGeometry(const AnimVariantKey& key, const glm::vec3& defaultValue) const {
+        auto value = find(key);
+        return value ? transformPoint(_rigToGeometryMat, value->getVec3()) : defaultValue;
     }
 
-    glm::vec3 lookupRigToGeometryVector(const QString& key, const glm::vec3& defaultValue) const {
-        if (key.isEmpty()) {
-            return defaultValue;
-        } else {
-            auto iter = _map.find(key);
-            return iter != _map.end() ? transformVectorFast(_rigToGeometryMat, iter->second.getVec3()) : defaultValue;
-        }
+    glm::vec3 lookupRigToGeometryVector(const AnimVariantKey& key, const glm::vec3& defaultValue) const {
+        auto value = find(key);
+        return value ? transformVectorFast(_rigToGeometryMat, value->getVec3()) : defaultValue;
     }
 
-    const glm::quat& lookupRaw(const QString& key, const glm::quat& defaultValue) const {
-        if (key.isEmpty()) {
-            return defaultValue;
-        } else {
-            auto iter = _map.find(key);
-            return iter != _map.end() ? iter->second.getQuat() : defaultValue;
-        }
+    const glm::quat& lookupRaw(const AnimVariantKey& key, const glm::quat& defaultValue) const {
+        auto value = find(key);
+        return value ? value->getQuat() : defaultValue;
     }
 
-    glm::quat lookupRigToGeometry(const QString& key, const glm::quat& defaultValue) const {
-        if (key.isEmpty()) {
-            return defaultValue;
-        } else {
-            auto iter = _map.find(key);
-            return iter != _map.end() ? _rigToGeometryRot * iter->second.getQuat() : defaultValue;
-        }
+    glm::quat lookupRigToGeometry(const AnimVariantKey& key, const glm::quat& defaultValue) const {
+        auto value = find(key);
+        return value ? _rigToGeometryRot * value->getQuat() : defaultValue;
     }
 
-    const QString& lookup(const QString& key, const QString& defaultValue) const {
-        if (key.isEmpty()) {
-            return defaultValue;
-        } else {
-            auto iter = _map.find(key);
-            return iter != _map.end() ? iter->second.getString() : defaultValue;
-        }
+    const QString& lookup(const AnimVariantKey& key, const QString& defaultValue) const {
+        auto value = find(key);
+        return value ? value->getString() : defaultValue;
     }
 
-    void set(const QString& key, bool value) { _map[key] = AnimVariant(value); }
-    void set(const QString& key, int value) { _map[key] = AnimVariant(value); }
-    void set(const QString& key, float value) { _map[key] = AnimVariant(value); }
-    void set(const QString& key, const glm::vec3& value) { _map[key] = AnimVariant(value); }
-    void set(const QString& key, const glm::quat& value) { _map[key] = AnimVariant(value); }
-    void set(const QString& key, const QString& value) { _map[key] = AnimVariant(value); }
-    void unset(const QString& key) { _map.erase(key); }
+    void set(const AnimVariantKey& key, bool value) { assign(key, AnimVariant(value)); }
+    void set(const AnimVariantKey& key, int value) { assign(key, AnimVariant(value)); }
+    void set(const AnimVariantKey& key, float value) { assign(key, AnimVariant(value)); }
+    void set(const AnimVariantKey& key, const glm::vec3& value) { assign(key, AnimVariant(value)); }
+    void set(const AnimVariantKey& key, const glm::quat& value) { assign(key, AnimVariant(value)); }
+    void set(const AnimVariantKey& key, const QString& value) { assign(key, AnimVariant(value)); }
+    void unset(const AnimVariantKey& key) {
+        int slot = key.getSlot();
+        if (slot >= 0 && slot < (int)_slots.size() && _slots[slot].isSet) {
+            _slots[slot] = Slot();
+            --_numSet;
+        }
+    }
 
-    void setTrigger(const QString& key) { _map[key] = AnimVariant(true); }
+    void setTrigger(const AnimVariantKey& key) { assign(key, AnimVariant(true)); }
 
     void setRigToGeometryTransform(const glm::mat4& rigToGeometry) {
         _rigToGeometryMat = rigToGeometry;
         _rigToGeometryRot = glmExtractRotation(rigToGeometry);
     }
 
-    void clearMap() { _map.clear(); _triggers.clear(); }
-    bool hasKey(const QString& key) const { return _map.find(key) != _map.end(); }
+    void clearMap() { _slots.clear(); _numSet = 0; }
+    bool hasKey(const AnimVariantKey& key) const { return find(key) != nullptr; }
+    int size() const { return _numSet; }
 
-    const AnimVariant& get(const QString& key) const {
-        auto iter = _map.find(key);
-        if (iter != _map.end()) {
-            return iter->second;
-        } else {
-            return AnimVariant::False;
-        }
+    const AnimVariant& get(const AnimVariantKey& key) const {
+        auto value = find(key);
+        return value ? *value : AnimVariant::False;
     }
 
     // Answer a Plain Old Javascript Object (for the given engine) all of our values set as properties.
@@ -240,25 +232,30 @@ public:
 #ifndef NDEBUG
     void dump() const {
         qCDebug(animation) << "AnimVariantMap =";
-        for (auto& pair : _map) {
-            switch (pair.second.getType()) {
+        for (int slot = 0; slot < (int)_slots.size(); ++slot) {
+            if (!_slots[slot].isSet) {
+                continue;
+            }
+            const AnimVariant& value = _slots[slot].value;
+            QString name = AnimVariantKey::nameOf(slot);
+            switch (value.getType()) {
             case AnimVariant::Type::Bool:
-                qCDebug(animation) << "    " << pair.first << "=" << pair.second.getBool();
+                qCDebug(animation) << "    " << name << "=" << value.getBool();
                 break;
             case AnimVariant::Type::Int:
-                qCDebug(animation) << "    " << pair.first << "=" << pair.second.getInt();
+                qCDebug(animation) << "    " << name << "=" << value.getInt();
                 break;
             case AnimVariant::Type::Float:
-                qCDebug(animation) << "    " << pair.first << "=" << pair.second.getFloat();
+                qCDebug(animation) << "    " << name << "=" << value.getFloat();
                 break;
             case AnimVariant::Type::Vec3:
-                qCDebug(animation) << "    " << pair.first << "=" << pair.second.getVec3();
+                qCDebug(animation) << "    " << name << "=" << value.getVec3();
                 break;
             case AnimVariant::Type::Quat:
-                qCDebug(animation) << "    " << pair.first << "=" << pair.second.getQuat();
+                qCDebug(animation) << "    " << name << "=" << value.getQuat();
                 break;
             case AnimVariant::Type::String:
-                qCDebug(animation) << "    " << pair.first << "=" << pair.second.getString();
+                qCDebug(animation) << "    " << name << "=" << value.getString();
                 break;
             default:
                 assert(false);
@@ -268,8 +265,34 @@ public:
 #endif
 
 protected:
-    std::map<QString, AnimVariant> _map;
-    std::set<QString> _triggers;
+    struct Slot {
+        AnimVariant value;
+        bool isSet { false };
+    };
+
+    const AnimVariant* find(const AnimVariantKey& key) const {
+        int slot = key.getSlot();
+        return slot >= 0 && slot < (int)_slots.size() && _slots[slot].isSet ? &_slots[slot].value : nullptr;
+    }
+
+    void assign(const AnimVariantKey& key, const AnimVariant& value) {
+        int slot = key.getSlot();
+        if (slot == AnimVariantKey::INVALID_SLOT) {
+            return;
+        }
+        if (slot >= (int)_slots.size()) {
+            // grow to every slot handed out so far, so that maps rarely grow more than once
+            _slots.resize(std::max(slot + 1, AnimVariantKey::getNumSlots()));
+        }
+        if (!_slots[slot].isSet) {
+            _slots[slot].isSet = true;
+            ++_numSet;
+        }
+        _slots[slot].value = value;
+    }
+
+    std::vector<Slot> _slots; // indexed by AnimVariantKey slot
+    int _numSet { 0 };
     glm::mat4 _rigToGeometryMat;
     glm::quat _rigToGeometryRot;
 };
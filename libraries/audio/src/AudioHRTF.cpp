@@ -212,6 +212,66 @@ static void FIR_1x4_SSE(float* src, float* dst0, float* dst1, float* dst2, float
     }
 }
 
+// 2 channel input, 2 channel output per input
+static void FIR_2x2_SSE(float* src0, float* src1, float* dst0, float* dst1, float* dst2, float* dst3, float coef[4][HRTF_TAPS], int numFrames) {
+
+    float* coef0 = coef[0] + HRTF_TAPS - 1;     // process backwards
+    float* coef1 = coef[1] + HRTF_TAPS - 1;
+    float* coef2 = coef[2] + HRTF_TAPS - 1;
+    float* coef3 = coef[3] + HRTF_TAPS - 1;
+
+    assert(numFrames % 4 == 0);
+
+    for (int i = 0; i < numFrames; i += 4) {
+
+        __m128 acc0 = _mm_setzero_ps();
+        __m128 acc1 = _mm_setzero_ps();
+        __m128 acc2 = _mm_setzero_ps();
+        __m128 acc3 = _mm_setzero_ps();
+
+        float* ps0 = &src0[i - HRTF_TAPS + 1];  // process forwards
+        float* ps1 = &src1[i - HRTF_TAPS + 1];
+
+        static_assert(HRTF_TAPS % 4 == 0, "HRTF_TAPS must be a multiple of 4");
+
+        for (int k = 0; k < HRTF_TAPS; k += 4) {
+
+            __m128 x0 = _mm_loadu_ps(&ps0[k+0]);
+            __m128 y0 = _mm_loadu_ps(&ps1[k+0]);
+            acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_load1_ps(&coef0[-k-0]), x0));
+            acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_load1_ps(&coef1[-k-0]), x0));
+            acc2 = _mm_add_ps(acc2, _mm_mul_ps(_mm_load1_ps(&coef2[-k-0]), y0));
+            acc3 = _mm_add_ps(acc3, _mm_mul_ps(_mm_load1_ps(&coef3[-k-0]), y0));
+
+            __m128 x1 = _mm_loadu_ps(&ps0[k+1]);
+            __m128 y1 = _mm_loadu_ps(&ps1[k+1]);
+            acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_load1_ps(&coef0[-k-1]), x1));
+            acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_load1_ps(&coef1[-k-1]), x1));
+            acc2 = _mm_add_ps(acc2, _mm_mul_ps(_mm_load1_ps(&coef2[-k-1]), y1));
+            acc3 = _mm_add_ps(acc3, _mm_mul_ps(_mm_load1_ps(&coef3[-k-1]), y1));
+
+            __m128 x2 = _mm_loadu_ps(&ps0[k+2]);
+            __m128 y2 = _mm_loadu_ps(&ps1[k+2]);
+            acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_load1_ps(&coef0[-k-2]), x2));
+            acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_load1_ps(&coef1[-k-2]), x2));
+            acc2 = _mm_add_ps(acc2, _mm_mul_ps(_mm_load1_ps(&coef2[-k-2]), y2));
+            acc3 = _mm_add_ps(acc3, _mm_mul_ps(_mm_load1_ps(&coef3[-k-2]), y2));
+
+            __m128 x3 = _mm_loadu_ps(&ps0[k+3]);
+            __m128 y3 = _mm_loadu_ps(&ps1[k+3]);
+            acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_load1_ps(&coef0[-k-3]), x3));
+            acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_load1_ps(&coef1[-k-3]), x3));
+            acc2 = _mm_add_ps(acc2, _mm_mul_ps(_mm_load1_ps(&coef2[-k-3]), y3));
+            acc3 = _mm_add_ps(acc3, _mm_mul_ps(_mm_load1_ps(&coef3[-k-3]), y3));
+        }
+
+        _mm_storeu_ps(&dst0[i], acc0);
+        _mm_storeu_ps(&dst1[i], acc1);
+        _mm_storeu_ps(&dst2[i], acc2);
+        _mm_storeu_ps(&dst3[i], acc3);
+    }
+}
+
 // 4 channel planar to interleaved
 static void interleave_4x4_SSE(float* src0, float* src1, float* src2, float* src3, float* dst, int numFrames) {
 
@@ -355,6 +415,43 @@ static void crossfade_4x2_SSE(float* src, float* dst, const float* win, int numF
     }
 }
 
+// mix 4 inputs into 2 outputs with accumulation (interleaved)
+static void mix_4x2_SSE(float* src, float* dst, int numFrames) {
+
+    assert(numFrames % 4 == 0);
+
+    for (int i = 0; i < numFrames; i += 4) {
+
+        __m128 x0 = _mm_loadu_ps(&src[4*i+0]);
+        __m128 x1 = _mm_loadu_ps(&src[4*i+4]);
+        __m128 x2 = _mm_loadu_ps(&src[4*i+8]);
+        __m128 x3 = _mm_loadu_ps(&src[4*i+12]);
+
+        __m128 y0 = _mm_loadu_ps(&dst[2*i+0]);
+        __m128 y1 = _mm_loadu_ps(&dst[2*i+4]);
+
+        // deinterleave (4x4 matrix transpose)
+        __m128 t0 = _mm_unpacklo_ps(x0, x1);
+        __m128 t2 = _mm_unpacklo_ps(x2, x3);
+        __m128 t1 = _mm_unpackhi_ps(x0, x1);
+        __m128 t3 = _mm_unpackhi_ps(x2, x3);
+
+        x0 = _mm_movelh_ps(t0, t2);
+        x1 = _mm_movehl_ps(t2, t0);
+        x2 = _mm_movelh_ps(t1, t3);
+        x3 = _mm_movehl_ps(t3, t1);
+
+        // accumulate the first pair, then the second (same order as two separate renders)
+        y0 = _mm_add_ps(y0, _mm_unpacklo_ps(x0, x1));
+        y1 = _mm_add_ps(y1, _mm_unpackhi_ps(x0, x1));
+        y0 = _mm_add_ps(y0, _mm_unpacklo_ps(x2, x3));
+        y1 = _mm_add_ps(y1, _mm_unpackhi_ps(x2, x3));
+
+        _mm_storeu_ps(&dst[2*i+0], y0);
+        _mm_storeu_ps(&dst[2*i+4], y1);
+    }
+}
+
 // linear interpolation with gain
 static void interpolate_SSE(const float* src0, const float* src1, float* dst, float frac, float gain) {
 
@@ -382,6 +479,8 @@ static void interpolate_SSE(const float* src0, const float* src1, float* dst, fl
 
 void FIR_1x4_AVX2(float* src, float* dst0, float* dst1, float* dst2, float* dst3, float coef[4][HRTF_TAPS], int numFrames);
 void FIR_1x4_AVX512(float* src, float* dst0, float* dst1, float* dst2, float* dst3, float coef[4][HRTF_TAPS], int numFrames);
+void FIR_2x2_AVX2(float* src0, float* src1, float* dst0, float* dst1, float* dst2, float* dst3, float coef[4][HRTF_TAPS], int numFrames);
+void FIR_2x2_AVX512(float* src0, float* src1, float* dst0, float* dst1, float* dst2, float* dst3, float coef[4][HRTF_TAPS], int numFrames);
 void interleave_4x4_AVX2(float* src0, float* src1, float* src2, float* src3, float* dst, int numFrames);
 void biquad2_4x4_AVX2(float* src, float* dst, float coef[5][8], float state[3][8], int numFrames);
 void crossfade_4x2_AVX2(float* src, float* dst, const float* win, int numFrames);
@@ -397,6 +496,15 @@ static void FIR_1x4(float* src, float* dst0, float* dst1, float* dst2, float* ds
     (*f)(src, dst0, dst1, dst2, dst3, coef, numFrames); // dispatch
 }
 
+static void FIR_2x2(float* src0, float* src1, float* dst0, float* dst1, float* dst2, float* dst3, float coef[4][HRTF_TAPS], int numFrames) {
+#ifndef STACK_PROTECTOR
+    static auto f = cpuSupportsAVX512() ? FIR_2x2_AVX512 : (cpuSupportsAVX2() ? FIR_2x2_AVX2 : FIR_2x2_SSE);
+#else
+    static auto f = cpuSupportsAVX2() ? FIR_2x2_AVX2 : FIR_2x2_SSE;
+#endif
+    (*f)(src0, src1, dst0, dst1, dst2, dst3, coef, numFrames); // dispatch
+}
+
 static void interleave_4x4(float* src0, float* src1, float* src2, float* src3, float* dst, int numFrames) {
     static auto f = cpuSupportsAVX2() ? interleave_4x4_AVX2 : interleave_4x4_SSE;
     (*f)(src0, src1, src2, src3, dst, numFrames); // dispatch
@@ -412,6 +520,10 @@ static void crossfade_4x2(float* src, float* dst, const float* win, int numFrame
     (*f)(src, dst, win, numFrames); // dispatch
 }
 
+static void mix_4x2(float* src, float* dst, int numFrames) {
+    mix_4x2_SSE(src, dst, numFrames);
+}
+
 static void interpolate(const float* src0, const float* src1, float* dst, float frac, float gain) {
     static auto f = cpuSupportsAVX2() ? interpolate_AVX2 : interpolate_SSE;
     (*f)(src0, src1, dst, frac, gain); // dispatch
@@ -484,6 +596,72 @@ static void FIR_1x4(float* src, float* dst0, float* dst1, float* dst2, float* ds
     }
 }
 
+// 2 channel input, 2 channel output per input
+static void FIR_2x2(float* src0, float* src1, float* dst0, float* dst1, float* dst2, float* dst3, float coef[4][HRTF_TAPS], int numFrames) {
+
+    float* coef0 = coef[0] + HRTF_TAPS - 1;     // process backwards
+    float* coef1 = coef[1] + HRTF_TAPS - 1;
+    float* coef2 = coef[2] + HRTF_TAPS - 1;
+    float* coef3 = coef[3] + HRTF_TAPS - 1;
+
+    assert(numFrames % 4 == 0);
+
+    for (int i = 0; i < numFrames; i += 4) {
+
+        dst0[i+0] = 0.0f;
+        dst0[i+1] = 0.0f;
+        dst0[i+2] = 0.0f;
+        dst0[i+3] = 0.0f;
+
+        dst1[i+0] = 0.0f;
+        dst1[i+1] = 0.0f;
+        dst1[i+2] = 0.0f;
+        dst1[i+3] = 0.0f;
+
+        dst2[i+0] = 0.0f;
+        dst2[i+1] = 0.0f;
+        dst2[i+2] = 0.0f;
+        dst2[i+3] = 0.0f;
+
+        dst3[i+0] = 0.0f;
+        dst3[i+1] = 0.0f;
+        dst3[i+2] = 0.0f;
+        dst3[i+3] = 0.0f;
+
+        float* ps0 = &src0[i - HRTF_TAPS + 1];  // process forwards
+        float* ps1 = &src1[i - HRTF_TAPS + 1];
+
+        static_assert(HRTF_TAPS % 4 == 0, "HRTF_TAPS must be a multiple of 4");
+
+        for (int k = 0; k < HRTF_TAPS; k += 4) {
+
+            // channel 0
+            dst0[i+0] += coef0[-k-0] * ps0[k+0] + coef0[-k-1] * ps0[k+1] + coef0[-k-2] * ps0[k+2] + coef0[-k-3] * ps0[k+3];
+            dst0[i+1] += coef0[-k-0] * ps0[k+1] + coef0[-k-1] * ps0[k+2] + coef0[-k-2] * ps0[k+3] + coef0[-k-3] * ps0[k+4];
+            dst0[i+2] += coef0[-k-0] * ps0[k+2] + coef0[-k-1] * ps0[k+3] + coef0[-k-2] * ps0[k+4] + coef0[-k-3] * ps0[k+5];
+            dst0[i+3] += coef0[-k-0] * ps0[k+3] + coef0[-k-1] * ps0[k+4] + coef0[-k-2] * ps0[k+5] + coef0[-k-3] * ps0[k+6];
+
+            // channel 1
+            dst1[i+0] += coef1[-k-0] * ps0[k+0] + coef1[-k-1] * ps0[k+1] + coef1[-k-2] * ps0[k+2] + coef1[-k-3] * ps0[k+3];
+            dst1[i+1] += coef1[-k-0] * ps0[k+1] + coef1[-k-1] * ps0[k+2] + coef1[-k-2] * ps0[k+3] + coef1[-k-3] * ps0[k+4];
+            dst1[i+2] += coef1[-k-0] * ps0[k+2] + coef1[-k-1] * ps0[k+3] + coef1[-k-2] * ps0[k+4] + coef1[-k-3] * ps0[k+5];
+            dst1[i+3] += coef1[-k-0] * ps0[k+3] + coef1[-k-1] * ps0[k+4] + coef1[-k-2] * ps0[k+5] + coef1[-k-3] * ps0[k+6];
+
+            // channel 2
+            dst2[i+0] += coef2[-k-0] * ps1[k+0] + coef2[-k-1] * ps1[k+1] + coef2[-k-2] * ps1[k+2] + coef2[-k-3] * ps1[k+3];
+            dst2[i+1] += coef2[-k-0] * ps1[k+1] + coef2[-k-1] * ps1[k+2] + coef2[-k-2] * ps1[k+3] + coef2[-k-3] * ps1[k+4];
+            dst2[i+2] += coef2[-k-0] * ps1[k+2] + coef2[-k-1] * ps1[k+3] + coef2[-k-2] * ps1[k+4] + coef2[-k-3] * ps1[k+5];
+            dst2[i+3] += coef2[-k-0] * ps1[k+3] + coef2[-k-1] * ps1[k+4] + coef2[-k-2] * ps1[k+5] + coef2[-k-3] * ps1[k+6];
+
+            // channel 3
+            dst3[i+0] += coef3[-k-0] * ps1[k+0] + coef3[-k-1] * ps1[k+1] + coef3[-k-2] * ps1[k+2] + coef3[-k-3] * ps1[k+3];
+            dst3[i+1] += coef3[-k-0] * ps1[k+1] + coef3[-k-1] * ps1[k+2] + coef3[-k-2] * ps1[k+3] + coef3[-k-3] * ps1[k+4];
+            dst3[i+2] += coef3[-k-0] * ps1[k+2] + coef3[-k-1] * ps1[k+3] + coef3[-k-2] * ps1[k+4] + coef3[-k-3] * ps1[k+5];
+            dst3[i+3] += coef3[-k-0] * ps1[k+3] + coef3[-k-1] * ps1[k+4] + coef3[-k-2] * ps1[k+5] + coef3[-k-3] * ps1[k+6];
+        }
+    }
+}
+
 // 4 channel planar to interleaved
 static void interleave_4x4(float* src0, float* src1, float* src2, float* src3, float* dst, int numFrames) {
 
@@ -678,6 +856,19 @@ static void crossfade_4x2(float* src, float* dst, const float* win, int numFrame
     }
 }
 
+// mix 4 inputs into 2 outputs with accumulation (interleaved)
+static void mix_4x2(float* src, float* dst, int numFrames) {
+
+    for (int i = 0; i < numFrames; i++) {
+
+        dst[2*i+0] += src[4*i+0];
+        dst[2*i+1] += src[4*i+1];
+
+        dst[2*i+0] += src[4*i+2];
+        dst[2*i+1] += src[4*i+3];
+    }
+}
+
 // linear interpolation with gain
 static void interpolate(const float* src0, const float* src1, float* dst, float frac, float gain) {
 
@@ -1060,6 +1251,12 @@ static void setFilters(float firCoef[4][HRTF_TAPS], float bqCoef[5][8], int dela
     }
 }
 
+// distance filter amount for a source distance
+static float distanceFilter(float distance, float lpfDistance) {
+    float lpf = 0.5f * fastLog2f(std::max(distance, 1.0f)) / fastLog2f(std::max(lpfDistance, 2.0f));
+    return std::min(std::max(lpf, 0.0f), 1.0f);
+}
+
 void AudioHRTF::render(int16_t* input, float* output, int index, float azimuth, float distance, float gain, int numFrames,
                        float lpfDistance) {
 
@@ -1078,8 +1275,7 @@ void AudioHRTF::render(int16_t* input, float* output, int index, float azimuth,
     gain *= _gainAdjust;
 
     // apply distance filter
-    float lpf = 0.5f * fastLog2f(std::max(distance, 1.0f)) / fastLog2f(std::max(lpfDistance, 2.0f));
-    lpf = std::min(std::max(lpf, 0.0f), 1.0f);
+    float lpf = distanceFilter(distance, lpfDistance);
 
     // disable interpolation from reset state
     if (_resetState) {
@@ -1162,6 +1358,158 @@ void AudioHRTF::render(int16_t* input, float* output, int index, float azimuth,
     _resetState = false;
 }
 
+void AudioHRTF::renderBatch(RenderSource* sources, int numSources, float* output, int index, int numFrames) {
+
+    assert(index >= 0);
+    assert(index < HRTF_TABLES);
+    assert(numFrames == HRTF_BLOCK);
+
+    RenderSource* unpaired = nullptr;   // steady source waiting for a partner
+
+    for (int i = 0; i < numSources; i++) {
+        RenderSource& source = sources[i];
+        AudioHRTF& hrtf = *source.hrtf;
+
+        float gain = source.gain * hrtf._gainAdjust;
+        float lpf = distanceFilter(source.distance, source.lpfDistance);
+
+        if (!hrtf.hasParameters(source.azimuth, source.distance, gain, lpf)) {
+            // moving source, crossfade from the old to the new filters
+            hrtf.render(source.input, output, index, source.azimuth, source.distance, source.gain, numFrames,
+                        source.lpfDistance);
+        } else if (unpaired) {
+            renderSteadyPair(*unpaired, source, output, index);
+            unpaired = nullptr;
+        } else {
+            unpaired = &source;
+        }
+    }
+
+    if (unpaired) {
+        unpaired->hrtf->render(unpaired->input, output, index, unpaired->azimuth, unpaired->distance, unpaired->gain,
+                               numFrames, unpaired->lpfDistance);
+    }
+}
+
+//
+// When the parameters are unchanged, the old and new filters of render() are identical and so are their states
+// (render() copies the new state over the old one after each block). The crossfade between them is then the new
+// output, so only the new channels are needed, which leaves room for a second source in the 4-channel kernels.
+//
+void AudioHRTF::renderSteadyPair(RenderSource& source0, RenderSource& source1, float* output, int index) {
+
+    ALIGN32 float in0[HRTF_TAPS + HRTF_BLOCK];              // mono, source 0
+    ALIGN32 float in1[HRTF_TAPS + HRTF_BLOCK];              // mono, source 1
+    ALIGN32 float firCoef[4][HRTF_TAPS];                    // 4-channel
+    ALIGN32 float firBuffer[4][HRTF_DELAY + HRTF_BLOCK];    // 4-channel
+    ALIGN32 float bqCoef[5][8];                             // 4-channel (interleaved)
+    ALIGN32 float bqState[3][8];                            // 4-channel (interleaved)
+    ALIGN32 float bqBuffer[4 * HRTF_BLOCK];                 // 4-channel (interleaved)
+    int delay[4];                                           // 4-channel (interleaved)
+
+    AudioHRTF& hrtf0 = *source0.hrtf;
+    AudioHRTF& hrtf1 = *source1.hrtf;
+
+    // source 0 uses channels L0/R0, source 1 uses channels L1/R1
+    float gain0 = source0.gain * hrtf0._gainAdjust;
+    float gain1 = source1.gain * hrtf1._gainAdjust;
+    float lpf0 = distanceFilter(source0.distance, source0.lpfDistance);
+    float lpf1 = distanceFilter(source1.distance, source1.lpfDistance);
+
+    setFilters(firCoef, bqCoef, delay, index, source0.azimuth, source0.distance, gain0, lpf0, L0);
+    setFilters(firCoef, bqCoef, delay, index, source1.azimuth, source1.distance, gain1, lpf1, L1);
+
+    // new parameters become old
+    hrtf0._azimuthState = source0.azimuth;
+    hrtf0._distanceState = source0.distance;
+    hrtf0._gainState = gain0;
+    hrtf0._lpfState = lpf0;
+
+    hrtf1._azimuthState = source1.azimuth;
+    hrtf1._distanceState = source1.distance;
+    hrtf1._gainState = gain1;
+    hrtf1._lpfState = lpf1;
+
+    // convert mono inputs to float
+    for (int i = 0; i < HRTF_BLOCK; i++) {
+        in0[HRTF_TAPS+i] = (float)source0.input[i] * (1/32768.0f);
+        in1[HRTF_TAPS+i] = (float)source1.input[i] * (1/32768.0f);
+    }
+
+    // FIR state update
+    memcpy(in0, hrtf0._firState, HRTF_TAPS * sizeof(float));
+    memcpy(hrtf0._firState, &in0[HRTF_BLOCK], HRTF_TAPS * sizeof(float));
+    memcpy(in1, hrtf1._firState, HRTF_TAPS * sizeof(float));
+    memcpy(hrtf1._firState, &in1[HRTF_BLOCK], HRTF_TAPS * sizeof(float));
+
+    // process both FIRs
+    FIR_2x2(&in0[HRTF_TAPS],
+            &in1[HRTF_TAPS],
+            &firBuffer[L0][HRTF_DELAY],
+            &firBuffer[R0][HRTF_DELAY],
+            &firBuffer[L1][HRTF_DELAY],
+            &firBuffer[R1][HRTF_DELAY],
+            firCoef, HRTF_BLOCK);
+
+    // delay state update (old and new state stay identical)
+    memcpy(firBuffer[L0], hrtf0._delayState[L1], HRTF_DELAY * sizeof(float));
+    memcpy(firBuffer[R0], hrtf0._delayState[R1], HRTF_DELAY * sizeof(float));
+    memcpy(firBuffer[L1], hrtf1._delayState[L1], HRTF_DELAY * sizeof(float));
+    memcpy(firBuffer[R1], hrtf1._delayState[R1], HRTF_DELAY * sizeof(float));
+
+    memcpy(hrtf0._delayState[L0], &firBuffer[L0][HRTF_BLOCK], HRTF_DELAY * sizeof(float));
+    memcpy(hrtf0._delayState[R0], &firBuffer[R0][HRTF_BLOCK], HRTF_DELAY * sizeof(float));
+    memcpy(hrtf0._delayState[L1], &firBuffer[L0][HRTF_BLOCK], HRTF_DELAY * sizeof(float));
+    memcpy(hrtf0._delayState[R1], &firBuffer[R0][HRTF_BLOCK], HRTF_DELAY * sizeof(float));
+
+    memcpy(hrtf1._delayState[L0], &firBuffer[L1][HRTF_BLOCK], HRTF_DELAY * sizeof(float));
+    memcpy(hrtf1._delayState[R0], &firBuffer[R1][HRTF_BLOCK], HRTF_DELAY * sizeof(float));
+    memcpy(hrtf1._delayState[L1], &firBuffer[L1][HRTF_BLOCK], HRTF_DELAY * sizeof(float));
+    memcpy(hrtf1._delayState[R1], &firBuffer[R1][HRTF_BLOCK], HRTF_DELAY * sizeof(float));
+
+    // interleave with integer delay
+    interleave_4x4(&firBuffer[L0][HRTF_DELAY] - delay[L0],
+                   &firBuffer[R0][HRTF_DELAY] - delay[R0],
+                   &firBuffer[L1][HRTF_DELAY] - delay[L1],
+                   &firBuffer[R1][HRTF_DELAY] - delay[R1],
+                   bqBuffer, HRTF_BLOCK);
+
+    // gather the new biquad state of each source into its channels
+    for (int j = 0; j < 3; j++) {
+        bqState[j][L0] = hrtf0._bqState[j][L1];
+        bqState[j][R0] = hrtf0._bqState[j][R1];
+        bqState[j][L2] = hrtf0._bqState[j][L3];
+        bqState[j][R2] = hrtf0._bqState[j][R3];
+
+        bqState[j][L1] = hrtf1._bqState[j][L1];
+        bqState[j][R1] = hrtf1._bqState[j][R1];
+        bqState[j][L3] = hrtf1._bqState[j][L3];
+        bqState[j][R3] = hrtf1._bqState[j][R3];
+    }
+
+    // process both biquads
+    biquad2_4x4(bqBuffer, bqBuffer, bqCoef, bqState, HRTF_BLOCK);
+
+    // scatter the biquad state back, as both old and new state
+    for (int j = 0; j < 3; j++) {
+        hrtf0._bqState[j][L0] = hrtf0._bqState[j][L1] = bqState[j][L0];
+        hrtf0._bqState[j][R0] = hrtf0._bqState[j][R1] = bqState[j][R0];
+        hrtf0._bqState[j][L2] = hrtf0._bqState[j][L3] = bqState[j][L2];
+        hrtf0._bqState[j][R2] = hrtf0._bqState[j][R3] = bqState[j][R2];
+
+        hrtf1._bqState[j][L0] = hrtf1._bqState[j][L1] = bqState[j][L1];
+        hrtf1._bqState[j][R0] = hrtf1._bqState[j][R1] = bqState[j][R1];
+        hrtf1._bqState[j][L2] = hrtf1._bqState[j][L3] = bqState[j][L3];
+        hrtf1._bqState[j][R2] = hrtf1._bqState[j][R3] = bqState[j][R3];
+    }
+
+    // mix both outputs and accumulate
+    mix_4x2(bqBuffer, output, HRTF_BLOCK);
+
+    hrtf0._resetState = false;
+    hrtf1._resetState = false;
+}
+
 void AudioHRTF::mixMono(int16_t* input, float* output, float gain, int numFrames) {
 
     assert(numFrames == HRTF_BLOCK);
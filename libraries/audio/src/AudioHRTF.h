@@ -58,6 +58,22 @@ public:
     void render(int16_t* input, float* output, int index, float azimuth, float distance, float gain, int numFrames,
                 float lpfDistance = LPF_DISTANCE_REF);
 
+    //
+    // Batched render of many mono sources into one output (accumulates into existing output)
+    // Sources whose parameters are unchanged since their last render need no old/new filter crossfade,
+    // so they are rendered two at a time with each source in its own pair of SIMD channels.
+    // The other sources are rendered one at a time, the same as render().
+    //
+    struct RenderSource {
+        AudioHRTF* hrtf;
+        int16_t* input;
+        float azimuth;
+        float distance;
+        float gain;
+        float lpfDistance;
+    };
+    static void renderBatch(RenderSource* sources, int numSources, float* output, int index, int numFrames);
+
     //
     // Non-spatialized direct mix (accumulates into existing output)
     //
@@ -111,6 +127,12 @@ private:
     AudioHRTF(const AudioHRTF&) = delete;
     AudioHRTF& operator=(const AudioHRTF&) = delete;
 
+    bool hasParameters(float azimuth, float distance, float gain, float lpf) const {
+        return _resetState ||
+            (azimuth == _azimuthState && distance == _distanceState && gain == _gainState && lpf == _lpfState);
+    }
+    static void renderSteadyPair(RenderSource& source0, RenderSource& source1, float* output, int index);
+
     // SIMD channel assignmentS
     enum Channel {
         L0, R0,
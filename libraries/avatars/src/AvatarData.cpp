@@ -282,6 +282,79 @@ QByteArray AvatarData::toByteArrayStateful(AvatarDataDetail dataDetail, bool dro
     return avatarByteArray;
 }
 
+AvatarDataPacket::HasFlags AvatarData::getWantedFlags(AvatarDataDetail dataDetail, quint64 lastSentTime,
+                                                     bool dropFaceTracking) const {
+    bool sendAll = (dataDetail == SendAllData);
+    bool sendMinimum = (dataDetail == MinimumData);
+    bool sendPALMinimum = (dataDetail == PALMinimum);
+
+    if (dataDetail == NoData) {
+        return 0;
+    }
+
+    lazyInitHeadData();
+
+    bool hasAvatarGlobalPosition = true; // always include global position
+    bool hasAvatarOrientation = false;
+    bool hasAvatarBoundingBox = false;
+    bool hasAvatarScale = false;
+    bool hasLookAtPosition = false;
+    bool hasAudioLoudness = false;
+    bool hasSensorToWorldMatrix = false;
+    bool hasJointData = false;
+    bool hasJointDefaultPoseFlags = false;
+    bool hasAdditionalFlags = false;
+
+    // local position, and parent info only apply to avatars that are parented. The local position
+    // and the parent info can change independently though, so we track their "changed since"
+    // separately
+    bool hasParentInfo = false;
+    bool hasAvatarLocalPosition = false;
+    bool hasHandControllers = false;
+
+    bool hasFaceTrackerInfo = false;
+
+    if (sendPALMinimum) {
+        hasAudioLoudness = true;
+    } else {
+        hasAvatarOrientation = sendAll || rotationChangedSince(lastSentTime);
+        hasAvatarBoundingBox = sendAll || avatarBoundingBoxChangedSince(lastSentTime);
+        hasAvatarScale = sendAll || avatarScaleChangedSince(lastSentTime);
+        hasLookAtPosition = sendAll || lookAtPositionChangedSince(lastSentTime);
+        hasAudioLoudness = sendAll || audioLoudnessChangedSince(lastSentTime);
+        hasSensorToWorldMatrix = sendAll || sensorToWorldMatrixChangedSince(lastSentTime);
+        hasAdditionalFlags = sendAll || additionalFlagsChangedSince(lastSentTime);
+        hasParentInfo = sendAll || parentInfoChangedSince(lastSentTime);
+        hasAvatarLocalPosition = hasParent() && (sendAll ||
+            tranlationChangedSince(lastSentTime) ||
+            parentInfoChangedSince(lastSentTime));
+        hasHandControllers = _controllerLeftHandMatrixCache.isValid() || _controllerRightHandMatrixCache.isValid();
+        hasFaceTrackerInfo = !dropFaceTracking && (getHasScriptedBlendshapes() || _headData->_hasInputDrivenBlendshapes) &&
+            (sendAll || faceTrackerInfoChangedSince(lastSentTime));
+        hasJointData = !sendMinimum;
+        hasJointDefaultPoseFlags = hasJointData;
+    }
+
+    AvatarDataPacket::HasFlags wantedFlags =
+        (hasAvatarGlobalPosition ? AvatarDataPacket::PACKET_HAS_AVATAR_GLOBAL_POSITION : 0)
+        | (hasAvatarBoundingBox ? AvatarDataPacket::PACKET_HAS_AVATAR_BOUNDING_BOX : 0)
+        | (hasAvatarOrientation ? AvatarDataPacket::PACKET_HAS_AVATAR_ORIENTATION : 0)
+        | (hasAvatarScale ? AvatarDataPacket::PACKET_HAS_AVATAR_SCALE : 0)
+        | (hasLookAtPosition ? AvatarDataPacket::PACKET_HAS_LOOK_AT_POSITION : 0)
+        | (hasAudioLoudness ? AvatarDataPacket::PACKET_HAS_AUDIO_LOUDNESS : 0)
+        | (hasSensorToWorldMatrix ? AvatarDataPacket::PACKET_HAS_SENSOR_TO_WORLD_MATRIX : 0)
+        | (hasAdditionalFlags ? AvatarDataPacket::PACKET_HAS_ADDITIONAL_FLAGS : 0)
+        | (hasParentInfo ? AvatarDataPacket::PACKET_HAS_PARENT_INFO : 0)
+        | (hasAvatarLocalPosition ? AvatarDataPacket::PACKET_HAS_AVATAR_LOCAL_POSITION : 0)
+        | (hasHandControllers ? AvatarDataPacket::PACKET_HAS_HAND_CONTROLLERS : 0)
+        | (hasFaceTrackerInfo ? AvatarDataPacket::PACKET_HAS_FACE_TRACKER_INFO : 0)
+        | (hasJointData ? AvatarDataPacket::PACKET_HAS_JOINT_DATA : 0)
+        | (hasJointDefaultPoseFlags ? AvatarDataPacket::PACKET_HAS_JOINT_DEFAULT_POSE_FLAGS : 0)
+        | (hasJointData ? AvatarDataPacket::PACKET_HAS_GRAB_JOINTS : 0);
+
+    return wantedFlags;
+}
+
 QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSentTime,
                                    const QVector<JointData>& lastSentJointData, AvatarDataPacket::SendStatus& sendStatus,
                                    bool dropFaceTracking, bool distanceAdjust, glm::vec3 viewerPosition,
@@ -290,8 +363,6 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
 
     bool cullSmallChanges = (dataDetail == CullSmallData);
     bool sendAll = (dataDetail == SendAllData);
-    bool sendMinimum = (dataDetail == MinimumData);
-    bool sendPALMinimum = (dataDetail == PALMinimum);
 
     lazyInitHeadData();
     ASSERT(maxDataSize == 0 || (size_t)maxDataSize >= AvatarDataPacket::MIN_BULK_PACKET_SIZE);
@@ -341,67 +412,10 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
 
     if (sendStatus.itemFlags == 0) {
         // New avatar ...
-        bool hasAvatarGlobalPosition = true; // always include global position
-        bool hasAvatarOrientation = false;
-        bool hasAvatarBoundingBox = false;
-        bool hasAvatarScale = false;
-        bool hasLookAtPosition = false;
-        bool hasAudioLoudness = false;
-        bool hasSensorToWorldMatrix = false;
-        bool hasJointData = false;
-        bool hasJointDefaultPoseFlags = false;
-        bool hasAdditionalFlags = false;
-
-        // local position, and parent info only apply to avatars that are parented. The local position
-        // and the parent info can change independently though, so we track their "changed since"
-        // separately
-        bool hasParentInfo = false;
-        bool hasAvatarLocalPosition = false;
-        bool hasHandControllers = false;
-
-        bool hasFaceTrackerInfo = false;
-
-        if (sendPALMinimum) {
-            hasAudioLoudness = true;
-        } else {
-            hasAvatarOrientation = sendAll || rotationChangedSince(lastSentTime);
-            hasAvatarBoundingBox = sendAll || avatarBoundingBoxChangedSince(lastSentTime);
-            hasAvatarScale = sendAll || avatarScaleChangedSince(lastSentTime);
-            hasLookAtPosition = sendAll || lookAtPositionChangedSince(lastSentTime);
-            hasAudioLoudness = sendAll || audioLoudnessChangedSince(lastSentTime);
-            hasSensorToWorldMatrix = sendAll || sensorToWorldMatrixChangedSince(lastSentTime);
-            hasAdditionalFlags = sendAll || additionalFlagsChangedSince(lastSentTime);
-            hasParentInfo = sendAll || parentInfoChangedSince(lastSentTime);
-            hasAvatarLocalPosition = hasParent() && (sendAll ||
-                tranlationChangedSince(lastSentTime) ||
-                parentInfoChangedSince(lastSentTime));
-            hasHandControllers = _controllerLeftHandMatrixCache.isValid() || _controllerRightHandMatrixCache.isValid();
-            hasFaceTrackerInfo = !dropFaceTracking && (getHasScriptedBlendshapes() || _headData->_hasInputDrivenBlendshapes) &&
-                (sendAll || faceTrackerInfoChangedSince(lastSentTime));
-            hasJointData = !sendMinimum;
-            hasJointDefaultPoseFlags = hasJointData;
-        }
-
-        wantedFlags =
-            (hasAvatarGlobalPosition ? AvatarDataPacket::PACKET_HAS_AVATAR_GLOBAL_POSITION : 0)
-            | (hasAvatarBoundingBox ? AvatarDataPacket::PACKET_HAS_AVATAR_BOUNDING_BOX : 0)
-            | (hasAvatarOrientation ? AvatarDataPacket::PACKET_HAS_AVATAR_ORIENTATION : 0)
-            | (hasAvatarScale ? AvatarDataPacket::PACKET_HAS_AVATAR_SCALE : 0)
-            | (hasLookAtPosition ? AvatarDataPacket::PACKET_HAS_LOOK_AT_POSITION : 0)
-            | (hasAudioLoudness ? AvatarDataPacket::PACKET_HAS_AUDIO_LOUDNESS : 0)
-            | (hasSensorToWorldMatrix ? AvatarDataPacket::PACKET_HAS_SENSOR_TO_WORLD_MATRIX : 0)
-            | (hasAdditionalFlags ? AvatarDataPacket::PACKET_HAS_ADDITIONAL_FLAGS : 0)
-            | (hasParentInfo ? AvatarDataPacket::PACKET_HAS_PARENT_INFO : 0)
-            | (hasAvatarLocalPosition ? AvatarDataPacket::PACKET_HAS_AVATAR_LOCAL_POSITION : 0)
-            | (hasHandControllers ? AvatarDataPacket::PACKET_HAS_HAND_CONTROLLERS : 0)
-            | (hasFaceTrackerInfo ? AvatarDataPacket::PACKET_HAS_FACE_TRACKER_INFO : 0)
-            | (hasJointData ? AvatarDataPacket::PACKET_HAS_JOINT_DATA : 0)
-            | (hasJointDefaultPoseFlags ? AvatarDataPacket::PACKET_HAS_JOINT_DEFAULT_POSE_FLAGS : 0)
-            | (hasJointData ? AvatarDataPacket::PACKET_HAS_GRAB_JOINTS : 0);
-
-            sendStatus.itemFlags = wantedFlags;
-            sendStatus.rotationsSent = 0;
-            sendStatus.translationsSent = 0;
+        wantedFlags = getWantedFlags(dataDetail, lastSentTime, dropFaceTracking);
+        sendStatus.itemFlags = wantedFlags;
+        sendStatus.rotationsSent = 0;
+        sendStatus.translationsSent = 0;
     } else {  // Continuing avatar ...
         wantedFlags = sendStatus.itemFlags;
         if (wantedFlags & AvatarDataPacket::PACKET_HAS_GRAB_JOINTS) {
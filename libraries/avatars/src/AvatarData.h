@@ -631,6 +631,12 @@ public:
 
     virtual void doneEncoding(bool cullSmallChanges);
 
+    // the items toByteArray would include for a new avatar at this detail, given when it was last sent
+    AvatarDataPacket::HasFlags getWantedFlags(AvatarDataDetail dataDetail, quint64 lastSentTime, bool dropFaceTracking) const;
+
+    float getDistanceBasedMinRotationDOT(glm::vec3 viewerPosition) const;
+    float getDistanceBasedMinTranslationDistance(glm::vec3 viewerPosition) const;
+
     /// \return true if an error should be logged
     bool shouldLogError(const quint64& now);
 
@@ -1685,9 +1691,6 @@ protected:
     void insertRemovedEntityID(const QUuid entityID);
     void lazyInitHeadData() const;
 
-    float getDistanceBasedMinRotationDOT(glm::vec3 viewerPosition) const;
-    float getDistanceBasedMinTranslationDistance(glm::vec3 viewerPosition) const;
-
     bool avatarBoundingBoxChangedSince(quint64 time) const { return _avatarBoundingBoxChanged >= time; }
     bool avatarScaleChangedSince(quint64 time) const { return _avatarScaleChanged >= time; }
     bool lookAtPositionChangedSince(quint64 time) const { return _headData->lookAtPositionChangedSince(time); }
@@ -0,0 +1,105 @@
+//
+//  AvatarEncodingCache.cpp
+//  libraries/avatars/src
+//
+//  Created on 2026-10-16.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AvatarEncodingCache.h"
+
+#include <limits>
+
+static bool jointsEqual(const QVector<JointData>& a, const QVector<JointData>& b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+
+    for (int i = 0; i < a.size(); ++i) {
+        if (a[i].rotation != b[i].rotation || a[i].translation != b[i].translation ||
+            a[i].rotationIsDefaultPose != b[i].rotationIsDefaultPose ||
+            a[i].translationIsDefaultPose != b[i].translationIsDefaultPose) {
+            return false;
+        }
+    }
+    return true;
+}
+
+QByteArray AvatarEncodingCache::encode(const AvatarData& avatar, HRCTime frame, AvatarData::AvatarDataDetail dataDetail,
+                                       quint64 lastSentTime, glm::vec3 viewerPosition, QVector<JointData>& lastSentJoints,
+                                       AvatarDataPacket::SendStatus& sendStatus, int maxDataSize, bool& isShared) {
+    const bool distanceAdjust = true;
+    const bool dropFaceTracking = false;
+
+    // everything else that goes into a new encoding is the same for all viewers this frame
+    Key key;
+    key.dataDetail = dataDetail;
+    key.wantedFlags = avatar.getWantedFlags(dataDetail, lastSentTime, dropFaceTracking);
+    key.minRotationDOT = (dataDetail == AvatarData::CullSmallData) ?
+        avatar.getDistanceBasedMinRotationDOT(viewerPosition) : 0.0f;
+    key.maxDataSize = maxDataSize > 0 ? maxDataSize : std::numeric_limits<int>::max();
+
+    // the last sent joints only matter if joints are sent
+    static const QVector<JointData> NO_JOINTS;
+    bool hasJointData = sendStatus.itemFlags == 0 && (key.wantedFlags & AvatarDataPacket::PACKET_HAS_JOINT_DATA);
+    QVector<JointData> keyJoints = hasJointData ? lastSentJoints : NO_JOINTS;
+
+    QByteArray encoding;
+    if (sendStatus.itemFlags == 0 && find(frame, key, keyJoints, encoding, hasJointData ? &lastSentJoints : nullptr)) {
+        isShared = true;
+        return encoding;
+    }
+    isShared = false;
+
+    bool isNewAvatar = sendStatus.itemFlags == 0;
+    encoding = avatar.toByteArray(dataDetail, lastSentTime, lastSentJoints, sendStatus, dropFaceTracking, distanceAdjust,
+                                  viewerPosition, &lastSentJoints, maxDataSize);
+
+    // only complete encodings can be shared, a partial one depends on the space the viewer had left
+    if (isNewAvatar && sendStatus) {
+        insert(frame, key, keyJoints, encoding, hasJointData ? lastSentJoints : NO_JOINTS);
+    }
+
+    return encoding;
+}
+
+bool AvatarEncodingCache::find(HRCTime frame, const Key& key, const QVector<JointData>& lastSentJoints,
+                               QByteArray& encoding, QVector<JointData>* sentJoints) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (frame != _frame) {
+        // the avatar may have changed since these were encoded
+        return false;
+    }
+
+    for (const auto& entry : _entries) {
+        // a complete encoding made with less space is the same for any viewer with more
+        if (entry.key.dataDetail == key.dataDetail && entry.key.wantedFlags == key.wantedFlags &&
+            entry.key.minRotationDOT == key.minRotationDOT && entry.key.maxDataSize <= key.maxDataSize &&
+            jointsEqual(entry.lastSentJoints, lastSentJoints)) {
+            encoding = entry.encoding;
+            if (sentJoints) {
+                *sentJoints = entry.sentJoints;
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+void AvatarEncodingCache::insert(HRCTime frame, const Key& key, const QVector<JointData>& lastSentJoints,
+                                 const QByteArray& encoding, const QVector<JointData>& sentJoints) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (frame != _frame) {
+        _frame = frame;
+        _entries.clear();
+    }
+
+    if (_entries.size() < MAX_ENTRIES) {
+        _entries.push_back({ key, lastSentJoints, encoding, sentJoints });
+    }
+}
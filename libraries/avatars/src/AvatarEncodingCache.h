@@ -0,0 +1,65 @@
+//
+//  AvatarEncodingCache.h
+//  libraries/avatars/src
+//
+//  Created on 2026-10-16.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_AvatarEncodingCache_h
+#define hifi_AvatarEncodingCache_h
+
+#include <mutex>
+#include <vector>
+
+#include <PortableHighResolutionClock.h>
+
+#include "AvatarData.h"
+
+// An avatar's encodings for the current frame, shared by the viewers that would each get the same bytes: those that
+// want the same detail and items, with the same joint tolerance and last sent joints.
+class AvatarEncodingCache {
+public:
+    using HRCTime = p_high_resolution_clock::time_point;
+
+    // Encodes the avatar for a viewer as AvatarData::toByteArray does with distance adjustment, re-using a complete
+    // encoding made for another viewer this frame when it would be the same. Encodings made with a maxDataSize are only
+    // re-used for viewers with at least as much space. Sets isShared if the encoding was re-used.
+    QByteArray encode(const AvatarData& avatar, HRCTime frame, AvatarData::AvatarDataDetail dataDetail, quint64 lastSentTime,
+                      glm::vec3 viewerPosition, QVector<JointData>& lastSentJoints,
+                      AvatarDataPacket::SendStatus& sendStatus, int maxDataSize, bool& isShared);
+
+private:
+    struct Key {
+        AvatarData::AvatarDataDetail dataDetail;
+        AvatarDataPacket::HasFlags wantedFlags;
+        float minRotationDOT;
+        int maxDataSize;
+    };
+
+    struct Entry {
+        Key key;
+        QVector<JointData> lastSentJoints;
+        QByteArray encoding;
+        QVector<JointData> sentJoints;
+    };
+
+    bool find(HRCTime frame, const Key& key, const QVector<JointData>& lastSentJoints,
+              QByteArray& encoding, QVector<JointData>* sentJoints);
+    void insert(HRCTime frame, const Key& key, const QVector<JointData>& lastSentJoints,
+                const QByteArray& encoding, const QVector<JointData>& sentJoints);
+
+    // bounds the linear search, viewers mostly share a handful of encodings
+    static const size_t MAX_ENTRIES = 16;
+
+    std::mutex _mutex;
+    HRCTime _frame;
+    std::vector<Entry> _entries;
+};
+
+#endif // hifi_AvatarEncodingCache_h
@@ -16,6 +16,9 @@
 
 #include <glm/gtx/transform.hpp>
 
+#include <tbb/task_arena.h>
+#include <tbb/task_group.h>
+
 using namespace render;
 using namespace render::entities;
 
@@ -40,15 +43,19 @@ static ShapePipelinePointer shapePipelineFactory(const ShapePlumber& plumber, co
     return std::make_shared<render::ShapePipeline>(texturedPipeline, nullptr, nullptr, nullptr);
 }
 
-struct GpuParticle {
-    GpuParticle(const glm::vec3& xyzIn, const glm::vec2& uvIn) : xyz(xyzIn), uv(uvIn) {}
-    glm::vec3 xyz; // Position
-    glm::vec2 uv; // Lifetime + seed
-};
+using GpuParticle = particle::Instance;
 
-using GpuParticles = std::vector<GpuParticle>;
+// the steps of every particle effect run here, so that they don't compete with other work for more than its threads
+static tbb::task_arena& getSimulationArena() {
+    static tbb::task_arena simulationArena(tbb::task_arena::automatic);
+    return simulationArena;
+}
 
-ParticleEffectEntityRenderer::ParticleEffectEntityRenderer(const EntityItemPointer& entity) : Parent(entity) {
+ParticleEffectEntityRenderer::ParticleEffectEntityRenderer(const EntityItemPointer& entity) :
+    Parent(entity),
+    _simulation(new tbb::task_group()),
+    _random((std::minstd_rand::result_type)qHash(entity->getEntityItemID()))
+{
     ParticleUniforms uniforms;
     _uniformBuffer = std::make_shared<Buffer>(sizeof(ParticleUniforms), (const gpu::Byte*) &uniforms);
 
@@ -64,6 +71,10 @@ ParticleEffectEntityRenderer::ParticleEffectEntityRenderer(const EntityItemPoint
     });
 }
 
+ParticleEffectEntityRenderer::~ParticleEffectEntityRenderer() {
+    waitForSimulation();
+}
+
 void ParticleEffectEntityRenderer::doRenderUpdateSynchronousTyped(const ScenePointer& scene, Transaction& transaction, const TypedEntityPointer& entity) {
     void* key = (void*)this;
     AbstractViewStateInterface::instance()->pushPostUpdateLambda(key, [this] {
@@ -74,6 +85,8 @@ void ParticleEffectEntityRenderer::doRenderUpdateSynchronousTyped(const ScenePoi
 }
 
 void ParticleEffectEntityRenderer::doRenderUpdateAsynchronousTyped(const TypedEntityPointer& entity) {
+    waitForSimulation();
+
     auto newParticleProperties = entity->getParticleProperties();
     if (!newParticleProperties.valid()) {
         qCWarning(entitiesrenderer) << "Bad particle properties";
@@ -165,34 +178,41 @@ Item::Bound ParticleEffectEntityRenderer::getBound(RenderArgs* args) {
     return _bound;
 }
 
+// rand() isn't safe to call from the simulation threads, so each emitter draws from its own generator
+static float randomFloatInRange(std::minstd_rand& random, float min, float max) {
+    return std::uniform_real_distribution<float>(min, max)(random);
+}
+
+static int randomIntInRange(std::minstd_rand& random, int min, int max) {
+    return std::uniform_int_distribution<int>(min, max)(random);
+}
+
 // FIXME: these methods assume uniform emitDimensions, need to importance sample based on dimensions
-float importanceSample2DDimension(float startDim) {
+float importanceSample2DDimension(std::minstd_rand& random, float startDim) {
     float dimension = 1.0f;
     if (startDim < 1.0f) {
         float innerDimensionSquared = startDim * startDim;
         float outerDimensionSquared = 1.0f;  // pow(particle::MAXIMUM_EMIT_RADIUS_START, 2);
-        float randDimensionSquared = randFloatInRange(innerDimensionSquared, outerDimensionSquared);
+        float randDimensionSquared = randomFloatInRange(random, innerDimensionSquared, outerDimensionSquared);
         dimension = std::sqrt(randDimensionSquared);
     }
     return dimension;
 }
 
-float importanceSample3DDimension(float startDim) {
+float importanceSample3DDimension(std::minstd_rand& random, float startDim) {
     float dimension = 1.0f;
     if (startDim < 1.0f) {
         float innerDimensionCubed = startDim * startDim * startDim;
         float outerDimensionCubed = 1.0f;  // pow(particle::MAXIMUM_EMIT_RADIUS_START, 3);
-        float randDimensionCubed = randFloatInRange(innerDimensionCubed, outerDimensionCubed);
+        float randDimensionCubed = randomFloatInRange(random, innerDimensionCubed, outerDimensionCubed);
         dimension = std::cbrt(randDimensionCubed);
     }
     return dimension;
 }
 
-ParticleEffectEntityRenderer::CpuParticle ParticleEffectEntityRenderer::createParticle(const Transform& baseTransform, const particle::Properties& particleProperties,
-                                                                                       const ShapeType& shapeType, const GeometryResource::Pointer& geometryResource,
-                                                                                       const TriangleInfo& triangleInfo) {
-    CpuParticle particle;
-
+void ParticleEffectEntityRenderer::emitParticle(particle::Pool& particles, const Transform& baseTransform, const particle::Properties& particleProperties,
+                                                const ShapeType& shapeType, const GeometryResource::Pointer& geometryResource,
+                                                const TriangleInfo& triangleInfo, std::minstd_rand& random) {
     const auto& accelerationSpread = particleProperties.emission.acceleration.spread;
     const auto& azimuthStart = particleProperties.azimuth.start;
     const auto& azimuthFinish = particleProperties.azimuth.finish;
@@ -205,11 +225,10 @@ ParticleEffectEntityRenderer::CpuParticle ParticleEffectEntityRenderer::createPa
     const auto& polarStart = particleProperties.polar.start;
     const auto& polarFinish = particleProperties.polar.finish;
 
-    particle.seed = randFloatInRange(-1.0f, 1.0f);
-    particle.expiration = (uint64_t)(particleProperties.lifespan * USECS_PER_SECOND);
+    float seed = randomFloatInRange(random, -1.0f, 1.0f);
+    uint64_t expiration = (uint64_t)(particleProperties.lifespan * USECS_PER_SECOND);
 
-    particle.relativePosition = glm::vec3(0.0f);
-    particle.basePosition = baseTransform.getTranslation();
+    glm::vec3 relativePosition(0.0f);
 
     // Position, velocity, and acceleration
     glm::vec3 emitDirection;
@@ -224,13 +243,13 @@ ParticleEffectEntityRenderer::CpuParticle ParticleEffectEntityRenderer::createPa
 
         float elevationMinZ = sinf(PI_OVER_TWO - polarFinish);
         float elevationMaxZ = sinf(PI_OVER_TWO - polarStart);
-        float elevation = asinf(elevationMinZ + (elevationMaxZ - elevationMinZ) * randFloat());
+        float elevation = asinf(elevationMinZ + (elevationMaxZ - elevationMinZ) * randomFloatInRange(random, 0.0f, 1.0f));
 
         float azimuth;
         if (azimuthFinish >= azimuthStart) {
-            azimuth = azimuthStart + (azimuthFinish - azimuthStart) * randFloat();
+            azimuth = azimuthStart + (azimuthFinish - azimuthStart) * randomFloatInRange(random, 0.0f, 1.0f);
         } else {
-            azimuth = azimuthStart + (TWO_PI + azimuthFinish - azimuthStart) * randFloat();
+            azimuth = azimuthStart + (TWO_PI + azimuthFinish - azimuthStart) * randomFloatInRange(random, 0.0f, 1.0f);
         }
         // TODO: azimuth and elevation are only used for ellipsoids/circles, but could be used for other shapes too
 
@@ -241,28 +260,28 @@ ParticleEffectEntityRenderer::CpuParticle ParticleEffectEntityRenderer::createPa
             glm::vec3 emitPosition;
             switch (shapeType) {
                 case SHAPE_TYPE_BOX: {
-                    glm::vec3 dim = importanceSample3DDimension(emitRadiusStart) * 0.5f * emitDimensions;
+                    glm::vec3 dim = importanceSample3DDimension(random, emitRadiusStart) * 0.5f * emitDimensions;
 
-                    int side = randIntInRange(0, 5);
+                    int side = randomIntInRange(random, 0, 5);
                     int axis = side % 3;
                     float direction = side > 2 ? 1.0f : -1.0f;
 
                     emitDirection[axis] = direction;
                     emitPosition[axis] = direction * dim[axis];
                     axis = (axis + 1) % 3;
-                    emitPosition[axis] = dim[axis] * randFloatInRange(-1.0f, 1.0f);
+                    emitPosition[axis] = dim[axis] * randomFloatInRange(random, -1.0f, 1.0f);
                     axis = (axis + 1) % 3;
-                    emitPosition[axis] = dim[axis] * randFloatInRange(-1.0f, 1.0f);
+                    emitPosition[axis] = dim[axis] * randomFloatInRange(random, -1.0f, 1.0f);
                     break;
                 }
 
                 case SHAPE_TYPE_CYLINDER_X:
                 case SHAPE_TYPE_CYLINDER_Y:
                 case SHAPE_TYPE_CYLINDER_Z: {
-                    glm::vec3 radii = importanceSample2DDimension(emitRadiusStart) * 0.5f * emitDimensions;
+                    glm::vec3 radii = importanceSample2DDimension(random, emitRadiusStart) * 0.5f * emitDimensions;
                     int axis = shapeType - SHAPE_TYPE_CYLINDER_X;
 
-                    emitPosition[axis] = emitDimensions[axis] * randFloatInRange(-0.5f, 0.5f);
+                    emitPosition[axis] = emitDimensions[axis] * randomFloatInRange(random, -0.5f, 0.5f);
                     emitDirection[axis] = 0.0f;
                     axis = (axis + 1) % 3;
                     emitPosition[axis] = radii[axis] * glm::cos(azimuth);
@@ -275,7 +294,7 @@ ParticleEffectEntityRenderer::CpuParticle ParticleEffectEntityRenderer::createPa
                 }
 
                 case SHAPE_TYPE_CIRCLE: {
-                    glm::vec2 radii = importanceSample2DDimension(emitRadiusStart) * 0.5f * glm::vec2(emitDimensions.x, emitDimensions.z);
+                    glm::vec2 radii = importanceSample2DDimension(random, emitRadiusStart) * 0.5f * glm::vec2(emitDimensions.x, emitDimensions.z);
                     float x = radii.x * glm::cos(azimuth);
                     float z = radii.y * glm::sin(azimuth);
                     emitPosition = glm::vec3(x, 0.0f, z);
@@ -283,16 +302,16 @@ ParticleEffectEntityRenderer::CpuParticle ParticleEffectEntityRenderer::createPa
                     break;
                 }
                 case SHAPE_TYPE_PLANE: {
-                    glm::vec2 dim = importanceSample2DDimension(emitRadiusStart) * 0.5f * glm::vec2(emitDimensions.x, emitDimensions.z);
+                    glm::vec2 dim = importanceSample2DDimension(random, emitRadiusStart) * 0.5f * glm::vec2(emitDimensions.x, emitDimensions.z);
 
-                    int side = randIntInRange(0, 3);
+                    int side = randomIntInRange(random, 0, 3);
                     int axis = side % 2;
                     float direction = side > 1 ? 1.0f : -1.0f;
 
                     glm::vec2 pos;
                     pos[axis] = direction * dim[axis];
                     axis = (axis + 1) % 2;
-                    pos[axis] = dim[axis] * randFloatInRange(-1.0f, 1.0f);
+                    pos[axis] = dim[axis] * randomFloatInRange(random, -1.0f, 1.0f);
 
                     emitPosition = glm::vec3(pos.x, 0.0f, pos.y);
                     emitDirection = Vectors::UP;
@@ -302,7 +321,7 @@ ParticleEffectEntityRenderer::CpuParticle ParticleEffectEntityRenderer::createPa
                 case SHAPE_TYPE_COMPOUND: {
                     // if we get here we know that geometryResource is loaded
 
-                    size_t index = randFloat() * triangleInfo.totalSamples;
+                    size_t index = randomFloatInRange(random, 0.0f, 1.0f) * triangleInfo.totalSamples;
                     Triangle triangle;
                     for (size_t i = 0; i < triangleInfo.samplesPerTriangle.size(); i++) {
                         size_t numSamples = triangleInfo.samplesPerTriangle[i];
@@ -318,14 +337,14 @@ ParticleEffectEntityRenderer::CpuParticle ParticleEffectEntityRenderer::createPa
                     float edgeLength3 = glm::length(triangle.v0 - triangle.v2);
 
                     float perimeter = edgeLength1 + edgeLength2 + edgeLength3;
-                    float fraction1 = randFloatInRange(0.0f, 1.0f);
+                    float fraction1 = randomFloatInRange(random, 0.0f, 1.0f);
                     float fractionEdge1 = glm::min(fraction1 * perimeter / edgeLength1, 1.0f);
                     float fraction2 = fraction1 - edgeLength1 / perimeter;
                     float fractionEdge2 = glm::clamp(fraction2 * perimeter / edgeLength2, 0.0f, 1.0f);
                     float fraction3 = fraction2 - edgeLength2 / perimeter;
                     float fractionEdge3 = glm::clamp(fraction3 * perimeter / edgeLength3, 0.0f, 1.0f);
 
-                    float dim = importanceSample2DDimension(emitRadiusStart);
+                    float dim = importanceSample2DDimension(random, emitRadiusStart);
                     triangle = triangle * (glm::scale(emitDimensions) * triangleInfo.transform);
                     glm::vec3 center = (triangle.v0 + triangle.v1 + triangle.v2) / 3.0f;
                     glm::vec3 v0 = (dim * (triangle.v0 - center)) + center;
@@ -340,7 +359,7 @@ ParticleEffectEntityRenderer::CpuParticle ParticleEffectEntityRenderer::createPa
                 case SHAPE_TYPE_SPHERE:
                 case SHAPE_TYPE_ELLIPSOID:
                 default: {
-                    glm::vec3 radii = importanceSample3DDimension(emitRadiusStart) * 0.5f * emitDimensions;
+                    glm::vec3 radii = importanceSample3DDimension(random, emitRadiusStart) * 0.5f * emitDimensions;
                     float x = radii.x * glm::cos(elevation) * glm::cos(azimuth);
                     float y = radii.y * glm::cos(elevation) * glm::sin(azimuth);
                     float z = radii.z * glm::sin(elevation);
@@ -352,17 +371,17 @@ ParticleEffectEntityRenderer::CpuParticle ParticleEffectEntityRenderer::createPa
                 }
             }
 
-            particle.relativePosition += emitOrientation * emitPosition;
+            relativePosition += emitOrientation * emitPosition;
         }
     }
-    particle.velocity = (emitSpeed + randFloatInRange(-1.0f, 1.0f) * speedSpread) * (emitOrientation * emitDirection);
-    particle.acceleration = emitAcceleration +
-        glm::vec3(randFloatInRange(-1.0f, 1.0f), randFloatInRange(-1.0f, 1.0f), randFloatInRange(-1.0f, 1.0f)) * accelerationSpread;
+    glm::vec3 velocity = (emitSpeed + randomFloatInRange(random, -1.0f, 1.0f) * speedSpread) * (emitOrientation * emitDirection);
+    glm::vec3 acceleration = emitAcceleration +
+        glm::vec3(randomFloatInRange(random, -1.0f, 1.0f), randomFloatInRange(random, -1.0f, 1.0f), randomFloatInRange(random, -1.0f, 1.0f)) * accelerationSpread;
 
-    return particle;
+    particles.emit(seed, expiration, baseTransform.getTranslation(), relativePosition, velocity, acceleration);
 }
 
-void ParticleEffectEntityRenderer::stepSimulation() {
+void ParticleEffectEntityRenderer::stepSimulation(const Transform& modelTransform) {
     if (_lastSimulated == 0) {
         _lastSimulated = usecTimestampNow();
         return;
@@ -372,7 +391,6 @@ void ParticleEffectEntityRenderer::stepSimulation() {
     const auto interval = std::min<uint64_t>(USECS_PER_SECOND / 60, now - _lastSimulated);
     _lastSimulated = now;
 
-    const auto& modelTransform = getModelTransform();
     if (_emitting && _particleProperties.emitting() &&
         (_shapeType != SHAPE_TYPE_COMPOUND || (_geometryResource && _geometryResource->isLoaded()))) {
         uint64_t emitInterval = _particleProperties.emitIntervalUsecs();
@@ -383,7 +401,7 @@ void ParticleEffectEntityRenderer::stepSimulation() {
                     computeTriangles(_geometryResource->getHFMModel());
                 }
                 // emit particle
-                _cpuParticles.push_back(createParticle(modelTransform, _particleProperties, _shapeType, _geometryResource, _triangleInfo));
+                emitParticle(_particles, modelTransform, _particleProperties, _shapeType, _geometryResource, _triangleInfo, _random);
                 _timeUntilNextEmit = emitInterval;
                 if (emitInterval < timeRemaining) {
                     timeRemaining -= emitInterval;
@@ -395,39 +413,36 @@ void ParticleEffectEntityRenderer::stepSimulation() {
     }
 
     // Kill any particles that have expired or are over the max size
-    while (_cpuParticles.size() > _particleProperties.maxParticles || (!_cpuParticles.empty() && _cpuParticles.front().expiration == 0)) {
-        _cpuParticles.pop_front();
-    }
+    _particles.removeExpired(_particleProperties.maxParticles);
 
-    const float deltaTime = (float)interval / (float)USECS_PER_SECOND;
     // update the particles
-    for (auto& particle : _cpuParticles) {
-        if (_prevEmitterShouldTrail != _particleProperties.emission.shouldTrail) {
-            if (_prevEmitterShouldTrail) {
-                particle.relativePosition = particle.relativePosition + particle.basePosition - modelTransform.getTranslation();
-            }
-            particle.basePosition = modelTransform.getTranslation();
-        }
-        particle.expiration = particle.expiration >= interval ? particle.expiration - interval : 0;
-        particle.integrate(deltaTime);
+    if (_prevEmitterShouldTrail != _particleProperties.emission.shouldTrail) {
+        _particles.rebase(modelTransform.getTranslation(), _prevEmitterShouldTrail);
     }
+    _particles.integrate(interval);
     _prevEmitterShouldTrail = _particleProperties.emission.shouldTrail;
 
     // Build particle primitives
-    static GpuParticles gpuParticles;
-    gpuParticles.clear();
-    gpuParticles.reserve(_cpuParticles.size()); // Reserve space
-    std::transform(_cpuParticles.begin(), _cpuParticles.end(), std::back_inserter(gpuParticles), [this, &modelTransform] (const CpuParticle& particle) {
-        glm::vec3 position = particle.relativePosition + (_particleProperties.emission.shouldTrail ? particle.basePosition : modelTransform.getTranslation());
-        return GpuParticle(position, glm::vec2(particle.lifetime, particle.seed));
+    _instances.resize(_particles.size());
+    _particles.writeInstances(_instances.data(), _particleProperties.emission.shouldTrail, modelTransform.getTranslation());
+    _instancesChanged = true;
+}
+
+void ParticleEffectEntityRenderer::startSimulation(const Transform& modelTransform) {
+    _isSimulating = true;
+    getSimulationArena().execute([&] {
+        _simulation->run([this, modelTransform] {
+            stepSimulation(modelTransform);
+        });
     });
+}
 
-    // Update particle buffer
-    auto& particleBuffer = _particleBuffer;
-    size_t numBytes = sizeof(GpuParticle) * gpuParticles.size();
-    particleBuffer->resize(numBytes);
-    if (numBytes != 0) {
-        particleBuffer->setData(numBytes, (const gpu::Byte*)gpuParticles.data());
+void ParticleEffectEntityRenderer::waitForSimulation() {
+    if (_isSimulating) {
+        getSimulationArena().execute([&] {
+            _simulation->wait();
+        });
+        _isSimulating = false;
     }
 }
 
@@ -437,7 +452,17 @@ void ParticleEffectEntityRenderer::doRender(RenderArgs* args) {
     }
 
     // FIXME migrate simulation to a compute stage
-    stepSimulation();
+    waitForSimulation();
+    if (_instancesChanged) {
+        // Update particle buffer
+        size_t numBytes = sizeof(GpuParticle) * _instances.size();
+        _particleBuffer->resize(numBytes);
+        if (numBytes != 0) {
+            _particleBuffer->setData(numBytes, (const gpu::Byte*)_instances.data());
+        }
+        _instancesChanged = false;
+    }
+    startSimulation(getModelTransform());
 
     gpu::Batch& batch = *args->_batch;
     batch.setResourceTexture(0, _networkTexture->getGPUTexture());
@@ -11,10 +11,17 @@
 #ifndef hifi_RenderableParticleEffectEntityItem_h
 #define hifi_RenderableParticleEffectEntityItem_h
 
+#include <random>
+
 #include "RenderableEntityItem.h"
 #include <ParticleEffectEntityItem.h>
+#include <ParticlePool.h>
 #include <TextureCache.h>
 
+namespace tbb {
+    class task_group;
+}
+
 namespace render { namespace entities {
 
 class ParticleEffectEntityRenderer : public TypedEntityRenderer<ParticleEffectEntityItem> {
@@ -23,6 +30,7 @@ class ParticleEffectEntityRenderer : public TypedEntityRenderer<ParticleEffectEn
 
 public:
     ParticleEffectEntityRenderer(const EntityItemPointer& entity);
+    ~ParticleEffectEntityRenderer();
 
 protected:
     virtual void doRenderUpdateSynchronousTyped(const ScenePointer& scene, Transaction& transaction, const TypedEntityPointer& entity) override;
@@ -41,26 +49,6 @@ private:
     using Buffer = gpu::Buffer;
     using BufferView = gpu::BufferView;
 
-    // CPU particles
-    // FIXME either switch to GPU compute particles or switch to simd updating of the particles
-    struct CpuParticle {
-        float seed { 0.0f };
-        uint64_t expiration { 0 };
-        float lifetime { 0.0f };
-        glm::vec3 basePosition;
-        glm::vec3 relativePosition;
-        glm::vec3 velocity;
-        glm::vec3 acceleration;
-
-        void integrate(float deltaTime) {
-            glm::vec3 atSquared = (0.5f * deltaTime * deltaTime) * acceleration;
-            relativePosition += velocity * deltaTime + atSquared;
-            velocity += acceleration * deltaTime;
-            lifetime += deltaTime;
-        }
-    };
-    using CpuParticles = std::deque<CpuParticle>;
-
 
     template<typename T>
     struct InterpolationData {
@@ -88,15 +76,26 @@ private:
         glm::mat4 transform;
     } _triangleInfo;
 
-    static CpuParticle createParticle(const Transform& baseTransform, const particle::Properties& particleProperties,
-                                      const ShapeType& shapeType, const GeometryResource::Pointer& geometryResource,
-                                      const TriangleInfo& triangleInfo);
-    void stepSimulation();
+    static void emitParticle(particle::Pool& particles, const Transform& baseTransform, const particle::Properties& particleProperties,
+                             const ShapeType& shapeType, const GeometryResource::Pointer& geometryResource,
+                             const TriangleInfo& triangleInfo, std::minstd_rand& random);
+    void stepSimulation(const Transform& modelTransform);
+
+    // Each frame's step runs on the simulation arena alongside those of the other emitters, and its instances are drawn
+    // the next frame. While a step is running it owns the particles, the instances, the triangles and the emission state,
+    // so anything else that touches those, or changes the properties it reads, waits for it first.
+    void startSimulation(const Transform& modelTransform);
+    void waitForSimulation();
+    std::unique_ptr<tbb::task_group> _simulation;
+    bool _isSimulating { false };
+    std::minstd_rand _random; // seeded per emitter, for its steps to draw from on whichever thread they run
 
     particle::Properties _particleProperties;
     bool _prevEmitterShouldTrail;
     bool _prevEmitterShouldTrailInitialized { false };
-    CpuParticles _cpuParticles;
+    particle::Pool _particles;
+    std::vector<particle::Instance> _instances;
+    bool _instancesChanged { false };
     bool _emitting { false };
     uint64_t _timeUntilNextEmit { 0 };
     BufferPointer _particleBuffer { std::make_shared<Buffer>() };
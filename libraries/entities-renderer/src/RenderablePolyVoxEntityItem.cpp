@@ -76,6 +76,12 @@
 
 const float MARCHING_CUBE_COLLISION_HULL_OFFSET = 0.5;
 
+const int MESH_REGION_SIZE = PolyVoxBricks::BRICK_SIZE;
+
+// edits are sent unreliably, so every so often one carries all of the voxel data rather than just the changed bricks,
+// which makes good any that were lost
+const int MAX_DELTAS_BETWEEN_VOXEL_DATA = 8;
+
 /*
   A PolyVoxEntity has several interdependent parts:
 
@@ -86,6 +92,12 @@ const float MARCHING_CUBE_COLLISION_HULL_OFFSET = 0.5;
 
   Each one depends on the one before it, except that _voxelData is set from _volData if a script edits the voxels.
 
+  _bricks mirrors the voxels of _volData in the bricks of PolyVoxBricks.  When _voxelData is received it is compared
+  with _bricks brick by brick, so only the voxels of bricks that changed are set in _volData.  When a script edits
+  voxels, the bricks it changed are sent to the entity-server as a voxelDelta, which is folded into the server's
+  voxelData, rather than all of _voxelData.  Each change to _volData marks the regions of the mesh around it dirty,
+  and recomputeMesh only re-extracts those regions.
+
   There are booleans to indicate that something has been updated and the dependents now need to be updated.
   _meshReady       -- do we have something to give scripts that ask for the mesh?
   _voxelDataDirty  -- do we need to uncompress data and expand it into _volData?
@@ -128,8 +140,8 @@ const float MARCHING_CUBE_COLLISION_HULL_OFFSET = 0.5;
   (for the physics-engine's benefit).  This is the right-hand side of the diagram.
 
   From the 'Ready' state, if a script changes a voxel, _volDataDirty will be set true.  We bake the mesh,
-  compress the voxels into a new _voxelData, and transmit the new _voxelData to the entity-server.  We then
-  bake the shape.  This is the left-hand side of the diagram.
+  compress the voxels into a new _voxelData, and transmit the changed bricks, or the new _voxelData if that is no
+  larger, to the entity-server.  We then bake the shape.  This is the left-hand side of the diagram.
 
   The actual state machine is more complicated than the diagram, because it's possible for _volDataDirty or
   _voxelDataDirty to be set true while worker threads are attempting to bake meshes or shapes.  If this happens,
@@ -206,6 +218,16 @@ void RenderablePolyVoxEntityItem::setVoxelData(const QByteArray& voxelData) {
     });
 }
 
+void RenderablePolyVoxEntityItem::applyVoxelDelta(const QByteArray& voxelDelta) {
+    // an edit applied here, as in a serverless domain, is rendered from _voxelData, so fold it in now
+    QByteArray voxelData = getVoxelData();
+    if (!applyVoxelDeltaTo(voxelData, voxelDelta)) {
+        qCDebug(entitiesrenderer) << "Ignoring voxel delta that doesn't fit the voxel data of" << getID();
+        return;
+    }
+    setVoxelData(voxelData);
+}
+
 void RenderablePolyVoxEntityItem::setVoxelSurfaceStyle(PolyVoxSurfaceStyle voxelSurfaceStyle) {
     // this controls whether the polyvox surface extractor does marching-cubes or makes a cubic mesh.  It
     // also determines if the extra "edged" layer is used.
@@ -262,27 +284,6 @@ void RenderablePolyVoxEntityItem::forEachVoxelValue(const ivec3& voxelSize, std:
     });
 }
 
-QByteArray RenderablePolyVoxEntityItem::volDataToArray(quint16 voxelXSize, quint16 voxelYSize, quint16 voxelZSize) const {
-    int totalSize = voxelXSize * voxelYSize * voxelZSize;
-    ivec3 voxelSize{ voxelXSize, voxelYSize, voxelZSize };
-    ivec3 low{ 0 };
-    int index = 0;
-
-    QByteArray result = QByteArray(totalSize, '\0');
-    withReadLock([&] {
-        if (isEdged()) {
-            low += 1;
-            voxelSize += 2;
-        }
-
-        loop3(low, voxelSize, [&](const ivec3& v){
-            result[index++] = _volData->getVoxelAt(v.x, v.y, v.z);
-        });
-    });
-
-    return result;
-}
-
 bool RenderablePolyVoxEntityItem::setAll(uint8_t toValue) {
     bool result = false;
     if (_locked) {
@@ -896,6 +897,11 @@ void RenderablePolyVoxEntityItem::setVoxelVolumeSize(const glm::vec3& voxelVolum
         _volData.reset(new PolyVox::SimpleVolume<uint8_t>(PolyVox::Region(lowCorner, highCorner)));
         // having the "outside of voxel-space" value be 255 has helped me notice some problems.
         _volData->setBorderValue(255);
+
+        _bricks = PolyVoxBricks(ivec3(_voxelVolumeSize));
+        _editedBricks.clear();
+        ivec3 numMeshRegions = getNumMeshRegions();
+        _dirtyMeshRegions.assign(numMeshRegions.x * numMeshRegions.y * numMeshRegions.z, true);
     });
 
     tellNeighborsToRecopyEdges(true);
@@ -948,6 +954,7 @@ uint8_t RenderablePolyVoxEntityItem::getVoxelInternal(const ivec3& v) const {
 
 void RenderablePolyVoxEntityItem::setVoxelMarkNeighbors(int x, int y, int z, uint8_t toValue) {
     _volData->setVoxelAt(x, y, z, toValue);
+    markMeshRegionsDirty(x, y, z);
     if (x == 0) {
         _neighborXNeedsUpdate = true;
         startUpdates();
@@ -964,6 +971,17 @@ void RenderablePolyVoxEntityItem::setVoxelMarkNeighbors(int x, int y, int z, uin
 
 bool RenderablePolyVoxEntityItem::setVoxelInternal(const ivec3& v, uint8_t toValue) {
     // set a voxel without recompressing the voxel data.  This assumes that the caller has write-locked the entity.
+    bool result = setVolDataVoxel(v, toValue);
+    if (result) {
+        _bricks.setVoxel(v, toValue);
+        _editedBricks.insert(_bricks.getBrickIndex(v));
+    }
+
+    return result;
+}
+
+bool RenderablePolyVoxEntityItem::setVolDataVoxel(const ivec3& v, uint8_t toValue) {
+    // set a voxel in _volData only, for setVoxelInternal and for voxels received from the entity-server
     bool result = updateOnCount(v, toValue);
     if (result) {
         if (isEdged()) {
@@ -1001,6 +1019,29 @@ bool RenderablePolyVoxEntityItem::updateOnCount(const ivec3& v, uint8_t toValue)
     return false;
 }
 
+ivec3 RenderablePolyVoxEntityItem::getNumMeshRegions() const {
+    // neighboring regions share a layer of voxels, so that between them they extract every cell of _volData
+    ivec3 numCells { _volData->getWidth() - 1, _volData->getHeight() - 1, _volData->getDepth() - 1 };
+    return glm::max((numCells + (MESH_REGION_SIZE - 1)) / MESH_REGION_SIZE, ivec3(1));
+}
+
+void RenderablePolyVoxEntityItem::markMeshRegionsDirty(int x, int y, int z) {
+    // a voxel is a corner of the cells on either side of it, and marching cubes also samples it for the normals of the
+    // cells beyond those
+    ivec3 numRegions = getNumMeshRegions();
+    if ((int)_dirtyMeshRegions.size() != numRegions.x * numRegions.y * numRegions.z) {
+        return;
+    }
+
+    ivec3 v { x, y, z };
+    ivec3 numCells { _volData->getWidth() - 1, _volData->getHeight() - 1, _volData->getDepth() - 1 };
+    ivec3 low = glm::min(glm::max(v - 2, ivec3(0)) / MESH_REGION_SIZE, numRegions - 1);
+    ivec3 high = glm::min(glm::max(glm::min(v + 1, numCells - 1), ivec3(0)) / MESH_REGION_SIZE, numRegions - 1);
+    loop3(low, high + 1, [&](const ivec3& region) {
+        _dirtyMeshRegions[(region.z * numRegions.y + region.y) * numRegions.x + region.x] = true;
+    });
+}
+
 void RenderablePolyVoxEntityItem::uncompressVolumeData() {
     // take compressed data and expand it into _volData.
     QByteArray voxelData;
@@ -1011,47 +1052,43 @@ void RenderablePolyVoxEntityItem::uncompressVolumeData() {
     });
 
     QtConcurrent::run([=] {
-        QDataStream reader(voxelData);
-        quint16 voxelXSize, voxelYSize, voxelZSize;
-        reader >> voxelXSize;
-        reader >> voxelYSize;
-        reader >> voxelZSize;
-
-        if (voxelXSize == 0 || voxelXSize > PolyVoxEntityItem::MAX_VOXEL_DIMENSION ||
-            voxelYSize == 0 || voxelYSize > PolyVoxEntityItem::MAX_VOXEL_DIMENSION ||
-            voxelZSize == 0 || voxelZSize > PolyVoxEntityItem::MAX_VOXEL_DIMENSION) {
-            qCDebug(entitiesrenderer) << "voxelSize is not reasonable, skipping uncompressions."
-                                      << voxelXSize << voxelYSize << voxelZSize << getName() << getID();
-            entity->setVoxelsFromData(QByteArray(1, 0), 1, 1, 1);
-            return;
-        }
-        int rawSize = voxelXSize * voxelYSize * voxelZSize;
-
-        QByteArray compressedData;
-        reader >> compressedData;
-
-        QByteArray uncompressedData = qUncompress(compressedData);
-
-        if (uncompressedData.size() != rawSize) {
-            qCDebug(entitiesrenderer) << "PolyVox uncompress -- size is (" << voxelXSize << voxelYSize << voxelZSize << ")"
-                     << "so expected uncompressed length of" << rawSize << "but length is" << uncompressedData.size()
-                                      << getName() << getID();
-            entity->setVoxelsFromData(QByteArray(1, 0), 1, 1, 1);
+        PolyVoxBricks bricks;
+        if (!bricks.fromVoxelData(voxelData)) {
+            qCDebug(entitiesrenderer) << "PolyVox voxel data is not reasonable, skipping uncompression."
+                                      << entity->getName() << entity->getID();
+            entity->withWriteLock([&] {
+                entity->_state = PolyVoxState::UncompressingFinished;
+            });
             return;
         }
 
-        entity->setVoxelsFromData(uncompressedData, voxelXSize, voxelYSize, voxelZSize);
+        entity->setVoxelsFromBricks(bricks);
     });
 }
 
-void RenderablePolyVoxEntityItem::setVoxelsFromData(QByteArray uncompressedData,
-                                                    quint16 voxelXSize, quint16 voxelYSize, quint16 voxelZSize) {
+void RenderablePolyVoxEntityItem::setVoxelsFromBricks(const PolyVoxBricks& bricks) {
     // this accepts the payload from uncompressVolumeData
     withWriteLock([&] {
-        loop3(ivec3(0), ivec3(voxelXSize, voxelYSize, voxelZSize), [&](const ivec3& v) {
-            int uncompressedIndex = (v.z * voxelYSize * voxelXSize) + (v.y * voxelZSize) + v.x;
-            setVoxelInternal(v, uncompressedData[uncompressedIndex]);
-        });
+        ivec3 voxelVolumeSize { _voxelVolumeSize };
+        if (bricks.getVoxelVolumeSize() == voxelVolumeSize) {
+            // only the bricks that differ from what is already in _volData need to be set
+            for (int brickIndex : bricks.diff(_bricks)) {
+                ivec3 origin = bricks.getBrickOrigin(brickIndex);
+                loop3(origin, glm::min(origin + PolyVoxBricks::BRICK_SIZE, voxelVolumeSize), [&](const ivec3& v) {
+                    setVolDataVoxel(v, bricks.getVoxel(v));
+                });
+            }
+            _bricks = bricks;
+        } else {
+            // the voxel data is for another size of volume, so only the voxels the two have in common are set
+            loop3(ivec3(0), glm::min(bricks.getVoxelVolumeSize(), voxelVolumeSize), [&](const ivec3& v) {
+                setVolDataVoxel(v, bricks.getVoxel(v));
+            });
+            _bricks = PolyVoxBricks(voxelVolumeSize);
+            loop3(ivec3(0), voxelVolumeSize, [&](const ivec3& v) {
+                _bricks.setVoxel(v, getVoxelInternal(v));
+            });
+        }
 
         _state = PolyVoxState::UncompressingFinished;
     });
@@ -1063,26 +1100,17 @@ void RenderablePolyVoxEntityItem::compressVolumeDataAndSendEditPacket() {
 
     EntityItemPointer entity = getThisPointer();
 
-    quint16 voxelXSize;
-    quint16 voxelYSize;
-    quint16 voxelZSize;
-    withReadLock([&] {
-        voxelXSize = _voxelVolumeSize.x;
-        voxelYSize = _voxelVolumeSize.y;
-        voxelZSize = _voxelVolumeSize.z;
+    PolyVoxBricks bricks;
+    std::vector<int> editedBricks;
+    withWriteLock([&] {
+        bricks = _bricks;
+        editedBricks.assign(_editedBricks.begin(), _editedBricks.end());
+        _editedBricks.clear();
     });
 
-    QtConcurrent::run([voxelXSize, voxelYSize, voxelZSize, entity] {
+    QtConcurrent::run([bricks, editedBricks, entity] {
         auto polyVoxEntity = std::static_pointer_cast<RenderablePolyVoxEntityItem>(entity);
-        QByteArray uncompressedData = polyVoxEntity->volDataToArray(voxelXSize, voxelYSize, voxelZSize);
-
-        QByteArray newVoxelData;
-        QDataStream writer(&newVoxelData, QIODevice::WriteOnly | QIODevice::Truncate);
-
-        writer << voxelXSize << voxelYSize << voxelZSize;
-
-        QByteArray compressedData = qCompress(uncompressedData, 9);
-        writer << compressedData;
+        QByteArray newVoxelData = bricks.toVoxelData();
 
         // make sure the compressed data can be sent over the wire-protocol
         if (newVoxelData.size() > 1150) {
@@ -1090,21 +1118,29 @@ void RenderablePolyVoxEntityItem::compressVolumeDataAndSendEditPacket() {
             // revert the active voxel-space to the last version that fit.
             qCDebug(entitiesrenderer) << "compressed voxel data is too large" << entity->getName() << entity->getID();
 
-            const auto polyVoxEntity = std::static_pointer_cast<RenderablePolyVoxEntityItem>(entity);
-            polyVoxEntity->compressVolumeDataFinished(QByteArray());
+            polyVoxEntity->compressVolumeDataFinished(QByteArray(), QByteArray());
             return;
         }
 
-        std::static_pointer_cast<RenderablePolyVoxEntityItem>(entity)->compressVolumeDataFinished(newVoxelData);
+        polyVoxEntity->compressVolumeDataFinished(newVoxelData, bricks.makeDelta(editedBricks));
     });
 }
 
-void RenderablePolyVoxEntityItem::compressVolumeDataFinished(const QByteArray& voxelData) {
+void RenderablePolyVoxEntityItem::compressVolumeDataFinished(const QByteArray& voxelData, const QByteArray& voxelDelta) {
     // compressed voxel information from the entity-server
+    bool sendDelta = false;
     withWriteLock([&] {
         if (voxelData.size() > 0 && _voxelData != voxelData) {
             _voxelData = voxelData;
         }
+
+        if (voxelData.size() > 0) {
+            sendDelta = voxelDelta.size() < voxelData.size() && _numDeltasSinceVoxelData < MAX_DELTAS_BETWEEN_VOXEL_DATA;
+            _numDeltasSinceVoxelData = sendDelta ? _numDeltasSinceVoxelData + 1 : 0;
+        } else {
+            // the bricks of this edit weren't sent, so the next edit has to send everything
+            _numDeltasSinceVoxelData = MAX_DELTAS_BETWEEN_VOXEL_DATA;
+        }
         _state = PolyVoxState::CompressingFinished;
     });
 
@@ -1120,7 +1156,11 @@ void RenderablePolyVoxEntityItem::compressVolumeDataFinished(const QByteArray& v
             EntityPropertyFlags desiredProperties;
             desiredProperties.setHasProperty(PROP_VOXEL_DATA);
             EntityItemProperties properties = getProperties(desiredProperties, false);
-            properties.setVoxelDataDirty();
+            if (sendDelta) {
+                properties.setVoxelDelta(voxelDelta);
+            } else {
+                properties.setVoxelDataDirty();
+            }
             properties.setLastEdited(now);
 
             EntitySimulationPointer simulation = tree ? tree->getSimulation() : nullptr;
@@ -1200,6 +1240,7 @@ void RenderablePolyVoxEntityItem::copyUpperEdgesFromNeighbors() {
                         uint8_t prevValue = _volData->getVoxelAt(x, y, z);
                         if (prevValue != neighborValue) {
                             _volData->setVoxelAt(x, y, z, neighborValue);
+                            markMeshRegionsDirty(x, y, z);
                             _volDataDirty = true;
                         }
                     }
@@ -1220,6 +1261,7 @@ void RenderablePolyVoxEntityItem::copyUpperEdgesFromNeighbors() {
                         uint8_t prevValue = _volData->getVoxelAt(x, y, z);
                         if (prevValue != neighborValue) {
                             _volData->setVoxelAt(x, y, z, neighborValue);
+                            markMeshRegionsDirty(x, y, z);
                             _volDataDirty = true;
                         }
                     }
@@ -1240,6 +1282,7 @@ void RenderablePolyVoxEntityItem::copyUpperEdgesFromNeighbors() {
                         uint8_t prevValue = _volData->getVoxelAt(x, y, z);
                         if (prevValue != neighborValue) {
                             _volData->setVoxelAt(x, y, z, neighborValue);
+                            markMeshRegionsDirty(x, y, z);
                             _volDataDirty = true;
                         }
                     }
@@ -1282,47 +1325,90 @@ void RenderablePolyVoxEntityItem::tellNeighborsToRecopyEdges(bool force) {
 void RenderablePolyVoxEntityItem::recomputeMesh() {
     // use _volData to make a renderable mesh
     PolyVoxSurfaceStyle voxelSurfaceStyle;
-    withReadLock([&] {
+    std::vector<bool> dirtyMeshRegions;
+    withWriteLock([&] {
         voxelSurfaceStyle = _voxelSurfaceStyle;
+        dirtyMeshRegions.swap(_dirtyMeshRegions);
+        _dirtyMeshRegions.assign(dirtyMeshRegions.size(), false);
     });
 
     auto entity = std::static_pointer_cast<RenderablePolyVoxEntityItem>(getThisPointer());
 
-    QtConcurrent::run([entity, voxelSurfaceStyle] {
+    QtConcurrent::run([entity, voxelSurfaceStyle, dirtyMeshRegions] {
         graphics::MeshPointer mesh(std::make_shared<graphics::Mesh>());
 
-        // A mesh object to hold the result of surface extraction
-        PolyVox::SurfaceMesh<PolyVox::PositionMaterialNormal> polyVoxMesh;
-
+        // re-extract the regions that have changed since the last mesh, or all of them if the volume was replaced
+        auto& meshRegions = entity->_meshRegions;
+        ivec3 numRegions;
         entity->withReadLock([&] {
             PolyVox::SimpleVolume<uint8_t>* volData = entity->getVolData();
-            switch (voxelSurfaceStyle) {
-                case PolyVoxEntityItem::SURFACE_EDGED_MARCHING_CUBES:
-                case PolyVoxEntityItem::SURFACE_MARCHING_CUBES: {
-                    PolyVox::MarchingCubesSurfaceExtractor<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
-                        (volData, volData->getEnclosingRegion(), &polyVoxMesh);
-                    surfaceExtractor.execute();
-                    break;
+            numRegions = entity->getNumMeshRegions();
+            size_t numMeshRegions = numRegions.x * numRegions.y * numRegions.z;
+            bool extractAll = meshRegions.size() != numMeshRegions || dirtyMeshRegions.size() != numMeshRegions ||
+                entity->_meshRegionsSurfaceStyle != voxelSurfaceStyle;
+            meshRegions.resize(numMeshRegions);
+            entity->_meshRegionsSurfaceStyle = voxelSurfaceStyle;
+
+            const PolyVox::Vector3DInt32& upperCorner = volData->getEnclosingRegion().getUpperCorner();
+            loop3(ivec3(0), numRegions, [&](const ivec3& region) {
+                int index = (region.z * numRegions.y + region.y) * numRegions.x + region.x;
+                if (!extractAll && !dirtyMeshRegions[index]) {
+                    return;
                 }
-                case PolyVoxEntityItem::SURFACE_EDGED_CUBIC:
-                case PolyVoxEntityItem::SURFACE_CUBIC: {
-                    PolyVox::CubicSurfaceExtractorWithNormals<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
-                        (volData, volData->getEnclosingRegion(), &polyVoxMesh);
-                    surfaceExtractor.execute();
-                    break;
+
+                ivec3 low = region * MESH_REGION_SIZE;
+                ivec3 high = low + MESH_REGION_SIZE;
+                PolyVox::Region extractRegion(PolyVox::Vector3DInt32(low.x, low.y, low.z),
+                                              PolyVox::Vector3DInt32(std::min(high.x, upperCorner.getX()),
+                                                                     std::min(high.y, upperCorner.getY()),
+                                                                     std::min(high.z, upperCorner.getZ())));
+
+                // A mesh object to hold the result of surface extraction
+                PolyVox::SurfaceMesh<PolyVox::PositionMaterialNormal>& polyVoxMesh = meshRegions[index];
+                polyVoxMesh = PolyVox::SurfaceMesh<PolyVox::PositionMaterialNormal>();
+                switch (voxelSurfaceStyle) {
+                    case PolyVoxEntityItem::SURFACE_EDGED_MARCHING_CUBES:
+                    case PolyVoxEntityItem::SURFACE_MARCHING_CUBES: {
+                        PolyVox::MarchingCubesSurfaceExtractor<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
+                            (volData, extractRegion, &polyVoxMesh);
+                        surfaceExtractor.execute();
+                        break;
+                    }
+                    case PolyVoxEntityItem::SURFACE_EDGED_CUBIC:
+                    case PolyVoxEntityItem::SURFACE_CUBIC: {
+                        PolyVox::CubicSurfaceExtractorWithNormals<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
+                            (volData, extractRegion, &polyVoxMesh);
+                        surfaceExtractor.execute();
+                        break;
+                    }
                 }
+            });
+        });
+
+        // join the regions into one mesh.  The extractors place vertices relative to the lower corner of their region.
+        std::vector<PolyVox::PositionMaterialNormal> vecVertices;
+        std::vector<uint32_t> vecIndices;
+        loop3(ivec3(0), numRegions, [&](const ivec3& region) {
+            const auto& polyVoxMesh = meshRegions[(region.z * numRegions.y + region.y) * numRegions.x + region.x];
+            vec3 low { region * MESH_REGION_SIZE };
+            PolyVox::Vector3DFloat offset(low.x, low.y, low.z);
+            uint32_t baseVertex = (uint32_t)vecVertices.size();
+            for (auto vertex : polyVoxMesh.getRawVertexData()) {
+                vertex.setPosition(vertex.getPosition() + offset);
+                vecVertices.push_back(vertex);
+            }
+            for (uint32_t index : polyVoxMesh.getIndices()) {
+                vecIndices.push_back(baseVertex + index);
             }
         });
 
         // convert PolyVox mesh to a Sam mesh
-        const std::vector<uint32_t>& vecIndices = polyVoxMesh.getIndices();
         auto indexBuffer = std::make_shared<gpu::Buffer>(vecIndices.size() * sizeof(uint32_t),
                                                          (gpu::Byte*)vecIndices.data());
         auto indexBufferPtr = gpu::BufferPointer(indexBuffer);
         gpu::BufferView indexBufferView(indexBufferPtr, gpu::Element(gpu::SCALAR, gpu::UINT32, gpu::INDEX));
         mesh->setIndexBuffer(indexBufferView);
 
-        const std::vector<PolyVox::PositionMaterialNormal>& vecVertices = polyVoxMesh.getRawVertexData();
         auto vertexBuffer = std::make_shared<gpu::Buffer>(vecVertices.size() * sizeof(PolyVox::PositionMaterialNormal),
                                                           (gpu::Byte*)vecVertices.data());
         auto vertexBufferPtr = gpu::BufferPointer(vertexBuffer);
@@ -13,17 +13,20 @@
 #define hifi_RenderablePolyVoxEntityItem_h
 
 #include <atomic>
+#include <set>
 
 #include <QSemaphore>
 
 #include <PolyVoxCore/SimpleVolume.h>
 #include <PolyVoxCore/Raycast.h>
+#include <PolyVoxCore/SurfaceMesh.h>
 
 #include <gpu/Forward.h>
 #include <gpu/Context.h>
 #include <graphics/Forward.h>
 #include <graphics/Geometry.h>
 #include <TextureCache.h>
+#include <PolyVoxBricks.h>
 #include <PolyVoxEntityItem.h>
 
 #include "RenderableEntityItem.h"
@@ -80,6 +83,7 @@ public:
                                                   QVariantMap& extraInfo, bool precisionPicking) const override;
 
     virtual void setVoxelData(const QByteArray& voxelData) override;
+    virtual void applyVoxelDelta(const QByteArray& voxelDelta) override;
     virtual void setVoxelVolumeSize(const glm::vec3& voxelVolumeSize) override;
     virtual void setVoxelSurfaceStyle(PolyVoxSurfaceStyle voxelSurfaceStyle) override;
 
@@ -115,9 +119,8 @@ public:
 
     virtual void setRegistrationPoint(const glm::vec3& value) override;
 
-    void setVoxelsFromData(QByteArray uncompressedData, quint16 voxelXSize, quint16 voxelYSize, quint16 voxelZSize);
+    void setVoxelsFromBricks(const PolyVoxBricks& bricks);
     void forEachVoxelValue(const ivec3& voxelSize, std::function<void(const ivec3&, uint8_t)> thunk);
-    QByteArray volDataToArray(quint16 voxelXSize, quint16 voxelYSize, quint16 voxelZSize) const;
 
     void setMesh(graphics::MeshPointer mesh);
     void setCollisionPoints(ShapeInfo::PointCollection points, AABox box);
@@ -127,7 +130,7 @@ public:
     bool setVoxelInternal(const ivec3& v, uint8_t toValue);
     void setVoxelMarkNeighbors(int x, int y, int z, uint8_t toValue);
 
-    void compressVolumeDataFinished(const QByteArray& voxelData);
+    void compressVolumeDataFinished(const QByteArray& voxelData, const QByteArray& voxelDelta);
     void neighborXEdgeChanged() { withWriteLock([&] { _updateFromNeighborXEdge = true; }); startUpdates(); }
     void neighborYEdgeChanged() { withWriteLock([&] { _updateFromNeighborYEdge = true; }); startUpdates(); }
     void neighborZEdgeChanged() { withWriteLock([&] { _updateFromNeighborZEdge = true; }); startUpdates(); }
@@ -140,6 +143,9 @@ public:
 
 private:
     bool updateOnCount(const ivec3& v, uint8_t toValue);
+    bool setVolDataVoxel(const ivec3& v, uint8_t toValue);
+    ivec3 getNumMeshRegions() const;
+    void markMeshRegionsDirty(int x, int y, int z);
     PolyVox::RaycastResult doRayCast(glm::vec4 originInVoxel, glm::vec4 farInVoxel, glm::vec4& result) const;
 
     void changeUpdates(bool value);
@@ -173,6 +179,16 @@ private:
     std::shared_ptr<PolyVox::SimpleVolume<uint8_t>> _volData;
     int _onCount; // how many non-zero voxels are in _volData
 
+    // the voxels of _volData that are within _voxelVolumeSize, which _voxelData and edits are made from
+    PolyVoxBricks _bricks;
+    std::set<int> _editedBricks; // changed by local edits since they were last sent
+    int _numDeltasSinceVoxelData { 0 }; // edits sent as bricks since the whole _voxelData was last sent
+
+    // _volData is meshed in regions of MESH_REGION_SIZE voxels a side, and only those that have changed are re-extracted
+    std::vector<bool> _dirtyMeshRegions;
+    std::vector<PolyVox::SurfaceMesh<PolyVox::PositionMaterialNormal>> _meshRegions; // only used by recomputeMesh
+    PolyVoxSurfaceStyle _meshRegionsSurfaceStyle { DEFAULT_VOXEL_SURFACE_STYLE }; // only used by recomputeMesh
+
     bool _neighborXNeedsUpdate { false };
     bool _neighborYNeedsUpdate { false };
     bool _neighborZNeedsUpdate { false };
@@ -0,0 +1,89 @@
+//
+//  AddEntitiesOperator.cpp
+//  libraries/entities/src
+//
+//  Created on 2026-10-16.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AddEntitiesOperator.h"
+
+#include "EntityItem.h"
+#include "EntityTree.h"
+#include "EntityTreeElement.h"
+
+AddEntitiesOperator::AddEntitiesOperator(EntityTreePointer tree) :
+    _tree(tree)
+{
+}
+
+void AddEntitiesOperator::addEntityToAddList(EntityItemPointer newEntity) {
+    assert(newEntity);
+
+    bool success;
+    auto queryCube = newEntity->getQueryAACube(success);
+    _newEntities.push_back({ newEntity, queryCube.clamp((float)(-HALF_TREE_SCALE), (float)HALF_TREE_SCALE) });
+}
+
+bool AddEntitiesOperator::preRecursion(const OctreeElementPointer& element) {
+    EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
+    const AACube& cube = element->getAACube();
+
+    // the root is offered every new entity, every other element those its parent couldn't place
+    std::vector<int> candidates;
+    if (_entitiesBelow.empty()) {
+        candidates.resize(_newEntities.size());
+        for (int i = 0; i < (int)_newEntities.size(); ++i) {
+            candidates[i] = i;
+        }
+    } else {
+        candidates = _entitiesBelow.back();
+    }
+
+    std::vector<int> entitiesBelow;
+    bool changed = false;
+    for (int index : candidates) {
+        const NewEntity& newEntity = _newEntities[index];
+        if (!cube.contains(newEntity.box)) {
+            continue;
+        }
+        changed = true;
+
+        // add it here if this element is the best fit for it, otherwise keep looking for it below
+        if (entityTreeElement->bestFitBounds(newEntity.box)) {
+            _tree->addEntityMapEntry(newEntity.entity);
+            entityTreeElement->addEntityItem(newEntity.entity);
+        } else {
+            entitiesBelow.push_back(index);
+        }
+    }
+
+    // mark the paths to the new entities as dirty
+    if (changed) {
+        element->markWithChangedTime();
+    }
+
+    bool keepSearching = !entitiesBelow.empty();
+    _entitiesBelow.push_back(std::move(entitiesBelow));
+    return keepSearching;
+}
+
+bool AddEntitiesOperator::postRecursion(const OctreeElementPointer& element) {
+    _entitiesBelow.pop_back();
+    return true; // the other children may have new entities too
+}
+
+OctreeElementPointer AddEntitiesOperator::possiblyCreateChildAt(const OctreeElementPointer& element, int childIndex) {
+    // create the child if any of the entities that go below this element go in it
+    float childElementScale = element->getAACube().getScale() / 2.0f; // all of our children will be half our scale
+    for (int index : _entitiesBelow.back()) {
+        const AABox& box = _newEntities[index].box;
+        if (box.getLargestDimension() <= childElementScale && element->getMyChildContaining(box) == childIndex) {
+            return element->addChildAtIndex(childIndex);
+        }
+    }
+    return NULL;
+}
@@ -0,0 +1,51 @@
+//
+//  AddEntitiesOperator.h
+//  libraries/entities/src
+//
+//  Created on 2026-10-16.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AddEntitiesOperator_h
+#define hifi_AddEntitiesOperator_h
+
+#include <memory>
+#include <vector>
+
+#include <AABox.h>
+#include <Octree.h>
+
+#include "EntityTypes.h"
+
+class EntityTree;
+using EntityTreePointer = std::shared_ptr<EntityTree>;
+
+// As AddEntityOperator, but for many new entities at once: the tree is walked once, and each branch only as far down as
+// the entities that go in it.
+class AddEntitiesOperator : public RecurseOctreeOperator {
+public:
+    AddEntitiesOperator(EntityTreePointer tree);
+
+    // the caller must have verified that the entity isn't in the tree yet
+    void addEntityToAddList(EntityItemPointer newEntity);
+
+    virtual bool preRecursion(const OctreeElementPointer& element) override;
+    virtual bool postRecursion(const OctreeElementPointer& element) override;
+    virtual OctreeElementPointer possiblyCreateChildAt(const OctreeElementPointer& element, int childIndex) override;
+
+private:
+    struct NewEntity {
+        EntityItemPointer entity;
+        AABox box;
+    };
+
+    EntityTreePointer _tree;
+    std::vector<NewEntity> _newEntities;
+    // for each element being recursed, root first, the new entities that go below it
+    std::vector<std::vector<int>> _entitiesBelow;
+};
+
+#endif // hifi_AddEntitiesOperator_h
@@ -196,8 +196,10 @@ OctreeElement::AppendState EntityItem::appendEntityData(OctreePacketData* packet
 
     // If we are being called for a subsequent pass at appendEntityData() that failed to completely encode this item,
     // then our entityTreeElementExtraEncodeData should include data about which properties we need to append.
+    bool isContinuation = false;
     if (entityTreeElementExtraEncodeData && entityTreeElementExtraEncodeData->entities.contains(getEntityItemID())) {
         requestedProperties = entityTreeElementExtraEncodeData->entities.value(getEntityItemID());
+        isContinuation = true;
     }
 
     QString privateUserData = "";
@@ -205,9 +207,42 @@ OctreeElement::AppendState EntityItem::appendEntityData(OctreePacketData* packet
         privateUserData = getPrivateUserData();
     }
 
+    // copy a complete encoding made for another receiver if nothing has changed since, the key is taken before
+    // encoding so that an encoding is never newer than its key
+    bool useEncodingCache = params.useEncodingCache && !isContinuation;
+    EncodingCacheKey encodingCacheKey;
+    if (useEncodingCache) {
+        encodingCacheKey.lastEdited = getLastEdited();
+        encodingCacheKey.lastUpdated = getLastUpdated();
+        encodingCacheKey.lastSimulated = getLastSimulated();
+        encodingCacheKey.changedOnServer = getLastChangedOnServer();
+        encodingCacheKey.includesPrivateUserData = !privateUserData.isEmpty();
+
+        QByteArray encoding;
+        {
+            std::lock_guard<std::mutex> lock(_encodingCacheLock);
+            if (_encodingCacheKey == encodingCacheKey) {
+                encoding = _encodingCache;
+            }
+        }
+
+        if (!encoding.isEmpty()) {
+            LevelDetails cachedLevel = packetData->startLevel();
+            if (packetData->appendRawData(encoding)) {
+                packetData->endLevel(cachedLevel);
+                params.trackSend(getID(), getLastEdited());
+                return OctreeElement::COMPLETED;
+            }
+
+            // encode whatever part of it fits
+            packetData->discardLevel(cachedLevel);
+        }
+    }
+
     EntityPropertyFlags propertiesDidntFit = requestedProperties;
 
     LevelDetails entityLevel = packetData->startLevel();
+    int entityOffset = packetData->getUncompressedByteOffset();
 
     quint64 lastEdited = getLastEdited();
 
@@ -381,6 +416,14 @@ OctreeElement::AppendState EntityItem::appendEntityData(OctreePacketData* packet
         }
 
         packetData->endLevel(entityLevel);
+
+        if (useEncodingCache && appendState == OctreeElement::COMPLETED) {
+            int entityLength = packetData->getUncompressedByteOffset() - entityOffset;
+            QByteArray encoding((const char*)packetData->getUncompressedData(entityOffset), entityLength);
+            std::lock_guard<std::mutex> lock(_encodingCacheLock);
+            _encodingCacheKey = encodingCacheKey;
+            _encodingCache = encoding;
+        }
     } else {
         packetData->discardLevel(entityLevel);
         appendState = OctreeElement::NONE; // if we got here, then we didn't include the item
@@ -1931,6 +1974,7 @@ void EntityItem::setParentID(const QUuid& value) {
 
         if (tree) {
             tree->addToNeedsParentFixupList(getThisPointer());
+            tree->reindexEntity(getThisPointer());
         }
         updateQueryAACube();
     }
@@ -2955,9 +2999,18 @@ QString EntityItem::getName() const {
 }
 
 void EntityItem::setName(const QString& value) {
+    bool changed = false;
     withWriteLock([&] {
+        changed = _name != value;
         _name = value;
     });
+
+    if (changed) {
+        EntityTreePointer tree = getTree();
+        if (tree) {
+            tree->reindexEntity(getThisPointer());
+        }
+    }
 }
 
 QString EntityItem::getDebugName() {
@@ -3512,11 +3565,19 @@ QUuid EntityItem::getOwningAvatarIDForProperties() const {
 }
 
 void EntityItem::setOwningAvatarID(const QUuid& owningAvatarID) {
+    QUuid oldOwningAvatarID = _owningAvatarID;
     if (!owningAvatarID.isNull() && owningAvatarID == Physics::getSessionUUID()) {
         _owningAvatarID = AVATAR_SELF_ID;
     } else {
         _owningAvatarID = owningAvatarID;
     }
+
+    if (_owningAvatarID != oldOwningAvatarID) {
+        EntityTreePointer tree = getTree();
+        if (tree) {
+            tree->reindexEntity(getThisPointer());
+        }
+    }
 }
 
 void EntityItem::addGrab(GrabPointer grab) {
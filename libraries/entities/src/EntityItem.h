@@ -13,6 +13,7 @@
 #define hifi_EntityItem_h
 
 #include <memory>
+#include <mutex>
 #include <stdint.h>
 
 #include <glm/glm.hpp>
@@ -618,6 +619,25 @@ protected:
     quint64 _created { 0 };
     quint64 _changedOnServer { 0 };
 
+    // the last complete encoding of this entity, which is the same for all the receivers that get the same private
+    // user data, valid for as long as none of the times it was made at have changed
+    struct EncodingCacheKey {
+        quint64 lastEdited { 0 };
+        quint64 lastUpdated { 0 };
+        quint64 lastSimulated { 0 };
+        quint64 changedOnServer { 0 };
+        bool includesPrivateUserData { false };
+
+        bool operator==(const EncodingCacheKey& other) const {
+            return lastEdited == other.lastEdited && lastUpdated == other.lastUpdated &&
+                lastSimulated == other.lastSimulated && changedOnServer == other.changedOnServer &&
+                includesPrivateUserData == other.includesPrivateUserData;
+        }
+    };
+    mutable std::mutex _encodingCacheLock;
+    mutable EncodingCacheKey _encodingCacheKey;
+    mutable QByteArray _encodingCache;
+
     mutable AABox _cachedAABox;
     mutable AACube _maxAACube;
     mutable AACube _minAACube;
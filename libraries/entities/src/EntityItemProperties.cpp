@@ -613,6 +613,7 @@ EntityPropertyFlags EntityItemProperties::getChangedProperties() const {
     CHECK_PROPERTY_CHANGE(PROP_X_P_NEIGHBOR_ID, xPNeighborID);
     CHECK_PROPERTY_CHANGE(PROP_Y_P_NEIGHBOR_ID, yPNeighborID);
     CHECK_PROPERTY_CHANGE(PROP_Z_P_NEIGHBOR_ID, zPNeighborID);
+    CHECK_PROPERTY_CHANGE(PROP_VOXEL_DELTA, voxelDelta);
 
     // Web
     CHECK_PROPERTY_CHANGE(PROP_SOURCE_URL, sourceUrl);
@@ -2525,6 +2526,7 @@ void EntityItemProperties::merge(const EntityItemProperties& other) {
     COPY_PROPERTY_IF_CHANGED(xPNeighborID);
     COPY_PROPERTY_IF_CHANGED(yPNeighborID);
     COPY_PROPERTY_IF_CHANGED(zPNeighborID);
+    COPY_PROPERTY_IF_CHANGED(voxelDelta);
 
     // Web
     COPY_PROPERTY_IF_CHANGED(sourceUrl);
@@ -3354,6 +3356,7 @@ OctreeElement::AppendState EntityItemProperties::encodeEntityEditPacket(PacketTy
                 APPEND_ENTITY_PROPERTY(PROP_X_P_NEIGHBOR_ID, properties.getXPNeighborID());
                 APPEND_ENTITY_PROPERTY(PROP_Y_P_NEIGHBOR_ID, properties.getYPNeighborID());
                 APPEND_ENTITY_PROPERTY(PROP_Z_P_NEIGHBOR_ID, properties.getZPNeighborID());
+                APPEND_ENTITY_PROPERTY(PROP_VOXEL_DELTA, properties.getVoxelDelta());
             }
 
             if (properties.getType() == EntityTypes::Web) {
@@ -3833,6 +3836,7 @@ bool EntityItemProperties::decodeEntityEditPacket(const unsigned char* data, int
         READ_ENTITY_PROPERTY_TO_PROPERTIES(PROP_X_P_NEIGHBOR_ID, EntityItemID, setXPNeighborID);
         READ_ENTITY_PROPERTY_TO_PROPERTIES(PROP_Y_P_NEIGHBOR_ID, EntityItemID, setYPNeighborID);
         READ_ENTITY_PROPERTY_TO_PROPERTIES(PROP_Z_P_NEIGHBOR_ID, EntityItemID, setZPNeighborID);
+        READ_ENTITY_PROPERTY_TO_PROPERTIES(PROP_VOXEL_DELTA, QByteArray, setVoxelDelta);
     }
 
     if (properties.getType() == EntityTypes::Web) {
@@ -4891,6 +4895,9 @@ QList<QString> EntityItemProperties::listChangedProperties() {
     if (zPNeighborIDChanged()) {
         out += "zPNeighborID";
     }
+    if (voxelDeltaChanged()) {
+        out += "voxelDelta";
+    }
 
     // Web
     if (sourceUrlChanged()) {
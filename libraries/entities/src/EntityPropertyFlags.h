@@ -313,6 +313,7 @@ enum EntityPropertyList {
     PROP_X_P_NEIGHBOR_ID = PROP_DERIVED_9,
     PROP_Y_P_NEIGHBOR_ID = PROP_DERIVED_10,
     PROP_Z_P_NEIGHBOR_ID = PROP_DERIVED_11,
+    PROP_VOXEL_DELTA = PROP_DERIVED_12,
 
     // Web
     PROP_SOURCE_URL = PROP_DERIVED_0,
@@ -1150,9 +1150,7 @@ QUuid EntityScriptingInterface::findClosestEntity(const glm::vec3& center, float
     EntityItemID result;
     if (_entityTree) {
         unsigned int searchFilter = PickFilter::getBitMask(PickFilter::FlagBit::DOMAIN_ENTITIES) | PickFilter::getBitMask(PickFilter::FlagBit::AVATAR_ENTITIES);
-        _entityTree->withReadLock([&] {
-            result = _entityTree->evalClosestEntity(center, radius, PickFilter(searchFilter));
-        });
+        result = _entityTree->evalClosestEntity(center, radius, PickFilter(searchFilter));
     }
     return result;
 }
@@ -1172,9 +1170,7 @@ QVector<QUuid> EntityScriptingInterface::findEntities(const glm::vec3& center, f
     QVector<QUuid> result;
     if (_entityTree) {
         unsigned int searchFilter = PickFilter::getBitMask(PickFilter::FlagBit::DOMAIN_ENTITIES) | PickFilter::getBitMask(PickFilter::FlagBit::AVATAR_ENTITIES);
-        _entityTree->withReadLock([&] {
-            _entityTree->evalEntitiesInSphere(center, radius, PickFilter(searchFilter), result);
-        });
+        _entityTree->evalEntitiesInSphere(center, radius, PickFilter(searchFilter), result);
     }
     return result;
 }
@@ -1185,10 +1181,8 @@ QVector<QUuid> EntityScriptingInterface::findEntitiesInBox(const glm::vec3& corn
     QVector<QUuid> result;
     if (_entityTree) {
         unsigned int searchFilter = PickFilter::getBitMask(PickFilter::FlagBit::DOMAIN_ENTITIES) | PickFilter::getBitMask(PickFilter::FlagBit::AVATAR_ENTITIES);
-        _entityTree->withReadLock([&] {
-            AABox box(corner, dimensions);
-            _entityTree->evalEntitiesInBox(box, PickFilter(searchFilter), result);
-        });
+        AABox box(corner, dimensions);
+        _entityTree->evalEntitiesInBox(box, PickFilter(searchFilter), result);
     }
     return result;
 }
@@ -1224,9 +1218,7 @@ QVector<QUuid> EntityScriptingInterface::findEntitiesInFrustum(QVariantMap frust
 
         if (_entityTree) {
             unsigned int searchFilter = PickFilter::getBitMask(PickFilter::FlagBit::DOMAIN_ENTITIES) | PickFilter::getBitMask(PickFilter::FlagBit::AVATAR_ENTITIES);
-            _entityTree->withReadLock([&] {
-                _entityTree->evalEntitiesInFrustum(viewFrustum, PickFilter(searchFilter), result);
-            });
+            _entityTree->evalEntitiesInFrustum(viewFrustum, PickFilter(searchFilter), result);
         }
     }
 
@@ -1239,9 +1231,7 @@ QVector<QUuid> EntityScriptingInterface::findEntitiesByType(const QString entity
     QVector<QUuid> result;
     if (_entityTree) {
         unsigned int searchFilter = PickFilter::getBitMask(PickFilter::FlagBit::DOMAIN_ENTITIES) | PickFilter::getBitMask(PickFilter::FlagBit::AVATAR_ENTITIES);
-        _entityTree->withReadLock([&] {
-            _entityTree->evalEntitiesInSphereWithType(center, radius, type, PickFilter(searchFilter), result);
-        });
+        _entityTree->evalEntitiesInSphereWithType(center, radius, type, PickFilter(searchFilter), result);
     }
     return result;
 }
@@ -1249,10 +1239,8 @@ QVector<QUuid> EntityScriptingInterface::findEntitiesByType(const QString entity
 QVector<QUuid> EntityScriptingInterface::findEntitiesByName(const QString entityName, const glm::vec3& center, float radius, bool caseSensitiveSearch) const {
     QVector<QUuid> result;
     if (_entityTree) {
-        _entityTree->withReadLock([&] {
-            unsigned int searchFilter = PickFilter::getBitMask(PickFilter::FlagBit::DOMAIN_ENTITIES) | PickFilter::getBitMask(PickFilter::FlagBit::AVATAR_ENTITIES);
-            _entityTree->evalEntitiesInSphereWithName(center, radius, entityName, caseSensitiveSearch, PickFilter(searchFilter), result);
-        });
+        unsigned int searchFilter = PickFilter::getBitMask(PickFilter::FlagBit::DOMAIN_ENTITIES) | PickFilter::getBitMask(PickFilter::FlagBit::AVATAR_ENTITIES);
+        _entityTree->evalEntitiesInSphereWithName(center, radius, entityName, caseSensitiveSearch, PickFilter(searchFilter), result);
     }
     return result;
 }
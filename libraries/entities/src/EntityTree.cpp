@@ -12,8 +12,16 @@
 //
 
 #include "EntityTree.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 #include <QtCore/QDateTime>
 #include <QtCore/QQueue>
+#include <QtCore/QThread>
 #include <openssl/err.h>
 #include <openssl/pem.h>
 #include <openssl/x509.h>
@@ -27,6 +35,7 @@
 #include <QtScript/QScriptEngine>
 
 #include <Extents.h>
+#include <OctreeEntitiesFileParser.h>
 #include <PerfStat.h>
 #include <Profile.h>
 #include <AddressManager.h>
@@ -34,6 +43,7 @@
 #include "EntitySimulation.h"
 #include "VariantMapToScriptValue.h"
 
+#include "AddEntitiesOperator.h"
 #include "AddEntityOperator.h"
 #include "UpdateEntityOperator.h"
 #include "QVariantGLM.h"
@@ -85,6 +95,7 @@ OctreeElementPointer EntityTree::createNewElement(unsigned char* octalCode) {
 
 void EntityTree::eraseDomainAndNonOwnedEntities() {
     emit clearingEntities();
+    loseTrackOfPersistChanges();
 
     if (_simulation) {
         // local-entities are not in the simulation, so we clear ALL
@@ -114,7 +125,12 @@ void EntityTree::eraseDomainAndNonOwnedEntities() {
             }
         }
         _entityMap.swap(savedEntities);
+        _entityIndex.clear();
+        foreach(EntityItemPointer entity, _entityMap) {
+            _entityIndex.add(entity);
+        }
     });
+    clearSnapshot();
 
     resetClientEditStats();
     clearDeletedEntities();
@@ -136,12 +152,14 @@ void EntityTree::eraseDomainAndNonOwnedEntities() {
 
 void EntityTree::eraseAllOctreeElements(bool createNewRoot) {
     emit clearingEntities();
+    loseTrackOfPersistChanges();
 
     if (_simulation) {
         _simulation->clearEntities();
     }
     QHash<EntityItemID, EntityItemPointer> localMap;
     localMap.swap(_entityMap);
+    _entityIndex.clear();
     this->withWriteLock([&] {
         foreach(EntityItemPointer entity, localMap) {
             EntityTreeElementPointer element = entity->getElement();
@@ -159,6 +177,11 @@ void EntityTree::eraseAllOctreeElements(bool createNewRoot) {
     });
     localMap.clear();
     Octree::eraseAllOctreeElements(createNewRoot);
+    withWriteLock([&] {
+        // the new elements have no snapshot to share
+        _changedSnapshotElements.clear();
+    });
+    clearSnapshot();
 
     resetClientEditStats();
     clearDeletedEntities();
@@ -306,9 +329,12 @@ void EntityTree::postAddEntity(EntityItemPointer entity) {
     }
 
     _isDirty = true;
+    trackPersistChange(entity->getEntityItemID(), false);
 
     // find and hook up any entities with this entity as a (previously) missing parent
-    fixupNeedsParentFixups();
+    if (!_deferParentFixups) {
+        fixupNeedsParentFixups();
+    }
 
     emit addingEntity(entity->getEntityItemID());
     emit addingEntityPointer(entity.get());
@@ -372,6 +398,7 @@ bool EntityTree::updateEntity(EntityItemPointer entity, const EntityItemProperti
                     emit editingEntityPointer(entity);
                 }
                 _isDirty = true;
+                trackPersistChange(entity->getEntityItemID(), false);
             }
         }
     } else {
@@ -507,6 +534,7 @@ bool EntityTree::updateEntity(EntityItemPointer entity, const EntityItemProperti
         }
 
         _isDirty = true;
+        trackPersistChange(entity->getEntityItemID(), false);
 
         uint32_t newFlags = entity->getDirtyFlags() & ~preFlags;
         if (newFlags) {
@@ -540,6 +568,17 @@ bool EntityTree::updateEntity(EntityItemPointer entity, const EntityItemProperti
 }
 
 EntityItemPointer EntityTree::addEntity(const EntityItemID& entityID, const EntityItemProperties& properties, bool isClone, const bool isImport) {
+    EntityItemPointer result = constructEntity(entityID, properties, isClone, isImport);
+    if (result) {
+        // Recurse the tree and store the entity in the correct tree element
+        AddEntityOperator theOperator(getThisPointer(), result);
+        recurseTreeWithOperator(&theOperator);
+        postAddEntity(result);
+    }
+    return result;
+}
+
+EntityItemPointer EntityTree::constructEntity(const EntityItemID& entityID, const EntityItemProperties& properties, bool isClone, const bool isImport) {
     EntityItemProperties props = properties;
 
     auto nodeList = DependencyManager::get<NodeList>();
@@ -574,14 +613,8 @@ EntityItemPointer EntityTree::addEntity(const EntityItemID& entityID, const Enti
     EntityTypes::EntityType type = props.getType();
     EntityItemPointer result = EntityTypes::constructEntityItem(type, entityID, props);
 
-    if (result) {
-        if (recordCreationTime) {
-            result->recordCreationTime();
-        }
-        // Recurse the tree and store the entity in the correct tree element
-        AddEntityOperator theOperator(getThisPointer(), result);
-        recurseTreeWithOperator(&theOperator);
-        postAddEntity(result);
+    if (result && recordCreationTime) {
+        result->recordCreationTime();
     }
     return result;
 }
@@ -748,6 +781,7 @@ void EntityTree::deleteEntitiesByPointer(const std::vector<EntityItemPointer>& e
             theOperator.addEntityToDeleteList(entity);
             emit deletingEntity(entity->getID());
             emit deletingEntityPointer(entity.get());
+            trackPersistChange(entity->getEntityItemID(), true);
         }
     }
 
@@ -813,11 +847,10 @@ public:
     EntityItemID entityID;
 };
 
-bool evalRayIntersectionOp(const OctreeElementPointer& element, void* extraData) {
+bool evalRayIntersectionOp(const EntityTreeSnapshot::Element& element, void* extraData) {
     RayArgs* args = static_cast<RayArgs*>(extraData);
     bool keepSearching = true;
-    EntityTreeElementPointer entityTreeElementPointer = std::static_pointer_cast<EntityTreeElement>(element);
-    EntityItemID entityID = entityTreeElementPointer->evalRayIntersection(args->origin, args->direction, args->viewFrustumPos,
+    EntityItemID entityID = EntityTreeElement::evalRayIntersection(element.entities, args->origin, args->direction, args->viewFrustumPos,
         args->element, args->distance, args->face, args->surfaceNormal, args->entityIdsToInclude,
         args->entityIdsToDiscard, args->searchFilter, args->extraInfo);
     if (!entityID.isNull()) {
@@ -828,18 +861,17 @@ bool evalRayIntersectionOp(const OctreeElementPointer& element, void* extraData)
     return keepSearching;
 }
 
-float evalRayIntersectionSortingOp(const OctreeElementPointer& element, void* extraData) {
+float evalRayIntersectionSortingOp(const EntityTreeSnapshot::Element& element, void* extraData) {
     RayArgs* args = static_cast<RayArgs*>(extraData);
-    EntityTreeElementPointer entityTreeElementPointer = std::static_pointer_cast<EntityTreeElement>(element);
     float distance = FLT_MAX;
     // If origin is inside the cube, always check this element first
-    if (entityTreeElementPointer->getAACube().contains(args->origin)) {
+    if (element.cube.contains(args->origin)) {
         distance = 0.0f;
     } else {
         float boundDistance = FLT_MAX;
         BoxFace face;
         glm::vec3 surfaceNormal;
-        if (entityTreeElementPointer->getAACube().findRayIntersection(args->origin, args->direction, args->invDirection,
+        if (element.cube.findRayIntersection(args->origin, args->direction, args->invDirection,
             boundDistance, face, surfaceNormal)) {
             // Don't add this cell if it's already farther than our best distance so far
             if (boundDistance < args->distance) {
@@ -864,10 +896,8 @@ EntityItemID EntityTree::evalRayIntersection(const glm::vec3& origin, const glm:
             searchFilter, element, distance, face, surfaceNormal, extraInfo, EntityItemID() };
     distance = FLT_MAX;
 
-    bool requireLock = lockType == Octree::Lock;
-    bool lockResult = withReadLock([&]{
-        recurseTreeWithOperationSorted(evalRayIntersectionOp, evalRayIntersectionSortingOp, &args);
-    }, requireLock);
+    bool lockResult;
+    getSnapshot(lockType, &lockResult)->recurseWithOperationSorted(evalRayIntersectionOp, evalRayIntersectionSortingOp, &args);
 
     if (accurateResult) {
         *accurateResult = lockResult; // if user asked to accuracy or result, let them know this is accurate
@@ -896,11 +926,10 @@ public:
     EntityItemID entityID;
 };
 
-bool evalParabolaIntersectionOp(const OctreeElementPointer& element, void* extraData) {
+bool evalParabolaIntersectionOp(const EntityTreeSnapshot::Element& element, void* extraData) {
     ParabolaArgs* args = static_cast<ParabolaArgs*>(extraData);
     bool keepSearching = true;
-    EntityTreeElementPointer entityTreeElementPointer = std::static_pointer_cast<EntityTreeElement>(element);
-    EntityItemID entityID = entityTreeElementPointer->evalParabolaIntersection(args->origin, args->velocity, args->acceleration, args->viewFrustumPos,
+    EntityItemID entityID = EntityTreeElement::evalParabolaIntersection(element.entities, args->origin, args->velocity, args->acceleration, args->viewFrustumPos,
         args->element, args->parabolicDistance, args->face, args->surfaceNormal, args->entityIdsToInclude,
         args->entityIdsToDiscard, args->searchFilter, args->extraInfo);
     if (!entityID.isNull()) {
@@ -911,18 +940,17 @@ bool evalParabolaIntersectionOp(const OctreeElementPointer& element, void* extra
     return keepSearching;
 }
 
-float evalParabolaIntersectionSortingOp(const OctreeElementPointer& element, void* extraData) {
+float evalParabolaIntersectionSortingOp(const EntityTreeSnapshot::Element& element, void* extraData) {
     ParabolaArgs* args = static_cast<ParabolaArgs*>(extraData);
-    EntityTreeElementPointer entityTreeElementPointer = std::static_pointer_cast<EntityTreeElement>(element);
     float distance = FLT_MAX;
     // If origin is inside the cube, always check this element first
-    if (entityTreeElementPointer->getAACube().contains(args->origin)) {
+    if (element.cube.contains(args->origin)) {
         distance = 0.0f;
     } else {
         float boundDistance = FLT_MAX;
         BoxFace face;
         glm::vec3 surfaceNormal;
-        if (entityTreeElementPointer->getAACube().findParabolaIntersection(args->origin, args->velocity, args->acceleration,
+        if (element.cube.findParabolaIntersection(args->origin, args->velocity, args->acceleration,
             boundDistance, face, surfaceNormal)) {
             // Don't add this cell if it's already farther than our best distance so far
             if (boundDistance < args->parabolicDistance) {
@@ -944,10 +972,8 @@ EntityItemID EntityTree::evalParabolaIntersection(const PickParabola& parabola,
     parabolicDistance = FLT_MAX;
     distance = FLT_MAX;
 
-    bool requireLock = lockType == Octree::Lock;
-    bool lockResult = withReadLock([&] {
-        recurseTreeWithOperationSorted(evalParabolaIntersectionOp, evalParabolaIntersectionSortingOp, &args);
-    }, requireLock);
+    bool lockResult;
+    getSnapshot(lockType, &lockResult)->recurseWithOperationSorted(evalParabolaIntersectionOp, evalParabolaIntersectionSortingOp, &args);
 
     if (accurateResult) {
         *accurateResult = lockResult; // if user asked to accuracy or result, let them know this is accurate
@@ -974,17 +1000,15 @@ public:
 };
 
 
-bool evalClosestEntityOperation(const OctreeElementPointer& element, void* extraData) {
+bool evalClosestEntityOperation(const EntityTreeSnapshot::Element& element, void* extraData) {
     FindClosestEntityArgs* args = static_cast<FindClosestEntityArgs*>(extraData);
-    EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
-
     glm::vec3 penetration;
-    bool sphereIntersection = entityTreeElement->getAACube().findSpherePenetration(args->position, args->targetRadius, penetration);
+    bool sphereIntersection = element.cube.findSpherePenetration(args->position, args->targetRadius, penetration);
 
     // If this entityTreeElement contains the point, then search it...
     if (sphereIntersection) {
         float closestDistanceSquared = FLT_MAX;
-        QUuid thisClosestEntity = entityTreeElement->evalClosetEntity(args->position, args->searchFilter, closestDistanceSquared);
+        QUuid thisClosestEntity = EntityTreeElement::evalClosetEntity(element.entities, args->position, args->searchFilter, closestDistanceSquared);
 
         // we may have gotten NULL back, meaning no entity was available
         if (!thisClosestEntity.isNull()) {
@@ -1008,10 +1032,10 @@ bool evalClosestEntityOperation(const OctreeElementPointer& element, void* extra
     return false;
 }
 
-// NOTE: assumes caller has handled locking
+// NOTE: searches a snapshot, so the caller needn't lock the tree
 QUuid EntityTree::evalClosestEntity(const glm::vec3& position, float targetRadius, PickFilter searchFilter) {
     FindClosestEntityArgs args = { position, targetRadius, searchFilter, QUuid(), FLT_MAX };
-    recurseTreeWithOperation(evalClosestEntityOperation, &args);
+    getSnapshot()->recurseWithOperation(evalClosestEntityOperation, &args);
     return args.closestEntity;
 }
 
@@ -1026,15 +1050,14 @@ public:
     QVector<QUuid> entities;
 };
 
-bool evalInSphereOperation(const OctreeElementPointer& element, void* extraData) {
+bool evalInSphereOperation(const EntityTreeSnapshot::Element& element, void* extraData) {
     FindEntitiesInSphereArgs* args = static_cast<FindEntitiesInSphereArgs*>(extraData);
     glm::vec3 penetration;
-    bool sphereIntersection = element->getAACube().findSpherePenetration(args->position, args->targetRadius, penetration);
+    bool sphereIntersection = element.cube.findSpherePenetration(args->position, args->targetRadius, penetration);
 
     // If this element contains the point, then search it...
     if (sphereIntersection) {
-        EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
-        entityTreeElement->evalEntitiesInSphere(args->position, args->targetRadius, args->searchFilter, args->entities);
+        EntityTreeElement::evalEntitiesInSphere(element.entities, args->position, args->targetRadius, args->searchFilter, args->entities);
         return true; // keep searching in case children have closer entities
     }
 
@@ -1042,10 +1065,10 @@ bool evalInSphereOperation(const OctreeElementPointer& element, void* extraData)
     return false;
 }
 
-// NOTE: assumes caller has handled locking
+// NOTE: searches a snapshot, so the caller needn't lock the tree
 void EntityTree::evalEntitiesInSphere(const glm::vec3& center, float radius, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
     FindEntitiesInSphereArgs args = { center, radius, searchFilter, QVector<QUuid>() };
-    recurseTreeWithOperation(evalInSphereOperation, &args);
+    getSnapshot()->recurseWithOperation(evalInSphereOperation, &args);
     foundEntities.swap(args.entities);
 }
 
@@ -1061,15 +1084,14 @@ public:
     QVector<QUuid> entities;
 };
 
-bool evalInSphereWithTypeOperation(const OctreeElementPointer& element, void* extraData) {
+bool evalInSphereWithTypeOperation(const EntityTreeSnapshot::Element& element, void* extraData) {
     FindEntitiesInSphereWithTypeArgs* args = static_cast<FindEntitiesInSphereWithTypeArgs*>(extraData);
     glm::vec3 penetration;
-    bool sphereIntersection = element->getAACube().findSpherePenetration(args->position, args->targetRadius, penetration);
+    bool sphereIntersection = element.cube.findSpherePenetration(args->position, args->targetRadius, penetration);
 
     // If this element contains the point, then search it...
     if (sphereIntersection) {
-        EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
-        entityTreeElement->evalEntitiesInSphereWithType(args->position, args->targetRadius, args->type, args->searchFilter, args->entities);
+        EntityTreeElement::evalEntitiesInSphereWithType(element.entities, args->position, args->targetRadius, args->type, args->searchFilter, args->entities);
         return true; // keep searching in case children have closer entities
     }
 
@@ -1077,10 +1099,41 @@ bool evalInSphereWithTypeOperation(const OctreeElementPointer& element, void* ex
     return false;
 }
 
-// NOTE: assumes caller has handled locking
+// An indexed query looks up each entity the index found, which is cheaper than visiting every element the sphere touches
+// unless they're a large part of the tree.
+const int MAX_INDEXED_QUERY_FRACTION = 4;
+
+bool EntityTree::shouldQueryIndex(int numIndexed) const {
+    return numIndexed * MAX_INDEXED_QUERY_FRACTION <= _entityIndex.size();
+}
+
+// NOTE: looks the entities up in the entity map, so the caller needn't lock the tree. The entities' elements are only
+// safe to read under the tree lock, so deleted entities are filtered out by checkFilterSettings() instead.
+void EntityTree::evalIndexedEntitiesInSphere(const QVector<EntityItemID>& entityIDs, const glm::vec3& center, float radius,
+                                             PickFilter searchFilter, QVector<QUuid>& foundEntities) {
+    QVector<QUuid> entities;
+    {
+        QReadLocker locker(&_entityMapLock);
+        for (const auto& entityID : entityIDs) {
+            EntityItemPointer entity = _entityMap.value(entityID);
+            if (entity && EntityTreeElement::checkFilterSettings(entity, searchFilter) &&
+                EntityTreeElement::isEntityInSphere(entity, center, radius)) {
+                entities.push_back(entityID);
+            }
+        }
+    }
+    foundEntities.swap(entities);
+}
+
+// NOTE: searches a snapshot, so the caller needn't lock the tree
 void EntityTree::evalEntitiesInSphereWithType(const glm::vec3& center, float radius, EntityTypes::EntityType type, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
+    if (shouldQueryIndex(_entityIndex.countByType(type))) {
+        evalIndexedEntitiesInSphere(_entityIndex.findByType(type), center, radius, searchFilter, foundEntities);
+        return;
+    }
+
     FindEntitiesInSphereWithTypeArgs args = { center, radius, type, searchFilter, QVector<QUuid>() };
-    recurseTreeWithOperation(evalInSphereWithTypeOperation, &args);
+    getSnapshot()->recurseWithOperation(evalInSphereWithTypeOperation, &args);
     foundEntities.swap(args.entities);
 }
 
@@ -1097,15 +1150,14 @@ public:
     QVector<QUuid> entities;
 };
 
-bool evalInSphereWithNameOperation(const OctreeElementPointer& element, void* extraData) {
+bool evalInSphereWithNameOperation(const EntityTreeSnapshot::Element& element, void* extraData) {
     FindEntitiesInSphereWithNameArgs* args = static_cast<FindEntitiesInSphereWithNameArgs*>(extraData);
     glm::vec3 penetration;
-    bool sphereIntersection = element->getAACube().findSpherePenetration(args->position, args->targetRadius, penetration);
+    bool sphereIntersection = element.cube.findSpherePenetration(args->position, args->targetRadius, penetration);
 
     // If this element contains the point, then search it...
     if (sphereIntersection) {
-        EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
-        entityTreeElement->evalEntitiesInSphereWithName(args->position, args->targetRadius, args->name, args->caseSensitive, args->searchFilter, args->entities);
+        EntityTreeElement::evalEntitiesInSphereWithName(element.entities, args->position, args->targetRadius, args->name, args->caseSensitive, args->searchFilter, args->entities);
         return true; // keep searching in case children have closer entities
     }
 
@@ -1113,10 +1165,19 @@ bool evalInSphereWithNameOperation(const OctreeElementPointer& element, void* ex
     return false;
 }
 
-// NOTE: assumes caller has handled locking
+// NOTE: searches a snapshot, so the caller needn't lock the tree
 void EntityTree::evalEntitiesInSphereWithName(const glm::vec3& center, float radius, const QString& name, bool caseSensitive, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
+    // entities without a name aren't indexed
+    if (!name.isEmpty()) {
+        QVector<EntityItemID> entityIDs = _entityIndex.findByName(name, caseSensitive);
+        if (shouldQueryIndex(entityIDs.size())) {
+            evalIndexedEntitiesInSphere(entityIDs, center, radius, searchFilter, foundEntities);
+            return;
+        }
+    }
+
     FindEntitiesInSphereWithNameArgs args = { center, radius, name, caseSensitive, searchFilter, QVector<QUuid>() };
-    recurseTreeWithOperation(evalInSphereWithNameOperation, &args);
+    getSnapshot()->recurseWithOperation(evalInSphereWithNameOperation, &args);
     foundEntities.swap(args.entities);
 }
 
@@ -1130,20 +1191,19 @@ public:
     QVector<QUuid> entities;
 };
 
-bool findInCubeOperation(const OctreeElementPointer& element, void* extraData) {
+bool findInCubeOperation(const EntityTreeSnapshot::Element& element, void* extraData) {
     FindEntitiesInCubeArgs* args = static_cast<FindEntitiesInCubeArgs*>(extraData);
-    if (element->getAACube().touches(args->cube)) {
-        EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
-        entityTreeElement->evalEntitiesInCube(args->cube, args->searchFilter, args->entities);
+    if (element.cube.touches(args->cube)) {
+        EntityTreeElement::evalEntitiesInCube(element.entities, args->cube, args->searchFilter, args->entities);
         return true;
     }
     return false;
 }
 
-// NOTE: assumes caller has handled locking
+// NOTE: searches a snapshot, so the caller needn't lock the tree
 void EntityTree::evalEntitiesInCube(const AACube& cube, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
     FindEntitiesInCubeArgs args { cube, searchFilter, QVector<QUuid>() };
-    recurseTreeWithOperation(findInCubeOperation, &args);
+    getSnapshot()->recurseWithOperation(findInCubeOperation, &args);
     foundEntities.swap(args.entities);
 }
 
@@ -1157,21 +1217,20 @@ public:
     QVector<QUuid> entities;
 };
 
-bool findInBoxOperation(const OctreeElementPointer& element, void* extraData) {
+bool findInBoxOperation(const EntityTreeSnapshot::Element& element, void* extraData) {
     FindEntitiesInBoxArgs* args = static_cast<FindEntitiesInBoxArgs*>(extraData);
-    if (element->getAACube().touches(args->box)) {
-        EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
-        entityTreeElement->evalEntitiesInBox(args->box, args->searchFilter, args->entities);
+    if (element.cube.touches(args->box)) {
+        EntityTreeElement::evalEntitiesInBox(element.entities, args->box, args->searchFilter, args->entities);
         return true;
     }
     return false;
 }
 
-// NOTE: assumes caller has handled locking
+// NOTE: searches a snapshot, so the caller needn't lock the tree
 void EntityTree::evalEntitiesInBox(const AABox& box, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
     FindEntitiesInBoxArgs args { box, searchFilter, QVector<QUuid>() };
     // NOTE: This should use recursion, since this is a spatial operation
-    recurseTreeWithOperation(findInBoxOperation, &args);
+    getSnapshot()->recurseWithOperation(findInBoxOperation, &args);
     // swap the two lists of entity pointers instead of copy
     foundEntities.swap(args.entities);
 }
@@ -1186,25 +1245,66 @@ public:
     QVector<QUuid> entities;
 };
 
-bool findInFrustumOperation(const OctreeElementPointer& element, void* extraData) {
+bool findInFrustumOperation(const EntityTreeSnapshot::Element& element, void* extraData) {
     FindEntitiesInFrustumArgs* args = static_cast<FindEntitiesInFrustumArgs*>(extraData);
-    if (element->isInView(args->frustum)) {
-        EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
-        entityTreeElement->evalEntitiesInFrustum(args->frustum, args->searchFilter, args->entities);
+    if (args->frustum.calculateCubeKeyholeIntersection(element.cube) != ViewFrustum::OUTSIDE) {
+        EntityTreeElement::evalEntitiesInFrustum(element.entities, args->frustum, args->searchFilter, args->entities);
         return true;
     }
     return false;
 }
 
-// NOTE: assumes caller has handled locking
+// NOTE: searches a snapshot, so the caller needn't lock the tree
 void EntityTree::evalEntitiesInFrustum(const ViewFrustum& frustum, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
     FindEntitiesInFrustumArgs args = { frustum, searchFilter, QVector<QUuid>() };
     // NOTE: This should use recursion, since this is a spatial operation
-    recurseTreeWithOperation(findInFrustumOperation, &args);
+    getSnapshot()->recurseWithOperation(findInFrustumOperation, &args);
     // swap the two lists of entity pointers instead of copy
     foundEntities.swap(args.entities);
 }
 
+EntityTreeSnapshotPointer EntityTree::getSnapshot(Octree::lockType lockType, bool* accurateResult) {
+    EntityTreeSnapshotPointer snapshot = std::atomic_load(&_snapshot);
+    bool isCurrent = snapshot && snapshot->getVersion() == _elementsVersion;
+    if (!isCurrent) {
+        // NOTE: lock the tree first, then the _snapshotLock, so that no reader waits for the tree holding it
+        isCurrent = withReadLock([&] {
+            std::lock_guard<std::mutex> lock(_snapshotLock);
+            // another reader may have taken it while we waited
+            snapshot = std::atomic_load(&_snapshot);
+            uint64_t version = _elementsVersion;
+            if (!snapshot || snapshot->getVersion() != version) {
+                PerformanceTimer perfTimer("takeSnapshot");
+                EntityTreeElementPointer root = std::static_pointer_cast<EntityTreeElement>(_rootElement);
+                // the elements above each that changed must be copied too, to point at its new copy
+                for (const AACube& cube : _changedSnapshotElements) {
+                    EntityTreeElementPointer element = root;
+                    while (element && element->getScale() > cube.getScale()) {
+                        element->markSnapshotElementChanged();
+                        int childIndex = element->getMyChildContainingPoint(cube.calcCenter());
+                        element = childIndex != OctreeElement::CHILD_UNKNOWN ? element->getChildAtIndex(childIndex) : nullptr;
+                    }
+                }
+                _changedSnapshotElements.clear();
+                snapshot = std::make_shared<const EntityTreeSnapshot>(root ? root->getSnapshotElement() : nullptr, version);
+                std::atomic_store(&_snapshot, snapshot);
+            }
+        }, lockType == Octree::Lock);
+        if (!snapshot) {
+            snapshot = std::make_shared<const EntityTreeSnapshot>();
+        }
+    }
+    if (accurateResult) {
+        *accurateResult = isCurrent;
+    }
+    return snapshot;
+}
+
+void EntityTree::clearSnapshot() {
+    std::lock_guard<std::mutex> lock(_snapshotLock);
+    std::atomic_store(&_snapshot, EntityTreeSnapshotPointer());
+}
+
 EntityItemPointer EntityTree::findEntityByID(const QUuid& id) const {
     EntityItemID entityID(id);
     return findEntityByEntityItemID(entityID);
@@ -2560,11 +2660,13 @@ void EntityTree::addEntityMapEntry(EntityItemPointer entity) {
         return;
     }
     _entityMap.insert(id, entity);
+    _entityIndex.add(entity);
 }
 
 void EntityTree::clearEntityMapEntry(const EntityItemID& id) {
     QWriteLocker locker(&_entityMapLock);
     _entityMap.remove(id);
+    _entityIndex.remove(id);
 }
 
 void EntityTree::debugDumpMap() {
@@ -2697,9 +2799,7 @@ QVector<EntityItemID> EntityTree::sendEntities(EntityEditPacketSender* packetSen
     QHash<EntityItemID, EntityItemID> map;
 
     args.map = &map;
-    withReadLock([&] {
-        recurseTreeWithOperation(sendEntitiesOperation, &args);
-    });
+    getSnapshot()->recurseWithOperation(sendEntitiesOperation, &args);
 
     // The values from map are used as the list of successfully "sent" entities.  If some didn't actually make it,
     // pull them out.  Bogus entries could happen if part of the imported data makes some reference to an entity
@@ -2793,9 +2893,8 @@ QString replaceEntityIDsInJSON(const QString& json, std::function<EntityItemID(E
     return document.toJson();
 }
 
-bool EntityTree::sendEntitiesOperation(const OctreeElementPointer& element, void* extraData) {
+bool EntityTree::sendEntitiesOperation(const EntityTreeSnapshot::Element& element, void* extraData) {
     SendEntitiesOperationArgs* args = static_cast<SendEntitiesOperationArgs*>(extraData);
-    EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
 
     auto getMapped = [&args](EntityItemID oldID) {
         if (oldID.isNull()) {
@@ -2817,7 +2916,7 @@ bool EntityTree::sendEntitiesOperation(const OctreeElementPointer& element, void
         return iter.value();
     };
 
-    entityTreeElement->forEachEntity([&args, &getMapped, &element](EntityItemPointer item) {
+    std::for_each(element.entities.begin(), element.entities.end(), [&args, &getMapped](EntityItemPointer item) {
         EntityItemID oldID = item->getEntityItemID();
         EntityItemID newID = getMapped(oldID);
         EntityItemProperties properties = item->getProperties();
@@ -2919,9 +3018,6 @@ bool EntityTree::sendEntitiesOperation(const OctreeElementPointer& element, void
         // set creation time to "now" for imported entities
         properties.setCreated(usecTimestampNow());
 
-        EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
-        EntityTreePointer tree = entityTreeElement->getTree();
-
         // also update the local tree instantly (note: this is not our tree, but an alternate tree)
         if (args->otherTree) {
             args->otherTree->withWriteLock([&] {
@@ -3068,10 +3164,7 @@ void convertGrabUserDataToProperties(EntityItemProperties& properties) {
 }
 
 
-bool EntityTree::readFromMap(QVariantMap& map, const bool isImport) {
-    // These are needed to deal with older content (before adding inheritance modes)
-    int contentVersion = map["Version"].toInt();
-
+void EntityTree::readHeaderFromMap(const QVariantMap& map) {
     if (map.contains("Id")) {
         _persistID = map["Id"].toUuid();
     }
@@ -3089,6 +3182,202 @@ bool EntityTree::readFromMap(QVariantMap& map, const bool isImport) {
             _namedPaths[namedPathName] = namedPathViewPoint;
         }
     }
+}
+
+void EntityTree::entityPropertiesFromMap(QVariantMap& entityMap, int contentVersion, QScriptEngine& scriptEngine,
+                                         const QUuid& sessionID, EntityItemID& entityItemID,
+                                         EntityItemProperties& properties) const {
+    // handle parentJointName for wearables
+    if (_myAvatar && entityMap.contains("parentJointName") && entityMap.contains("parentID") &&
+        QUuid(entityMap["parentID"].toString()) == AVATAR_SELF_ID) {
+
+        entityMap["parentJointIndex"] = _myAvatar->getJointIndex(entityMap["parentJointName"].toString());
+
+        qCDebug(entities) << "Found parentJointName " << entityMap["parentJointName"].toString() <<
+            " mapped it to parentJointIndex " << entityMap["parentJointIndex"].toInt();
+    }
+
+    QScriptValue entityScriptValue = variantMapToScriptValue(entityMap, scriptEngine);
+    EntityItemPropertiesFromScriptValueIgnoreReadOnly(entityScriptValue, properties);
+
+    if (entityMap.contains("id")) {
+        entityItemID = EntityItemID(QUuid(entityMap["id"].toString()));
+    } else {
+        entityItemID = EntityItemID(QUuid::createUuid());
+    }
+
+    // Convert old clientOnly bool to new entityHostType enum
+    // (must happen before setOwningAvatarID below)
+    if (contentVersion < (int)EntityVersion::EntityHostTypes) {
+        if (entityMap.contains("clientOnly")) {
+            properties.setEntityHostType(entityMap["clientOnly"].toBool() ? entity::HostType::AVATAR : entity::HostType::DOMAIN);
+        }
+    }
+
+    if (properties.getEntityHostType() == entity::HostType::AVATAR) {
+        properties.setOwningAvatarID(sessionID);
+    }
+
+    // Fix for older content not containing mode fields in the zones
+    if (contentVersion < (int)EntityVersion::ZoneLightInheritModes && (properties.getType() == EntityTypes::EntityType::Zone)) {
+        // The legacy version had no keylight mode - this is set to on
+        properties.setKeyLightMode(COMPONENT_MODE_ENABLED);
+
+        // The ambient URL has been moved from "keyLight" to "ambientLight"
+        if (entityMap.contains("keyLight")) {
+            QVariantMap keyLightObject = entityMap["keyLight"].toMap();
+            properties.getAmbientLight().setAmbientURL(keyLightObject["ambientURL"].toString());
+        }
+
+        // Copy the skybox URL if the ambient URL is empty, as this is the legacy behaviour
+        // Use skybox value only if it is not empty, else set ambientMode to inherit (to use default URL)
+        properties.setAmbientLightMode(COMPONENT_MODE_ENABLED);
+        if (properties.getAmbientLight().getAmbientURL() == "") {
+            if (properties.getSkybox().getURL() != "") {
+                properties.getAmbientLight().setAmbientURL(properties.getSkybox().getURL());
+            } else {
+                properties.setAmbientLightMode(COMPONENT_MODE_INHERIT);
+            }
+        }
+
+        // The background should be enabled if the mode is skybox
+        // Note that if the values are default then they are not stored in the JSON file
+        if (entityMap.contains("backgroundMode") && (entityMap["backgroundMode"].toString() == "skybox")) {
+            properties.setSkyboxMode(COMPONENT_MODE_ENABLED);
+        } else {
+            properties.setSkyboxMode(COMPONENT_MODE_INHERIT);
+        }
+    }
+
+    // Convert old materials so that they use materialData instead of userData
+    if (contentVersion < (int)EntityVersion::MaterialData && properties.getType() == EntityTypes::EntityType::Material) {
+        if (properties.getMaterialURL().startsWith("userData")) {
+            QString materialURL = properties.getMaterialURL();
+            properties.setMaterialURL(materialURL.replace("userData", "materialData"));
+
+            QJsonObject userData = QJsonDocument::fromJson(properties.getUserData().toUtf8()).object();
+            QJsonObject materialData;
+            QJsonValue materialVersion = userData["materialVersion"];
+            if (!materialVersion.isNull()) {
+                materialData.insert("materialVersion", materialVersion);
+                userData.remove("materialVersion");
+            }
+            QJsonValue materials = userData["materials"];
+            if (!materials.isNull()) {
+                materialData.insert("materials", materials);
+                userData.remove("materials");
+            }
+
+            properties.setMaterialData(QJsonDocument(materialData).toJson());
+            properties.setUserData(QJsonDocument(userData).toJson());
+        }
+    }
+
+    // Convert old cloneable entities so they use cloneableData instead of userData
+    if (contentVersion < (int)EntityVersion::CloneableData) {
+        QJsonObject userData = QJsonDocument::fromJson(properties.getUserData().toUtf8()).object();
+        QJsonObject grabbableKey = userData["grabbableKey"].toObject();
+        QJsonValue cloneable = grabbableKey["cloneable"];
+        if (cloneable.isBool() && cloneable.toBool()) {
+            QJsonValue cloneLifetime = grabbableKey["cloneLifetime"];
+            QJsonValue cloneLimit = grabbableKey["cloneLimit"];
+            QJsonValue cloneDynamic = grabbableKey["cloneDynamic"];
+            QJsonValue cloneAvatarEntity = grabbableKey["cloneAvatarEntity"];
+
+            // This is cloneable, we need to convert the properties
+            properties.setCloneable(true);
+            properties.setCloneLifetime(cloneLifetime.toInt());
+            properties.setCloneLimit(cloneLimit.toInt());
+            properties.setCloneDynamic(cloneDynamic.toBool());
+            properties.setCloneAvatarEntity(cloneAvatarEntity.toBool());
+        }
+    }
+
+    // convert old grab-related userData to new grab properties
+    if (contentVersion < (int)EntityVersion::GrabProperties) {
+        convertGrabUserDataToProperties(properties);
+    }
+
+    // Zero out the spread values that were fixed in version ParticleEntityFix so they behave the same as before
+    if (contentVersion < (int)EntityVersion::ParticleEntityFix) {
+        properties.setRadiusSpread(0.0f);
+        properties.setAlphaSpread(0.0f);
+        properties.setColorSpread({0, 0, 0});
+    }
+
+    if (contentVersion < (int)EntityVersion::FixPropertiesFromCleanup) {
+        if (entityMap.contains("created")) {
+            quint64 created = QDateTime::fromString(entityMap["created"].toString().trimmed(), Qt::ISODate).toMSecsSinceEpoch() * 1000;
+            properties.setCreated(created);
+        }
+    }
+
+    // Before, billboarded entities ignored rotation.  Now, they use it to determine which axis is facing you.
+    if (contentVersion < (int)EntityVersion::AllBillboardMode) {
+        if (properties.getBillboardMode() != BillboardMode::NONE) {
+            properties.setRotation(glm::quat());
+        }
+    }
+}
+
+EntityItemPointer EntityTree::constructLoadedEntity(const EntityItemID& entityItemID, const EntityItemProperties& properties,
+                                                    bool isImport) {
+    EntityItemPointer entity = constructEntity(entityItemID, properties, isImport);
+    if (!entity) {
+        qCDebug(entities) << "adding Entity failed:" << entityItemID << properties.getType();
+    }
+    return entity;
+}
+
+bool EntityTree::addLoadedEntities(const std::vector<EntityItemPointer>& entities, QMap<QUuid, QVector<QUuid>>& cloneIDs) {
+    // store all the entities in the tree in one pass, rather than one pass per entity
+    bool success = true;
+    QSet<EntityItemID> addedIDs;
+    AddEntitiesOperator theOperator(getThisPointer());
+    for (const auto& entity : entities) {
+        const EntityItemID& entityItemID = entity->getEntityItemID();
+        if (addedIDs.contains(entityItemID)) {
+            qCWarning(entities) << "EntityTree::addLoadedEntities() skipping duplicate entityID=" << entityItemID;
+            success = false;
+            continue;
+        }
+        addedIDs.insert(entityItemID);
+        theOperator.addEntityToAddList(entity);
+    }
+    recurseTreeWithOperator(&theOperator);
+
+    for (const auto& entity : entities) {
+        if (!addedIDs.remove(entity->getEntityItemID())) {
+            continue; // a duplicate
+        }
+        postAddEntity(entity);
+
+        const QUuid& cloneOriginID = entity->getCloneOriginID();
+        if (!cloneOriginID.isNull()) {
+            cloneIDs[cloneOriginID].push_back(entity->getEntityItemID());
+        }
+    }
+    return success;
+}
+
+void EntityTree::finishLoadingEntities(const QMap<QUuid, QVector<QUuid>>& cloneIDs) {
+    // hook up all the children loaded before their parents in one pass, rather than one pass per entity added
+    _deferParentFixups = false;
+    fixupNeedsParentFixups();
+
+    for (const auto& entityID : cloneIDs.keys()) {
+        auto entity = findEntityByID(entityID);
+        if (entity) {
+            entity->setCloneIDs(cloneIDs.value(entityID));
+        }
+    }
+}
+
+bool EntityTree::readFromMap(QVariantMap& map, const bool isImport) {
+    // These are needed to deal with older content (before adding inheritance modes)
+    int contentVersion = map["Version"].toInt();
+
+    readHeaderFromMap(map);
 
     // map will have a top-level list keyed as "Entities".  This will be extracted
     // and iterated over.  Each member of this list is converted to a QVariantMap, then
@@ -3102,171 +3391,272 @@ bool EntityTree::readFromMap(QVariantMap& map, const bool isImport) {
         return false;
     }
 
+    auto nodeList = DependencyManager::get<NodeList>();
+    const QUuid sessionID = nodeList ? nodeList->getSessionUUID() : QUuid();
     QMap<QUuid, QVector<QUuid>> cloneIDs;
 
     bool success = true;
+    std::vector<EntityItemPointer> entities;
+    entities.reserve(entitiesQList.length());
     foreach (QVariant entityVariant, entitiesQList) {
         // QVariantMap --> QScriptValue --> EntityItemProperties --> Entity
         QVariantMap entityMap = entityVariant.toMap();
-
-        // handle parentJointName for wearables
-        if (_myAvatar && entityMap.contains("parentJointName") && entityMap.contains("parentID") &&
-            QUuid(entityMap["parentID"].toString()) == AVATAR_SELF_ID) {
-
-            entityMap["parentJointIndex"] = _myAvatar->getJointIndex(entityMap["parentJointName"].toString());
-
-            qCDebug(entities) << "Found parentJointName " << entityMap["parentJointName"].toString() <<
-                " mapped it to parentJointIndex " << entityMap["parentJointIndex"].toInt();
-        }
-
-        QScriptValue entityScriptValue = variantMapToScriptValue(entityMap, scriptEngine);
+        EntityItemID entityItemID;
         EntityItemProperties properties;
-        EntityItemPropertiesFromScriptValueIgnoreReadOnly(entityScriptValue, properties);
+        entityPropertiesFromMap(entityMap, contentVersion, scriptEngine, sessionID, entityItemID, properties);
 
-        EntityItemID entityItemID;
-        if (entityMap.contains("id")) {
-            entityItemID = EntityItemID(QUuid(entityMap["id"].toString()));
+        EntityItemPointer entity = constructLoadedEntity(entityItemID, properties, isImport);
+        if (entity) {
+            entities.push_back(entity);
         } else {
-            entityItemID = EntityItemID(QUuid::createUuid());
+            success = false;
         }
+    }
 
-        // Convert old clientOnly bool to new entityHostType enum
-        // (must happen before setOwningAvatarID below)
-        if (contentVersion < (int)EntityVersion::EntityHostTypes) {
-            if (entityMap.contains("clientOnly")) {
-                properties.setEntityHostType(entityMap["clientOnly"].toBool() ? entity::HostType::AVATAR : entity::HostType::DOMAIN);
-            }
-        }
+    _deferParentFixups = true;
+    if (!addLoadedEntities(entities, cloneIDs)) {
+        success = false;
+    }
+    finishLoadingEntities(cloneIDs);
 
-        if (properties.getEntityHostType() == entity::HostType::AVATAR) {
-            auto nodeList = DependencyManager::get<NodeList>();
-            const QUuid myNodeID = nodeList->getSessionUUID();
-            properties.setOwningAvatarID(myNodeID);
-        }
+    return success;
+}
 
-        // Fix for older content not containing mode fields in the zones
-        if (contentVersion < (int)EntityVersion::ZoneLightInheritModes && (properties.getType() == EntityTypes::EntityType::Zone)) {
-            // The legacy version had no keylight mode - this is set to on
-            properties.setKeyLightMode(COMPONENT_MODE_ENABLED);
+bool EntityTree::readFromJSON(const QByteArray& jsonData, const QString& marketplaceID, bool isImport,
+                              const QUrl& relativeURL) {
+    if (_myAvatar) {
+        // wearables look up the joints of the avatar, which mustn't happen off its thread
+        return Octree::readFromJSON(jsonData, marketplaceID, isImport, relativeURL);
+    }
 
-            // The ambient URL has been moved from "keyLight" to "ambientLight"
-            if (entityMap.contains("keyLight")) {
-                QVariantMap keyLightObject = entityMap["keyLight"].toMap();
-                properties.getAmbientLight().setAmbientURL(keyLightObject["ambientURL"].toString());
-            }
+    quint64 startTime = usecTimestampNow();
 
-            // Copy the skybox URL if the ambient URL is empty, as this is the legacy behaviour
-            // Use skybox value only if it is not empty, else set ambientMode to inherit (to use default URL)
-            properties.setAmbientLightMode(COMPONENT_MODE_ENABLED);
-            if (properties.getAmbientLight().getAmbientURL() == "") {
-                if (properties.getSkybox().getURL() != "") {
-                    properties.getAmbientLight().setAmbientURL(properties.getSkybox().getURL());
-                } else {
-                    properties.setAmbientLightMode(COMPONENT_MODE_INHERIT);
-                }
-            }
+    // find the text of each entity, which is only converted once the content version that follows it is known
+    std::vector<QByteArray> entityJSONs;
+    QVariantMap map;
+    OctreeEntitiesFileParser octreeParser;
+    octreeParser.setEntitiesString(jsonData);
+    octreeParser.setRelativeURL(relativeURL);
+    if (!octreeParser.parseEntities(map, [&](const QByteArray& entityJSON) { entityJSONs.push_back(entityJSON); })) {
+        qCritical() << "Can't parse Entities JSON: " << octreeParser.getErrorString().c_str();
+        return false;
+    }
 
-            // The background should be enabled if the mode is skybox
-            // Note that if the values are default then they are not stored in the JSON file
-            if (entityMap.contains("backgroundMode") && (entityMap["backgroundMode"].toString() == "skybox")) {
-                properties.setSkyboxMode(COMPONENT_MODE_ENABLED);
-            } else {
-                properties.setSkyboxMode(COMPONENT_MODE_INHERIT);
-            }
-        }
+    int contentVersion = map["Version"].toInt();
+    readHeaderFromMap(map);
 
-        // Convert old materials so that they use materialData instead of userData
-        if (contentVersion < (int)EntityVersion::MaterialData && properties.getType() == EntityTypes::EntityType::Material) {
-            if (properties.getMaterialURL().startsWith("userData")) {
-                QString materialURL = properties.getMaterialURL();
-                properties.setMaterialURL(materialURL.replace("userData", "materialData"));
+    if (entityJSONs.empty()) {
+        // Empty map or invalidly formed file.
+        return false;
+    }
 
-                QJsonObject userData = QJsonDocument::fromJson(properties.getUserData().toUtf8()).object();
-                QJsonObject materialData;
-                QJsonValue materialVersion = userData["materialVersion"];
-                if (!materialVersion.isNull()) {
-                    materialData.insert("materialVersion", materialVersion);
-                    userData.remove("materialVersion");
-                }
-                QJsonValue materials = userData["materials"];
-                if (!materials.isNull()) {
-                    materialData.insert("materials", materials);
-                    userData.remove("materials");
-                }
+    auto nodeList = DependencyManager::get<NodeList>();
+    const QUuid sessionID = nodeList ? nodeList->getSessionUUID() : QUuid();
 
-                properties.setMaterialData(QJsonDocument(materialData).toJson());
-                properties.setUserData(QJsonDocument(userData).toJson());
+    // JSON --> QVariantMap --> QScriptValue --> EntityItemProperties on worker threads, a batch at a time so that only
+    // two batches of properties are held at once, while this thread adds the previous batch to the tree
+    struct LoadedEntity {
+        EntityItemID id;
+        EntityItemProperties properties;
+        bool isValid { false };
+    };
+    const size_t LOAD_BATCH_SIZE = 4096;
+    const size_t numEntities = entityJSONs.size();
+    const int numWorkers = std::max(1, std::min(QThread::idealThreadCount() - 1,
+                                                (int)((numEntities + LOAD_BATCH_SIZE - 1) / LOAD_BATCH_SIZE)));
+
+    std::vector<LoadedEntity> convertedBatch;
+    std::vector<LoadedEntity> convertingBatch;
+    size_t convertingStart = 0;
+    std::atomic<size_t> nextToConvert { 0 };
+
+    // the workers live for the whole load, each with its own script engine, and are woken for each batch
+    std::mutex workersMutex;
+    std::condition_variable batchStarted;
+    std::condition_variable batchFinished;
+    int batchNumber = 0;
+    int numWorking = 0;
+    bool finishedLoading = false;
+
+    auto convert = [&](QScriptEngine& scriptEngine) {
+        for (size_t i = nextToConvert++; i < convertingBatch.size(); i = nextToConvert++) {
+            QJsonParseError error;
+            QJsonDocument entityDocument = QJsonDocument::fromJson(entityJSONs[convertingStart + i], &error);
+            if (!entityDocument.isObject()) {
+                qCWarning(entities) << "Skipping ill-formed entity" << convertingStart + i << error.errorString();
+                continue;
             }
+            QJsonObject entityObject = entityDocument.object();
+            octreeParser.resolveRelativeURLs(entityObject);
+            if (!marketplaceID.isEmpty()) {
+                entityObject["marketplaceID"] = marketplaceID;
+            }
+
+            LoadedEntity& loaded = convertingBatch[i];
+            QVariantMap entityMap = entityObject.toVariantMap();
+            entityPropertiesFromMap(entityMap, contentVersion, scriptEngine, sessionID, loaded.id, loaded.properties);
+            loaded.isValid = true;
         }
+    };
+    auto work = [&] {
+        QScriptEngine scriptEngine;
+        int lastBatchNumber = 0;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(workersMutex);
+                batchStarted.wait(lock, [&] { return finishedLoading || batchNumber != lastBatchNumber; });
+                if (finishedLoading) {
+                    return;
+                }
+                lastBatchNumber = batchNumber;
+            }
 
-        // Convert old cloneable entities so they use cloneableData instead of userData
-        if (contentVersion < (int)EntityVersion::CloneableData) {
-            QJsonObject userData = QJsonDocument::fromJson(properties.getUserData().toUtf8()).object();
-            QJsonObject grabbableKey = userData["grabbableKey"].toObject();
-            QJsonValue cloneable = grabbableKey["cloneable"];
-            if (cloneable.isBool() && cloneable.toBool()) {
-                QJsonValue cloneLifetime = grabbableKey["cloneLifetime"];
-                QJsonValue cloneLimit = grabbableKey["cloneLimit"];
-                QJsonValue cloneDynamic = grabbableKey["cloneDynamic"];
-                QJsonValue cloneAvatarEntity = grabbableKey["cloneAvatarEntity"];
+            convert(scriptEngine);
 
-                // This is cloneable, we need to convert the properties
-                properties.setCloneable(true);
-                properties.setCloneLifetime(cloneLifetime.toInt());
-                properties.setCloneLimit(cloneLimit.toInt());
-                properties.setCloneDynamic(cloneDynamic.toBool());
-                properties.setCloneAvatarEntity(cloneAvatarEntity.toBool());
+            std::lock_guard<std::mutex> lock(workersMutex);
+            if (--numWorking == 0) {
+                batchFinished.notify_one();
             }
         }
+    };
+    auto startConverting = [&](size_t start) {
+        convertingStart = start;
+        convertingBatch.clear();
+        convertingBatch.resize(std::min(LOAD_BATCH_SIZE, numEntities - start));
+        nextToConvert = 0;
+
+        std::lock_guard<std::mutex> lock(workersMutex);
+        ++batchNumber;
+        numWorking = numWorkers;
+        batchStarted.notify_all();
+    };
+    auto finishConverting = [&] {
+        std::unique_lock<std::mutex> lock(workersMutex);
+        batchFinished.wait(lock, [&] { return numWorking == 0; });
+        convertedBatch.swap(convertingBatch);
+    };
 
-        // convert old grab-related userData to new grab properties
-        if (contentVersion < (int)EntityVersion::GrabProperties) {
-            convertGrabUserDataToProperties(properties);
-        }
+    std::vector<std::thread> workers;
+    for (int i = 0; i < numWorkers; ++i) {
+        workers.emplace_back(work);
+    }
 
-        // Zero out the spread values that were fixed in version ParticleEntityFix so they behave the same as before
-        if (contentVersion < (int)EntityVersion::ParticleEntityFix) {
-            properties.setRadiusSpread(0.0f);
-            properties.setAlphaSpread(0.0f);
-            properties.setColorSpread({0, 0, 0});
-        }
+    QMap<QUuid, QVector<QUuid>> cloneIDs;
+    bool success = true;
+    _deferParentFixups = true;
 
-        if (contentVersion < (int)EntityVersion::FixPropertiesFromCleanup) {
-            if (entityMap.contains("created")) {
-                quint64 created = QDateTime::fromString(entityMap["created"].toString().trimmed(), Qt::ISODate).toMSecsSinceEpoch() * 1000;
-                properties.setCreated(created);
-            }
+    startConverting(0);
+    std::vector<EntityItemPointer> entities;
+    for (size_t batchStart = 0; batchStart < numEntities; batchStart += LOAD_BATCH_SIZE) {
+        finishConverting();
+        if (batchStart + LOAD_BATCH_SIZE < numEntities) {
+            startConverting(batchStart + LOAD_BATCH_SIZE);
         }
 
-        // Before, billboarded entities ignored rotation.  Now, they use it to determine which axis is facing you.
-        if (contentVersion < (int)EntityVersion::AllBillboardMode) {
-            if (properties.getBillboardMode() != BillboardMode::NONE) {
-                properties.setRotation(glm::quat());
+        // entities are constructed one at a time, but stored in the tree a batch at a time
+        entities.clear();
+        for (const auto& loaded : convertedBatch) {
+            EntityItemPointer entity = loaded.isValid ? constructLoadedEntity(loaded.id, loaded.properties, isImport) : nullptr;
+            if (entity) {
+                entities.push_back(entity);
+            } else {
+                success = false;
             }
         }
-
-        EntityItemPointer entity = addEntity(entityItemID, properties, isImport);
-        if (!entity) {
-            qCDebug(entities) << "adding Entity failed:" << entityItemID << properties.getType();
+        if (!addLoadedEntities(entities, cloneIDs)) {
             success = false;
         }
+    }
+    entities.clear();
+    convertedBatch.clear();
+    finishLoadingEntities(cloneIDs);
 
-        if (entity) {
-            const QUuid& cloneOriginID = entity->getCloneOriginID();
-            if (!cloneOriginID.isNull()) {
-                cloneIDs[cloneOriginID].push_back(entity->getEntityItemID());
-            }
-        }
+    {
+        std::lock_guard<std::mutex> lock(workersMutex);
+        finishedLoading = true;
+        batchStarted.notify_all();
+    }
+    for (auto& worker : workers) {
+        worker.join();
     }
 
-    for (const auto& entityID : cloneIDs.keys()) {
-        auto entity = findEntityByID(entityID);
-        if (entity) {
-            entity->setCloneIDs(cloneIDs.value(entityID));
+    _lastReadStats.numItems = (int)numEntities;
+    _lastReadStats.numThreads = numWorkers + 1;
+    _lastReadStats.usecs = usecTimestampNow() - startTime;
+    qCDebug(entities) << "Loaded" << numEntities << "entities in" << _lastReadStats.usecs / USECS_PER_MSEC << "ms using"
+        << numWorkers << "conversion threads";
+
+    return success;
+}
+
+void EntityTree::setTrackPersistChanges(bool trackChanges) {
+    std::lock_guard<std::mutex> lock(_persistChangesLock);
+    _trackPersistChanges = trackChanges;
+    _lostTrackOfPersistChanges = false;
+    _persistChangedIDs.clear();
+    _persistDeletedIDs.clear();
+}
+
+void EntityTree::trackPersistChange(const EntityItemID& entityID, bool deleted) {
+    std::lock_guard<std::mutex> lock(_persistChangesLock);
+    if (!_trackPersistChanges) {
+        return;
+    }
+    if (deleted) {
+        _persistChangedIDs.remove(entityID);
+        _persistDeletedIDs.insert(entityID);
+    } else {
+        _persistChangedIDs.insert(entityID);
+    }
+}
+
+void EntityTree::loseTrackOfPersistChanges() {
+    std::lock_guard<std::mutex> lock(_persistChangesLock);
+    if (_trackPersistChanges) {
+        // the whole tree is going, which is cheaper to persist with a new snapshot than with a record of every delete
+        _lostTrackOfPersistChanges = true;
+        _persistChangedIDs.clear();
+        _persistDeletedIDs.clear();
+    }
+}
+
+bool EntityTree::takePersistChanges(QVariantMap& changes) {
+    QSet<EntityItemID> changedIDs;
+    QSet<EntityItemID> deletedIDs;
+    {
+        std::lock_guard<std::mutex> lock(_persistChangesLock);
+        if (!_trackPersistChanges || _lostTrackOfPersistChanges) {
+            _lostTrackOfPersistChanges = false;
+            _persistChangedIDs.clear();
+            _persistDeletedIDs.clear();
+            return false;
         }
+        changedIDs.swap(_persistChangedIDs);
+        deletedIDs.swap(_persistDeletedIDs);
     }
 
-    return success;
+    // an entity deleted and then re-added under the same ID is journaled as deleted and then added
+    QVariantList deleted;
+    for (const auto& entityID : deletedIDs) {
+        deleted << entityID.toString();
+    }
+
+    // same as the snapshot written by writeToMap(), but only for the entities that changed
+    QVariantList entities;
+    QScriptEngine scriptEngine;
+    withReadLock([&] {
+        for (const auto& entityID : changedIDs) {
+            EntityItemPointer entity = findEntityByEntityItemID(entityID);
+            if (entity) {
+                EntityItemProperties properties = entity->getProperties();
+                entities << EntityItemNonDefaultPropertiesToScriptValue(&scriptEngine, properties).toVariant();
+            }
+        }
+    });
+
+    changes["Deleted"] = deleted;
+    changes["Entities"] = entities;
+    return true;
 }
 
 bool EntityTree::writeToJSON(QString& jsonString, const OctreeElementPointer& element) {
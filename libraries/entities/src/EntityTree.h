@@ -12,6 +12,9 @@
 #ifndef hifi_EntityTree_h
 #define hifi_EntityTree_h
 
+#include <atomic>
+#include <mutex>
+
 #include <QSet>
 #include <QVector>
 
@@ -21,12 +24,15 @@
 #include "AddEntityOperator.h"
 #include "EntityTreeElement.h"
 #include "DeleteEntityOperator.h"
+#include "EntityTreeIndex.h"
+#include "EntityTreeSnapshot.h"
 #include "MovingEntitiesOperator.h"
 
 class EntityTree;
 using EntityTreePointer = std::shared_ptr<EntityTree>;
 
 class EntitySimulation;
+class QScriptEngine;
 
 namespace EntityQueryFilterSymbol {
     static const QString NonDefault = "+";
@@ -119,6 +125,8 @@ public:
     void postAddEntity(EntityItemPointer entityItem);
 
     EntityItemPointer addEntity(const EntityItemID& entityID, const EntityItemProperties& properties, bool isClone = false, const bool isImport = false);
+    // as addEntity(), without storing the entity in the tree
+    EntityItemPointer constructEntity(const EntityItemID& entityID, const EntityItemProperties& properties, bool isClone = false, const bool isImport = false);
 
     // use this method if you only know the entityID
     bool updateEntity(const EntityItemID& entityID, const EntityItemProperties& properties, const SharedNodePointer& senderNode = SharedNodePointer(nullptr));
@@ -171,6 +179,24 @@ public:
     EntityTreeElementPointer getContainingElement(const EntityItemID& entityItemID)  /*const*/;
     void addEntityMapEntry(EntityItemPointer entity);
     void clearEntityMapEntry(const EntityItemID& id);
+    // the entities in the map by name, type, owning avatar and parent ID
+    const EntityTreeIndex& getEntityIndex() const { return _entityIndex; }
+    // called by an entity when its name, owning avatar or parent ID changes
+    void reindexEntity(const EntityItemPointer& entity) { _entityIndex.update(entity); }
+
+    // The entities in the tree's elements, for queries that shouldn't lock the tree. A new snapshot is taken, under the
+    // tree's read lock, by the first query after entities have entered or left an element. It copies only the elements
+    // that changed and those above them, and shares the rest with the last snapshot. With TryLock, a query that can't get
+    // the lock searches the last snapshot instead, and accurateResult is set false.
+    EntityTreeSnapshotPointer getSnapshot(Octree::lockType lockType = Octree::Lock, bool* accurateResult = nullptr);
+    // called, with the tree write locked, by an element when entities enter or leave it; with its cube the first time
+    void bumpElementsVersion(const AACube* changedElementCube) {
+        if (changedElementCube) {
+            _changedSnapshotElements.push_back(*changedElementCube);
+        }
+        _elementsVersion++;
+    }
+
     void debugDumpMap();
     virtual void dumpTree() override;
     virtual void pruneTree() override;
@@ -197,8 +223,13 @@ public:
     virtual bool writeToMap(QVariantMap& entityDescription, OctreeElementPointer element, bool skipDefaultValues,
                             bool skipThoseWithBadParents) override;
     virtual bool readFromMap(QVariantMap& entityDescription, const bool isImport = false) override;
+    virtual bool readFromJSON(const QByteArray& jsonData, const QString& marketplaceID, bool isImport,
+                              const QUrl& relativeURL) override;
     virtual bool writeToJSON(QString& jsonString, const OctreeElementPointer& element) override;
 
+    virtual void setTrackPersistChanges(bool trackChanges) override;
+    virtual bool takePersistChanges(QVariantMap& changes) override;
+
 
     glm::vec3 getContentsDimensions();
     float getContentsLargestDimension();
@@ -301,9 +332,14 @@ protected:
     void processRemovedEntities(const DeleteEntityOperator& theOperator);
     bool updateEntity(EntityItemPointer entity, const EntityItemProperties& properties,
             const SharedNodePointer& senderNode = SharedNodePointer(nullptr));
-    static bool sendEntitiesOperation(const OctreeElementPointer& element, void* extraData);
+    static bool sendEntitiesOperation(const EntityTreeSnapshot::Element& element, void* extraData);
     static void bumpTimestamp(EntityItemProperties& properties);
 
+    // whether to look up the entities an index found rather than search the tree, which is better unless they are many
+    bool shouldQueryIndex(int numIndexed) const;
+    void evalIndexedEntitiesInSphere(const QVector<EntityItemID>& entityIDs, const glm::vec3& center, float radius,
+                                     PickFilter searchFilter, QVector<QUuid>& foundEntities);
+
     void notifyNewlyCreatedEntity(const EntityItem& newEntity, const SharedNodePointer& senderNode);
 
     bool isScriptInWhitelist(const QString& scriptURL);
@@ -329,6 +365,13 @@ protected:
 
     mutable QReadWriteLock _entityMapLock;
     QHash<EntityItemID, EntityItemPointer> _entityMap;
+    EntityTreeIndex _entityIndex; // of the entities in _entityMap
+
+    void clearSnapshot();
+    std::atomic<uint64_t> _elementsVersion { 1 }; // of which entities are in which elements
+    std::mutex _snapshotLock; // held while taking a snapshot
+    std::vector<AACube> _changedSnapshotElements; // since the last snapshot
+    EntityTreeSnapshotPointer _snapshot; // only accessed with std::atomic_load() and std::atomic_store()
 
     mutable QReadWriteLock _entityCertificateIDMapLock;
     QHash<QString, QList<EntityItemID>> _entityCertificateIDMap;
@@ -362,6 +405,7 @@ protected:
     quint64 _treeResetTime = 0;
 
     void fixupNeedsParentFixups(); // try to hook members of _needsParentFixup to parent instances
+    bool _deferParentFixups { false }; // while loading, fixups wait until all the entities have been added
     QVector<EntityItemWeakPointer> _needsParentFixup; // entites with a parentID but no (yet) known parent instance
     mutable QReadWriteLock _needsParentFixupLock;
 
@@ -371,6 +415,15 @@ protected:
     std::mutex _childrenOfAvatarsLock;
     QHash<QUuid, QSet<EntityItemID>> _childrenOfAvatars;  // which entities are children of which avatars
 
+    // entities added, edited or deleted since the persist thread last journaled them
+    void trackPersistChange(const EntityItemID& entityID, bool deleted);
+    void loseTrackOfPersistChanges();
+    std::mutex _persistChangesLock;
+    bool _trackPersistChanges { false };
+    bool _lostTrackOfPersistChanges { false };
+    QSet<EntityItemID> _persistChangedIDs;
+    QSet<EntityItemID> _persistDeletedIDs;
+
     float _maxTmpEntityLifetime { DEFAULT_MAX_TMP_ENTITY_LIFETIME };
 
     bool filterProperties(const EntityItemPointer& existingEntity, EntityItemProperties& propertiesIn, EntityItemProperties& propertiesOut, bool& wasChanged, FilterType filterType) const;
@@ -389,6 +442,15 @@ private:
     void sendChallengeOwnershipRequestPacket(const QByteArray& id, const QByteArray& text, const QByteArray& nodeToChallenge, const SharedNodePointer& senderNode);
     void validatePop(const QString& certID, const EntityItemID& entityItemID, const SharedNodePointer& senderNode);
 
+    // loading from a description map or its JSON
+    void readHeaderFromMap(const QVariantMap& map);
+    // converts older content as it goes, may be called from several threads at once when there is no _myAvatar
+    void entityPropertiesFromMap(QVariantMap& entityMap, int contentVersion, QScriptEngine& scriptEngine,
+                                 const QUuid& sessionID, EntityItemID& entityItemID, EntityItemProperties& properties) const;
+    EntityItemPointer constructLoadedEntity(const EntityItemID& entityItemID, const EntityItemProperties& properties, bool isImport);
+    bool addLoadedEntities(const std::vector<EntityItemPointer>& entities, QMap<QUuid, QVector<QUuid>>& cloneIDs);
+    void finishLoadingEntities(const QMap<QUuid, QVector<QUuid>>& cloneIDs);
+
     std::shared_ptr<AvatarData> _myAvatar{ nullptr };
 
     static std::function<QObject*(const QUuid&)> _getEntityObjectOperator;
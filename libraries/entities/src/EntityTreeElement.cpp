@@ -140,6 +140,11 @@ bool EntityTreeElement::bestFitBounds(const glm::vec3& minPoint, const glm::vec3
 }
 
 bool EntityTreeElement::checkFilterSettings(const EntityItemPointer& entity, PickFilter searchFilter) {
+    // a snapshot of the tree can still hold entities that have been deleted since
+    if (entity->isDead()) {
+        return false;
+    }
+
     bool visible = entity->isVisible();
     entity::HostType hostType = entity->getEntityHostType();
     if ((!searchFilter.doesPickVisible() && visible) || (!searchFilter.doesPickInvisible() && !visible) ||
@@ -162,7 +167,7 @@ bool EntityTreeElement::checkFilterSettings(const EntityItemPointer& entity, Pic
     return true;
 }
 
-EntityItemID EntityTreeElement::evalRayIntersection(const glm::vec3& origin, const glm::vec3& direction, const glm::vec3& viewFrustumPos,
+EntityItemID EntityTreeElement::evalRayIntersection(const EntityItems& entities, const glm::vec3& origin, const glm::vec3& direction, const glm::vec3& viewFrustumPos,
         OctreeElementPointer& element, float& distance, BoxFace& face, glm::vec3& surfaceNormal,
         const QVector<EntityItemID>& entityIdsToInclude, const QVector<EntityItemID>& entityIdsToDiscard,
         PickFilter searchFilter, QVariantMap& extraInfo) {
@@ -171,13 +176,13 @@ EntityItemID EntityTreeElement::evalRayIntersection(const glm::vec3& origin, con
     BoxFace localFace { UNKNOWN_FACE };
     glm::vec3 localSurfaceNormal;
 
-    if (!canPickIntersect()) {
+    if (entities.isEmpty()) {
         return result;
     }
 
     QVariantMap localExtraInfo;
     float distanceToElementDetails = distance;
-    EntityItemID entityID = evalDetailedRayIntersection(origin, direction, viewFrustumPos, element, distanceToElementDetails,
+    EntityItemID entityID = evalDetailedRayIntersection(entities, origin, direction, viewFrustumPos, element, distanceToElementDetails,
             localFace, localSurfaceNormal, entityIdsToInclude, entityIdsToDiscard, searchFilter, localExtraInfo);
     if (!entityID.isNull() && distanceToElementDetails < distance) {
         distance = distanceToElementDetails;
@@ -189,16 +194,16 @@ EntityItemID EntityTreeElement::evalRayIntersection(const glm::vec3& origin, con
     return result;
 }
 
-EntityItemID EntityTreeElement::evalDetailedRayIntersection(const glm::vec3& origin, const glm::vec3& direction, const glm::vec3& viewFrustumPos,
+EntityItemID EntityTreeElement::evalDetailedRayIntersection(const EntityItems& entities, const glm::vec3& origin, const glm::vec3& direction, const glm::vec3& viewFrustumPos,
                                     OctreeElementPointer& element, float& distance, BoxFace& face, glm::vec3& surfaceNormal,
                                     const QVector<EntityItemID>& entityIdsToInclude, const QVector<EntityItemID>& entityIDsToDiscard,
                                     PickFilter searchFilter, QVariantMap& extraInfo) {
 
     // only called if we do intersect our bounding cube, but find if we actually intersect with entities...
     EntityItemID entityID;
-    forEachEntity([&](EntityItemPointer entity) {
+    for (const auto& entity : entities) {
         if (entity->getIgnorePickIntersection() && !searchFilter.bypassIgnore()) {
-            return;
+            continue;
         }
 
         // use simple line-sphere for broadphase check
@@ -206,13 +211,13 @@ EntityItemID EntityTreeElement::evalDetailedRayIntersection(const glm::vec3& ori
         bool success;
         AABox entityBox = entity->getAABox(success);
         if (!success || !entityBox.rayHitsBoundingSphere(origin, direction)) {
-            return;
+            continue;
         }
 
         if (!checkFilterSettings(entity, searchFilter) ||
             (entityIdsToInclude.size() > 0 && !entityIdsToInclude.contains(entity->getID())) ||
             (entityIDsToDiscard.size() > 0 && entityIDsToDiscard.contains(entity->getID())) ) {
-            return;
+            continue;
         }
 
         // extents is the entity relative, scaled, centered extents of the entity
@@ -268,7 +273,7 @@ EntityItemID EntityTreeElement::evalDetailedRayIntersection(const glm::vec3& ori
                 }
             }
         }
-    });
+    }
     return entityID;
 }
 
@@ -299,7 +304,7 @@ bool EntityTreeElement::findSpherePenetration(const glm::vec3& center, float rad
     return result;
 }
 
-EntityItemID EntityTreeElement::evalParabolaIntersection(const glm::vec3& origin, const glm::vec3& velocity,
+EntityItemID EntityTreeElement::evalParabolaIntersection(const EntityItems& entities, const glm::vec3& origin, const glm::vec3& velocity,
     const glm::vec3& acceleration, const glm::vec3& viewFrustumPos, OctreeElementPointer& element, float& parabolicDistance,
     BoxFace& face, glm::vec3& surfaceNormal, const QVector<EntityItemID>& entityIdsToInclude,
     const QVector<EntityItemID>& entityIdsToDiscard, PickFilter searchFilter, QVariantMap& extraInfo) {
@@ -308,7 +313,7 @@ EntityItemID EntityTreeElement::evalParabolaIntersection(const glm::vec3& origin
     BoxFace localFace;
     glm::vec3 localSurfaceNormal;
 
-    if (!canPickIntersect()) {
+    if (entities.isEmpty()) {
         return result;
     }
 
@@ -323,7 +328,7 @@ EntityItemID EntityTreeElement::evalParabolaIntersection(const glm::vec3& origin
     }
     // Get the normal of the plane, the cross product of two vectors on the plane
     glm::vec3 normal = glm::normalize(glm::cross(vectorOnPlane, acceleration));
-    EntityItemID entityID = evalDetailedParabolaIntersection(origin, velocity, acceleration, viewFrustumPos, normal, element, distanceToElementDetails,
+    EntityItemID entityID = evalDetailedParabolaIntersection(entities, origin, velocity, acceleration, viewFrustumPos, normal, element, distanceToElementDetails,
             localFace, localSurfaceNormal, entityIdsToInclude, entityIdsToDiscard, searchFilter, localExtraInfo);
     if (!entityID.isNull() && distanceToElementDetails < parabolicDistance) {
         parabolicDistance = distanceToElementDetails;
@@ -335,16 +340,16 @@ EntityItemID EntityTreeElement::evalParabolaIntersection(const glm::vec3& origin
     return result;
 }
 
-EntityItemID EntityTreeElement::evalDetailedParabolaIntersection(const glm::vec3& origin, const glm::vec3& velocity, const glm::vec3& acceleration,
+EntityItemID EntityTreeElement::evalDetailedParabolaIntersection(const EntityItems& entities, const glm::vec3& origin, const glm::vec3& velocity, const glm::vec3& acceleration,
                                     const glm::vec3& viewFrustumPos,const glm::vec3& normal, OctreeElementPointer& element, float& parabolicDistance,
                                     BoxFace& face, glm::vec3& surfaceNormal, const QVector<EntityItemID>& entityIdsToInclude,
                                     const QVector<EntityItemID>& entityIDsToDiscard, PickFilter searchFilter, QVariantMap& extraInfo) {
 
     // only called if we do intersect our bounding cube, but find if we actually intersect with entities...
     EntityItemID entityID;
-    forEachEntity([&](EntityItemPointer entity) {
+    for (const auto& entity : entities) {
         if (entity->getIgnorePickIntersection() && !searchFilter.bypassIgnore()) {
-            return;
+            continue;
         }
 
         // use simple line-sphere for broadphase check
@@ -357,13 +362,13 @@ EntityItemID EntityTreeElement::evalDetailedParabolaIntersection(const glm::vec3
         // the solution to which is more computationally expensive than the quadratic AABox::findParabolaIntersection
         // below
         if (!success || !entityBox.parabolaPlaneIntersectsBoundingSphere(origin, velocity, acceleration, normal)) {
-            return;
+            continue;
         }
 
         if (!checkFilterSettings(entity, searchFilter) ||
             (entityIdsToInclude.size() > 0 && !entityIdsToInclude.contains(entity->getID())) ||
             (entityIDsToDiscard.size() > 0 && entityIDsToDiscard.contains(entity->getID()))) {
-            return;
+            continue;
         }
 
         // extents is the entity relative, scaled, centered extents of the entity
@@ -420,15 +425,15 @@ EntityItemID EntityTreeElement::evalDetailedParabolaIntersection(const glm::vec3
                 }
             }
         }
-    });
+    }
     return entityID;
 }
 
-QUuid EntityTreeElement::evalClosetEntity(const glm::vec3& position, PickFilter searchFilter, float& closestDistanceSquared) const {
+QUuid EntityTreeElement::evalClosetEntity(const EntityItems& entities, const glm::vec3& position, PickFilter searchFilter, float& closestDistanceSquared) {
     QUuid closestEntity;
-    forEachEntity([&](EntityItemPointer entity) {
+    for (const auto& entity : entities) {
         if (!checkFilterSettings(entity, searchFilter)) {
-            return;
+            continue;
         }
 
         float distanceToEntity = glm::distance2(position, entity->getWorldPosition());
@@ -436,176 +441,89 @@ QUuid EntityTreeElement::evalClosetEntity(const glm::vec3& position, PickFilter
             closestEntity = entity->getID();
             closestDistanceSquared = distanceToEntity;
         }
-    });
+    }
     return closestEntity;
 }
 
-void EntityTreeElement::evalEntitiesInSphere(const glm::vec3& position, float radius, PickFilter searchFilter, QVector<QUuid>& foundEntities) const {
-    forEachEntity([&](EntityItemPointer entity) {
-        if (!checkFilterSettings(entity, searchFilter)) {
-            return;
-        }
+bool EntityTreeElement::isEntityInSphere(const EntityItemPointer& entity, const glm::vec3& position, float radius) {
+    bool success;
+    AABox entityBox = entity->getAABox(success);
+    // if the sphere doesn't intersect with our world frame AABox, we don't need to consider the more complex case
+    glm::vec3 penetration;
+    if (!success || !entityBox.findSpherePenetration(position, radius, penetration)) {
+        return false;
+    }
 
-        bool success;
-        AABox entityBox = entity->getAABox(success);
-        // if the sphere doesn't intersect with our world frame AABox, we don't need to consider the more complex case
-        glm::vec3 penetration;
-        if (success && entityBox.findSpherePenetration(position, radius, penetration)) {
-
-            glm::vec3 dimensions = entity->getScaledDimensions();
-
-            // FIXME - consider allowing the entity to determine penetration so that
-            //         entities could presumably do actual hull testing if they wanted to
-            // FIXME - handle entity->getShapeType() == SHAPE_TYPE_SPHERE case better in particular
-            //         can we handle the ellipsoid case better? We only currently handle perfect spheres
-            //         with centered registration points
-            if (entity->getShapeType() == SHAPE_TYPE_SPHERE && (dimensions.x == dimensions.y && dimensions.y == dimensions.z)) {
-
-                // NOTE: entity->getRadius() doesn't return the true radius, it returns the radius of the
-                //       maximum bounding sphere, which is actually larger than our actual radius
-                float entityTrueRadius = dimensions.x / 2.0f;
-
-                bool success;
-                glm::vec3 center = entity->getCenterPosition(success);
-                if (success && findSphereSpherePenetration(position, radius, center, entityTrueRadius, penetration)) {
-                    foundEntities.push_back(entity->getID());
-                }
-            } else {
-                // determine the worldToEntityMatrix that doesn't include scale because
-                // we're going to use the registration aware aa box in the entity frame
-                glm::mat4 translation = glm::translate(entity->getWorldPosition());
-                glm::mat4 rotation = glm::mat4_cast(entity->getWorldOrientation());
-                glm::mat4 entityToWorldMatrix = translation * rotation;
-                glm::mat4 worldToEntityMatrix = glm::inverse(entityToWorldMatrix);
+    glm::vec3 dimensions = entity->getScaledDimensions();
 
-                glm::vec3 registrationPoint = entity->getRegistrationPoint();
-                glm::vec3 corner = -(dimensions * registrationPoint) + entity->getPivot();
+    // FIXME - consider allowing the entity to determine penetration so that
+    //         entities could presumably do actual hull testing if they wanted to
+    // FIXME - handle entity->getShapeType() == SHAPE_TYPE_SPHERE case better in particular
+    //         can we handle the ellipsoid case better? We only currently handle perfect spheres
+    //         with centered registration points
+    if (entity->getShapeType() == SHAPE_TYPE_SPHERE && (dimensions.x == dimensions.y && dimensions.y == dimensions.z)) {
 
-                AABox entityFrameBox(corner, dimensions);
+        // NOTE: entity->getRadius() doesn't return the true radius, it returns the radius of the
+        //       maximum bounding sphere, which is actually larger than our actual radius
+        float entityTrueRadius = dimensions.x / 2.0f;
 
-                glm::vec3 entityFrameSearchPosition = glm::vec3(worldToEntityMatrix * glm::vec4(position, 1.0f));
-                if (entityFrameBox.findSpherePenetration(entityFrameSearchPosition, radius, penetration)) {
-                    foundEntities.push_back(entity->getID());
-                }
-            }
-        }
-    });
-}
+        glm::vec3 center = entity->getCenterPosition(success);
+        return success && findSphereSpherePenetration(position, radius, center, entityTrueRadius, penetration);
+    }
 
-void EntityTreeElement::evalEntitiesInSphereWithType(const glm::vec3& position, float radius, EntityTypes::EntityType type, PickFilter searchFilter, QVector<QUuid>& foundEntities) const {
-    forEachEntity([&](EntityItemPointer entity) {
-        if (!checkFilterSettings(entity, searchFilter) || type != entity->getType()) {
-            return;
-        }
+    // determine the worldToEntityMatrix that doesn't include scale because
+    // we're going to use the registration aware aa box in the entity frame
+    glm::mat4 translation = glm::translate(entity->getWorldPosition());
+    glm::mat4 rotation = glm::mat4_cast(entity->getWorldOrientation());
+    glm::mat4 entityToWorldMatrix = translation * rotation;
+    glm::mat4 worldToEntityMatrix = glm::inverse(entityToWorldMatrix);
 
-        bool success;
-        AABox entityBox = entity->getAABox(success);
-        // if the sphere doesn't intersect with our world frame AABox, we don't need to consider the more complex case
-        glm::vec3 penetration;
-        if (success && entityBox.findSpherePenetration(position, radius, penetration)) {
-
-            glm::vec3 dimensions = entity->getScaledDimensions();
-
-            // FIXME - consider allowing the entity to determine penetration so that
-            //         entities could presumably do actual hull testing if they wanted to
-            // FIXME - handle entity->getShapeType() == SHAPE_TYPE_SPHERE case better in particular
-            //         can we handle the ellipsoid case better? We only currently handle perfect spheres
-            //         with centered registration points
-            if (entity->getShapeType() == SHAPE_TYPE_SPHERE && (dimensions.x == dimensions.y && dimensions.y == dimensions.z)) {
-
-                // NOTE: entity->getRadius() doesn't return the true radius, it returns the radius of the
-                //       maximum bounding sphere, which is actually larger than our actual radius
-                float entityTrueRadius = dimensions.x / 2.0f;
-
-                bool success;
-                glm::vec3 center = entity->getCenterPosition(success);
-                if (success && findSphereSpherePenetration(position, radius, center, entityTrueRadius, penetration)) {
-                    foundEntities.push_back(entity->getID());
-                }
-            } else {
-                // determine the worldToEntityMatrix that doesn't include scale because
-                // we're going to use the registration aware aa box in the entity frame
-                glm::mat4 translation = glm::translate(entity->getWorldPosition());
-                glm::mat4 rotation = glm::mat4_cast(entity->getWorldOrientation());
-                glm::mat4 entityToWorldMatrix = translation * rotation;
-                glm::mat4 worldToEntityMatrix = glm::inverse(entityToWorldMatrix);
+    glm::vec3 registrationPoint = entity->getRegistrationPoint();
+    glm::vec3 corner = -(dimensions * registrationPoint) + entity->getPivot();
 
-                glm::vec3 registrationPoint = entity->getRegistrationPoint();
-                glm::vec3 corner = -(dimensions * registrationPoint) + entity->getPivot();
+    AABox entityFrameBox(corner, dimensions);
 
-                AABox entityFrameBox(corner, dimensions);
+    glm::vec3 entityFrameSearchPosition = glm::vec3(worldToEntityMatrix * glm::vec4(position, 1.0f));
+    return entityFrameBox.findSpherePenetration(entityFrameSearchPosition, radius, penetration);
+}
 
-                glm::vec3 entityFrameSearchPosition = glm::vec3(worldToEntityMatrix * glm::vec4(position, 1.0f));
-                if (entityFrameBox.findSpherePenetration(entityFrameSearchPosition, radius, penetration)) {
-                    foundEntities.push_back(entity->getID());
-                }
-            }
+void EntityTreeElement::evalEntitiesInSphere(const EntityItems& entities, const glm::vec3& position, float radius, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
+    for (const auto& entity : entities) {
+        if (checkFilterSettings(entity, searchFilter) && isEntityInSphere(entity, position, radius)) {
+            foundEntities.push_back(entity->getID());
         }
-    });
+    }
 }
 
-void EntityTreeElement::evalEntitiesInSphereWithName(const glm::vec3& position, float radius, const QString& name, bool caseSensitive, PickFilter searchFilter, QVector<QUuid>& foundEntities) const {
-    forEachEntity([&](EntityItemPointer entity) {
+void EntityTreeElement::evalEntitiesInSphereWithType(const EntityItems& entities, const glm::vec3& position, float radius, EntityTypes::EntityType type, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
+    for (const auto& entity : entities) {
+        if (checkFilterSettings(entity, searchFilter) && type == entity->getType() && isEntityInSphere(entity, position, radius)) {
+            foundEntities.push_back(entity->getID());
+        }
+    }
+}
+
+void EntityTreeElement::evalEntitiesInSphereWithName(const EntityItems& entities, const glm::vec3& position, float radius, const QString& name, bool caseSensitive, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
+    for (const auto& entity : entities) {
         if (!checkFilterSettings(entity, searchFilter)) {
-            return;
+            continue;
         }
 
         QString entityName = entity->getName();
         if ((caseSensitive && name != entityName) || (!caseSensitive && name.toLower() != entityName.toLower())) {
-            return;
+            continue;
         }
 
-        bool success;
-        AABox entityBox = entity->getAABox(success);
-
-        // if the sphere doesn't intersect with our world frame AABox, we don't need to consider the more complex case
-        glm::vec3 penetration;
-        if (success && entityBox.findSpherePenetration(position, radius, penetration)) {
-
-            glm::vec3 dimensions = entity->getScaledDimensions();
-
-            // FIXME - consider allowing the entity to determine penetration so that
-            //         entities could presumably do actual hull testing if they wanted to
-            // FIXME - handle entity->getShapeType() == SHAPE_TYPE_SPHERE case better in particular
-            //         can we handle the ellipsoid case better? We only currently handle perfect spheres
-            //         with centered registration points
-            if (entity->getShapeType() == SHAPE_TYPE_SPHERE && (dimensions.x == dimensions.y && dimensions.y == dimensions.z)) {
-
-                // NOTE: entity->getRadius() doesn't return the true radius, it returns the radius of the
-                //       maximum bounding sphere, which is actually larger than our actual radius
-                float entityTrueRadius = dimensions.x / 2.0f;
-                bool success;
-                glm::vec3 center = entity->getCenterPosition(success);
-
-                if (success && findSphereSpherePenetration(position, radius, center, entityTrueRadius, penetration)) {
-                    foundEntities.push_back(entity->getID());
-                }
-            } else {
-                // determine the worldToEntityMatrix that doesn't include scale because
-                // we're going to use the registration aware aa box in the entity frame
-                glm::mat4 translation = glm::translate(entity->getWorldPosition());
-                glm::mat4 rotation = glm::mat4_cast(entity->getWorldOrientation());
-                glm::mat4 entityToWorldMatrix = translation * rotation;
-                glm::mat4 worldToEntityMatrix = glm::inverse(entityToWorldMatrix);
-
-                glm::vec3 registrationPoint = entity->getRegistrationPoint();
-                glm::vec3 corner = -(dimensions * registrationPoint) + entity->getPivot();
-
-                AABox entityFrameBox(corner, dimensions);
-
-                glm::vec3 entityFrameSearchPosition = glm::vec3(worldToEntityMatrix * glm::vec4(position, 1.0f));
-                if (entityFrameBox.findSpherePenetration(entityFrameSearchPosition, radius, penetration)) {
-                    foundEntities.push_back(entity->getID());
-                }
-            }
+        if (isEntityInSphere(entity, position, radius)) {
+            foundEntities.push_back(entity->getID());
         }
-    });
+    }
 }
 
-void EntityTreeElement::evalEntitiesInCube(const AACube& cube, PickFilter searchFilter, QVector<QUuid>& foundEntities) const {
-    forEachEntity([&](EntityItemPointer entity) {
+void EntityTreeElement::evalEntitiesInCube(const EntityItems& entities, const AACube& cube, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
+    for (const auto& entity : entities) {
         if (!checkFilterSettings(entity, searchFilter)) {
-            return;
+            continue;
         }
 
         bool success;
@@ -630,13 +548,13 @@ void EntityTreeElement::evalEntitiesInCube(const AACube& cube, PickFilter search
         if (success && entityBox.touches(cube)) {
             foundEntities.push_back(entity->getID());
         }
-    });
+    }
 }
 
-void EntityTreeElement::evalEntitiesInBox(const AABox& box, PickFilter searchFilter, QVector<QUuid>& foundEntities) const {
-    forEachEntity([&](EntityItemPointer entity) {
+void EntityTreeElement::evalEntitiesInBox(const EntityItems& entities, const AABox& box, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
+    for (const auto& entity : entities) {
         if (!checkFilterSettings(entity, searchFilter)) {
-            return;
+            continue;
         }
 
         bool success;
@@ -661,13 +579,13 @@ void EntityTreeElement::evalEntitiesInBox(const AABox& box, PickFilter searchFil
         if (success && entityBox.touches(box)) {
             foundEntities.push_back(entity->getID());
         }
-    });
+    }
 }
 
-void EntityTreeElement::evalEntitiesInFrustum(const ViewFrustum& frustum, PickFilter searchFilter, QVector<QUuid>& foundEntities) const {
-    forEachEntity([&](EntityItemPointer entity) {
+void EntityTreeElement::evalEntitiesInFrustum(const EntityItems& entities, const ViewFrustum& frustum, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
+    for (const auto& entity : entities) {
         if (!checkFilterSettings(entity, searchFilter)) {
-            return;
+            continue;
         }
 
         bool success;
@@ -677,7 +595,7 @@ void EntityTreeElement::evalEntitiesInFrustum(const ViewFrustum& frustum, PickFi
         if (success && (frustum.boxIntersectsFrustum(entityBox) || frustum.boxIntersectsKeyhole(entityBox))) {
             foundEntities.push_back(entity->getID());
         }
-    });
+    }
 }
 
 void EntityTreeElement::getEntities(EntityItemFilter& filter, QVector<EntityItemPointer>& foundEntities) {
@@ -716,6 +634,7 @@ void EntityTreeElement::cleanupDomainAndNonOwnedEntities() {
         _entityItems = savedEntities;
     });
     bumpChangedContent();
+    bumpTreeElementsVersion();
 }
 
 void EntityTreeElement::cleanupEntities() {
@@ -731,6 +650,7 @@ void EntityTreeElement::cleanupEntities() {
         _entityItems.clear();
     });
     bumpChangedContent();
+    bumpTreeElementsVersion();
 }
 
 bool EntityTreeElement::removeEntityItem(EntityItemPointer entity, bool deletion) {
@@ -746,6 +666,7 @@ bool EntityTreeElement::removeEntityItem(EntityItemPointer entity, bool deletion
         assert(entity->_element.get() == this);
         entity->_element = NULL;
         bumpChangedContent();
+        bumpTreeElementsVersion();
         return true;
     }
     return false;
@@ -764,9 +685,49 @@ void EntityTreeElement::addEntityItem(EntityItemPointer entity) {
         _entityItems.push_back(entity);
     });
     bumpChangedContent();
+    bumpTreeElementsVersion();
     entity->_element = getThisPointer();
 }
 
+EntityItems EntityTreeElement::getEntityItems() const {
+    EntityItems entities;
+    withReadLock([&] {
+        entities = _entityItems;
+    });
+    return entities;
+}
+
+void EntityTreeElement::bumpTreeElementsVersion() {
+    if (_myTree) {
+        // the tree only needs to find each changed element once
+        _myTree->bumpElementsVersion(_snapshotElementChanged ? nullptr : &_cube);
+        _snapshotElementChanged = true;
+    }
+}
+
+std::shared_ptr<const EntityTreeSnapshotElement> EntityTreeElement::getSnapshotElement() {
+    if (_snapshotElement && !_snapshotElementChanged) {
+        return _snapshotElement;
+    }
+
+    auto snapshotElement = std::make_shared<EntityTreeSnapshotElement>();
+    snapshotElement->cube = _cube;
+    snapshotElement->entities = getEntityItems();
+    snapshotElement->numEntities = snapshotElement->entities.size();
+    snapshotElement->children.reserve(getChildCount());
+    for (int childIndex = 0; childIndex < NUMBER_OF_CHILDREN; ++childIndex) {
+        EntityTreeElementPointer child = getChildAtIndex(childIndex);
+        if (child) {
+            auto childSnapshotElement = child->getSnapshotElement();
+            snapshotElement->numEntities += childSnapshotElement->numEntities;
+            snapshotElement->children.push_back(std::move(childSnapshotElement));
+        }
+    }
+    _snapshotElement = snapshotElement;
+    _snapshotElementChanged = false;
+    return _snapshotElement;
+}
+
 // will average a "common reduced LOD view" from the the child elements...
 void EntityTreeElement::calculateAverageFromChildren() {
     // nothing to do here yet...
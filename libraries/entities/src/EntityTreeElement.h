@@ -24,6 +24,7 @@
 
 class EntityTree;
 class EntityTreeElement;
+struct EntityTreeSnapshotElement;
 
 using EntityItems = QVector<EntityItemPointer>;
 using EntityTreeElementWeakPointer = std::weak_ptr<EntityTreeElement>;
@@ -135,27 +136,39 @@ public:
     virtual bool deleteApproved() const override { return !hasEntities(); }
 
     static bool checkFilterSettings(const EntityItemPointer& entity, PickFilter searchFilter);
+    static bool isEntityInSphere(const EntityItemPointer& entity, const glm::vec3& position, float radius);
     virtual bool canPickIntersect() const override { return hasEntities(); }
-    virtual EntityItemID evalRayIntersection(const glm::vec3& origin, const glm::vec3& direction, const glm::vec3& viewFrustumPos,
-        OctreeElementPointer& element, float& distance, BoxFace& face, glm::vec3& surfaceNormal,
+    virtual bool findSpherePenetration(const glm::vec3& center, float radius,
+                        glm::vec3& penetration, void** penetratedObject) const override;
+
+    // These evaluate the entities an element held, as got by getEntityItems(), so that they can be evaluated without
+    // the element or its tree being locked.
+    static EntityItemID evalRayIntersection(const EntityItems& entities, const glm::vec3& origin, const glm::vec3& direction,
+        const glm::vec3& viewFrustumPos, OctreeElementPointer& element, float& distance, BoxFace& face, glm::vec3& surfaceNormal,
         const QVector<EntityItemID>& entityIdsToInclude, const QVector<EntityItemID>& entityIdsToDiscard,
         PickFilter searchFilter, QVariantMap& extraInfo);
-    virtual EntityItemID evalDetailedRayIntersection(const glm::vec3& origin, const glm::vec3& direction,
+    static EntityItemID evalDetailedRayIntersection(const EntityItems& entities, const glm::vec3& origin, const glm::vec3& direction,
                          const glm::vec3& viewFrustumPos, OctreeElementPointer& element, float& distance,
                          BoxFace& face, glm::vec3& surfaceNormal, const QVector<EntityItemID>& entityIdsToInclude,
                          const QVector<EntityItemID>& entityIdsToDiscard, PickFilter searchFilter, QVariantMap& extraInfo);
-    virtual bool findSpherePenetration(const glm::vec3& center, float radius,
-                        glm::vec3& penetration, void** penetratedObject) const override;
 
-    virtual EntityItemID evalParabolaIntersection(const glm::vec3& origin, const glm::vec3& velocity,
+    static EntityItemID evalParabolaIntersection(const EntityItems& entities, const glm::vec3& origin, const glm::vec3& velocity,
         const glm::vec3& acceleration, const glm::vec3& viewFrustumPos, OctreeElementPointer& element, float& parabolicDistance,
         BoxFace& face, glm::vec3& surfaceNormal, const QVector<EntityItemID>& entityIdsToInclude,
         const QVector<EntityItemID>& entityIdsToDiscard, PickFilter searchFilter, QVariantMap& extraInfo);
-    virtual EntityItemID evalDetailedParabolaIntersection(const glm::vec3& origin, const glm::vec3& velocity,
+    static EntityItemID evalDetailedParabolaIntersection(const EntityItems& entities, const glm::vec3& origin, const glm::vec3& velocity,
         const glm::vec3& normal, const glm::vec3& acceleration, const glm::vec3& viewFrustumPos, OctreeElementPointer& element,
         float& parabolicDistance, BoxFace& face, glm::vec3& surfaceNormal, const QVector<EntityItemID>& entityIdsToInclude,
         const QVector<EntityItemID>& entityIdsToDiscard, PickFilter searchFilter, QVariantMap& extraInfo);
 
+    static QUuid evalClosetEntity(const EntityItems& entities, const glm::vec3& position, PickFilter searchFilter, float& closestDistanceSquared);
+    static void evalEntitiesInSphere(const EntityItems& entities, const glm::vec3& position, float radius, PickFilter searchFilter, QVector<QUuid>& foundEntities);
+    static void evalEntitiesInSphereWithType(const EntityItems& entities, const glm::vec3& position, float radius, EntityTypes::EntityType type, PickFilter searchFilter, QVector<QUuid>& foundEntities);
+    static void evalEntitiesInSphereWithName(const EntityItems& entities, const glm::vec3& position, float radius, const QString& name, bool caseSensitive, PickFilter searchFilter, QVector<QUuid>& foundEntities);
+    static void evalEntitiesInCube(const EntityItems& entities, const AACube& cube, PickFilter searchFilter, QVector<QUuid>& foundEntities);
+    static void evalEntitiesInBox(const EntityItems& entities, const AABox& box, PickFilter searchFilter, QVector<QUuid>& foundEntities);
+    static void evalEntitiesInFrustum(const EntityItems& entities, const ViewFrustum& frustum, PickFilter searchFilter, QVector<QUuid>& foundEntities);
+
     template <typename F>
     void forEachEntity(F f) const {
         withReadLock([&] {
@@ -173,13 +186,8 @@ public:
 
     void addEntityItem(EntityItemPointer entity);
 
-    QUuid evalClosetEntity(const glm::vec3& position, PickFilter searchFilter, float& closestDistanceSquared) const;
-    void evalEntitiesInSphere(const glm::vec3& position, float radius, PickFilter searchFilter, QVector<QUuid>& foundEntities) const;
-    void evalEntitiesInSphereWithType(const glm::vec3& position, float radius, EntityTypes::EntityType type, PickFilter searchFilter, QVector<QUuid>& foundEntities) const;
-    void evalEntitiesInSphereWithName(const glm::vec3& position, float radius, const QString& name, bool caseSensitive, PickFilter searchFilter, QVector<QUuid>& foundEntities) const;
-    void evalEntitiesInCube(const AACube& cube, PickFilter searchFilter, QVector<QUuid>& foundEntities) const;
-    void evalEntitiesInBox(const AABox& box, PickFilter searchFilter, QVector<QUuid>& foundEntities) const;
-    void evalEntitiesInFrustum(const ViewFrustum& frustum, PickFilter searchFilter, QVector<QUuid>& foundEntities) const;
+    // a copy of the entities in this element, which is shared with it until it changes
+    EntityItems getEntityItems() const;
 
     /// finds all entities that match filter
     /// \param filter function that adds matching entities to foundEntities
@@ -225,10 +233,21 @@ public:
         return std::static_pointer_cast<const OctreeElement>(shared_from_this());
     }
 
+    // This element and those below it, for a snapshot of the tree. Only made again for the elements that changed since
+    // it was last asked for, and those above them; the rest are shared with the last snapshot. The caller must hold the
+    // tree's lock, and not let another thread ask at the same time.
+    std::shared_ptr<const EntityTreeSnapshotElement> getSnapshotElement();
+    // called by the tree for the elements above one that entities entered or left
+    void markSnapshotElementChanged() { _snapshotElementChanged = true; }
+
 protected:
     virtual void init(unsigned char * octalCode) override;
+    // for when entities enter or leave this element
+    void bumpTreeElementsVersion();
     EntityTreePointer _myTree;
     EntityItems _entityItems;
+    std::shared_ptr<const EntityTreeSnapshotElement> _snapshotElement;
+    bool _snapshotElementChanged { false }; // since _snapshotElement was made
 };
 
 #endif // hifi_EntityTreeElement_h
@@ -0,0 +1,182 @@
+//
+//  EntityTreeIndex.cpp
+//  libraries/entities/src
+//
+//  Created on 2026-10-16.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityTreeIndex.h"
+
+#include "EntityItem.h"
+
+namespace {
+
+bool isIndexed(const QString& name) {
+    return !name.isEmpty();
+}
+
+bool isIndexed(const QUuid& id) {
+    return !id.isNull();
+}
+
+}
+
+void EntityTreeIndex::add(const EntityItemPointer& entity) {
+    EntityItemID entityID = entity->getEntityItemID();
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto keys = _keys.find(entityID);
+    if (keys != _keys.end()) {
+        unindex(entityID, keys.value());
+    }
+    Keys newKeys = getKeys(entity);
+    index(entityID, newKeys);
+    _keys[entityID] = newKeys;
+}
+
+void EntityTreeIndex::update(const EntityItemPointer& entity) {
+    EntityItemID entityID = entity->getEntityItemID();
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto keys = _keys.find(entityID);
+    if (keys == _keys.end()) {
+        return;
+    }
+
+    // the keys are read while locked, so that concurrent updates of the same entity leave it indexed by its latest ones
+    Keys newKeys = getKeys(entity);
+    Keys& oldKeys = keys.value();
+    if (newKeys.name != oldKeys.name) {
+        erase(_byName, oldKeys.name, entityID);
+        erase(_byLowerName, oldKeys.lowerName, entityID);
+        insert(_byName, newKeys.name, entityID);
+        insert(_byLowerName, newKeys.lowerName, entityID);
+    }
+    if (newKeys.owningAvatarID != oldKeys.owningAvatarID) {
+        erase(_byOwningAvatar, oldKeys.owningAvatarID, entityID);
+        insert(_byOwningAvatar, newKeys.owningAvatarID, entityID);
+    }
+    if (newKeys.parentID != oldKeys.parentID) {
+        erase(_byParent, oldKeys.parentID, entityID);
+        insert(_byParent, newKeys.parentID, entityID);
+    }
+    // an entity's type never changes
+    oldKeys = newKeys;
+}
+
+void EntityTreeIndex::remove(const EntityItemID& entityID) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto keys = _keys.find(entityID);
+    if (keys != _keys.end()) {
+        unindex(entityID, keys.value());
+        _keys.erase(keys);
+    }
+}
+
+void EntityTreeIndex::clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _keys.clear();
+    _byName.clear();
+    _byLowerName.clear();
+    for (auto& ids : _byType) {
+        ids.clear();
+    }
+    _byOwningAvatar.clear();
+    _byParent.clear();
+}
+
+int EntityTreeIndex::size() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _keys.size();
+}
+
+QVector<EntityItemID> EntityTreeIndex::findByName(const QString& name, bool caseSensitive) const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    const auto& index = caseSensitive ? _byName : _byLowerName;
+    return toVector(index.value(caseSensitive ? name : name.toLower()));
+}
+
+QVector<EntityItemID> EntityTreeIndex::findByType(EntityTypes::EntityType type) const {
+    if (type < 0 || type >= EntityTypes::NUM_TYPES) {
+        return QVector<EntityItemID>();
+    }
+    std::lock_guard<std::mutex> lock(_mutex);
+    return toVector(_byType[type]);
+}
+
+int EntityTreeIndex::countByType(EntityTypes::EntityType type) const {
+    if (type < 0 || type >= EntityTypes::NUM_TYPES) {
+        return 0;
+    }
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _byType[type].size();
+}
+
+QVector<EntityItemID> EntityTreeIndex::findByOwningAvatar(const QUuid& avatarID) const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return toVector(_byOwningAvatar.value(avatarID));
+}
+
+QVector<EntityItemID> EntityTreeIndex::findByParent(const QUuid& parentID) const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return toVector(_byParent.value(parentID));
+}
+
+EntityTreeIndex::Keys EntityTreeIndex::getKeys(const EntityItemPointer& entity) {
+    Keys keys;
+    keys.name = entity->getName();
+    keys.lowerName = keys.name.toLower();
+    keys.type = entity->getType();
+    keys.owningAvatarID = entity->getOwningAvatarID();
+    keys.parentID = entity->getParentID();
+    return keys;
+}
+
+QVector<EntityItemID> EntityTreeIndex::toVector(const IDs& ids) {
+    QVector<EntityItemID> result;
+    result.reserve(ids.size());
+    for (const auto& id : ids) {
+        result.push_back(id);
+    }
+    return result;
+}
+
+template <typename Key>
+void EntityTreeIndex::insert(QHash<Key, IDs>& index, const Key& key, const EntityItemID& entityID) {
+    if (isIndexed(key)) {
+        index[key].insert(entityID);
+    }
+}
+
+template <typename Key>
+void EntityTreeIndex::erase(QHash<Key, IDs>& index, const Key& key, const EntityItemID& entityID) {
+    auto ids = index.find(key);
+    if (ids != index.end()) {
+        ids.value().remove(entityID);
+        if (ids.value().isEmpty()) {
+            index.erase(ids);
+        }
+    }
+}
+
+void EntityTreeIndex::index(const EntityItemID& entityID, const Keys& keys) {
+    insert(_byName, keys.name, entityID);
+    insert(_byLowerName, keys.lowerName, entityID);
+    if (keys.type >= 0 && keys.type < EntityTypes::NUM_TYPES) {
+        _byType[keys.type].insert(entityID);
+    }
+    insert(_byOwningAvatar, keys.owningAvatarID, entityID);
+    insert(_byParent, keys.parentID, entityID);
+}
+
+void EntityTreeIndex::unindex(const EntityItemID& entityID, const Keys& keys) {
+    erase(_byName, keys.name, entityID);
+    erase(_byLowerName, keys.lowerName, entityID);
+    if (keys.type >= 0 && keys.type < EntityTypes::NUM_TYPES) {
+        _byType[keys.type].remove(entityID);
+    }
+    erase(_byOwningAvatar, keys.owningAvatarID, entityID);
+    erase(_byParent, keys.parentID, entityID);
+}
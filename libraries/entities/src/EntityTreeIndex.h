@@ -0,0 +1,82 @@
+//
+//  EntityTreeIndex.h
+//  libraries/entities/src
+//
+//  Created on 2026-10-16.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_EntityTreeIndex_h
+#define hifi_EntityTreeIndex_h
+
+#include <array>
+#include <mutex>
+
+#include <QHash>
+#include <QSet>
+#include <QString>
+#include <QUuid>
+#include <QVector>
+
+#include "EntityItemID.h"
+#include "EntityTypes.h"
+
+// Secondary indexes of the entities in a tree by name, type, owning avatar and parent ID.
+//   The tree adds and removes entities as they enter and leave its entity map, and an entity has itself re-indexed
+//   whenever its name, owning avatar or parent changes, so that finding entities by any of these costs as much as the
+//   entities found rather than a visit to every entity in the tree. Names are indexed both as they are and lower-cased,
+//   for case-insensitive lookups. Entities are indexed by the parent ID they were given, whether or not that parent is
+//   known. Empty names and null IDs aren't indexed.
+//   EntityTreeIndex is thread-safe.
+class EntityTreeIndex {
+public:
+    void add(const EntityItemPointer& entity);
+    // re-reads what an entity is indexed by, if it has been added
+    void update(const EntityItemPointer& entity);
+    void remove(const EntityItemID& entityID);
+    void clear();
+
+    int size() const;
+
+    QVector<EntityItemID> findByName(const QString& name, bool caseSensitive) const;
+    QVector<EntityItemID> findByType(EntityTypes::EntityType type) const;
+    int countByType(EntityTypes::EntityType type) const;
+    QVector<EntityItemID> findByOwningAvatar(const QUuid& avatarID) const;
+    QVector<EntityItemID> findByParent(const QUuid& parentID) const;
+
+private:
+    using IDs = QSet<EntityItemID>;
+
+    struct Keys {
+        QString name;
+        QString lowerName;
+        EntityTypes::EntityType type { EntityTypes::Unknown };
+        QUuid owningAvatarID;
+        QUuid parentID;
+    };
+
+    static Keys getKeys(const EntityItemPointer& entity);
+    static QVector<EntityItemID> toVector(const IDs& ids);
+    template <typename Key>
+    static void insert(QHash<Key, IDs>& index, const Key& key, const EntityItemID& entityID);
+    template <typename Key>
+    static void erase(QHash<Key, IDs>& index, const Key& key, const EntityItemID& entityID);
+
+    void index(const EntityItemID& entityID, const Keys& keys);
+    void unindex(const EntityItemID& entityID, const Keys& keys);
+
+    mutable std::mutex _mutex;
+    QHash<EntityItemID, Keys> _keys;
+    QHash<QString, IDs> _byName;
+    QHash<QString, IDs> _byLowerName;
+    std::array<IDs, EntityTypes::NUM_TYPES> _byType;
+    QHash<QUuid, IDs> _byOwningAvatar;
+    QHash<QUuid, IDs> _byParent;
+};
+
+#endif // hifi_EntityTreeIndex_h
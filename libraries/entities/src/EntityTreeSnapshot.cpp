@@ -0,0 +1,67 @@
+//
+//  EntityTreeSnapshot.cpp
+//  libraries/entities/src
+//
+//  Created on 2026-10-16.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityTreeSnapshot.h"
+
+#include <algorithm>
+#include <cfloat>
+
+void EntityTreeSnapshot::recurseWithOperation(const Operation& operation, void* extraData) const {
+    if (_root) {
+        recurseElementWithOperation(*_root, operation, extraData);
+    }
+}
+
+void EntityTreeSnapshot::recurseElementWithOperation(const Element& element, const Operation& operation,
+                                                     void* extraData) const {
+    if (operation(element, extraData)) {
+        for (const auto& child : element.children) {
+            recurseElementWithOperation(*child, operation, extraData);
+        }
+    }
+}
+
+void EntityTreeSnapshot::recurseWithOperationSorted(const Operation& operation, const SortingOperation& sortingOperation,
+                                                    void* extraData) const {
+    if (_root) {
+        recurseElementWithOperationSorted(*_root, operation, sortingOperation, extraData);
+    }
+}
+
+bool EntityTreeSnapshot::recurseElementWithOperationSorted(const Element& element, const Operation& operation,
+                                                           const SortingOperation& sortingOperation, void* extraData) const {
+    bool keepSearching = operation(element, extraData);
+
+    std::vector<std::pair<float, const Element*>> sortedChildren;
+    sortedChildren.reserve(element.children.size());
+    for (const auto& child : element.children) {
+        float priority = sortingOperation(*child, extraData);
+        if (priority < FLT_MAX) {
+            sortedChildren.emplace_back(priority, child.get());
+        }
+    }
+
+    if (sortedChildren.size() > 1) {
+        std::sort(sortedChildren.begin(), sortedChildren.end(),
+            [](const std::pair<float, const Element*>& left, const std::pair<float, const Element*>& right) {
+                return left.first < right.first;
+            });
+    }
+
+    for (const auto& sortedChild : sortedChildren) {
+        // our children were sorted, so if one hits something, we don't need to check the others
+        if (!recurseElementWithOperationSorted(*sortedChild.second, operation, sortingOperation, extraData)) {
+            return false;
+        }
+    }
+    // we checked all our children and didn't find anything, so stop if we hit something in this element
+    return keepSearching;
+}
@@ -0,0 +1,71 @@
+//
+//  EntityTreeSnapshot.h
+//  libraries/entities/src
+//
+//  Created on 2026-10-16.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_EntityTreeSnapshot_h
+#define hifi_EntityTreeSnapshot_h
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <AACube.h>
+
+#include "EntityTreeElement.h"
+
+// One element of an EntityTreeSnapshot, and the elements below it. Elements that haven't changed between two versions of
+//   the tree are shared by their snapshots.
+struct EntityTreeSnapshotElement {
+    AACube cube;
+    EntityItems entities;
+    std::vector<std::shared_ptr<const EntityTreeSnapshotElement>> children;
+    int numEntities { 0 }; // in this element and those below it
+};
+
+// An immutable view of which entities were in which elements of an entity tree, as of one version of the tree.
+//   Queries walk a snapshot instead of the tree, so that they neither wait for nor hold up edits to it. Only the elements
+//   and which entities they hold are frozen: the entities are shared with the tree, and are read as they are now, under
+//   their own locks. An entity deleted since the snapshot was taken is still in it, but dead.
+//   EntityTreeSnapshot is thread-safe.
+class EntityTreeSnapshot {
+public:
+    using Element = EntityTreeSnapshotElement;
+    using ElementPointer = std::shared_ptr<const Element>;
+
+    using Operation = std::function<bool(const Element&, void*)>;
+    using SortingOperation = std::function<float(const Element&, void*)>;
+
+    EntityTreeSnapshot() { }
+    EntityTreeSnapshot(const ElementPointer& root, uint64_t version) : _root(root), _version(version) { }
+
+    uint64_t getVersion() const { return _version; }
+    const ElementPointer& getRoot() const { return _root; }
+    int getNumEntities() const { return _root ? _root->numEntities : 0; }
+
+    // as Octree::recurseTreeWithOperation()
+    void recurseWithOperation(const Operation& operation, void* extraData = nullptr) const;
+    // as Octree::recurseTreeWithOperationSorted()
+    void recurseWithOperationSorted(const Operation& operation, const SortingOperation& sortingOperation,
+                                    void* extraData = nullptr) const;
+
+private:
+    void recurseElementWithOperation(const Element& element, const Operation& operation, void* extraData) const;
+    bool recurseElementWithOperationSorted(const Element& element, const Operation& operation,
+                                           const SortingOperation& sortingOperation, void* extraData) const;
+
+    ElementPointer _root;
+    uint64_t _version { 0 };
+};
+
+using EntityTreeSnapshotPointer = std::shared_ptr<const EntityTreeSnapshot>;
+
+#endif // hifi_EntityTreeSnapshot_h
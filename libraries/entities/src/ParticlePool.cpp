@@ -0,0 +1,143 @@
+//
+//  ParticlePool.cpp
+//  libraries/entities/src
+//
+//  Created on 2026-10-16.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ParticlePool.h"
+
+#include <NumericalConstants.h>
+
+using namespace particle;
+
+void Pool::reserve(size_t numParticles) {
+    for (auto& field : _fields) {
+        field.reserve(numParticles);
+    }
+    _expiration.reserve(numParticles);
+}
+
+void Pool::clear() {
+    for (auto& field : _fields) {
+        field.clear();
+    }
+    _expiration.clear();
+}
+
+void Pool::emit(float seed, uint64_t lifespanUsecs, const glm::vec3& basePosition, const glm::vec3& relativePosition,
+                const glm::vec3& velocity, const glm::vec3& acceleration) {
+    _fields[SEED].push_back(seed);
+    _fields[LIFETIME].push_back(0.0f);
+    for (int i = 0; i < 3; ++i) {
+        _fields[BASE_X + i].push_back(basePosition[i]);
+        _fields[POSITION_X + i].push_back(relativePosition[i]);
+        _fields[VELOCITY_X + i].push_back(velocity[i]);
+        _fields[ACCELERATION_X + i].push_back(acceleration[i]);
+    }
+    _expiration.push_back(lifespanUsecs);
+}
+
+void Pool::removeExpired(size_t maxParticles) {
+    const size_t numParticles = size();
+    const size_t first = numParticles > maxParticles ? numParticles - maxParticles : 0;
+
+    // find where the survivors stop being where they already are, as they usually all are
+    size_t kept = 0;
+    size_t next = first;
+    if (first == 0) {
+        while (next < numParticles && _expiration[next] != 0) {
+            ++next;
+        }
+        kept = next;
+    }
+
+    for (; next < numParticles; ++next) {
+        if (_expiration[next] != 0) {
+            for (auto& field : _fields) {
+                field[kept] = field[next];
+            }
+            _expiration[kept] = _expiration[next];
+            ++kept;
+        }
+    }
+
+    if (kept != numParticles) {
+        for (auto& field : _fields) {
+            field.resize(kept);
+        }
+        _expiration.resize(kept);
+    }
+}
+
+void Pool::rebase(const glm::vec3& basePosition, bool wereTrailing) {
+    const size_t numParticles = size();
+    for (int i = 0; i < 3; ++i) {
+        float* base = _fields[BASE_X + i].data();
+        float* position = _fields[POSITION_X + i].data();
+        const float to = basePosition[i];
+        if (wereTrailing) {
+            for (size_t p = 0; p < numParticles; ++p) {
+                position[p] = position[p] + base[p] - to;
+            }
+        }
+        for (size_t p = 0; p < numParticles; ++p) {
+            base[p] = to;
+        }
+    }
+}
+
+void Pool::integrate(uint64_t intervalUsecs) {
+    const size_t numParticles = size();
+    const float deltaTime = (float)intervalUsecs / (float)USECS_PER_SECOND;
+    const float halfDeltaTimeSquared = 0.5f * deltaTime * deltaTime;
+
+    for (int i = 0; i < 3; ++i) {
+        float* position = _fields[POSITION_X + i].data();
+        float* velocity = _fields[VELOCITY_X + i].data();
+        const float* acceleration = _fields[ACCELERATION_X + i].data();
+        for (size_t p = 0; p < numParticles; ++p) {
+            position[p] += velocity[p] * deltaTime + halfDeltaTimeSquared * acceleration[p];
+            velocity[p] += acceleration[p] * deltaTime;
+        }
+    }
+
+    float* lifetime = _fields[LIFETIME].data();
+    for (size_t p = 0; p < numParticles; ++p) {
+        lifetime[p] += deltaTime;
+    }
+
+    uint64_t* expiration = _expiration.data();
+    for (size_t p = 0; p < numParticles; ++p) {
+        expiration[p] = expiration[p] >= intervalUsecs ? expiration[p] - intervalUsecs : 0;
+    }
+}
+
+void Pool::writeInstances(Instance* instances, bool trail, const glm::vec3& emitterPosition) const {
+    const size_t numParticles = size();
+    const float* seed = _fields[SEED].data();
+    const float* lifetime = _fields[LIFETIME].data();
+    const float* positionX = _fields[POSITION_X].data();
+    const float* positionY = _fields[POSITION_Y].data();
+    const float* positionZ = _fields[POSITION_Z].data();
+
+    if (trail) {
+        const float* baseX = _fields[BASE_X].data();
+        const float* baseY = _fields[BASE_Y].data();
+        const float* baseZ = _fields[BASE_Z].data();
+        for (size_t p = 0; p < numParticles; ++p) {
+            instances[p].xyz = glm::vec3(positionX[p] + baseX[p], positionY[p] + baseY[p], positionZ[p] + baseZ[p]);
+            instances[p].uv = glm::vec2(lifetime[p], seed[p]);
+        }
+    } else {
+        for (size_t p = 0; p < numParticles; ++p) {
+            instances[p].xyz = glm::vec3(positionX[p] + emitterPosition.x, positionY[p] + emitterPosition.y,
+                positionZ[p] + emitterPosition.z);
+            instances[p].uv = glm::vec2(lifetime[p], seed[p]);
+        }
+    }
+}
@@ -0,0 +1,80 @@
+//
+//  ParticlePool.h
+//  libraries/entities/src
+//
+//  Created on 2026-10-16.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_ParticlePool_h
+#define hifi_ParticlePool_h
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+namespace particle {
+
+// What is drawn for each particle: its world position, and its lifetime and seed, which the shader interpolates by.
+struct Instance {
+    glm::vec3 xyz;
+    glm::vec2 uv;
+};
+
+// The CPU particles of one emitter, as a structure of arrays kept in emission order, oldest first.
+//   Each step is a handful of plain loops over float arrays, which the compiler vectorizes, and expired particles are
+//   compacted out in place, so that a full pool steps without allocating.
+//   Pool is not thread-safe! It should be used from a single thread at a time.
+class Pool {
+public:
+    enum Field {
+        SEED = 0,
+        LIFETIME,
+        BASE_X, BASE_Y, BASE_Z, // where the emitter was, for trailing particles
+        POSITION_X, POSITION_Y, POSITION_Z, // relative to the base position
+        VELOCITY_X, VELOCITY_Y, VELOCITY_Z,
+        ACCELERATION_X, ACCELERATION_Y, ACCELERATION_Z,
+        NUM_FIELDS
+    };
+
+    size_t size() const { return _expiration.size(); }
+    bool empty() const { return _expiration.empty(); }
+    void reserve(size_t numParticles);
+    void clear();
+
+    void emit(float seed, uint64_t lifespanUsecs, const glm::vec3& basePosition, const glm::vec3& relativePosition,
+        const glm::vec3& velocity, const glm::vec3& acceleration);
+
+    // removes the particles that had expired by the last step, and the oldest ones over maxParticles, keeping the
+    // order of the rest
+    void removeExpired(size_t maxParticles);
+
+    // moves every particle onto a new base position, e.g. when the emitter starts or stops trailing, keeping their
+    // world position if they were trailing
+    void rebase(const glm::vec3& basePosition, bool wereTrailing);
+
+    // advances the particles, which are expired once their lifespan has run out
+    void integrate(uint64_t intervalUsecs);
+
+    // writes an instance per particle, which are at their base position if they trail the emitter and otherwise follow
+    // it to emitterPosition
+    void writeInstances(Instance* instances, bool trail, const glm::vec3& emitterPosition) const;
+
+    const float* get(Field field) const { return _fields[field].data(); }
+    const uint64_t* getExpiration() const { return _expiration.data(); }
+
+private:
+    std::array<std::vector<float>, NUM_FIELDS> _fields;
+    std::vector<uint64_t> _expiration; // usecs left to live, 0 once expired
+};
+
+}
+
+#endif // hifi_ParticlePool_h
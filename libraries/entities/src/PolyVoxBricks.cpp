@@ -0,0 +1,302 @@
+//
+//  PolyVoxBricks.cpp
+//  libraries/entities/src
+//
+//  Created on 2026-10-16.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PolyVoxBricks.h"
+
+#include <algorithm>
+
+#include <QDataStream>
+
+#include "PolyVoxEntityItem.h"
+
+namespace {
+
+const quint8 DELTA_FORMAT_VERSION = 1;
+
+const quint8 BRICK_EMPTY = 0;
+const quint8 BRICK_VOXELS = 1;
+
+bool isReasonableSize(quint16 x, quint16 y, quint16 z) {
+    const quint16 MAX_SIZE = (quint16)PolyVoxEntityItem::MAX_VOXEL_DIMENSION;
+    return x > 0 && x <= MAX_SIZE && y > 0 && y <= MAX_SIZE && z > 0 && z <= MAX_SIZE;
+}
+
+}
+
+PolyVoxBricks::PolyVoxBricks(const glm::ivec3& voxelVolumeSize) :
+    _voxelVolumeSize(voxelVolumeSize),
+    _numBricks((voxelVolumeSize + (BRICK_SIZE - 1)) / BRICK_SIZE)
+{
+}
+
+bool PolyVoxBricks::fromVoxelData(const QByteArray& voxelData) {
+    *this = PolyVoxBricks();
+
+    QDataStream reader(voxelData);
+    quint16 voxelXSize, voxelYSize, voxelZSize;
+    QByteArray compressedData;
+    reader >> voxelXSize >> voxelYSize >> voxelZSize >> compressedData;
+    if (reader.status() != QDataStream::Ok || !isReasonableSize(voxelXSize, voxelYSize, voxelZSize)) {
+        return false;
+    }
+
+    QByteArray voxels = qUncompress(compressedData);
+    if (voxels.size() != voxelXSize * voxelYSize * voxelZSize) {
+        return false;
+    }
+
+    fromDense(voxels, glm::ivec3(voxelXSize, voxelYSize, voxelZSize));
+    return true;
+}
+
+QByteArray PolyVoxBricks::toVoxelData() const {
+    QByteArray voxelData;
+    QDataStream writer(&voxelData, QIODevice::WriteOnly | QIODevice::Truncate);
+    writer << (quint16)_voxelVolumeSize.x << (quint16)_voxelVolumeSize.y << (quint16)_voxelVolumeSize.z;
+    writer << qCompress(toDense(), 9);
+    return voxelData;
+}
+
+void PolyVoxBricks::fromDense(const QByteArray& voxels, const glm::ivec3& voxelVolumeSize) {
+    *this = PolyVoxBricks(voxelVolumeSize);
+    if (voxels.size() != voxelVolumeSize.x * voxelVolumeSize.y * voxelVolumeSize.z) {
+        return;
+    }
+
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(voxels.constData());
+    int numBricks = _numBricks.x * _numBricks.y * _numBricks.z;
+    for (int brickIndex = 0; brickIndex < numBricks; ++brickIndex) {
+        glm::ivec3 origin = getBrickOrigin(brickIndex);
+        glm::ivec3 end = glm::min(origin + BRICK_SIZE, _voxelVolumeSize);
+        int rowLength = end.x - origin.x;
+
+        Brick brick;
+        brick.fill(0);
+        for (int z = origin.z; z < end.z; ++z) {
+            for (int y = origin.y; y < end.y; ++y) {
+                const uint8_t* row = data + (z * _voxelVolumeSize.y + y) * _voxelVolumeSize.x + origin.x;
+                std::copy(row, row + rowLength, brick.begin() + getVoxelIndex(glm::ivec3(0, y, z) - origin));
+            }
+        }
+
+        if (!isEmpty(brick)) {
+            _bricks.emplace(brickIndex, brick);
+        }
+    }
+}
+
+QByteArray PolyVoxBricks::toDense() const {
+    QByteArray voxels(_voxelVolumeSize.x * _voxelVolumeSize.y * _voxelVolumeSize.z, '\0');
+    uint8_t* data = reinterpret_cast<uint8_t*>(voxels.data());
+
+    for (const auto& entry : _bricks) {
+        glm::ivec3 origin = getBrickOrigin(entry.first);
+        glm::ivec3 end = glm::min(origin + BRICK_SIZE, _voxelVolumeSize);
+        int rowLength = end.x - origin.x;
+
+        for (int z = origin.z; z < end.z; ++z) {
+            for (int y = origin.y; y < end.y; ++y) {
+                auto row = entry.second.begin() + getVoxelIndex(glm::ivec3(0, y, z) - origin);
+                std::copy(row, row + rowLength, data + (z * _voxelVolumeSize.y + y) * _voxelVolumeSize.x + origin.x);
+            }
+        }
+    }
+
+    return voxels;
+}
+
+uint8_t PolyVoxBricks::getVoxel(const glm::ivec3& v) const {
+    if (!isInVolume(v)) {
+        return 0;
+    }
+
+    auto brick = _bricks.find(getBrickIndex(v));
+    if (brick == _bricks.end()) {
+        return 0;
+    }
+    return brick->second[getVoxelIndex(v % BRICK_SIZE)];
+}
+
+bool PolyVoxBricks::setVoxel(const glm::ivec3& v, uint8_t toValue) {
+    if (!isInVolume(v)) {
+        return false;
+    }
+
+    int brickIndex = getBrickIndex(v);
+    auto brick = _bricks.find(brickIndex);
+    if (brick == _bricks.end()) {
+        if (toValue == 0) {
+            return false;
+        }
+        Brick emptyBrick;
+        emptyBrick.fill(0);
+        brick = _bricks.emplace(brickIndex, emptyBrick).first;
+    }
+
+    uint8_t& voxel = brick->second[getVoxelIndex(v % BRICK_SIZE)];
+    if (voxel == toValue) {
+        return false;
+    }
+    voxel = toValue;
+    return true;
+}
+
+int PolyVoxBricks::getBrickIndex(const glm::ivec3& v) const {
+    glm::ivec3 brick = v / BRICK_SIZE;
+    return (brick.z * _numBricks.y + brick.y) * _numBricks.x + brick.x;
+}
+
+glm::ivec3 PolyVoxBricks::getBrickOrigin(int brickIndex) const {
+    glm::ivec3 brick;
+    brick.x = brickIndex % _numBricks.x;
+    brick.y = (brickIndex / _numBricks.x) % _numBricks.y;
+    brick.z = brickIndex / (_numBricks.x * _numBricks.y);
+    return brick * BRICK_SIZE;
+}
+
+std::vector<int> PolyVoxBricks::diff(const PolyVoxBricks& other) const {
+    std::vector<int> changed;
+    if (_voxelVolumeSize != other._voxelVolumeSize) {
+        int numBricks = _numBricks.x * _numBricks.y * _numBricks.z;
+        changed.reserve(numBricks);
+        for (int brickIndex = 0; brickIndex < numBricks; ++brickIndex) {
+            changed.push_back(brickIndex);
+        }
+        return changed;
+    }
+
+    // a brick that isn't stored is empty
+    for (const auto& entry : _bricks) {
+        auto otherBrick = other._bricks.find(entry.first);
+        if (otherBrick == other._bricks.end() ? !isEmpty(entry.second) : otherBrick->second != entry.second) {
+            changed.push_back(entry.first);
+        }
+    }
+    for (const auto& entry : other._bricks) {
+        if (_bricks.find(entry.first) == _bricks.end() && !isEmpty(entry.second)) {
+            changed.push_back(entry.first);
+        }
+    }
+
+    std::sort(changed.begin(), changed.end());
+    return changed;
+}
+
+QByteArray PolyVoxBricks::makeDelta(const std::vector<int>& brickIndices) const {
+    QByteArray bricks;
+    {
+        QDataStream writer(&bricks, QIODevice::WriteOnly);
+        for (int brickIndex : brickIndices) {
+            auto brick = _bricks.find(brickIndex);
+            if (brick == _bricks.end() || isEmpty(brick->second)) {
+                writer << (quint16)brickIndex << BRICK_EMPTY;
+            } else {
+                writer << (quint16)brickIndex << BRICK_VOXELS;
+                writer.writeRawData(reinterpret_cast<const char*>(brick->second.data()), BRICK_VOLUME);
+            }
+        }
+    }
+
+    QByteArray delta;
+    QDataStream writer(&delta, QIODevice::WriteOnly | QIODevice::Truncate);
+    writer << DELTA_FORMAT_VERSION;
+    writer << (quint16)_voxelVolumeSize.x << (quint16)_voxelVolumeSize.y << (quint16)_voxelVolumeSize.z;
+    writer << qCompress(bricks, 9);
+    return delta;
+}
+
+bool PolyVoxBricks::applyDelta(const QByteArray& delta, std::vector<int>* changedBricks) {
+    QDataStream reader(delta);
+    quint8 formatVersion;
+    quint16 voxelXSize, voxelYSize, voxelZSize;
+    QByteArray compressedBricks;
+    reader >> formatVersion >> voxelXSize >> voxelYSize >> voxelZSize >> compressedBricks;
+    if (reader.status() != QDataStream::Ok || formatVersion != DELTA_FORMAT_VERSION ||
+        glm::ivec3(voxelXSize, voxelYSize, voxelZSize) != _voxelVolumeSize) {
+        return false;
+    }
+
+    // read every brick before changing any, so that a malformed delta is rejected as a whole
+    std::vector<std::pair<int, Brick>> bricks;
+    QByteArray uncompressedBricks = qUncompress(compressedBricks);
+    QDataStream brickReader(uncompressedBricks);
+    int numBricks = _numBricks.x * _numBricks.y * _numBricks.z;
+    while (!brickReader.atEnd()) {
+        quint16 brickIndex;
+        quint8 contents;
+        brickReader >> brickIndex >> contents;
+        if (brickReader.status() != QDataStream::Ok || brickIndex >= numBricks) {
+            return false;
+        }
+
+        Brick brick;
+        brick.fill(0);
+        if (contents == BRICK_VOXELS) {
+            if (brickReader.readRawData(reinterpret_cast<char*>(brick.data()), BRICK_VOLUME) != BRICK_VOLUME) {
+                return false;
+            }
+            clipToVolume(brickIndex, brick);
+        } else if (contents != BRICK_EMPTY) {
+            return false;
+        }
+        bricks.emplace_back(brickIndex, brick);
+    }
+
+    for (const auto& entry : bricks) {
+        auto brick = _bricks.find(entry.first);
+        bool wasEmpty = brick == _bricks.end() || isEmpty(brick->second);
+        bool willBeEmpty = isEmpty(entry.second);
+        if (wasEmpty && willBeEmpty) {
+            continue;
+        }
+        if (!wasEmpty && !willBeEmpty && brick->second == entry.second) {
+            continue;
+        }
+
+        if (willBeEmpty) {
+            _bricks.erase(brick);
+        } else {
+            _bricks[entry.first] = entry.second;
+        }
+        if (changedBricks) {
+            changedBricks->push_back(entry.first);
+        }
+    }
+
+    return true;
+}
+
+bool PolyVoxBricks::isEmpty(const Brick& brick) {
+    return std::all_of(brick.begin(), brick.end(), [](uint8_t voxel) { return voxel == 0; });
+}
+
+bool PolyVoxBricks::isInVolume(const glm::ivec3& v) const {
+    return glm::all(glm::greaterThanEqual(v, glm::ivec3(0))) && glm::all(glm::lessThan(v, _voxelVolumeSize));
+}
+
+void PolyVoxBricks::clipToVolume(int brickIndex, Brick& brick) const {
+    // the parts of bricks on the upper faces that lie outside of the volume are always 0
+    glm::ivec3 origin = getBrickOrigin(brickIndex);
+    glm::ivec3 end = glm::min(origin + BRICK_SIZE, _voxelVolumeSize) - origin;
+    if (end == glm::ivec3(BRICK_SIZE)) {
+        return;
+    }
+
+    for (int z = 0; z < BRICK_SIZE; ++z) {
+        for (int y = 0; y < BRICK_SIZE; ++y) {
+            for (int x = 0; x < BRICK_SIZE; ++x) {
+                if (x >= end.x || y >= end.y || z >= end.z) {
+                    brick[getVoxelIndex(glm::ivec3(x, y, z))] = 0;
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,81 @@
+//
+//  PolyVoxBricks.h
+//  libraries/entities/src
+//
+//  Created on 2026-10-16.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_PolyVoxBricks_h
+#define hifi_PolyVoxBricks_h
+
+#include <array>
+#include <unordered_map>
+#include <vector>
+
+#include <QByteArray>
+
+#include <glm/glm.hpp>
+
+// Voxel values of a PolyVox entity, split into cubic bricks of which only those with any voxels set are stored.
+//   Bricks are the unit of change for voxel edits: a delta carries the complete contents of just the bricks an edit
+//   touched, so applying it is idempotent and doesn't depend on which version of the volume it is applied over, and it
+//   tells whoever applies it which regions need to be re-meshed. The dense, compressed voxelData property is still what
+//   is persisted and what a delta is folded into.
+//   PolyVoxBricks is not thread-safe! It should be instantiated and used from a single thread, or guarded by the caller.
+class PolyVoxBricks {
+public:
+    static constexpr int BRICK_SIZE = 8;
+    static constexpr int BRICK_VOLUME = BRICK_SIZE * BRICK_SIZE * BRICK_SIZE;
+    using Brick = std::array<uint8_t, BRICK_VOLUME>;
+
+    PolyVoxBricks(const glm::ivec3& voxelVolumeSize = glm::ivec3(0));
+
+    // reads the voxelData property, x-major voxels compressed after the volume size
+    // \return false if it is malformed, leaving the bricks empty
+    bool fromVoxelData(const QByteArray& voxelData);
+    QByteArray toVoxelData() const;
+
+    // x-major voxels, as they are before compression in voxelData
+    void fromDense(const QByteArray& voxels, const glm::ivec3& voxelVolumeSize);
+    QByteArray toDense() const;
+
+    const glm::ivec3& getVoxelVolumeSize() const { return _voxelVolumeSize; }
+    const glm::ivec3& getNumBricks() const { return _numBricks; }
+    int getNumStoredBricks() const { return (int)_bricks.size(); }
+
+    // voxels outside of the volume read as 0 and can't be set
+    uint8_t getVoxel(const glm::ivec3& v) const;
+    // \return whether the voxel changed
+    bool setVoxel(const glm::ivec3& v, uint8_t toValue);
+
+    int getBrickIndex(const glm::ivec3& v) const;
+    glm::ivec3 getBrickOrigin(int brickIndex) const;
+
+    // the bricks whose contents differ from those of a volume of the same size, every brick if the size differs
+    std::vector<int> diff(const PolyVoxBricks& other) const;
+
+    // encodes the complete contents of some bricks
+    QByteArray makeDelta(const std::vector<int>& brickIndices) const;
+    // overwrites the bricks carried by a delta, which must have been made from a volume of the same size
+    // \return false if the delta is malformed or for another size of volume, in which case nothing is changed
+    bool applyDelta(const QByteArray& delta, std::vector<int>* changedBricks = nullptr);
+
+private:
+    static bool isEmpty(const Brick& brick);
+    static int getVoxelIndex(const glm::ivec3& v) { return ((v.z * BRICK_SIZE) + v.y) * BRICK_SIZE + v.x; }
+
+    bool isInVolume(const glm::ivec3& v) const;
+    void clipToVolume(int brickIndex, Brick& brick) const;
+
+    glm::ivec3 _voxelVolumeSize;
+    glm::ivec3 _numBricks;
+    std::unordered_map<int, Brick> _bricks;
+};
+
+#endif // hifi_PolyVoxBricks_h
@@ -24,6 +24,7 @@
 #include "EntityItemProperties.h"
 #include "EntityTree.h"
 #include "EntityTreeElement.h"
+#include "PolyVoxBricks.h"
 
 bool PolyVoxEntityItem::isEdged(PolyVoxSurfaceStyle surfaceStyle) {
     switch (surfaceStyle) {
@@ -121,6 +122,7 @@ bool PolyVoxEntityItem::setSubClassProperties(const EntityItemProperties& proper
     SET_ENTITY_PROPERTY_FROM_PROPERTIES(xPNeighborID, setXPNeighborID);
     SET_ENTITY_PROPERTY_FROM_PROPERTIES(yPNeighborID, setYPNeighborID);
     SET_ENTITY_PROPERTY_FROM_PROPERTIES(zPNeighborID, setZPNeighborID);
+    SET_ENTITY_PROPERTY_FROM_PROPERTIES(voxelDelta, applyVoxelDelta);
 
     return somethingChanged;
 }
@@ -201,17 +203,63 @@ void PolyVoxEntityItem::setVoxelData(const QByteArray& voxelData) {
     withWriteLock([&] {
         _voxelData = voxelData;
         _voxelDataDirty = true;
+        _voxelBricks.reset();
+        _voxelBricksChanged = false;
     });
 }
 
 QByteArray PolyVoxEntityItem::getVoxelData() const {
     QByteArray voxelDataCopy;
+    bool bricksChanged = false;
     withReadLock([&] {
         voxelDataCopy = _voxelData;
+        bricksChanged = _voxelBricksChanged;
     });
+
+    if (bricksChanged) {
+        withWriteLock([&] {
+            // another reader may have compressed them while we waited
+            if (_voxelBricksChanged) {
+                _voxelData = _voxelBricks->toVoxelData();
+                _voxelBricksChanged = false;
+            }
+            voxelDataCopy = _voxelData;
+        });
+    }
     return voxelDataCopy;
 }
 
+void PolyVoxEntityItem::applyVoxelDelta(const QByteArray& voxelDelta) {
+    // fold the bricks of an edit into the volume, which is persisted and sent on to everyone else as the full voxel data
+    bool applied = false;
+    withWriteLock([&] {
+        if (!_voxelBricks) {
+            auto bricks = std::make_shared<PolyVoxBricks>();
+            if (!bricks->fromVoxelData(_voxelData)) {
+                return;
+            }
+            _voxelBricks = bricks;
+        }
+        if (_voxelBricks->applyDelta(voxelDelta)) {
+            _voxelBricksChanged = true;
+            _voxelDataDirty = true;
+            applied = true;
+        }
+    });
+
+    if (!applied) {
+        qCDebug(entities) << "Ignoring voxel delta that doesn't fit the voxel data of" << getID();
+    }
+}
+
+bool PolyVoxEntityItem::applyVoxelDeltaTo(QByteArray& voxelData, const QByteArray& voxelDelta) {
+    PolyVoxBricks bricks;
+    if (!bricks.fromVoxelData(voxelData) || !bricks.applyDelta(voxelDelta)) {
+        return false;
+    }
+    voxelData = bricks.toVoxelData();
+    return true;
+}
 
 void PolyVoxEntityItem::setXTextureURL(const QString& xTextureURL) {
     withWriteLock([&] {
@@ -12,8 +12,12 @@
 #ifndef hifi_PolyVoxEntityItem_h
 #define hifi_PolyVoxEntityItem_h
 
+#include <memory>
+
 #include "EntityItem.h"
 
+class PolyVoxBricks;
+
 class PolyVoxEntityItem : public EntityItem {
  public:
     static EntityItemPointer factory(const EntityItemID& entityID, const EntityItemProperties& properties);
@@ -60,6 +64,10 @@ class PolyVoxEntityItem : public EntityItem {
     virtual void setVoxelData(const QByteArray& voxelData);
     virtual QByteArray getVoxelData() const;
 
+    // Applies an edit that only carries the bricks it changed, see PolyVoxBricks. The volume is kept decoded, and only
+    // compressed into the voxel data again when that is next asked for, so that a run of edits is compressed once.
+    virtual void applyVoxelDelta(const QByteArray& voxelDelta);
+
     virtual int getOnCount() const { return 0; }
 
     /*@jsdoc
@@ -177,8 +185,14 @@ class PolyVoxEntityItem : public EntityItem {
 
     glm::vec3 _voxelVolumeSize { DEFAULT_VOXEL_VOLUME_SIZE }; // this is always 3 bytes
 
-    QByteArray _voxelData { DEFAULT_VOXEL_DATA };
+    // folds a delta into voxel data right away, for subclasses that read _voxelData themselves
+    static bool applyVoxelDeltaTo(QByteArray& voxelData, const QByteArray& voxelDelta);
+
+    // NOTE: mutable, since getVoxelData() compresses _voxelBricks into it if deltas were applied since
+    mutable QByteArray _voxelData { DEFAULT_VOXEL_DATA };
     bool _voxelDataDirty { true }; // _voxelData has changed, things that depend on it should be updated
+    std::shared_ptr<PolyVoxBricks> _voxelBricks; // the volume, once a delta has been applied to it
+    mutable bool _voxelBricksChanged { false }; // since _voxelData was compressed from them
 
     PolyVoxSurfaceStyle _voxelSurfaceStyle { DEFAULT_VOXEL_SURFACE_STYLE };
 
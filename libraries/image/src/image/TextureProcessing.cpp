@@ -11,6 +11,8 @@
 
 #include "TextureProcessing.h"
 
+#include <mutex>
+
 #include <glm/gtc/packing.hpp>
 
 #include <QtCore/QtGlobal>
@@ -34,6 +36,9 @@
 using namespace gpu;
 
 #include <nvtt/nvtt.h>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
 
 #undef _CRT_SECURE_NO_WARNINGS
 #include <Etc2/Etc.h>
@@ -500,23 +505,58 @@ struct MyErrorHandler : public nvtt::ErrorHandler {
     }
 };
 
+// the arena that texture compression runs in, shared by every texture being processed, replaced when its concurrency
+// changes while any compression already running in the old one finishes there
+static std::mutex compressionArenaMutex;
+static std::shared_ptr<tbb::task_arena> compressionArena;
+
+static std::shared_ptr<tbb::task_arena> getCompressionArena() {
+    std::lock_guard<std::mutex> lock(compressionArenaMutex);
+    if (!compressionArena) {
+        compressionArena = std::make_shared<tbb::task_arena>(tbb::task_arena::automatic);
+    }
+    return compressionArena;
+}
+
+void setTextureCompressionConcurrency(int concurrency) {
+    std::lock_guard<std::mutex> lock(compressionArenaMutex);
+    compressionArena = std::make_shared<tbb::task_arena>(concurrency > 0 ? concurrency : (int)tbb::task_arena::automatic);
+}
+
+int getTextureCompressionConcurrency() {
+    auto arena = getCompressionArena();
+    arena->initialize();
+    return arena->max_concurrency();
+}
+
 #if defined(NVTT_API)
-class SequentialTaskDispatcher : public nvtt::TaskDispatcher {
+// Runs the tasks nvtt splits a compression into across the threads of the compression arena
+class ParallelTaskDispatcher : public nvtt::TaskDispatcher {
 public:
-    SequentialTaskDispatcher(const std::atomic<bool>& abortProcessing = false) : _abortProcessing(abortProcessing) {
+    ParallelTaskDispatcher(const std::atomic<bool>& abortProcessing) :
+        _abortProcessing(abortProcessing),
+        _arena(getCompressionArena()) {
     }
 
-    const std::atomic<bool>& _abortProcessing;
-
     void dispatch(nvtt::Task* task, void* context, int count) override {
-        for (int i = 0; i < count; i++) {
-            if (!_abortProcessing.load()) {
+        auto runTasks = [&](const tbb::blocked_range<int>& range) {
+            for (int i = range.begin(); i < range.end() && !_abortProcessing.load(); i++) {
                 task(context, i);
-            } else {
-                break;
             }
+        };
+
+        if (count <= 1) {
+            runTasks(tbb::blocked_range<int>(0, count));
+        } else {
+            _arena->execute([&] {
+                tbb::parallel_for(tbb::blocked_range<int>(0, count), runTasks);
+            });
         }
     }
+
+private:
+    const std::atomic<bool>& _abortProcessing;
+    std::shared_ptr<tbb::task_arena> _arena;
 };
 #endif
 
@@ -622,7 +662,7 @@ void convertImageToHDRTexture(gpu::Texture* texture, Image&& image, BackendTarge
     surface.setAlphaMode(nvtt::AlphaMode_None);
     surface.setWrapMode(nvtt::WrapMode_Mirror);
 
-    SequentialTaskDispatcher dispatcher(abortProcessing);
+    ParallelTaskDispatcher dispatcher(abortProcessing);
     nvtt::Compressor compressor;
     context.setTaskDispatcher(&dispatcher);
 
@@ -759,8 +799,9 @@ void convertImageToLDRTexture(gpu::Texture* texture, Image&& image, BackendTarge
         MyErrorHandler errorHandler;
         outputOptions.setErrorHandler(&errorHandler);
 
-        SequentialTaskDispatcher dispatcher(abortProcessing);
+        ParallelTaskDispatcher dispatcher(abortProcessing);
         nvtt::Compressor context;
+        context.setTaskDispatcher(&dispatcher);
 
         context.compress(surface, face, mipLevel++, compressionOptions, outputOptions);
         if (buildMips) {
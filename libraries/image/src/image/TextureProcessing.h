@@ -30,6 +30,11 @@ namespace image {
     void convertToPackedFromFloat(unsigned char* output, int width, int height, size_t outputLineByteStride, gpu::Element outputFormat,
                           const glm::vec4* source, size_t srcLinePixelStride);
 
+    // the number of threads that compressing each texture is split across, as many as there are cores unless
+    // concurrency is more than 0, shared by all of the textures being compressed at once
+    void setTextureCompressionConcurrency(int concurrency);
+    int getTextureCompressionConcurrency();
+
 namespace TextureUsage {
 
 /*@jsdoc
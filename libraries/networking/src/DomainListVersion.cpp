@@ -0,0 +1,38 @@
+//
+//  DomainListVersion.cpp
+//  libraries/networking/src
+//
+//  Created on 2026-10-16.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "DomainListVersion.h"
+
+void DomainListVersion::reset() {
+    _version = 0;
+    _pendingListNumber = 0;
+    _numPendingListPackets = 0;
+}
+
+bool DomainListVersion::processPacket(quint32 listNumber, quint16 numListPackets, quint64 listVersion,
+                                      quint64 listBaseVersion, bool newConnection) {
+    if (listNumber != _pendingListNumber) {
+        _pendingListNumber = listNumber;
+        _numPendingListPackets = 0;
+        if (newConnection) {
+            // the domain-server sends the whole list to a node that has just connected, whatever it had before
+            _version = 0;
+        }
+    }
+
+    // once we've had every packet of a list that follows on from the version we have, we have its version
+    ++_numPendingListPackets;
+    if (_numPendingListPackets >= numListPackets && listBaseVersion <= _version && listVersion > _version) {
+        _version = listVersion;
+        return true;
+    }
+    return false;
+}
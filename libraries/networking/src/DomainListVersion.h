@@ -0,0 +1,43 @@
+//
+//  DomainListVersion.h
+//  libraries/networking/src
+//
+//  Created on 2026-10-16.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_DomainListVersion_h
+#define hifi_DomainListVersion_h
+
+#include <atomic>
+
+#include <QtGlobal>
+
+// The version of the domain list that a node has all of, which it sends with each DomainListRequest so that the
+// domain-server only sends what has changed since. A list is sent as one or more unreliable packets, each carrying the
+// list's number, how many packets it has, its version and the version it follows on from. The node only has a list's
+// version once it has had every packet of it, and only if it has the version the list follows on from.
+class DomainListVersion {
+public:
+    quint64 get() const { return _version; }
+
+    // for a new domain-server, which sends the whole list
+    void reset();
+
+    // Called for each DomainList packet, after its nodes are processed. A packet with newConnection set starts a whole
+    // list, whatever version was had before. Returns true if the version advanced.
+    bool processPacket(quint32 listNumber, quint16 numListPackets, quint64 listVersion, quint64 listBaseVersion,
+                       bool newConnection);
+
+private:
+    std::atomic<quint64> _version { 0 };
+    quint32 _pendingListNumber { 0 };
+    int _numPendingListPackets { 0 };
+};
+
+#endif // hifi_DomainListVersion_h
@@ -21,24 +21,48 @@
 #if OPENSSL_VERSION_NUMBER >= 0x10100000
 HMACAuth::HMACAuth(AuthMethod authMethod)
     : _hmacContext(HMAC_CTX_new())
+    , _keyedContext(HMAC_CTX_new())
     , _authMethod(authMethod) { }
 
 HMACAuth::~HMACAuth()
 {
     HMAC_CTX_free(_hmacContext);
+    HMAC_CTX_free(_keyedContext);
+}
+
+namespace {
+    // per-thread scratch context that the keyed state is copied into for each hash
+    struct ScratchHMACContext {
+        ScratchHMACContext() : context(HMAC_CTX_new()) { }
+        ~ScratchHMACContext() { HMAC_CTX_free(context); }
+        HMAC_CTX* context;
+    };
 }
 
 #else
 
 HMACAuth::HMACAuth(AuthMethod authMethod)
     : _hmacContext(new HMAC_CTX())
+    , _keyedContext(new HMAC_CTX())
     , _authMethod(authMethod) {
     HMAC_CTX_init(_hmacContext);
+    HMAC_CTX_init(_keyedContext);
 }
 
 HMACAuth::~HMACAuth() {
     HMAC_CTX_cleanup(_hmacContext);
     delete _hmacContext;
+    HMAC_CTX_cleanup(_keyedContext);
+    delete _keyedContext;
+}
+
+namespace {
+    struct ScratchHMACContext {
+        ScratchHMACContext() : context(&storage) { HMAC_CTX_init(&storage); }
+        ~ScratchHMACContext() { HMAC_CTX_cleanup(&storage); }
+        HMAC_CTX storage;
+        HMAC_CTX* context;
+    };
 }
 #endif
 
@@ -71,7 +95,13 @@ bool HMACAuth::setKey(const char* keyValue, int keyLen) {
     }
 
     QMutexLocker lock(&_lock);
-    return (bool) HMAC_Init_ex(_hmacContext, keyValue, keyLen, sslStruct, nullptr);
+    if (!HMAC_Init_ex(_hmacContext, keyValue, keyLen, sslStruct, nullptr)) {
+        return false;
+    }
+
+    // keep an untouched copy of the keyed state for calculateHashFromKeyedState()
+    QWriteLocker keyedLock(&_keyedContextLock);
+    return (bool) HMAC_CTX_copy(_keyedContext, _hmacContext);
 }
 
 bool HMACAuth::setKey(const QUuid& uidKey) {
@@ -115,3 +145,25 @@ bool HMACAuth::calculateHash(HMACHash& hashResult, const char* data, int dataLen
     hashResult = result();
     return true;
 }
+
+bool HMACAuth::calculateHashFromKeyedState(HMACHash& hashResult, const char* data, int dataLen) const {
+    static thread_local ScratchHMACContext scratch;
+
+    {
+        QReadLocker keyedLock(&_keyedContextLock);
+        if (!HMAC_CTX_copy(scratch.context, _keyedContext)) {
+            return false;
+        }
+    }
+
+    hashResult.resize(EVP_MAX_MD_SIZE);
+    unsigned int hashLen;
+    if (!HMAC_Update(scratch.context, reinterpret_cast<const unsigned char*>(data), dataLen)
+        || !HMAC_Final(scratch.context, &hashResult[0], &hashLen)) {
+        qCWarning(networking) << "Error occured calculating hash from keyed HMAC state";
+        return false;
+    }
+
+    hashResult.resize((size_t)hashLen);
+    return true;
+}
@@ -15,6 +15,7 @@
 #include <vector>
 #include <memory>
 #include <QtCore/QMutex>
+#include <QtCore/QReadWriteLock>
 
 class QUuid;
 
@@ -38,9 +39,15 @@ public:
     // HMACAuth instance if this interface is used.
     HMACHash result();
 
+    // Calculate complete hash from a copy of the inner and outer digest states precomputed for the key by setKey(),
+    // without taking the lock of the incremental interface - safe to call from several threads at once.
+    bool calculateHashFromKeyedState(HMACHash& hashResult, const char* data, int dataLen) const;
+
 private:
     QRecursiveMutex _lock;
     struct hmac_ctx_st* _hmacContext;
+    mutable QReadWriteLock _keyedContextLock;
+    struct hmac_ctx_st* _keyedContext;
     AuthMethod _authMethod;
 };
 
@@ -0,0 +1,95 @@
+//
+//  HMACVerificationStage.cpp
+//  libraries/networking/src
+//
+//  Created on 2026-10-16.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "HMACVerificationStage.h"
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+
+#include <SharedUtil.h>
+
+#include "NLPacket.h"
+
+HMACVerificationStage::HMACVerificationStage(int maxConcurrency) :
+    _arena(new tbb::task_arena(maxConcurrency)),
+    _lastSampleUsecs(usecTimestampNow())
+{
+}
+
+HMACVerificationStage::~HMACVerificationStage() {
+}
+
+void HMACVerificationStage::verifyBatch(const std::vector<Job>& jobs) {
+    _expectedHashes.clear();
+    if (jobs.empty()) {
+        return;
+    }
+
+    auto start = usecTimestampNow();
+
+    _batchHashes.resize(jobs.size());
+    auto hashJobs = [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t i = range.begin(); i != range.end(); ++i) {
+            _batchHashes[i] = NLPacket::hashForPacketAndKeyedHMAC(*jobs[i].packet, *jobs[i].sourceNode->getAuthenticateHash());
+        }
+    };
+
+    if (jobs.size() < MIN_PARALLEL_BATCH_SIZE) {
+        hashJobs(tbb::blocked_range<size_t>(0, jobs.size()));
+    } else {
+        _arena->execute([&] {
+            tbb::parallel_for(tbb::blocked_range<size_t>(0, jobs.size()), hashJobs);
+        });
+        ++_numParallelBatches;
+    }
+
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        _expectedHashes[jobs[i].packet] = std::move(_batchHashes[i]);
+    }
+
+    auto batchUsecs = usecTimestampNow() - start;
+    ++_numBatches;
+    _numPackets += jobs.size();
+    _totalBatchUsecs += batchUsecs;
+
+    auto maxBatchUsecs = _maxBatchUsecs.load();
+    while (batchUsecs > maxBatchUsecs && !_maxBatchUsecs.compare_exchange_weak(maxBatchUsecs, batchUsecs)) { }
+}
+
+bool HMACVerificationStage::takeExpectedHash(const udt::Packet& packet, QByteArray& expectedHash) {
+    auto it = _expectedHashes.find(&packet);
+    if (it == _expectedHashes.end()) {
+        return false;
+    }
+
+    expectedHash = std::move(it->second);
+    _expectedHashes.erase(it);
+    return true;
+}
+
+QJsonObject HMACVerificationStage::sampleStats() {
+    auto now = usecTimestampNow();
+    auto elapsedUsecs = now - _lastSampleUsecs.exchange(now);
+
+    auto numBatches = _numBatches.exchange(0);
+    auto numPackets = _numPackets.exchange(0);
+    auto totalBatchUsecs = _totalBatchUsecs.exchange(0);
+
+    QJsonObject stats;
+    stats["batches"] = (qint64)numBatches;
+    stats["parallel_batches"] = (qint64)_numParallelBatches.exchange(0);
+    stats["packets"] = (qint64)numPackets;
+    stats["packets_per_second"] = elapsedUsecs > 0 ? (double)numPackets * USECS_PER_SECOND / elapsedUsecs : 0.0;
+    stats["avg_batch_latency_usecs"] = numBatches > 0 ? (double)totalBatchUsecs / numBatches : 0.0;
+    stats["max_batch_latency_usecs"] = (qint64)_maxBatchUsecs.exchange(0);
+    return stats;
+}
@@ -0,0 +1,70 @@
+//
+//  HMACVerificationStage.h
+//  libraries/networking/src
+//
+//  Created on 2026-10-16.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_HMACVerificationStage_h
+#define hifi_HMACVerificationStage_h
+
+#include <atomic>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QJsonObject>
+
+#include "Node.h"
+#include "udt/Packet.h"
+
+namespace tbb {
+    class task_arena;
+}
+
+// Computes the expected verification hashes of a batch of received packets on a small worker pool, ahead of the
+// in-order filtering of those packets on the socket thread. Each hash is calculated from the precomputed keyed state
+// of the source node's HMACAuth, so workers don't contend on the per-node HMACAuth lock.
+class HMACVerificationStage {
+public:
+    struct Job {
+        const udt::Packet* packet;
+        SharedNodePointer sourceNode; // keeps the node's HMACAuth alive while the batch is hashed
+    };
+
+    HMACVerificationStage(int maxConcurrency);
+    ~HMACVerificationStage();
+
+    // socket thread only - hashes the packets of the jobs, replacing the expected hashes of the previous batch
+    void verifyBatch(const std::vector<Job>& jobs);
+    // socket thread only - moves out the expected hash calculated for this packet, if there is one
+    bool takeExpectedHash(const udt::Packet& packet, QByteArray& expectedHash);
+    void clear() { _expectedHashes.clear(); }
+
+    // stats since the last call, safe to call from any thread
+    QJsonObject sampleStats();
+
+private:
+    // batches smaller than this are hashed inline on the socket thread
+    static const size_t MIN_PARALLEL_BATCH_SIZE = 4;
+
+    std::unique_ptr<tbb::task_arena> _arena;
+    std::vector<QByteArray> _batchHashes;
+    std::unordered_map<const udt::Packet*, QByteArray> _expectedHashes;
+
+    std::atomic<quint64> _numBatches { 0 };
+    std::atomic<quint64> _numParallelBatches { 0 };
+    std::atomic<quint64> _numPackets { 0 };
+    std::atomic<quint64> _totalBatchUsecs { 0 };
+    std::atomic<quint64> _maxBatchUsecs { 0 };
+    std::atomic<quint64> _lastSampleUsecs { 0 };
+};
+
+#endif // hifi_HMACVerificationStage_h
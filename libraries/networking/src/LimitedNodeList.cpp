@@ -20,6 +20,7 @@
 #include <QtCore/QDataStream>
 #include <QtCore/QDebug>
 #include <QtCore/QJsonDocument>
+#include <QtCore/QProcessEnvironment>
 #include <QtCore/QThread>
 #include <QtCore/QUrl>
 #include <QtNetwork/QTcpSocket>
@@ -51,6 +52,11 @@ static Setting::Handle<quint16> LIMITED_NODELIST_LOCAL_PORT("LimitedNodeList.Loc
 using namespace std::chrono_literals;
 static const std::chrono::milliseconds CONNECTION_RATE_INTERVAL_MS = 1s;
 
+// verifying received packet batches on a worker pool is opt-in, it only pays off for busy mixers
+static const bool PARALLEL_PACKET_VERIFICATION_DEFAULT =
+    QProcessEnvironment::systemEnvironment().contains("VIRCADIA_ENABLE_PARALLEL_PACKET_VERIFICATION");
+static const int MAX_PACKET_VERIFICATION_THREADS = 4;
+
 LimitedNodeList::LimitedNodeList(int socketListenPort, int dtlsListenPort) :
     _nodeSocket(this, true),
     _packetReceiver(new PacketReceiver(this))
@@ -115,6 +121,7 @@ LimitedNodeList::LimitedNodeList(int socketListenPort, int dtlsListenPort) :
     // set our isPacketVerified method as the verify operator for the udt::Socket
     using std::placeholders::_1;
     _nodeSocket.setPacketFilterOperator(std::bind(&LimitedNodeList::isPacketVerified, this, _1));
+    setParallelPacketVerificationEnabled(PARALLEL_PACKET_VERIFICATION_DEFAULT);
 
     // set our socketBelongsToNode method as the connection creation filter operator for the udt::Socket
     _nodeSocket.setConnectionCreationFilterOperator(std::bind(&LimitedNodeList::sockAddrBelongsToNode, this, _1));
@@ -260,6 +267,52 @@ bool LimitedNodeList::isPacketVerifiedWithSource(const udt::Packet& packet, Node
     return packetVersionMatch(packet) && packetSourceAndHashMatchAndTrackBandwidth(packet, sourceNode);
 }
 
+void LimitedNodeList::setParallelPacketVerificationEnabled(bool enabled) {
+    if (enabled && !_hmacVerificationStage) {
+        int numThreads = std::max(1, std::min(QThread::idealThreadCount() / 2, MAX_PACKET_VERIFICATION_THREADS));
+        _hmacVerificationStage.reset(new HMACVerificationStage(numThreads));
+        _nodeSocket.setPacketBatchFilterOperator(std::bind(&LimitedNodeList::verifyPacketBatch, this,
+                                                           std::placeholders::_1));
+    } else if (!enabled && _hmacVerificationStage) {
+        _nodeSocket.setPacketBatchFilterOperator(nullptr);
+        _hmacVerificationStage.reset();
+    }
+}
+
+QJsonObject LimitedNodeList::sampleParallelPacketVerificationStats() {
+    return _hmacVerificationStage ? _hmacVerificationStage->sampleStats() : QJsonObject();
+}
+
+void LimitedNodeList::verifyPacketBatch(const std::vector<const udt::Packet*>& packets) {
+    if (packets.empty()) {
+        // the batch has been filtered, drop any hashes that were not needed
+        _hmacVerificationStage->clear();
+        return;
+    }
+
+    // only hash the packets that packetSourceAndHashMatchAndTrackBandwidth would hash, the other checks stay in order
+    std::vector<HMACVerificationStage::Job> jobs;
+    jobs.reserve(packets.size());
+
+    for (auto packet : packets) {
+        PacketType headerType = NLPacket::typeInHeader(*packet);
+        if (NLPacket::versionInHeader(*packet) != versionForPacketType(headerType)
+            || PacketTypeEnum::getNonSourcedPackets().contains(headerType)
+            || PacketTypeEnum::getNonVerifiedPackets().contains(headerType)
+            || !_useAuthentication
+            || (isDomainServer() && PacketTypeEnum::getDomainIgnoredVerificationPackets().contains(headerType))) {
+            continue;
+        }
+
+        SharedNodePointer sourceNode = nodeWithLocalID(NLPacket::sourceIDInHeader(*packet));
+        if (sourceNode && sourceNode->getAuthenticateHash()) {
+            jobs.push_back({ packet, sourceNode });
+        }
+    }
+
+    _hmacVerificationStage->verifyBatch(jobs);
+}
+
 bool LimitedNodeList::packetVersionMatch(const udt::Packet& packet) {
     PacketType headerType = NLPacket::typeInHeader(packet);
     PacketVersion headerVersion = NLPacket::versionInHeader(packet);
@@ -373,7 +426,9 @@ bool LimitedNodeList::packetSourceAndHashMatchAndTrackBandwidth(const udt::Packe
                 QByteArray packetHeaderHash = NLPacket::verificationHashInHeader(packet);
                 QByteArray expectedHash;
                 auto sourceNodeHMACAuth = sourceNode->getAuthenticateHash();
-                if (sourceNode->getAuthenticateHash()) {
+                if (_hmacVerificationStage && _hmacVerificationStage->takeExpectedHash(packet, expectedHash)) {
+                    // the hash was calculated with the rest of its receive batch
+                } else if (sourceNodeHMACAuth) {
                     expectedHash = NLPacket::hashForPacketAndHMAC(packet, *sourceNodeHMACAuth);
                 }
 
@@ -39,6 +39,7 @@
 #include <DependencyManager.h>
 #include <SharedUtil.h>
 
+#include "HMACVerificationStage.h"
 #include "NetworkingConstants.h"
 #include "Node.h"
 #include "NLPacket.h"
@@ -119,6 +120,12 @@ public:
     };
     Q_ENUM(ConnectReason);
 
+    // what each entry of a DomainList packet is, written ahead of the entry as a quint8
+    enum DomainListEntryType : quint8 {
+        ListedNode = 0,
+        RemovedNode
+    };
+
     QUuid getSessionUUID() const;
     void setSessionUUID(const QUuid& sessionUUID);
     Node::LocalID getSessionLocalID() const;
@@ -320,6 +327,10 @@ public:
 
     void setConnectionMaxBandwidth(int maxBandwidth) { _nodeSocket.setConnectionMaxBandwidth(maxBandwidth); }
 
+    // mixers wrap the send phase of each frame in a send batch, which is a no-op unless batched send is enabled
+    void beginSendBatch() { _nodeSocket.beginSendBatch(); }
+    void endSendBatch() { _nodeSocket.endSendBatch(); }
+
     void setPacketFilterOperator(udt::PacketFilterOperator filterOperator) { _nodeSocket.setPacketFilterOperator(filterOperator); }
     bool packetVersionMatch(const udt::Packet& packet);
 
@@ -328,6 +339,11 @@ public:
     void setAuthenticatePackets(bool useAuthentication) { _useAuthentication = useAuthentication; }
     bool getAuthenticatePackets() const { return _useAuthentication; }
 
+    // verify the hashes of each batch of received packets on a small worker pool before they are filtered in order
+    void setParallelPacketVerificationEnabled(bool enabled);
+    bool isParallelPacketVerificationEnabled() const { return (bool)_hmacVerificationStage; }
+    QJsonObject sampleParallelPacketVerificationStats();
+
     void setFlagTimeForConnectionStep(bool flag) { _flagTimeForConnectionStep = flag; }
     bool isFlagTimeForConnectionStep() { return _flagTimeForConnectionStep; }
 
@@ -429,6 +445,7 @@ protected:
     void setLocalSocket(const SockAddr& sockAddr);
 
     bool packetSourceAndHashMatchAndTrackBandwidth(const udt::Packet& packet, Node* sourceNode = nullptr);
+    void verifyPacketBatch(const std::vector<const udt::Packet*>& packets);
     void processSTUNResponse(std::unique_ptr<udt::BasePacket> packet);
 
     void handleNodeKill(const SharedNodePointer& node, ConnectionID newConnectionID = NULL_CONNECTION_ID);
@@ -454,6 +471,7 @@ protected:
     SockAddr _stunSockAddr { SocketType::UDP, STUN_SERVER_HOSTNAME, STUN_SERVER_PORT };
     bool _hasTCPCheckedLocalSocket { false };
     bool _useAuthentication { true };
+    std::unique_ptr<HMACVerificationStage> _hmacVerificationStage;
 
     PacketReceiver* _packetReceiver;
 
@@ -62,43 +62,34 @@ void MessagesClient::decodeMessagesPacket(QSharedPointer<ReceivedMessage> receiv
 
 std::unique_ptr<NLPacketList> MessagesClient::encodeMessagesPacket(QString channel, QString message, QUuid senderID) {
     auto packetList = NLPacketList::create(PacketType::MessagesData, QByteArray(), true, true);
-
-    auto channelUtf8 = channel.toUtf8();
-    quint16 channelLength = channelUtf8.length();
-    packetList->writePrimitive(channelLength);
-    packetList->write(channelUtf8);
-
-    bool isTextMessage = true;
-    packetList->writePrimitive(isTextMessage);
-
-    auto messageUtf8 = message.toUtf8();
-    quint32 messageLength = messageUtf8.length();
-    packetList->writePrimitive(messageLength);
-    packetList->write(messageUtf8);
-
-    packetList->write(senderID.toRfc4122());
-
+    packetList->write(encodeMessagesPayload(channel, true, message.toUtf8(), senderID));
     return packetList;
 }
 
 std::unique_ptr<NLPacketList> MessagesClient::encodeMessagesDataPacket(QString channel, QByteArray data, QUuid senderID) {
     auto packetList = NLPacketList::create(PacketType::MessagesData, QByteArray(), true, true);
+    packetList->write(encodeMessagesPayload(channel, false, data, senderID));
+    return packetList;
+}
 
+QByteArray MessagesClient::encodeMessagesPayload(const QString& channel, bool isText, const QByteArray& message,
+                                                 const QUuid& senderID) {
     auto channelUtf8 = channel.toUtf8();
     quint16 channelLength = channelUtf8.length();
-    packetList->writePrimitive(channelLength);
-    packetList->write(channelUtf8);
+    quint32 messageLength = message.length();
 
-    bool isTextMessage = false;
-    packetList->writePrimitive(isTextMessage);
+    QByteArray payload;
+    payload.reserve(sizeof(channelLength) + channelLength + sizeof(isText) + sizeof(messageLength) + messageLength +
+                    NUM_BYTES_RFC4122_UUID);
 
-    quint32 dataLength = data.length();
-    packetList->writePrimitive(dataLength);
-    packetList->write(data);
+    payload.append(reinterpret_cast<const char*>(&channelLength), sizeof(channelLength));
+    payload.append(channelUtf8);
+    payload.append(reinterpret_cast<const char*>(&isText), sizeof(isText));
+    payload.append(reinterpret_cast<const char*>(&messageLength), sizeof(messageLength));
+    payload.append(message);
+    payload.append(senderID.toRfc4122());
 
-    packetList->write(senderID.toRfc4122());
-
-    return packetList;
+    return payload;
 }
 
 
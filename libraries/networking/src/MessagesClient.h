@@ -167,6 +167,9 @@ public:
 
     static std::unique_ptr<NLPacketList> encodeMessagesPacket(QString channel, QString message, QUuid senderID);
     static std::unique_ptr<NLPacketList> encodeMessagesDataPacket(QString channel, QByteArray data, QUuid senderID);
+    // the payload of a MessagesData packet, for sending the same message to several nodes
+    static QByteArray encodeMessagesPayload(const QString& channel, bool isText, const QByteArray& message,
+                                            const QUuid& senderID);
 
 signals:
     /*@jsdoc
@@ -36,7 +36,7 @@ std::unique_ptr<NLPacket> NLPacket::create(PacketType type, qint64 size, bool is
     return packet;
 }
 
-std::unique_ptr<NLPacket> NLPacket::fromReceivedPacket(std::unique_ptr<char[]> data, qint64 size,
+std::unique_ptr<NLPacket> NLPacket::fromReceivedPacket(udt::PacketData data, qint64 size,
                                                        const SockAddr& senderSockAddr) {
     // Fail with null data
     Q_ASSERT(data);
@@ -91,7 +91,7 @@ NLPacket::NLPacket(const NLPacket& other) : Packet(other) {
     _sourceID = other._sourceID;
 }
 
-NLPacket::NLPacket(std::unique_ptr<char[]> data, qint64 size, const SockAddr& senderSockAddr) :
+NLPacket::NLPacket(udt::PacketData data, qint64 size, const SockAddr& senderSockAddr) :
     Packet(std::move(data), size, senderSockAddr)
 {    
     // sanity check before we decrease the payloadSize with the payloadCapacity
@@ -166,6 +166,17 @@ QByteArray NLPacket::hashForPacketAndHMAC(const udt::Packet& packet, HMACAuth& h
     return QByteArray((const char*) hashResult.data(), (int) hashResult.size());
 }
 
+QByteArray NLPacket::hashForPacketAndKeyedHMAC(const udt::Packet& packet, const HMACAuth& hash) {
+    int offset = Packet::totalHeaderSize(packet.isPartOfMessage()) + sizeof(PacketType) + sizeof(PacketVersion)
+        + NUM_BYTES_LOCALID + NUM_BYTES_MD5_HASH;
+
+    HMACAuth::HMACHash hashResult;
+    if (!hash.calculateHashFromKeyedState(hashResult, packet.getData() + offset, packet.getDataSize() - offset)) {
+        return QByteArray();
+    }
+    return QByteArray((const char*) hashResult.data(), (int) hashResult.size());
+}
+
 void NLPacket::writeTypeAndVersion() {
     auto headerOffset = Packet::totalHeaderSize(isPartOfMessage());
     
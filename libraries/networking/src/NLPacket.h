@@ -59,7 +59,7 @@ public:
     static std::unique_ptr<NLPacket> create(PacketType type, qint64 size = -1,
                     bool isReliable = false, bool isPartOfMessage = false, PacketVersion version = 0);
     
-    static std::unique_ptr<NLPacket> fromReceivedPacket(std::unique_ptr<char[]> data, qint64 size,
+    static std::unique_ptr<NLPacket> fromReceivedPacket(udt::PacketData data, qint64 size,
                                                         const SockAddr& senderSockAddr);
 
     static std::unique_ptr<NLPacket> fromBase(std::unique_ptr<Packet> packet);
@@ -80,6 +80,8 @@ public:
     static LocalID sourceIDInHeader(const udt::Packet& packet);
     static QByteArray verificationHashInHeader(const udt::Packet& packet);
     static QByteArray hashForPacketAndHMAC(const udt::Packet& packet, HMACAuth& hash);
+    // thread-safe variant that hashes from the precomputed keyed state of the HMACAuth
+    static QByteArray hashForPacketAndKeyedHMAC(const udt::Packet& packet, const HMACAuth& hash);
     
     PacketType getType() const { return _type; }
     void setType(PacketType type);
@@ -95,7 +97,7 @@ public:
 protected:
     
     NLPacket(PacketType type, qint64 size = -1, bool forceReliable = false, bool isPartOfMessage = false, PacketVersion version = 0);
-    NLPacket(std::unique_ptr<char[]> data, qint64 size, const SockAddr& senderSockAddr);
+    NLPacket(udt::PacketData data, qint64 size, const SockAddr& senderSockAddr);
     
     NLPacket(const NLPacket& other);
     NLPacket(NLPacket&& other);
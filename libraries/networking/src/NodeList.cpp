@@ -323,6 +323,9 @@ void NodeList::reset(QString reason, bool skipDomainHandlerReset) {
     setSessionUUID(QUuid());
     setSessionLocalID(Node::NULL_LOCAL_ID);
 
+    // the next domain-server we connect to sends us its whole list
+    _domainListVersion.reset();
+
     // if we setup the DTLS socket, also disconnect from the DTLS socket readyRead() so it can handle handshaking
     if (_dtlsSocket) {
         disconnect(_dtlsSocket, 0, this, 0);
@@ -505,6 +508,11 @@ void NodeList::sendDomainServerCheckIn() {
             << localSockAddr << _nodeTypesOfInterest.values();
         packetStream << DependencyManager::get<AddressManager>()->getPlaceName();
 
+        if (domainPacketType == PacketType::DomainListRequest) {
+            // the version of the domain list we have all of, so that we're sent only what has changed since
+            packetStream << _domainListVersion.get();
+        }
+
         if (!domainIsConnected) {
 
             // Metaverse account.
@@ -766,6 +774,20 @@ void NodeList::processDomainList(QSharedPointer<ReceivedMessage> message) {
     bool newConnection;
     packetStream >> newConnection;
 
+    // the version of the domain list this is, the version it has the changes since (or 0 if it's the whole list),
+    // and which list and how many packets it is
+    quint64 domainListVersion;
+    packetStream >> domainListVersion;
+
+    quint64 domainListBaseVersion;
+    packetStream >> domainListBaseVersion;
+
+    quint32 domainListNumber;
+    packetStream >> domainListNumber;
+
+    quint16 numDomainListPackets;
+    packetStream >> numDomainListPackets;
+
     if (newConnection) {
         _nodeConnectTimestamp = usecTimestampNow();
         _connectReason = Connect;
@@ -862,10 +884,22 @@ void NodeList::processDomainList(QSharedPointer<ReceivedMessage> message) {
     setPermissions(newPermissions);
     setAuthenticatePackets(isAuthenticated);
 
-    // pull each node in the packet
+    // pull each entry in the packet, the nodes removed since the base version coming before those added or changed
     while (packetStream.device()->pos() < message->getSize()) {
-        parseNodeFromPacketStream(packetStream);
+        quint8 entryType;
+        packetStream >> entryType;
+        if (entryType == RemovedNode) {
+            QUuid nodeUUID;
+            packetStream >> nodeUUID;
+            killNodeWithUUID(nodeUUID);
+            removeDelayedAdd(nodeUUID);
+        } else {
+            parseNodeFromPacketStream(packetStream);
+        }
     }
+
+    _domainListVersion.processPacket(domainListNumber, numDomainListPackets, domainListVersion, domainListBaseVersion,
+                                     newConnection);
 }
 
 void NodeList::processDomainServerAddedNode(QSharedPointer<ReceivedMessage> message) {
@@ -35,6 +35,7 @@
 #include <SettingHandle.h>
 
 #include "DomainHandler.h"
+#include "DomainListVersion.h"
 #include "LimitedNodeList.h"
 #include "Node.h"
 
@@ -188,6 +189,8 @@ private:
     QTimer _keepAlivePingTimer;
     bool _requestsDomainListData { false };
 
+    DomainListVersion _domainListVersion;
+
     bool _sendDomainServerCheckInEnabled { true };
     bool _domainPortAutoDiscovery { true };
 
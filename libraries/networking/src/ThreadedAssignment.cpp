@@ -118,6 +118,9 @@ void ThreadedAssignment::addPacketStatsAndSendStatsPacket(QJsonObject statsObjec
     ioStats["inbound_pps"] = nodeList->getInboundPPS();
     ioStats["outbound_kbps"] = nodeList->getOutboundKbps();
     ioStats["outbound_pps"] = nodeList->getOutboundPPS();
+    if (nodeList->isParallelPacketVerificationEnabled()) {
+        ioStats["packet_verification"] = nodeList->sampleParallelPacketVerificationStats();
+    }
 
     statsObject["io_stats"] = ioStats;
 
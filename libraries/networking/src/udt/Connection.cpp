@@ -210,6 +210,10 @@ void Connection::recordReceivedUnreliablePackets(int wireSize, int payloadSize)
     _stats.recordUnreliableReceivedPackets(payloadSize, wireSize);
 }
 
+void Connection::recordSendBatch(int batchSize, int segmentedSends) {
+    _stats.recordSendBatch(batchSize, segmentedSends);
+}
+
 void Connection::sendACK() {
     SequenceNumber nextACKNumber = nextACK();
 
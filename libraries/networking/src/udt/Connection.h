@@ -77,6 +77,7 @@ public:
     
     void recordSentUnreliablePackets(int wireSize, int payloadSize);
     void recordReceivedUnreliablePackets(int wireSize, int payloadSize);
+    void recordSendBatch(int batchSize, int segmentedSends);
     void setDestinationAddress(const SockAddr& destination);
 
 signals:
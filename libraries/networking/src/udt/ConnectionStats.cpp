@@ -11,6 +11,8 @@
 
 #include "ConnectionStats.h"
 
+#include <algorithm>
+
 #include <QtCore/QDebug>
 
 using namespace udt;
@@ -82,6 +84,13 @@ void ConnectionStats::recordUnreliableReceivedPackets(int payload, int total) {
     _currentSample.receivedUnreliableBytes += total;
 }
 
+void ConnectionStats::recordSendBatch(int batchSize, int segmentedSends) {
+    ++_currentSample.sendBatches;
+    _currentSample.batchedPackets += batchSize;
+    _currentSample.maxSendBatchSize = std::max(_currentSample.maxSendBatchSize, (uint32_t)batchSize);
+    _currentSample.segmentedSends += segmentedSends;
+}
+
 void ConnectionStats::recordCongestionWindowSize(int sample) {
     _currentSample.congestionWindowSize = sample;
 }
@@ -106,6 +115,10 @@ QDebug& operator<<(QDebug&& debug, const udt::ConnectionStats::Stats& stats) {
     debug << "\n     Duplicate packets: " << stats.duplicatePackets;
     debug << "\n     Sent util bytes: " << stats.sentUtilBytes;
     debug << "\n     Sent bytes: " << stats.sentBytes;
-    debug << "\n     Received bytes: " << stats.receivedBytes << "\n";
+    debug << "\n     Received bytes: " << stats.receivedBytes;
+    debug << "\n     Send batches: " << stats.sendBatches;
+    debug << "\n     Batched packets: " << stats.batchedPackets;
+    debug << "\n     Max send batch size: " << stats.maxSendBatchSize;
+    debug << "\n     Segmented sends: " << stats.segmentedSends << "\n";
     return debug;
 }
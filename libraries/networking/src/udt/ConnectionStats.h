@@ -60,6 +60,13 @@ public:
         uint64_t receivedUnreliableUtilBytes { 0 };
         uint64_t sentUnreliableBytes { 0 };
         uint64_t receivedUnreliableBytes { 0 };
+
+        // batched egress - the number of send batch flushes that included this connection, the datagrams sent
+        // through them, the largest number of datagrams in one flush and the number of UDP GSO sends
+        uint32_t sendBatches { 0 };
+        uint32_t batchedPackets { 0 };
+        uint32_t maxSendBatchSize { 0 };
+        uint32_t segmentedSends { 0 };
        
         // the following stats are trailing averages in the result, not totals
         int sendRate { 0 };
@@ -91,6 +98,8 @@ public:
     void recordUnreliableSentPackets(int payload, int total);
     void recordUnreliableReceivedPackets(int payload, int total);
 
+    void recordSendBatch(int batchSize, int segmentedSends);
+
     void recordCongestionWindowSize(int sample);
     void recordPacketSendPeriod(int sample);
     
@@ -57,7 +57,7 @@ public:
     };
     
     static std::unique_ptr<ControlPacket> create(Type type, qint64 size = -1);
-    static std::unique_ptr<ControlPacket> fromReceivedPacket(std::unique_ptr<char[]> data, qint64 size,
+    static std::unique_ptr<ControlPacket> fromReceivedPacket(PacketData data, qint64 size,
                                                              const SockAddr& senderSockAddr);
     // Current level's header size
     static int localHeaderSize();
@@ -72,7 +72,7 @@ public:
 private:
     Q_DISABLE_COPY(ControlPacket)
     ControlPacket(Type type, qint64 size = -1);
-    ControlPacket(std::unique_ptr<char[]> data, qint64 size, const SockAddr& senderSockAddr);
+    ControlPacket(PacketData data, qint64 size, const SockAddr& senderSockAddr);
     ControlPacket(ControlPacket&& other);
     
     ControlPacket& operator=(ControlPacket&& other);
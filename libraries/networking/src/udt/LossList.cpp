@@ -11,34 +11,36 @@
 
 #include "LossList.h"
 
+#include <algorithm>
+
 #include "ControlPacket.h"
 
 using namespace udt;
 using namespace std;
 
 void LossList::append(SequenceNumber seq) {
-    Q_ASSERT_X(_lossList.empty() || (_lossList.back().second < seq), "LossList::append(SequenceNumber)",
+    Q_ASSERT_X(_count == 0 || (rangeAt(_count - 1).second < seq), "LossList::append(SequenceNumber)",
                "SequenceNumber appended is not greater than the last SequenceNumber in the list");
     
-    if (getLength() > 0 && _lossList.back().second + 1 == seq) {
-        ++_lossList.back().second;
+    if (getLength() > 0 && rangeAt(_count - 1).second + 1 == seq) {
+        ++rangeAt(_count - 1).second;
     } else {
-        _lossList.push_back(make_pair(seq, seq));
+        insertRangeAt(_count, make_pair(seq, seq));
     }
     _length += 1;
 }
 
 void LossList::append(SequenceNumber start, SequenceNumber end) {
-    Q_ASSERT_X(_lossList.empty() || (_lossList.back().second < start),
+    Q_ASSERT_X(_count == 0 || (rangeAt(_count - 1).second < start),
                "LossList::append(SequenceNumber, SequenceNumber)",
                "SequenceNumber range appended is not greater than the last SequenceNumber in the list");
     Q_ASSERT_X(start <= end,
                "LossList::append(SequenceNumber, SequenceNumber)", "Range start greater than range end");
 
-    if (getLength() > 0 && _lossList.back().second + 1 == start) {
-        _lossList.back().second = end;
+    if (getLength() > 0 && rangeAt(_count - 1).second + 1 == start) {
+        rangeAt(_count - 1).second = end;
     } else {
-        _lossList.push_back(make_pair(start, end));
+        insertRangeAt(_count, make_pair(start, end));
     }
     _length += seqlen(start, end);
 }
@@ -47,60 +49,62 @@ void LossList::insert(SequenceNumber start, SequenceNumber end) {
     Q_ASSERT_X(start <= end,
                "LossList::insert(SequenceNumber, SequenceNumber)", "Range start greater than range end");
     
-    auto it = find_if_not(_lossList.begin(), _lossList.end(), [&start](pair<SequenceNumber, SequenceNumber> pair){
-        return pair.second < start;
-    });
+    int index = findFirstRangeEndingAtOrAfter(start);
     
-    if (it == _lossList.end() || end < it->first) {
+    if (index == _count || end < rangeAt(index).first) {
         // No overlap, simply insert
         _length += seqlen(start, end);
-        _lossList.insert(it, make_pair(start, end));
+        insertRangeAt(index, make_pair(start, end));
     } else {
+        auto& range = rangeAt(index);
+
         // If it starts before segment, extend segment
-        if (start < it->first) {
-            _length += seqlen(start, it->first - 1);
-            it->first = start;
+        if (start < range.first) {
+            _length += seqlen(start, range.first - 1);
+            range.first = start;
         }
         
         // If it ends after segment, extend segment
-        if (end > it->second) {
-            _length += seqlen(it->second + 1, end);
-            it->second = end;
+        if (end > range.second) {
+            _length += seqlen(range.second + 1, end);
+            range.second = end;
         }
         
-        auto it2 = it;
-        ++it2;
         // For all ranges touching the current range
-        while (it2 != _lossList.end() && it->second >= it2->first - 1) {
+        int next = index + 1;
+        while (next < _count && range.second >= rangeAt(next).first - 1) {
+            const auto& nextRange = rangeAt(next);
+
             // extend current range if necessary
-            if (it->second < it2->second) {
-                _length += seqlen(it->second + 1, it2->second);
-                it->second = it2->second;
+            if (range.second < nextRange.second) {
+                _length += seqlen(range.second + 1, nextRange.second);
+                range.second = nextRange.second;
             }
             
-            // Remove overlapping range
-            _length -= seqlen(it2->first, it2->second);
-            it2 = _lossList.erase(it2);
+            // Drop overlapping range
+            _length -= seqlen(nextRange.first, nextRange.second);
+            ++next;
         }
+        eraseRangesAt(index + 1, next - (index + 1));
     }
 }
 
 bool LossList::remove(SequenceNumber seq) {
-    auto it = find_if(_lossList.begin(), _lossList.end(), [&seq](pair<SequenceNumber, SequenceNumber> pair) {
-        return pair.first <= seq && seq <= pair.second;
-    });
+    int index = findFirstRangeEndingAtOrAfter(seq);
     
-    if (it != end(_lossList)) {
-        if (it->first == it->second) {
-            _lossList.erase(it);
-        } else if (seq == it->first) {
-            ++it->first;
-        } else if (seq == it->second) {
-            --it->second;
+    if (index < _count && rangeAt(index).first <= seq) {
+        auto& range = rangeAt(index);
+
+        if (range.first == range.second) {
+            eraseRangesAt(index);
+        } else if (seq == range.first) {
+            ++range.first;
+        } else if (seq == range.second) {
+            --range.second;
         } else {
-            auto temp = it->second;
-            it->second = seq - 1;
-            _lossList.insert(++it, make_pair(seq + 1, temp));
+            auto temp = range.second;
+            range.second = seq - 1;
+            insertRangeAt(index + 1, make_pair(seq + 1, temp));
         }
         _length -= 1;
         
@@ -116,63 +120,70 @@ void LossList::remove(SequenceNumber start, SequenceNumber end) {
     Q_ASSERT_X(start <= end,
                "LossList::remove(SequenceNumber, SequenceNumber)", "Range start greater than range end");
     // Find the first segment sharing sequence numbers
-    auto it = find_if(_lossList.begin(), _lossList.end(), [&start, &end](pair<SequenceNumber, SequenceNumber> pair) {
-        return (pair.first <= start && start <= pair.second) || (start <= pair.first && pair.first <= end);
-    });
-    
+    int index = findFirstRangeEndingAtOrAfter(start);
+
     // If we found one
-    if (it != _lossList.end()) {
-        
-        // While the end of the current segment is contained, either shorten it (first one only - sometimes)
-        // or remove it altogether since it is fully contained it the range
-        while (it != _lossList.end() && end >= it->second) {
-            if (start <= it->first) {
-                // Segment is contained, update new length and erase it.
-                _length -= seqlen(it->first, it->second);
-                it = _lossList.erase(it);
-            } else {
-                // Beginning of segment not contained, modify end of segment.
-                // Will only occur sometimes one the first loop
-                _length -= seqlen(start, it->second);
-                it->second = start - 1;
-                ++it;
-            }
-        }
-        
-        // There might be more to remove
-        if (it != _lossList.end() && it->first <= end) {
-            if (start <= it->first) {
-                // Truncate beginning of segment
-                _length -= seqlen(it->first, end);
-                it->first = end + 1;
-            } else {
+    if (index < _count && rangeAt(index).first <= end) {
+        auto& first = rangeAt(index);
+
+        if (first.first < start) {
+            if (end < first.second) {
                 // Cut it in half if the range we are removing is contained within one segment
                 _length -= seqlen(start, end);
-                auto temp = it->second;
-                it->second = start - 1;
-                _lossList.insert(++it, make_pair(end + 1, temp));
+                auto temp = first.second;
+                first.second = start - 1;
+                insertRangeAt(index + 1, make_pair(end + 1, temp));
+                return;
             }
+
+            // Beginning of segment not contained, modify end of segment.
+            _length -= seqlen(start, first.second);
+            first.second = start - 1;
+            ++index;
+        }
+
+        // Remove all the segments that are fully contained in the range
+        int last = index;
+        while (last < _count && end >= rangeAt(last).second) {
+            _length -= seqlen(rangeAt(last).first, rangeAt(last).second);
+            ++last;
+        }
+        eraseRangesAt(index, last - index);
+
+        // There might be more to remove, truncate beginning of segment
+        if (index < _count && rangeAt(index).first <= end) {
+            _length -= seqlen(rangeAt(index).first, end);
+            rangeAt(index).first = end + 1;
         }
     }
 }
 
 SequenceNumber LossList::getFirstSequenceNumber() const {
     Q_ASSERT_X(getLength() > 0, "LossList::getFirstSequenceNumber()", "Trying to get first element of an empty list");
-    return _lossList.front().first;
+    return rangeAt(0).first;
 }
 
 SequenceNumber LossList::popFirstSequenceNumber() {
     auto front = getFirstSequenceNumber();
-    remove(front);
+
+    auto& range = rangeAt(0);
+    if (range.first == range.second) {
+        eraseRangesAt(0);
+    } else {
+        ++range.first;
+    }
+    _length -= 1;
+
     return front;
 }
 
 void LossList::write(ControlPacket& packet, int maxPairs) {
     int writtenPairs = 0;
     
-    for (const auto& pair : _lossList) {
-        packet.writePrimitive(pair.first);
-        packet.writePrimitive(pair.second);
+    for (int i = 0; i < _count; ++i) {
+        const auto& range = rangeAt(i);
+        packet.writePrimitive(range.first);
+        packet.writePrimitive(range.second);
         
         ++writtenPairs;
         
@@ -182,3 +193,66 @@ void LossList::write(ControlPacket& packet, int maxPairs) {
         }
     }
 }
+
+int LossList::findFirstRangeEndingAtOrAfter(SequenceNumber seq) const {
+    // binary search, the ranges are sorted and disjoint
+    int low = 0;
+    int high = _count;
+    while (low < high) {
+        int middle = low + (high - low) / 2;
+        if (rangeAt(middle).second < seq) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+void LossList::insertRangeAt(int index, const Range& range) {
+    if (_count == (int)_ranges.size()) {
+        // full - unwrap the ring into a buffer twice the size
+        static const int MIN_CAPACITY = 16;
+        std::vector<Range> ranges(std::max(MIN_CAPACITY, _count * 2));
+        for (int i = 0; i < _count; ++i) {
+            ranges[i] = rangeAt(i);
+        }
+        _ranges.swap(ranges);
+        _head = 0;
+    }
+
+    // move whichever side of the insertion point is shorter
+    if (index < _count - index) {
+        _head = (_head - 1) & (_ranges.size() - 1);
+        for (int i = 0; i < index; ++i) {
+            rangeAt(i) = rangeAt(i + 1);
+        }
+    } else {
+        for (int i = _count; i > index; --i) {
+            rangeAt(i) = rangeAt(i - 1);
+        }
+    }
+
+    rangeAt(index) = range;
+    ++_count;
+}
+
+void LossList::eraseRangesAt(int index, int count) {
+    if (count <= 0) {
+        return;
+    }
+
+    // move whichever side of the erased ranges is shorter
+    if (index < _count - (index + count)) {
+        for (int i = index - 1; i >= 0; --i) {
+            rangeAt(i + count) = rangeAt(i);
+        }
+        _head = (_head + count) & (_ranges.size() - 1);
+    } else {
+        for (int i = index; i + count < _count; ++i) {
+            rangeAt(i) = rangeAt(i + count);
+        }
+    }
+
+    _count -= count;
+}
@@ -12,7 +12,8 @@
 #ifndef hifi_LossList_h
 #define hifi_LossList_h
 
-#include <list>
+#include <utility>
+#include <vector>
 
 #include "SequenceNumber.h"
 
@@ -20,17 +21,22 @@ namespace udt {
 
 class ControlPacket;
     
+// Ordered set of lost sequence number ranges. The ranges are kept in a contiguous ring buffer so that the common
+// operations (append at the back, pop from the front) are O(1) and everything else is a binary search plus a short
+// move of neighbouring ranges, with no per-range allocation.
 class LossList {
 public:
+    using Range = std::pair<SequenceNumber, SequenceNumber>;
+
     LossList() {}
     
-    void clear() { _length = 0; _lossList.clear(); }
+    void clear() { _length = 0; _head = 0; _count = 0; }
     
     // must always add at the end - faster than insert
     void append(SequenceNumber seq);
     void append(SequenceNumber start, SequenceNumber end);
     
-    // inserts anywhere - MUCH slower
+    // inserts anywhere - O(log n) search, moves at most half of the ranges
     void insert(SequenceNumber start, SequenceNumber end);
     
     bool remove(SequenceNumber seq);
@@ -44,8 +50,17 @@ public:
     void write(ControlPacket& packet, int maxPairs = -1);
     
 private:
-    std::list<std::pair<SequenceNumber, SequenceNumber>> _lossList;
-    int _length { 0 };
+    Range& rangeAt(int index) { return _ranges[(_head + index) & (_ranges.size() - 1)]; }
+    const Range& rangeAt(int index) const { return _ranges[(_head + index) & (_ranges.size() - 1)]; }
+
+    int findFirstRangeEndingAtOrAfter(SequenceNumber seq) const;
+    void insertRangeAt(int index, const Range& range);
+    void eraseRangesAt(int index, int count = 1);
+
+    std::vector<Range> _ranges; // ring buffer, the size is always zero or a power of two
+    int _head { 0 }; // index in _ranges of the first range
+    int _count { 0 }; // number of ranges
+    int _length { 0 }; // number of sequence numbers in all ranges
 };
     
 }
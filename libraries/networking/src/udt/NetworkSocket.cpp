@@ -9,6 +9,19 @@
 
 #include "NetworkSocket.h"
 
+#if defined(Q_OS_LINUX)
+#include <algorithm>
+#include <errno.h>
+#include <netinet/in.h>
+#include <netinet/udp.h>
+#include <string.h>
+#include <sys/socket.h>
+
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103 // from linux/udp.h, for C libraries that predate UDP GSO
+#endif
+#endif
+
 #include "../NetworkLogging.h"
 
 
@@ -142,6 +155,108 @@ qint64 NetworkSocket::writeDatagram(const QByteArray& datagram, const SockAddr&
     }
 }
 
+#if defined(Q_OS_LINUX)
+static socklen_t toNativeSockAddr(const SockAddr& sockAddr, sockaddr_storage& native) {
+    memset(&native, 0, sizeof(native));
+
+    const QHostAddress& address = sockAddr.getAddress();
+    if (address.protocol() == QAbstractSocket::IPv6Protocol) {
+        auto addr6 = reinterpret_cast<sockaddr_in6*>(&native);
+        addr6->sin6_family = AF_INET6;
+        addr6->sin6_port = htons(sockAddr.getPort());
+        Q_IPV6ADDR ipv6 = address.toIPv6Address();
+        memcpy(&addr6->sin6_addr, &ipv6, sizeof(ipv6));
+        return sizeof(sockaddr_in6);
+    } else {
+        auto addr4 = reinterpret_cast<sockaddr_in*>(&native);
+        addr4->sin_family = AF_INET;
+        addr4->sin_port = htons(sockAddr.getPort());
+        addr4->sin_addr.s_addr = htonl(address.toIPv4Address());
+        return sizeof(sockaddr_in);
+    }
+}
+
+int NetworkSocket::writeUDPDatagramRuns(const std::vector<UDPDatagramRun>& runs, bool segment) {
+    union SegmentControl {
+        char buffer[CMSG_SPACE(sizeof(uint16_t))];
+        cmsghdr align;
+    };
+
+    size_t numDatagrams = 0;
+    for (const auto& run : runs) {
+        numDatagrams += run.datagrams.size();
+    }
+    size_t numMessages = segment ? runs.size() : numDatagrams;
+
+    // everything is sized up front so that the pointers between these stay valid
+    std::vector<mmsghdr> messages(numMessages);
+    std::vector<iovec> iovecs(numDatagrams);
+    std::vector<sockaddr_storage> addresses(runs.size());
+    std::vector<SegmentControl> controls(segment ? runs.size() : 0);
+
+    size_t messageIndex = 0;
+    size_t iovecIndex = 0;
+    for (size_t runIndex = 0; runIndex < runs.size(); ++runIndex) {
+        const auto& run = runs[runIndex];
+        socklen_t addressLength = toNativeSockAddr(run.sockAddr, addresses[runIndex]);
+
+        for (size_t i = 0; i < run.datagrams.size(); ++i) {
+            iovecs[iovecIndex + i].iov_base = const_cast<char*>(run.datagrams[i]->constData());
+            iovecs[iovecIndex + i].iov_len = run.datagrams[i]->size();
+        }
+
+        if (segment) {
+            auto& message = messages[messageIndex++];
+            memset(&message, 0, sizeof(message));
+            message.msg_hdr.msg_name = &addresses[runIndex];
+            message.msg_hdr.msg_namelen = addressLength;
+            message.msg_hdr.msg_iov = &iovecs[iovecIndex];
+            message.msg_hdr.msg_iovlen = run.datagrams.size();
+
+            if (run.datagrams.size() > 1) {
+                // ask for the payload to be split into datagrams the size of the first one
+                message.msg_hdr.msg_control = controls[runIndex].buffer;
+                message.msg_hdr.msg_controllen = sizeof(controls[runIndex].buffer);
+
+                cmsghdr* control = CMSG_FIRSTHDR(&message.msg_hdr);
+                control->cmsg_level = SOL_UDP;
+                control->cmsg_type = UDP_SEGMENT;
+                control->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+                uint16_t segmentSize = (uint16_t)run.datagrams.front()->size();
+                memcpy(CMSG_DATA(control), &segmentSize, sizeof(segmentSize));
+            }
+        } else {
+            for (size_t i = 0; i < run.datagrams.size(); ++i) {
+                auto& message = messages[messageIndex++];
+                memset(&message, 0, sizeof(message));
+                message.msg_hdr.msg_name = &addresses[runIndex];
+                message.msg_hdr.msg_namelen = addressLength;
+                message.msg_hdr.msg_iov = &iovecs[iovecIndex + i];
+                message.msg_hdr.msg_iovlen = 1;
+            }
+        }
+
+        iovecIndex += run.datagrams.size();
+    }
+
+    int fd = (int)_udpSocket.socketDescriptor();
+    size_t numSent = 0;
+    while (numSent < numMessages) {
+        int result = sendmmsg(fd, &messages[numSent], (unsigned int)(numMessages - numSent), 0);
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            // leave the rest to the caller, who must know which were sent so as not to send them again
+            return numSent > 0 ? (int)numSent : -1;
+        }
+        numSent += result;
+    }
+
+    return (int)numSent;
+}
+#endif
+
 qint64 NetworkSocket::bytesToWrite(SocketType socketType, const SockAddr& address) const {
     switch (socketType) {
     case SocketType::UDP:
@@ -224,6 +339,50 @@ qint64 NetworkSocket::readDatagram(char* data, qint64 maxSize, SockAddr* sockAdd
 }
 
 
+#if defined(Q_OS_LINUX)
+int NetworkSocket::readUDPDatagrams(char* const* buffers, qint64 bufferSize, qint64* sizes, SockAddr* sockAddrs,
+                                    int maxDatagrams) {
+    static const int MAX_BATCH_SIZE = 64;
+    maxDatagrams = std::min(maxDatagrams, MAX_BATCH_SIZE);
+
+    struct mmsghdr messages[MAX_BATCH_SIZE];
+    struct iovec iovecs[MAX_BATCH_SIZE];
+    struct sockaddr_storage addresses[MAX_BATCH_SIZE];
+
+    for (int i = 0; i < maxDatagrams; ++i) {
+        iovecs[i].iov_base = buffers[i];
+        iovecs[i].iov_len = bufferSize;
+
+        memset(&messages[i], 0, sizeof(messages[i]));
+        messages[i].msg_hdr.msg_iov = &iovecs[i];
+        messages[i].msg_hdr.msg_iovlen = 1;
+        messages[i].msg_hdr.msg_name = &addresses[i];
+        messages[i].msg_hdr.msg_namelen = sizeof(addresses[i]);
+    }
+
+    int numRead = recvmmsg((int)_udpSocket.socketDescriptor(), messages, maxDatagrams, MSG_DONTWAIT, nullptr);
+    if (numRead < 0) {
+        return (errno == EAGAIN || errno == EWOULDBLOCK) ? 0 : -1;
+    }
+
+    for (int i = 0; i < numRead; ++i) {
+        sizes[i] = (messages[i].msg_hdr.msg_flags & MSG_TRUNC) ? -1 : (qint64)messages[i].msg_len;
+
+        const auto address = reinterpret_cast<const sockaddr*>(&addresses[i]);
+        quint16 port = address->sa_family == AF_INET6
+            ? ntohs(reinterpret_cast<const sockaddr_in6*>(address)->sin6_port)
+            : ntohs(reinterpret_cast<const sockaddr_in*>(address)->sin_port);
+
+        sockAddrs[i].setType(SocketType::UDP);
+        sockAddrs[i].setAddress(QHostAddress(address));
+        sockAddrs[i].setPort(port);
+    }
+
+    return numRead;
+}
+#endif
+
+
 QAbstractSocket::SocketState NetworkSocket::state(SocketType socketType) const {
     switch (socketType) {
     case SocketType::UDP:
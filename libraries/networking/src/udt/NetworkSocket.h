@@ -10,6 +10,8 @@
 #ifndef vircadia_NetworkSocket_h
 #define vircadia_NetworkSocket_h
 
+#include <vector>
+
 #include <QObject>
 #include <QUdpSocket>
 
@@ -78,6 +80,25 @@ public:
     /// @return The number of bytes if successfully sent, otherwise <code>-1</code>.
     qint64 writeDatagram(const QByteArray& datagram, const SockAddr& sockAddr);
 
+#if defined(Q_OS_LINUX)
+    /// @brief A run of UDP datagrams to the same address, in send order.
+    struct UDPDatagramRun {
+        SockAddr sockAddr;
+        /// @brief The datagrams of the run. When segmented, all but the last must be the same size and the last must not
+        /// be larger than the others.
+        std::vector<const QByteArray*> datagrams;
+    };
+
+    /// @brief Sends runs of UDP datagrams with as few <code>sendmmsg</code> system calls as possible.
+    /// @param runs The runs of datagrams to send.
+    /// @param segment If <code>true</code>, each run is sent as a single UDP GSO (<code>UDP_SEGMENT</code>) message that the
+    /// kernel or NIC splits into the individual datagrams, otherwise each datagram is its own message.
+    /// @return The number of messages sent, which are always the first ones, or <code>-1</code> if none were. If fewer than
+    /// all were sent <code>errno</code> is set for the first that wasn't. <code>EIO</code> or <code>EINVAL</code> with
+    /// <code>segment</code> set indicates that UDP GSO is not supported.
+    int writeUDPDatagramRuns(const std::vector<UDPDatagramRun>& runs, bool segment);
+#endif
+
     /// @brief Gets the number of bytes waiting to be written.
     /// @details For UDP, there's a single buffer used for all destinations. For WebRTC, each destination has its own buffer.
     /// @param socketType The type of socket for which to get the number of bytes waiting to be written.
@@ -103,6 +124,20 @@ public:
     /// @return The number of bytes if successfully read, otherwise <code>-1</code>.
     qint64 readDatagram(char* data, qint64 maxSize, SockAddr* sockAddr = nullptr);
 
+#if defined(Q_OS_LINUX)
+    /// @brief Reads up to <code>maxDatagrams</code> pending UDP datagrams with a single non-blocking system call.
+    /// @details This bypasses the QUdpSocket, so it should only be used to drain the socket after at least one
+    /// readDatagram() call for the current readyRead signal - that call re-arms the QUdpSocket read notifier.
+    /// @param buffers The destinations to write the data of each datagram into.
+    /// @param bufferSize The size of each of the destination buffers.
+    /// @param sizes The destination to write the size of each datagram into. A size of <code>-1</code> indicates a
+    /// datagram that was truncated because it was larger than <code>bufferSize</code>.
+    /// @param sockAddrs The destinations to write the source network address of each datagram into.
+    /// @param maxDatagrams The maximum number of datagrams to read.
+    /// @return The number of datagrams read, <code>0</code> if there were none pending, otherwise <code>-1</code>.
+    int readUDPDatagrams(char* const* buffers, qint64 bufferSize, qint64* sizes, SockAddr* sockAddrs, int maxDatagrams);
+#endif
+
 
     /// @brief Gets the state of the UDP or WebRTC socket.
     /// @param socketType The type of socket for which to get the state.
@@ -0,0 +1,67 @@
+//
+//  PacketBufferPool.cpp
+//  libraries/networking/src/udt
+//
+//  Created on 2026-10-16.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PacketBufferPool.h"
+
+using namespace udt;
+
+void PacketDataDeleter::operator()(char* data) const {
+    if (_pool) {
+        _pool->release(data);
+    } else {
+        delete[] data;
+    }
+}
+
+std::shared_ptr<PacketBufferPool> PacketBufferPool::create(size_t maxPooledBuffers) {
+    return std::shared_ptr<PacketBufferPool>(new PacketBufferPool(maxPooledBuffers));
+}
+
+PacketBufferPool::~PacketBufferPool() {
+    for (auto buffer : _freeBuffers) {
+        delete[] buffer;
+    }
+}
+
+PacketData PacketBufferPool::acquire() {
+    char* buffer = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!_freeBuffers.empty()) {
+            buffer = _freeBuffers.back();
+            _freeBuffers.pop_back();
+        }
+    }
+
+    if (!buffer) {
+        buffer = new char[BUFFER_SIZE];
+    }
+
+    return PacketData(buffer, PacketDataDeleter(shared_from_this()));
+}
+
+void PacketBufferPool::release(char* buffer) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_freeBuffers.size() < _maxPooledBuffers) {
+            _freeBuffers.push_back(buffer);
+            return;
+        }
+    }
+
+    // the pool is full, this buffer was only needed for a burst
+    delete[] buffer;
+}
+
+size_t PacketBufferPool::getNumPooledBuffers() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _freeBuffers.size();
+}
@@ -0,0 +1,72 @@
+//
+//  PacketBufferPool.h
+//  libraries/networking/src/udt
+//
+//  Created on 2026-10-16.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_PacketBufferPool_h
+#define hifi_PacketBufferPool_h
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "Constants.h"
+
+namespace udt {
+
+class PacketBufferPool;
+
+// Frees the data of a packet - buffers that came from a PacketBufferPool are handed back to it instead of deleted.
+// Implicitly constructible from std::default_delete so that a std::unique_ptr<char[]> converts to PacketData.
+class PacketDataDeleter {
+public:
+    PacketDataDeleter() = default;
+    PacketDataDeleter(const std::default_delete<char[]>&) {}
+    PacketDataDeleter(std::shared_ptr<PacketBufferPool> pool) : _pool(std::move(pool)) {}
+
+    void operator()(char* data) const;
+
+private:
+    std::shared_ptr<PacketBufferPool> _pool;
+};
+
+using PacketData = std::unique_ptr<char[], PacketDataDeleter>;
+
+// Thread-safe free list of MTU sized receive buffers. Received packets are usually destroyed on a different thread
+// than the socket thread that read them, so the deleter of every pooled buffer keeps the pool alive.
+class PacketBufferPool : public std::enable_shared_from_this<PacketBufferPool> {
+public:
+    // large enough for any datagram we could have sent, including the UDP/IP header allowance
+    static const int BUFFER_SIZE = MAX_PACKET_SIZE_WITH_UDP_HEADER;
+
+    static std::shared_ptr<PacketBufferPool> create(size_t maxPooledBuffers);
+    ~PacketBufferPool();
+
+    // returns a BUFFER_SIZE buffer, re-using a pooled buffer if one is available
+    PacketData acquire();
+
+    size_t getNumPooledBuffers() const;
+
+private:
+    PacketBufferPool(size_t maxPooledBuffers) : _maxPooledBuffers(maxPooledBuffers) {}
+
+    void release(char* buffer);
+
+    mutable std::mutex _mutex;
+    std::vector<char*> _freeBuffers;
+    const size_t _maxPooledBuffers;
+
+    friend class PacketDataDeleter;
+};
+
+} // namespace udt
+
+#endif // hifi_PacketBufferPool_h
@@ -291,6 +291,7 @@ enum class EntityVersion : PacketVersion {
     UserAgent,
     AllBillboardMode,
     TextAlignment,
+    PolyVoxDeltaEdits,
 
     // Add new versions above here
     NUM_PACKET_TYPE,
@@ -375,7 +376,8 @@ enum class DomainConnectRequestVersion : PacketVersion {
 
 enum class DomainListRequestVersion : PacketVersion {
     PreSocketTypes = 22,
-    SocketTypes
+    SocketTypes,
+    HasDomainListVersion
 };
 
 enum class DomainConnectionDeniedVersion : PacketVersion {
@@ -398,7 +400,8 @@ enum class DomainListVersion : PacketVersion {
     AuthenticationOptional,
     HasTimestamp,
     HasConnectReason,
-    SocketTypes
+    SocketTypes,
+    DeltaEncoded
 };
 
 enum class AudioVersion : PacketVersion {
@@ -152,8 +152,7 @@ void SendQueue::ack(SequenceNumber ack) {
     }
     
     {
-        // remove any ACKed packets from the map of sent packets
-        QWriteLocker locker(&_sentLock);
+        // remove any ACKed packets from the window of sent packets
         for (auto seq = SequenceNumber { (uint32_t) _lastACKSequenceNumber }; seq <= ack; ++seq) {
             _sentPackets.erase(seq);
         }
@@ -227,14 +226,8 @@ bool SendQueue::sendNewPacketAndAddToSentList(std::unique_ptr<Packet> newPacket,
 
     emit packetSent(packetSize, payloadSize, sequenceNumber, p_high_resolution_clock::now());
 
-    {
-        // Insert the packet we have just sent in the sent list
-        QWriteLocker locker(&_sentLock);
-        auto& entry = _sentPackets[newPacket->getSequenceNumber()];
-        entry.first = 0; // No resend
-        entry.second.swap(newPacket);
-    }
-    Q_ASSERT_X(!newPacket, "SendQueue::sendNewPacketAndAddToSentList()", "Overriden packet in sent list");
+    // Insert the packet we have just sent in the sent window
+    _sentPackets.insert(sequenceNumber, std::move(newPacket));
 
     if (bytesWritten < 0) {
         // this is a short-circuit loss - we failed to put this packet on the wire
@@ -396,24 +389,16 @@ bool SendQueue::maybeResendPacket() {
             SequenceNumber resendNumber = _naks.popFirstSequenceNumber();
             naksLocker.unlock();
             
-            // pull the packet to re-send from the sent packets list
-            QReadLocker sentLocker(&_sentLock);
-            
-            // see if we can find the packet to re-send
-            auto it = _sentPackets.find(resendNumber);
-
-            if (it != _sentPackets.end()) {
+            // re-send the packet from the sent packets window, if it is still there
+            int wireSize = 0;
+            int payloadSize = 0;
+            std::unique_ptr<Packet> obfuscatedPacket;
 
-                auto& entry = it->second;
-                // we found the packet - grab it
-                auto& resendPacket = *(entry.second);
-                ++entry.first; // Add 1 resend
+            bool found = _sentPackets.resend(resendNumber, [&](Packet& resendPacket, uint8_t resendCount) {
+                Packet::ObfuscationLevel level = (Packet::ObfuscationLevel)(resendCount < 2 ? 0 : (resendCount - 2) % 4);
 
-                Packet::ObfuscationLevel level = (Packet::ObfuscationLevel)(entry.first < 2 ? 0 : (entry.first - 2) % 4);
-
-                auto wireSize = resendPacket.getWireSize();
-                auto payloadSize = resendPacket.getPayloadSize();
-                auto sequenceNumber = it->first;
+                wireSize = resendPacket.getWireSize();
+                payloadSize = resendPacket.getPayloadSize();
 
                 if (level != Packet::NoObfuscation) {
 #ifdef UDT_CONNECTION_DEBUG
@@ -429,26 +414,22 @@ bool SendQueue::maybeResendPacket() {
                     HIFI_FDEBUG(debugString);
 #endif
 
-                    // Create copy of the packet
-                    auto packet = Packet::createCopy(resendPacket);
-
-                    // unlock the sent packets
-                    sentLocker.unlock();
-
-                    // Obfuscate packet
-                    packet->obfuscate(level);
-
-                    // send it off
-                    sendPacket(*packet);
+                    // Create copy of the packet, it is obfuscated and sent once the slot is released
+                    obfuscatedPacket = Packet::createCopy(resendPacket);
+                    obfuscatedPacket->obfuscate(level);
                 } else {
                     // send it off
                     sendPacket(resendPacket);
+                }
+            });
 
-                    // unlock the sent packets
-                    sentLocker.unlock();
+            if (found) {
+                if (obfuscatedPacket) {
+                    // send it off
+                    sendPacket(*obfuscatedPacket);
                 }
-                
-                emit packetRetransmitted(wireSize, payloadSize, sequenceNumber,
+
+                emit packetRetransmitted(wireSize, payloadSize, resendNumber,
                                          p_high_resolution_clock::now());
                 
                 // Signal that we did resend a packet
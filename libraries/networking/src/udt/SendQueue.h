@@ -20,10 +20,8 @@
 #include <list>
 #include <memory>
 #include <mutex>
-#include <unordered_map>
 
 #include <QtCore/QObject>
-#include <QtCore/QReadWriteLock>
 
 #include <PortableHighResolutionClock.h>
 
@@ -33,6 +31,7 @@
 #include "PacketQueue.h"
 #include "SequenceNumber.h"
 #include "LossList.h"
+#include "SentPacketWindow.h"
 
 namespace udt {
     
@@ -131,9 +130,7 @@ private:
     mutable std::mutex _naksLock; // Protects the naks list.
     LossList _naks; // Sequence numbers of packets to resend
     
-    mutable QReadWriteLock _sentLock; // Protects the sent packet list
-    using PacketResendPair = std::pair<uint8_t, std::unique_ptr<Packet>>; // Number of resend + packet ptr
-    std::unordered_map<SequenceNumber, PacketResendPair> _sentPackets; // Packets waiting for ACK.
+    SentPacketWindow _sentPackets; // Packets waiting for ACK, shared by the ACK path and the send loop
     
     std::mutex _handshakeMutex; // Protects the handshake ACK condition_variable
     std::atomic<bool> _hasReceivedHandshakeACK { false }; // flag for receipt of handshake ACK from client
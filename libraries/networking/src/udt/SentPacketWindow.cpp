@@ -0,0 +1,120 @@
+//
+//  SentPacketWindow.cpp
+//  libraries/networking/src/udt
+//
+//  Created on 2026-10-16.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SentPacketWindow.h"
+
+#include <thread>
+
+using namespace udt;
+
+SentPacketWindow::~SentPacketWindow() {
+    for (auto& chunk : _chunks) {
+        delete chunk.load();
+    }
+}
+
+int SentPacketWindow::getNumChunks() const {
+    int numChunks = 0;
+    for (auto& chunk : _chunks) {
+        if (chunk.load(std::memory_order_relaxed)) {
+            ++numChunks;
+        }
+    }
+    return numChunks;
+}
+
+SentPacketWindow::Slot& SentPacketWindow::findOrCreateSlot(SequenceNumber sequenceNumber, Chunk*& chunk) {
+    auto index = (uint32_t)sequenceNumber % CAPACITY;
+    auto chunkIndex = index / CHUNK_SIZE;
+
+    chunk = _chunks[chunkIndex].load(std::memory_order_acquire);
+    if (!chunk) {
+        // only the send thread creates chunks, so there is no race to publish this one
+        chunk = new Chunk();
+        _chunks[chunkIndex].store(chunk, std::memory_order_release);
+    }
+    if (index % CHUNK_SIZE == 0) {
+        // the window moved on to a new chunk, so the ones it left behind may be all ACKed by now
+        freeEmptyChunks(chunkIndex);
+    }
+    return chunk->chunkSlots[index % CHUNK_SIZE];
+}
+
+void SentPacketWindow::freeEmptyChunks(int currentChunkIndex) {
+    for (int chunkIndex = 0; chunkIndex < NUM_CHUNKS; ++chunkIndex) {
+        Chunk* chunk = _chunks[chunkIndex].load(std::memory_order_relaxed);
+        // only the send thread fills slots, so an empty chunk stays empty
+        if (chunkIndex == currentChunkIndex || !chunk || chunk->numFull.load(std::memory_order_acquire) > 0) {
+            continue;
+        }
+
+        // NOTE: seq_cst, paired with erase(), so that an erase() either sees no chunk or is waited for here
+        _chunks[chunkIndex].store(nullptr);
+        while (_numErasing.load() > 0) {
+            std::this_thread::yield();
+        }
+        delete chunk;
+    }
+}
+
+uint32_t SentPacketWindow::claim(Slot& slot) {
+    while (true) {
+        uint32_t state = slot.state.load(std::memory_order_relaxed);
+        if (state != Claimed &&
+            slot.state.compare_exchange_weak(state, Claimed, std::memory_order_acquire, std::memory_order_relaxed)) {
+            return state;
+        }
+        // the other side only holds a slot for a single send or delete
+        std::this_thread::yield();
+    }
+}
+
+void SentPacketWindow::insert(SequenceNumber sequenceNumber, std::unique_ptr<Packet> packet) {
+    Chunk* chunk;
+    auto& slot = findOrCreateSlot(sequenceNumber, chunk);
+
+    // a full slot holds a packet from a whole window ago - its ACK raced with its insertion, so it can be dropped
+    if (claim(slot) != Full) {
+        chunk->numFull.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    slot.sequenceNumber = sequenceNumber;
+    slot.resendCount = 0;
+    slot.packet = std::move(packet);
+
+    release(slot, Full);
+}
+
+void SentPacketWindow::erase(SequenceNumber sequenceNumber) {
+    auto index = (uint32_t)sequenceNumber % CAPACITY;
+
+    // NOTE: seq_cst, paired with freeEmptyChunks()
+    _numErasing.fetch_add(1);
+    Chunk* chunk = _chunks[index / CHUNK_SIZE].load();
+
+    std::unique_ptr<Packet> packet;
+    if (chunk) {
+        Slot& slot = chunk->chunkSlots[index % CHUNK_SIZE];
+        if (slot.state.load(std::memory_order_relaxed) != Empty) {
+            uint32_t previousState = claim(slot);
+            if (previousState == Full && slot.sequenceNumber == sequenceNumber) {
+                // take the packet out so that it is destroyed after the slot is handed back
+                packet = std::move(slot.packet);
+                release(slot, Empty);
+                chunk->numFull.fetch_sub(1, std::memory_order_release);
+            } else {
+                release(slot, previousState);
+            }
+        }
+    }
+
+    _numErasing.fetch_sub(1, std::memory_order_release);
+}
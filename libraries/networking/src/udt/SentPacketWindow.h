@@ -0,0 +1,120 @@
+//
+//  SentPacketWindow.h
+//  libraries/networking/src/udt
+//
+//  Created on 2026-10-16.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_SentPacketWindow_h
+#define hifi_SentPacketWindow_h
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include "Constants.h"
+#include "Packet.h"
+#include "SequenceNumber.h"
+
+namespace udt {
+
+// Reliable packets waiting for an ACK, in a fixed-size ring indexed by sequence number modulo the window size.
+// The send thread inserts and re-sends, the ACK path erases, and each slot is claimed with an atomic state so that
+// neither side takes a lock shared by the whole window. Slot storage is allocated in chunks as the window reaches
+// them, and the send thread frees each chunk again once every packet in it has been ACKed, so a connection only holds
+// the chunks its flow window spans.
+class SentPacketWindow {
+public:
+    static const int CAPACITY = 32768;
+    static const int CHUNK_SIZE = 512;
+    static const int NUM_CHUNKS = CAPACITY / CHUNK_SIZE;
+
+    static_assert(CAPACITY > MAX_PACKETS_IN_FLIGHT, "SentPacketWindow must hold the largest flow window");
+    static_assert((SequenceNumber::MAX + 1) % CAPACITY == 0, "SentPacketWindow must divide the sequence number space");
+
+    SentPacketWindow() {}
+    ~SentPacketWindow();
+
+    // send thread only - stores a packet that was just sent
+    void insert(SequenceNumber sequenceNumber, std::unique_ptr<Packet> packet);
+
+    // drops the packet with this sequence number, if it is still in the window
+    void erase(SequenceNumber sequenceNumber);
+
+    // send thread only - bumps the resend count of the packet with this sequence number and calls
+    // resendOperator(packet, resendCount) while the slot is claimed, so that the packet can't be erased under it.
+    // Returns false if the packet is not in the window (it was already ACKed).
+    template <typename ResendOperator>
+    bool resend(SequenceNumber sequenceNumber, ResendOperator resendOperator);
+
+    // the number of chunks of slots allocated now
+    int getNumChunks() const;
+
+private:
+    enum SlotState : uint32_t {
+        Empty,
+        Claimed,
+        Full
+    };
+
+    struct Slot {
+        std::atomic<uint32_t> state { Empty };
+        SequenceNumber sequenceNumber;
+        uint8_t resendCount { 0 };
+        std::unique_ptr<Packet> packet;
+    };
+
+    struct Chunk {
+        std::atomic<int> numFull { 0 };
+        Slot chunkSlots[CHUNK_SIZE];
+    };
+
+    // send thread only
+    Slot& findOrCreateSlot(SequenceNumber sequenceNumber, Chunk*& chunk);
+    void freeEmptyChunks(int currentChunkIndex);
+
+    // spins until the slot is claimed by this thread, returns the state it was in before
+    static uint32_t claim(Slot& slot);
+    static void release(Slot& slot, uint32_t state) { slot.state.store(state, std::memory_order_release); }
+
+    std::array<std::atomic<Chunk*>, NUM_CHUNKS> _chunks {};
+    // erase() calls that may still be using a chunk they found, which the send thread waits for before freeing one
+    std::atomic<int> _numErasing { 0 };
+};
+
+template <typename ResendOperator>
+bool SentPacketWindow::resend(SequenceNumber sequenceNumber, ResendOperator resendOperator) {
+    // only the send thread frees chunks, so this one can't go away under us
+    auto index = (uint32_t)sequenceNumber % CAPACITY;
+    Chunk* chunk = _chunks[index / CHUNK_SIZE].load(std::memory_order_acquire);
+    if (!chunk) {
+        return false;
+    }
+    Slot* slot = &chunk->chunkSlots[index % CHUNK_SIZE];
+    if (slot->state.load(std::memory_order_relaxed) == Empty) {
+        return false;
+    }
+
+    uint32_t previousState = claim(*slot);
+    if (previousState != Full || slot->sequenceNumber != sequenceNumber) {
+        release(*slot, previousState);
+        return false;
+    }
+
+    ++slot->resendCount;
+    resendOperator(*slot->packet, slot->resendCount);
+
+    release(*slot, Full);
+    return true;
+}
+
+} // namespace udt
+
+#endif // hifi_SentPacketWindow_h
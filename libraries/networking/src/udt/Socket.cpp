@@ -13,10 +13,17 @@
 
 #include "Socket.h"
 
+#include <algorithm>
+
 #ifdef Q_OS_ANDROID
 #include <sys/socket.h>
 #endif
 
+#if defined(Q_OS_LINUX)
+#include <errno.h>
+#endif
+
+#include <QtCore/QProcessEnvironment>
 #include <QtCore/QThread>
 
 #include <shared/QtHelpers.h>
@@ -40,11 +47,24 @@ using namespace udt;
 #include <netinet/in.h>
 #endif
 
+#if defined(Q_OS_LINUX)
+// batched receive is on by default, it can be turned off to compare against the per-datagram QUdpSocket path
+static const bool BATCHED_RECEIVE_DEFAULT =
+    !QProcessEnvironment::systemEnvironment().contains("VIRCADIA_DISABLE_BATCHED_RECEIVE");
+#else
+static const bool BATCHED_RECEIVE_DEFAULT = false;
+#endif
+
+// batched send is opt-in, since it holds datagrams back until the end of the batch
+static const bool BATCHED_SEND_DEFAULT =
+    QProcessEnvironment::systemEnvironment().contains("VIRCADIA_ENABLE_BATCHED_SEND");
 
 Socket::Socket(QObject* parent, bool shouldChangeSocketOptions) :
     QObject(parent),
     _networkSocket(parent),
     _readyReadBackupTimer(new QTimer(this)),
+    _batchedReceiveEnabled(BATCHED_RECEIVE_DEFAULT),
+    _batchedSendEnabled(BATCHED_SEND_DEFAULT),
     _shouldChangeSocketOptions(shouldChangeSocketOptions)
 {
     connect(&_networkSocket, &NetworkSocket::readyRead, this, &Socket::readPendingDatagrams);
@@ -250,6 +270,146 @@ qint64 Socket::writeDatagram(const char* data, qint64 size, const SockAddr& sock
 }
 
 qint64 Socket::writeDatagram(const QByteArray& datagram, const SockAddr& sockAddr) {
+    if (_batchedSendEnabled && sockAddr.getType() == SocketType::UDP) {
+        Lock sendBatchLock(_sendBatchMutex);
+        if (_sendBatchDepth > 0) {
+            // the datagram is often raw data owned by a packet that is about to be re-used, so take a deep copy
+            _sendBatch.emplace_back(sockAddr, QByteArray(datagram.constData(), datagram.size()));
+            return datagram.size();
+        }
+    }
+
+    return writeDatagramNow(datagram, sockAddr);
+}
+
+void Socket::setBatchedSendEnabled(bool enabled) {
+    _batchedSendEnabled = enabled;
+
+    if (!enabled) {
+        // don't strand anything that was queued by a batch that is still open
+        std::vector<std::pair<SockAddr, QByteArray>> datagrams;
+        {
+            Lock sendBatchLock(_sendBatchMutex);
+            datagrams.swap(_sendBatch);
+        }
+        flushSendBatch(datagrams);
+    }
+}
+
+void Socket::beginSendBatch() {
+    Lock sendBatchLock(_sendBatchMutex);
+    ++_sendBatchDepth;
+}
+
+void Socket::endSendBatch() {
+    std::vector<std::pair<SockAddr, QByteArray>> datagrams;
+    {
+        Lock sendBatchLock(_sendBatchMutex);
+        Q_ASSERT(_sendBatchDepth > 0);
+        if (_sendBatchDepth > 0 && --_sendBatchDepth == 0) {
+            datagrams.swap(_sendBatch);
+        }
+    }
+    flushSendBatch(datagrams);
+}
+
+void Socket::flushSendBatch(std::vector<std::pair<SockAddr, QByteArray>>& datagrams) {
+    if (datagrams.empty()) {
+        return;
+    }
+
+    // the number of datagrams and segmented sends to each peer in this flush, for the connection stats
+    std::unordered_map<SockAddr, std::pair<int, int>> batchSizes;
+
+#if defined(Q_OS_LINUX)
+    // as in writeDatagramNow(), don't write to an unbound socket, just drop the datagrams
+    if (_networkSocket.state(SocketType::UDP) != QAbstractSocket::BoundState) {
+        qCDebug(networking) << "Attempt to flush" << datagrams.size() << "batched datagrams when in unbound state";
+        datagrams.clear();
+        return;
+    }
+
+    static const size_t MAX_SEGMENTS_PER_SEND = 64; // UDP_MAX_SEGMENTS in the kernel
+    static const int MAX_SEGMENTED_SEND_BYTES = 65000; // must fit in a single IP datagram before segmentation
+
+    bool segment = _segmentationOffloadEnabled;
+
+    std::vector<NetworkSocket::UDPDatagramRun> runs;
+    std::vector<int> runBytes;
+    std::unordered_map<SockAddr, size_t> openRuns; // the run that the next datagram to a peer may join
+
+    for (const auto& datagram : datagrams) {
+        const auto& sockAddr = datagram.first;
+        int size = datagram.second.size();
+        ++batchSizes[sockAddr].first;
+
+        auto openRun = openRuns.find(sockAddr);
+        if (segment && openRun != openRuns.end()) {
+            auto& run = runs[openRun->second];
+            int segmentSize = run.datagrams.front()->size();
+
+            // a run can only be segmented if every datagram but the last is the segment size
+            if (run.datagrams.back()->size() == segmentSize && size <= segmentSize &&
+                run.datagrams.size() < MAX_SEGMENTS_PER_SEND &&
+                runBytes[openRun->second] + size <= MAX_SEGMENTED_SEND_BYTES) {
+                run.datagrams.push_back(&datagram.second);
+                runBytes[openRun->second] += size;
+                continue;
+            }
+        }
+
+        openRuns[sockAddr] = runs.size();
+        runs.push_back({ sockAddr, { &datagram.second } });
+        runBytes.push_back(size);
+    }
+
+    size_t numMessages = segment ? runs.size() : datagrams.size();
+    int result = _networkSocket.writeUDPDatagramRuns(runs, segment);
+    size_t numRunsSent = segment ? (size_t)std::max(result, 0) : 0;
+    if (segment && numRunsSent < runs.size() && (errno == EIO || errno == EINVAL)) {
+        qCWarning(networking) << "UDP segmentation offload is not available, sending batched datagrams individually";
+        _segmentationOffloadEnabled = false;
+
+        // only the runs from the first that was refused, those before it have gone out
+        std::vector<NetworkSocket::UDPDatagramRun> unsentRuns(runs.begin() + numRunsSent, runs.end());
+        numMessages = 0;
+        for (const auto& run : unsentRuns) {
+            numMessages += run.datagrams.size();
+        }
+        result = _networkSocket.writeUDPDatagramRuns(unsentRuns, false);
+    }
+
+    if (result < (int)numMessages) {
+        // a full send buffer drops the remainder, as it would for individual writes
+        HIFI_FCDEBUG(networking(), "udt::Socket::flushSendBatch failed to send" << numMessages - std::max(result, 0)
+                     << "of" << numMessages << "messages - errno" << errno);
+    }
+    for (size_t i = 0; i < numRunsSent; ++i) {
+        if (runs[i].datagrams.size() > 1) {
+            ++batchSizes[runs[i].sockAddr].second;
+        }
+    }
+#else
+    for (const auto& datagram : datagrams) {
+        ++batchSizes[datagram.first].first;
+        writeDatagramNow(datagram.second, datagram.first);
+    }
+#endif
+
+    {
+        Lock connectionsLock(_connectionsHashMutex);
+        for (const auto& batchSize : batchSizes) {
+            auto it = _connectionsHash.find(batchSize.first);
+            if (it != _connectionsHash.end()) {
+                it->second->recordSendBatch(batchSize.second.first, batchSize.second.second);
+            }
+        }
+    }
+
+    datagrams.clear();
+}
+
+qint64 Socket::writeDatagramNow(const QByteArray& datagram, const SockAddr& sockAddr) {
     auto socketType = sockAddr.getType();
 
     // don't attempt to write the datagram if we're unbound.  Just drop it.
@@ -410,8 +570,10 @@ void Socket::readPendingDatagrams() {
         // setup a SockAddr to read into
         SockAddr senderSockAddr;
 
-        // setup a buffer to read the packet into
-        auto buffer = std::unique_ptr<char[]>(new char[packetSizeWithHeader]);
+        // setup a buffer to read the packet into, re-using a pooled buffer for anything that fits in one
+        auto buffer = packetSizeWithHeader <= PacketBufferPool::BUFFER_SIZE
+            ? _receiveBufferPool->acquire()
+            : PacketData(new char[packetSizeWithHeader]);
 
         // pull the datagram
         auto sizeRead = _networkSocket.readDatagram(buffer.get(), packetSizeWithHeader, &senderSockAddr);
@@ -426,74 +588,176 @@ void Socket::readPendingDatagrams() {
             continue;
         }
 
-        auto it = _unfilteredHandlers.find(senderSockAddr);
+        processReceivedDatagram(std::move(buffer), packetSizeWithHeader, senderSockAddr, receiveTime);
 
-        if (it != _unfilteredHandlers.end()) {
-            // we have a registered unfiltered handler for this SockAddr - call that and return
-            if (it->second) {
-                auto basePacket = BasePacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
-                basePacket->setReceiveTime(receiveTime);
-                it->second(std::move(basePacket));
+#if defined(Q_OS_LINUX)
+        if (_batchedReceiveEnabled && senderSockAddr.getType() == SocketType::UDP) {
+            // the read above re-armed the QUdpSocket read notifier, drain whatever else is queued in batches
+            readPendingDatagramBatches(abortTime);
+        }
+#endif
+    }
+}
+
+#if defined(Q_OS_LINUX)
+void Socket::readPendingDatagramBatches(std::chrono::system_clock::time_point abortTime) {
+    PacketData buffers[RECEIVE_BATCH_SIZE];
+    char* bufferPointers[RECEIVE_BATCH_SIZE];
+    qint64 sizes[RECEIVE_BATCH_SIZE];
+    SockAddr senderSockAddrs[RECEIVE_BATCH_SIZE];
+
+    while (std::chrono::system_clock::now() <= abortTime) {
+        // top up the buffers that were handed off to packets during the last batch
+        for (int i = 0; i < RECEIVE_BATCH_SIZE; ++i) {
+            if (!buffers[i]) {
+                buffers[i] = _receiveBufferPool->acquire();
             }
+            bufferPointers[i] = buffers[i].get();
+        }
 
-            continue;
+        int numRead = _networkSocket.readUDPDatagrams(bufferPointers, PacketBufferPool::BUFFER_SIZE, sizes,
+                                                      senderSockAddrs, RECEIVE_BATCH_SIZE);
+        if (numRead <= 0) {
+            // nothing left to read (or an error that the next QUdpSocket read will surface)
+            break;
         }
 
-        // check if this was a control packet or a data packet
-        bool isControlPacket = *reinterpret_cast<uint32_t*>(buffer.get()) & CONTROL_BIT_MASK;
+        _readyReadBackupTimer->start();
+        auto receiveTime = p_high_resolution_clock::now();
 
-        if (isControlPacket) {
-            // setup a control packet from the data we just read
-            auto controlPacket = ControlPacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
-            controlPacket->setReceiveTime(receiveTime);
+        if (_packetBatchFilterOperator) {
+            // set up the data packets of the batch up front so the batch filter gets to see all of them at once
+            std::unique_ptr<Packet> packets[RECEIVE_BATCH_SIZE];
+            std::vector<const Packet*> batch;
+            batch.reserve(numRead);
+
+            for (int i = 0; i < numRead; ++i) {
+                if (sizes[i] > 0 && _unfilteredHandlers.find(senderSockAddrs[i]) == _unfilteredHandlers.end()
+                    && !(*reinterpret_cast<uint32_t*>(buffers[i].get()) & CONTROL_BIT_MASK)) {
+                    packets[i] = Packet::fromReceivedPacket(std::move(buffers[i]), sizes[i], senderSockAddrs[i]);
+                    packets[i]->setReceiveTime(receiveTime);
+                    batch.push_back(packets[i].get());
+                }
+            }
 
-            // move this control packet to the matching connection, if there is one
-            auto connection = findOrCreateConnection(senderSockAddr, true);
+            if (!batch.empty()) {
+                _packetBatchFilterOperator(batch);
+            }
 
-            if (connection) {
-                connection->processControl(move(controlPacket));
+            for (int i = 0; i < numRead; ++i) {
+                _lastPacketSizeRead = sizes[i];
+                _lastPacketSockAddr = senderSockAddrs[i];
+
+                if (packets[i]) {
+                    processReceivedPacket(std::move(packets[i]));
+                } else if (sizes[i] > 0) {
+                    processReceivedDatagram(std::move(buffers[i]), sizes[i], senderSockAddrs[i], receiveTime);
+                } else {
+                    HIFI_FCDEBUG(networking(), "Dropping oversized or empty datagram from" << senderSockAddrs[i]);
+                }
             }
 
+            if (!batch.empty()) {
+                _packetBatchFilterOperator({});
+            }
         } else {
-            // setup a Packet from the data we just read
-            auto packet = Packet::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
-            packet->setReceiveTime(receiveTime);
+            for (int i = 0; i < numRead; ++i) {
+                _lastPacketSizeRead = sizes[i];
+                _lastPacketSockAddr = senderSockAddrs[i];
+
+                if (sizes[i] <= 0) {
+                    // empty or truncated datagram - it can't be a packet of ours
+                    HIFI_FCDEBUG(networking(), "Dropping oversized or empty datagram from" << senderSockAddrs[i]);
+                    continue;
+                }
 
-            // save the sequence number in case this is the packet that sticks readyRead
-            _lastReceivedSequenceNumber = packet->getSequenceNumber();
+                processReceivedDatagram(std::move(buffers[i]), sizes[i], senderSockAddrs[i], receiveTime);
+            }
+        }
 
-            // call our verification operator to see if this packet is verified
-            if (!_packetFilterOperator || _packetFilterOperator(*packet)) {
-                auto connection = findOrCreateConnection(senderSockAddr, true);
+        if (numRead < RECEIVE_BATCH_SIZE) {
+            // the socket has been drained
+            break;
+        }
+    }
+}
+#endif
+
+void Socket::processReceivedDatagram(PacketData buffer, qint64 packetSizeWithHeader, const SockAddr& senderSockAddr,
+                                     p_high_resolution_clock::time_point receiveTime) {
+    auto it = _unfilteredHandlers.find(senderSockAddr);
+
+    if (it != _unfilteredHandlers.end()) {
+        // we have a registered unfiltered handler for this SockAddr - call that and return
+        if (it->second) {
+            auto basePacket = BasePacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
+            basePacket->setReceiveTime(receiveTime);
+            it->second(std::move(basePacket));
+        }
+
+        return;
+    }
+
+    // check if this was a control packet or a data packet
+    bool isControlPacket = *reinterpret_cast<uint32_t*>(buffer.get()) & CONTROL_BIT_MASK;
+
+    if (isControlPacket) {
+        // setup a control packet from the data we just read
+        auto controlPacket = ControlPacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
+        controlPacket->setReceiveTime(receiveTime);
+
+        // move this control packet to the matching connection, if there is one
+        auto connection = findOrCreateConnection(senderSockAddr, true);
+
+        if (connection) {
+            connection->processControl(move(controlPacket));
+        }
 
-                if (packet->isReliable()) {
-                    // if this was a reliable packet then signal the matching connection with the sequence number
+    } else {
+        // setup a Packet from the data we just read
+        auto packet = Packet::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
+        packet->setReceiveTime(receiveTime);
+
+        processReceivedPacket(std::move(packet));
+    }
+}
+
+void Socket::processReceivedPacket(std::unique_ptr<Packet> packet) {
+    const SockAddr& senderSockAddr = packet->getSenderSockAddr();
+
+    // save the sequence number in case this is the packet that sticks readyRead
+    _lastReceivedSequenceNumber = packet->getSequenceNumber();
+
+    // call our verification operator to see if this packet is verified
+    if (!_packetFilterOperator || _packetFilterOperator(*packet)) {
+        auto connection = findOrCreateConnection(senderSockAddr, true);
 
-                    if (!connection || !connection->processReceivedSequenceNumber(packet->getSequenceNumber(),
-                                                                                  packet->getDataSize(),
-                                                                                  packet->getPayloadSize())) {
-                        // the connection could not be created or indicated that we should not continue processing this packet
+        if (packet->isReliable()) {
+            // if this was a reliable packet then signal the matching connection with the sequence number
+
+            if (!connection || !connection->processReceivedSequenceNumber(packet->getSequenceNumber(),
+                                                                          packet->getDataSize(),
+                                                                          packet->getPayloadSize())) {
+                // the connection could not be created or indicated that we should not continue processing this packet
 #ifdef UDT_CONNECTION_DEBUG
-                        qCDebug(networking) << "Can't process packet: version" << (unsigned int)NLPacket::versionInHeader(*packet)
-                            << ", type" << NLPacket::typeInHeader(*packet);
+                qCDebug(networking) << "Can't process packet: version" << (unsigned int)NLPacket::versionInHeader(*packet)
+                    << ", type" << NLPacket::typeInHeader(*packet);
 #endif
-                        continue;
-                    }
-                } else if (connection) {
-                    connection->recordReceivedUnreliablePackets(packet->getWireSize(),
-                                                                packet->getPayloadSize());
-                }
+                return;
+            }
+        } else if (connection) {
+            connection->recordReceivedUnreliablePackets(packet->getWireSize(),
+                                                        packet->getPayloadSize());
+        }
 
-                if (packet->isPartOfMessage()) {
-                    auto connection = findOrCreateConnection(senderSockAddr, true);
-                    if (connection) {
-                        connection->queueReceivedMessagePacket(std::move(packet));
-                    }
-                } else if (_packetHandler) {
-                    // call the verified packet callback to let it handle this packet
-                    _packetHandler(std::move(packet));
-                }
+        if (packet->isPartOfMessage()) {
+            auto connection = findOrCreateConnection(senderSockAddr, true);
+            if (connection) {
+                connection->queueReceivedMessagePacket(std::move(packet));
             }
+        } else if (_packetHandler) {
+            // call the verified packet callback to let it handle this packet
+            _packetHandler(std::move(packet));
         }
     }
 }
@@ -16,6 +16,8 @@
 #ifndef hifi_Socket_h
 #define hifi_Socket_h
 
+#include <atomic>
+#include <chrono>
 #include <functional>
 #include <unordered_map>
 #include <mutex>
@@ -28,6 +30,7 @@
 #include "TCPVegasCC.h"
 #include "Connection.h"
 #include "NetworkSocket.h"
+#include "PacketBufferPool.h"
 
 //#define UDT_CONNECTION_DEBUG
 
@@ -41,6 +44,7 @@ class PacketList;
 class SequenceNumber;
 
 using PacketFilterOperator = std::function<bool(const Packet&)>;
+using PacketBatchFilterOperator = std::function<void(const std::vector<const Packet*>&)>;
 using ConnectionCreationFilterOperator = std::function<bool(const SockAddr&)>;
 
 using BasePacketHandler = std::function<void(std::unique_ptr<BasePacket>)>;
@@ -74,6 +78,10 @@ public:
     void rebind(SocketType socketType);
 
     void setPacketFilterOperator(PacketFilterOperator filterOperator) { _packetFilterOperator = filterOperator; }
+    // called on the socket thread with each batch of received data packets before they go through the packet filter
+    // operator one at a time, then with an empty batch once they have all been handled
+    void setPacketBatchFilterOperator(PacketBatchFilterOperator filterOperator)
+        { _packetBatchFilterOperator = filterOperator; }
     void setPacketHandler(PacketHandler handler) { _packetHandler = handler; }
     void setMessageHandler(MessageHandler handler) { _messageHandler = handler; }
     void setMessageFailureHandler(MessageFailureHandler handler) { _messageFailureHandler = handler; }
@@ -91,6 +99,18 @@ public:
 
     StatsVector sampleStatsForAllConnections();
 
+    // Linux only - drain the UDP socket with recvmmsg batches instead of one QUdpSocket read per datagram
+    void setBatchedReceiveEnabled(bool enabled) { _batchedReceiveEnabled = enabled; }
+    bool isBatchedReceiveEnabled() const { return _batchedReceiveEnabled; }
+
+    // Opt-in batched egress - while a send batch is open, UDP datagrams written by any thread (including the SendQueue
+    // of each Connection) are queued and then sent with sendmmsg when the outermost batch ends. On Linux, runs of
+    // datagrams to the same peer are coalesced into single UDP GSO sends.
+    void setBatchedSendEnabled(bool enabled);
+    bool isBatchedSendEnabled() const { return _batchedSendEnabled; }
+    void beginSendBatch();
+    void endSendBatch();
+
 #if defined(WEBRTC_DATA_CHANNELS)
     const WebRTCSocket* getWebRTCSocket();
     void setWebRTCIceServers(QList<QVariant> iceServers);
@@ -119,6 +139,15 @@ private:
     void setSystemBufferSizes(SocketType socketType);
     Connection* findOrCreateConnection(const SockAddr& sockAddr, bool filterCreation = false);
 
+    void processReceivedDatagram(PacketData buffer, qint64 packetSizeWithHeader, const SockAddr& senderSockAddr,
+                                 p_high_resolution_clock::time_point receiveTime);
+    void processReceivedPacket(std::unique_ptr<Packet> packet);
+#if defined(Q_OS_LINUX)
+    void readPendingDatagramBatches(std::chrono::system_clock::time_point abortTime);
+#endif
+    void flushSendBatch(std::vector<std::pair<SockAddr, QByteArray>>& datagrams);
+    qint64 writeDatagramNow(const QByteArray& datagram, const SockAddr& sockAddr);
+
     // privatized methods used by UDTTest - they are private since they must be called on the Socket thread
     ConnectionStats::Stats sampleStatsForConnection(const SockAddr& destination);
 
@@ -130,6 +159,7 @@ private:
 
     NetworkSocket _networkSocket;
     PacketFilterOperator _packetFilterOperator;
+    PacketBatchFilterOperator _packetBatchFilterOperator;
     PacketHandler _packetHandler;
     MessageHandler _messageHandler;
     MessageFailureHandler _messageFailureHandler;
@@ -144,6 +174,17 @@ private:
 
     QTimer* _readyReadBackupTimer { nullptr };
 
+    static const int RECEIVE_BATCH_SIZE = 32;
+    static const size_t MAX_POOLED_RECEIVE_BUFFERS = 2048;
+    std::shared_ptr<PacketBufferPool> _receiveBufferPool { PacketBufferPool::create(MAX_POOLED_RECEIVE_BUFFERS) };
+    bool _batchedReceiveEnabled { false };
+
+    Mutex _sendBatchMutex;
+    std::vector<std::pair<SockAddr, QByteArray>> _sendBatch;
+    int _sendBatchDepth { 0 };
+    std::atomic<bool> _batchedSendEnabled { false };
+    std::atomic<bool> _segmentationOffloadEnabled { true };
+
     int _maxBandwidth { -1 };
 
     std::unique_ptr<CongestionControlVirtualFactory> _ccFactory { new CongestionControlFactory<TCPVegasCC>() };
@@ -16,6 +16,7 @@
 #include <cmath>
 #include <fstream> // to load voxels from file
 
+#include <QBuffer>
 #include <QDataStream>
 #include <QDebug>
 #include <QEventLoop>
@@ -61,6 +62,7 @@ Octree::Octree(bool shouldReaverage) :
     _isViewing(false),
     _isServer(false)
 {
+    setLockWaitHistograms(&_lockWaitHistograms);
 }
 
 Octree::~Octree() {
@@ -839,8 +841,6 @@ QVariantMap addMarketplaceIDToDocumentEntities(QVariantMap& doc, const QString&
 }
 
 }  // Unnamed namepsace
-const int READ_JSON_BUFFER_SIZE = 2048;
-
 bool Octree::readJSONFromStream(
     uint64_t streamLength,
     QDataStream& inputStream,
@@ -852,23 +852,28 @@ bool Octree::readJSONFromStream(
     // we get an eof.  Leave streamLength parameter for consistency.
 
     QByteArray jsonBuffer;
-    char* rawData = new char[READ_JSON_BUFFER_SIZE];
-    while (!inputStream.atEnd()) {
-        int got = inputStream.readRawData(rawData, READ_JSON_BUFFER_SIZE - 1);
-        if (got < 0) {
-            qCritical() << "error while reading from json stream";
-            delete[] rawData;
-            return false;
-        }
-        if (got == 0) {
-            break;
-        }
-        jsonBuffer += QByteArray(rawData, got);
+    QIODevice* device = inputStream.device();
+    auto buffer = qobject_cast<QBuffer*>(device);
+    if (buffer && buffer->pos() == 0) {
+        // a stream over data that's already in memory, which is shared rather than copied
+        jsonBuffer = buffer->data();
+    } else if (device) {
+        jsonBuffer = device->readAll();
+    }
+    if (jsonBuffer.isEmpty()) {
+        qCritical() << "error while reading from json stream";
+        return false;
     }
 
+    return readFromJSON(jsonBuffer, marketplaceID, isImport, relativeURL);
+}
+
+bool Octree::readFromJSON(const QByteArray& jsonData, const QString& marketplaceID, bool isImport, const QUrl& relativeURL) {
+    quint64 startTime = usecTimestampNow();
+
     OctreeEntitiesFileParser octreeParser;
     octreeParser.setRelativeURL(relativeURL);
-    octreeParser.setEntitiesString(jsonBuffer);
+    octreeParser.setEntitiesString(jsonData);
 
     QVariantMap asMap;
     if (!octreeParser.parseEntities(asMap)) {
@@ -881,7 +886,11 @@ bool Octree::readJSONFromStream(
     }
 
     bool success = readFromMap(asMap, isImport);
-    delete[] rawData;
+
+    _lastReadStats.numItems = asMap["Entities"].toList().size();
+    _lastReadStats.numThreads = 1;
+    _lastReadStats.usecs = usecTimestampNow() - startTime;
+
     return success;
 }
 
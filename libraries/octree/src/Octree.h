@@ -99,6 +99,10 @@ public:
     }
 
     std::function<void(const QUuid& dataID, quint64 itemLastEdited)> trackSend { [](const QUuid&, quint64){} };
+
+    // whether items may reuse an encoding of themselves made for another receiver, for servers that send the same
+    // items to many receivers
+    bool useEncodingCache { false };
 };
 
 class ReadBitstreamToTreeParams {
@@ -221,8 +225,26 @@ public:
     bool readFromStream(uint64_t streamLength, QDataStream& inputStream, const QString& marketplaceID="", const bool isImport = false, const QUrl& urlString = QUrl());
     bool readJSONFromStream(uint64_t streamLength, QDataStream& inputStream, const QString& marketplaceID="", const bool isImport = false, const QUrl& urlString = QUrl());
     bool readJSONFromGzippedFile(QString qFileName);
+    /// Reads a JSON description of the tree, by default by parsing all of it into a map for readFromMap()
+    virtual bool readFromJSON(const QByteArray& jsonData, const QString& marketplaceID, bool isImport,
+                              const QUrl& relativeURL);
     virtual bool readFromMap(QVariantMap& entityDescription, const bool isImport = false) = 0;
 
+    struct ReadStats {
+        int numItems { 0 };
+        int numThreads { 0 };
+        quint64 usecs { 0 };
+    };
+    // stats of the last description read with readFromJSON()
+    ReadStats getLastReadStats() const { return _lastReadStats; }
+
+    // incremental persistence, for trees that can track which items change between snapshots
+    virtual void setTrackPersistChanges(bool trackChanges) { }
+    /// Moves the items changed since the last call into changes, as an "Entities" list of added or edited items in the
+    /// same form as writeToMap and a "Deleted" list of item IDs.
+    /// \return false if the tree doesn't track its changes or has lost track of them, so needs a full snapshot
+    virtual bool takePersistChanges(QVariantMap& changes) { return false; }
+
     uint64_t getOctreeElementsCount();
 
     bool getShouldReaverage() const { return _shouldReaverage; }
@@ -250,6 +272,7 @@ public:
         _persistID = id;
         _persistDataVersion = dataVersion;
     }
+    QUuid getPersistID() const { return _persistID; }
 
     virtual void resetEditStats() { }
     virtual quint64 getAverageDecodeTime() const { return 0; }
@@ -259,6 +282,10 @@ public:
     virtual quint64 getAverageLoggingTime() const { return 0;  }
     virtual quint64 getAverageFilterTime() const { return 0; }
 
+    // how long withReadLock() and withWriteLock() on this tree have waited, since it was made or the histograms were reset
+    const LockWaitHistograms& getLockWaitHistograms() const { return _lockWaitHistograms; }
+    void resetLockWaitHistograms() { _lockWaitHistograms.read.reset(); _lockWaitHistograms.write.reset(); }
+
     void incrementPersistDataVersion() { _persistDataVersion++; }
 
 
@@ -277,11 +304,15 @@ protected:
     QUuid _persistID { QUuid::createUuid() };
     int _persistDataVersion { 0 };
 
+    ReadStats _lastReadStats;
+
     bool _isDirty;
     bool _shouldReaverage;
 
     bool _isViewing;
     bool _isServer;
+
+    LockWaitHistograms _lockWaitHistograms;
 };
 
 #endif // hifi_Octree_h
@@ -40,6 +40,10 @@ void OctreeEntitiesFileParser::setEntitiesString(const QByteArray& entitiesConte
 }
 
 bool OctreeEntitiesFileParser::parseEntities(QVariantMap& parsedEntities) {
+    return parseEntities(parsedEntities, nullptr);
+}
+
+bool OctreeEntitiesFileParser::parseEntities(QVariantMap& parsedEntities, const EntityHandler& entityHandler) {
     if (nextToken() != '{') {
         _errorString = "Text before start of object";
         return false;
@@ -88,11 +92,13 @@ bool OctreeEntitiesFileParser::parseEntities(QVariantMap& parsedEntities) {
             }
 
             QVariantList entitiesValue;
-            if (!readEntitiesArray(entitiesValue)) {
+            if (!readEntitiesArray(entitiesValue, entityHandler)) {
                 return false;
             }
 
-            parsedEntities["Entities"] = std::move(entitiesValue);
+            if (!entityHandler) {
+                parsedEntities["Entities"] = std::move(entitiesValue);
+            }
             gotEntities = true;
         } else if (key == "Id") {
             if (gotId) {
@@ -215,7 +221,7 @@ int OctreeEntitiesFileParser::readInteger() {
     return i;
 }
 
-bool OctreeEntitiesFileParser::readEntitiesArray(QVariantList& entitiesArray) {
+bool OctreeEntitiesFileParser::readEntitiesArray(QVariantList& entitiesArray, const EntityHandler& entityHandler) {
     if (nextToken() != '[') {
         _errorString = "Entities entry is not an array";
         return false;
@@ -232,112 +238,111 @@ bool OctreeEntitiesFileParser::readEntitiesArray(QVariantList& entitiesArray) {
             return false;
         }
 
-        QByteArray jsonEntity = _entitiesContents.mid(_position - 1, matchingBrace - _position + 1);
-        QJsonDocument entity = QJsonDocument::fromJson(jsonEntity);
-        if (entity.isNull()) {
-            _errorString = "Ill-formed entity";
+        if (entityHandler) {
+            entityHandler(QByteArray::fromRawData(_entitiesContents.constData() + _position - 1, matchingBrace - _position + 1));
+        } else {
+            QByteArray jsonEntity = _entitiesContents.mid(_position - 1, matchingBrace - _position + 1);
+            QJsonDocument entity = QJsonDocument::fromJson(jsonEntity);
+            if (entity.isNull()) {
+                _errorString = "Ill-formed entity";
+                return false;
+            }
+
+            QJsonObject entityObject = entity.object();
+            resolveRelativeURLs(entityObject);
+            entitiesArray.append(entityObject);
+        }
+
+        _position = matchingBrace;
+        char c = nextToken();
+        if (c == ']') {
+            return true;
+        } else if (c != ',') {
+            _errorString = "Entity array item incorrectly terminated";
             return false;
         }
+    }
+    return true;
+}
 
-        QJsonObject entityObject = entity.object();
-
-        // resolve urls starting with ./ or ../ 
-        if (!_relativeURL.isEmpty()) {
-            bool isDirty = false;
-
-            const QStringList urlKeys { 
-                // model
-                "modelURL",
-                "animation.url",
-                "textures",
-                // image
-                "imageURL",
-                // web
-                "sourceUrl",
-                "scriptURL",
-                // zone
-                "ambientLight.ambientURL",
-                "skybox.url",
-                // particles
-                //"textures",  Already specified for model entity type.
-                // materials
-                "materialURL",
-                // ...shared
-                "href",
-                "script",
-                "serverScripts",
-                "collisionSoundURL",
-                "compoundShapeURL",
-                // TODO: deal with materialData and userData
-            };
+void OctreeEntitiesFileParser::resolveRelativeURLs(QJsonObject& entityObject) const {
+    if (_relativeURL.isEmpty()) {
+        return;
+    }
 
-            for (const QString& key : urlKeys) {
-                if (key.contains('.')) {
-                    // url is inside another object
-                    const QStringList keyPair = key.split('.');
-                    const QString entityKey = keyPair[0];
-                    const QString childKey = keyPair[1];
+    const QStringList urlKeys {
+        // model
+        "modelURL",
+        "animation.url",
+        "textures",
+        // image
+        "imageURL",
+        // web
+        "sourceUrl",
+        "scriptURL",
+        // zone
+        "ambientLight.ambientURL",
+        "skybox.url",
+        // particles
+        //"textures",  Already specified for model entity type.
+        // materials
+        "materialURL",
+        // ...shared
+        "href",
+        "script",
+        "serverScripts",
+        "collisionSoundURL",
+        "compoundShapeURL",
+        // TODO: deal with materialData and userData
+    };
 
-                    if (entityObject.contains(entityKey) && entityObject[entityKey].isObject()) {
-                        QJsonObject childObject = entityObject[entityKey].toObject();
+    for (const QString& key : urlKeys) {
+        if (key.contains('.')) {
+            // url is inside another object
+            const QStringList keyPair = key.split('.');
+            const QString entityKey = keyPair[0];
+            const QString childKey = keyPair[1];
 
-                        if (childObject.contains(childKey) && childObject[childKey].isString()) {
-                            const QString url = childObject[childKey].toString();
+            if (entityObject.contains(entityKey) && entityObject[entityKey].isObject()) {
+                QJsonObject childObject = entityObject[entityKey].toObject();
 
-                            if (url.startsWith("./") || url.startsWith("../")) {
-                                childObject[childKey] = _relativeURL.resolved(url).toString();
-                                entityObject[entityKey] = childObject;
-                                isDirty = true;
-                            }
-                        }
+                if (childObject.contains(childKey) && childObject[childKey].isString()) {
+                    const QString url = childObject[childKey].toString();
+
+                    if (url.startsWith("./") || url.startsWith("../")) {
+                        childObject[childKey] = _relativeURL.resolved(url).toString();
+                        entityObject[entityKey] = childObject;
                     }
-                } else {
-                    if (entityObject.contains(key) && entityObject[key].isString()) {
-                        const QString value = entityObject[key].toString();
-
-                        if (value.startsWith("./") || value.startsWith("../")) {
-                            // URL value.
-                            entityObject[key] = _relativeURL.resolved(value).toString();
-                            isDirty = true;
-                        } else if (value.startsWith("{")) {
-                            // Object with URL values.
-                            auto document = QJsonDocument::fromJson(value.toUtf8());
-                            if (!document.isNull()) {
-                                auto object = document.object();
-                                bool isObjectUpdated = false;
-                                for (const QString& key : object.keys()) {
-                                    auto value = object[key].toString();
-                                    if (value.startsWith("./") || value.startsWith("../")) {
-                                        object[key] = _relativeURL.resolved(value).toString();
-                                        isObjectUpdated = true;
-                                    }
-                                }
-                                if (isObjectUpdated) {
-                                    entityObject[key] = QString(QJsonDocument(object).toJson());
-                                    isDirty = true;
-                                }
+                }
+            }
+        } else {
+            if (entityObject.contains(key) && entityObject[key].isString()) {
+                const QString value = entityObject[key].toString();
+
+                if (value.startsWith("./") || value.startsWith("../")) {
+                    // URL value.
+                    entityObject[key] = _relativeURL.resolved(value).toString();
+                } else if (value.startsWith("{")) {
+                    // Object with URL values.
+                    auto document = QJsonDocument::fromJson(value.toUtf8());
+                    if (!document.isNull()) {
+                        auto object = document.object();
+                        bool isObjectUpdated = false;
+                        for (const QString& key : object.keys()) {
+                            auto value = object[key].toString();
+                            if (value.startsWith("./") || value.startsWith("../")) {
+                                object[key] = _relativeURL.resolved(value).toString();
+                                isObjectUpdated = true;
                             }
                         }
+                        if (isObjectUpdated) {
+                            entityObject[key] = QString(QJsonDocument(object).toJson());
+                        }
                     }
                 }
             }
-
-            if (isDirty) {
-                entity.setObject(entityObject);
-            }
-        }
-
-        entitiesArray.append(entityObject);
-        _position = matchingBrace;
-        char c = nextToken();
-        if (c == ']') {
-            return true;
-        } else if (c != ',') {
-            _errorString = "Entity array item incorrectly terminated";
-            return false;
         }
     }
-    return true;
 }
 
 int OctreeEntitiesFileParser::findMatchingBrace() const {
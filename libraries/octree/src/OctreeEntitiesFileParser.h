@@ -14,22 +14,33 @@
 #ifndef hifi_OctreeEntitiesFileParser_h
 #define hifi_OctreeEntitiesFileParser_h
 
+#include <functional>
+
 #include <QByteArray>
+#include <QJsonObject>
 #include <QUrl>
 #include <QVariant>
 
 class OctreeEntitiesFileParser {
 public:
+    // called with the text of each entity object, which is only valid for as long as the entities string is
+    using EntityHandler = std::function<void(const QByteArray& entityJSON)>;
+
     void setEntitiesString(const QByteArray& entitiesContents);
     void setRelativeURL(const QUrl& relativeURL) { _relativeURL = relativeURL; }
     bool parseEntities(QVariantMap& parsedEntities);
+    // as above, but rather than parsing each entity into the "Entities" list, hands over its text to be parsed later
+    bool parseEntities(QVariantMap& parsedEntities, const EntityHandler& entityHandler);
     std::string getErrorString() const;
 
+    // resolves URLs starting with ./ or ../ against the relative URL
+    void resolveRelativeURLs(QJsonObject& entityObject) const;
+
 private:
     int nextToken();
     std::string readString();
     int readInteger();
-    bool readEntitiesArray(QVariantList& entitiesArray);
+    bool readEntitiesArray(QVariantList& entitiesArray, const EntityHandler& entityHandler);
     int findMatchingBrace() const;
 
     QByteArray _entitiesContents;
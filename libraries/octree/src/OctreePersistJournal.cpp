@@ -0,0 +1,334 @@
+//
+//  OctreePersistJournal.cpp
+//  libraries/octree/src
+//
+//  Created on 2026-10-16.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreePersistJournal.h"
+
+#include <QDataStream>
+#include <QHash>
+
+#include <UUID.h>
+
+#include "OctreeEntitiesFileParser.h"
+#include "OctreeLogging.h"
+
+const QString OctreePersistJournal::JOURNAL_EXTENSION = ".journal";
+const QString OctreePersistJournal::COMPACTING_EXTENSION = ".compacting";
+
+namespace {
+
+const quint32 JOURNAL_MAGIC = 0x564A524E; // "VJRN"
+const quint32 JOURNAL_FORMAT_VERSION = 1;
+const QDataStream::Version JOURNAL_STREAM_VERSION = QDataStream::Qt_5_9;
+
+const int RECORD_HEADER_SIZE = sizeof(quint32) + sizeof(quint16);
+
+// applies records to the "Entities" list of a description map, indexed by ID so that each record only costs as much
+// as the items it changed
+class DescriptionEditor {
+public:
+    DescriptionEditor(QVariantMap& entityDescription) : _entityDescription(entityDescription) {
+        _entities = _entityDescription["Entities"].toList();
+        for (int i = 0; i < _entities.size(); ++i) {
+            _indices[QUuid(_entities[i].toMap()["id"].toString())] = i;
+        }
+    }
+
+    ~DescriptionEditor() {
+        QVariantList entities;
+        entities.reserve(_indices.size());
+        for (auto& entity : _entities) {
+            if (entity.isValid()) {
+                entities.push_back(std::move(entity));
+            }
+        }
+        _entityDescription["Entities"] = entities;
+    }
+
+    void apply(const QVariantMap& changes) {
+        for (const auto& deleted : changes["Deleted"].toList()) {
+            auto index = _indices.find(QUuid(deleted.toString()));
+            if (index != _indices.end()) {
+                _entities[index.value()] = QVariant();
+                _indices.erase(index);
+            }
+        }
+
+        for (const auto& entity : changes["Entities"].toList()) {
+            QUuid id(entity.toMap()["id"].toString());
+            auto index = _indices.find(id);
+            if (index != _indices.end()) {
+                _entities[index.value()] = entity;
+            } else {
+                _indices[id] = _entities.size();
+                _entities.push_back(entity);
+            }
+        }
+    }
+
+private:
+    QVariantMap& _entityDescription;
+    QVariantList _entities;
+    QHash<QUuid, int> _indices;
+};
+
+}
+
+OctreePersistJournal::OctreePersistJournal(const QString& snapshotFilename) :
+    _filename(snapshotFilename + JOURNAL_EXTENSION),
+    _compactingFilename(snapshotFilename + JOURNAL_EXTENSION + COMPACTING_EXTENSION)
+{
+}
+
+bool OctreePersistJournal::exists() const {
+    return QFile::exists(_filename) || QFile::exists(_compactingFilename);
+}
+
+bool OctreePersistJournal::writeHeader(QFile& file, const QUuid& snapshotID) {
+    QByteArray header;
+    QDataStream stream(&header, QIODevice::WriteOnly);
+    stream << JOURNAL_MAGIC << JOURNAL_FORMAT_VERSION;
+    header.append(snapshotID.toRfc4122());
+    return file.write(header) == header.size();
+}
+
+bool OctreePersistJournal::readHeader(QFile& file, QUuid& snapshotID) {
+    QDataStream stream(&file);
+    quint32 magic = 0;
+    quint32 formatVersion = 0;
+    stream >> magic >> formatVersion;
+    if (stream.status() != QDataStream::Ok || magic != JOURNAL_MAGIC || formatVersion != JOURNAL_FORMAT_VERSION) {
+        return false;
+    }
+
+    QByteArray id = file.read(NUM_BYTES_RFC4122_UUID);
+    if (id.size() != NUM_BYTES_RFC4122_UUID) {
+        return false;
+    }
+    snapshotID = QUuid::fromRfc4122(id);
+    return true;
+}
+
+bool OctreePersistJournal::readRecord(QFile& file, QByteArray& payload) {
+    QByteArray header = file.read(RECORD_HEADER_SIZE);
+    if (header.size() != RECORD_HEADER_SIZE) {
+        return false;
+    }
+
+    QDataStream stream(header);
+    quint32 size = 0;
+    quint16 checksum = 0;
+    stream >> size >> checksum;
+    if ((qint64)size > file.size() - file.pos()) {
+        return false;
+    }
+
+    payload = file.read(size);
+    return payload.size() == (int)size && qChecksum(payload.constData(), payload.size()) == checksum;
+}
+
+bool OctreePersistJournal::open(const QUuid& snapshotID) {
+    close();
+
+    _snapshotID = snapshotID;
+    _size = 0;
+    _numRecords = 0;
+
+    _file.setFileName(_filename);
+    if (!_file.open(QIODevice::ReadWrite)) {
+        qCWarning(octree) << "Couldn't open octree journal" << _filename << _file.errorString();
+        return false;
+    }
+
+    // keep everything up to the last complete record of a journal over the same snapshot
+    QUuid journalID;
+    if (readHeader(_file, journalID) && journalID == snapshotID) {
+        _size = _file.pos();
+        QByteArray payload;
+        while (readRecord(_file, payload)) {
+            _size = _file.pos();
+            ++_numRecords;
+        }
+        if (_size < _file.size()) {
+            qCWarning(octree) << "Dropping" << _file.size() - _size << "bytes of incomplete record from octree journal"
+                << _filename;
+        }
+    }
+
+    if (_size == 0) {
+        if (!_file.resize(0) || !_file.seek(0) || !writeHeader(_file, snapshotID) || !_file.flush()) {
+            qCWarning(octree) << "Couldn't start octree journal" << _filename << _file.errorString();
+            _file.close();
+            return false;
+        }
+        _size = _file.pos();
+    } else if (!_file.resize(_size) || !_file.seek(_size)) {
+        qCWarning(octree) << "Couldn't truncate octree journal" << _filename << _file.errorString();
+        _file.close();
+        return false;
+    }
+
+    return true;
+}
+
+void OctreePersistJournal::close() {
+    if (_file.isOpen()) {
+        _file.close();
+    }
+}
+
+bool OctreePersistJournal::append(const QVariantMap& changes) {
+    if (!_file.isOpen()) {
+        return false;
+    }
+
+    QByteArray payload;
+    {
+        QDataStream stream(&payload, QIODevice::WriteOnly);
+        stream.setVersion(JOURNAL_STREAM_VERSION);
+        stream << changes;
+    }
+
+    QByteArray record;
+    {
+        QDataStream stream(&record, QIODevice::WriteOnly);
+        stream << (quint32)payload.size() << qChecksum(payload.constData(), payload.size());
+    }
+    record.append(payload);
+
+    if (_file.write(record) != record.size() || !_file.flush()) {
+        qCWarning(octree) << "Couldn't append to octree journal" << _filename << _file.errorString();
+
+        // don't leave a partial record for the next one to be appended after
+        _file.resize(_size);
+        _file.seek(_size);
+        return false;
+    }
+
+    _size += record.size();
+    ++_numRecords;
+    return true;
+}
+
+bool OctreePersistJournal::beginCompaction() {
+    close();
+
+    if (QFile::exists(_compactingFilename)) {
+        // the last compaction failed, so fold this journal into the one it left behind
+        QFile journal(_filename);
+        QFile compacting(_compactingFilename);
+        QUuid journalID;
+        if (journal.open(QIODevice::ReadOnly) && readHeader(journal, journalID)) {
+            QByteArray records = journal.readAll();
+            if (!compacting.open(QIODevice::WriteOnly | QIODevice::Append)) {
+                qCWarning(octree) << "Couldn't fold octree journal into" << _compactingFilename << compacting.errorString();
+                open(_snapshotID);
+                return false;
+            }
+            qint64 compactingSize = compacting.size();
+            if (compacting.write(records) != records.size() || !compacting.flush()) {
+                qCWarning(octree) << "Couldn't fold octree journal into" << _compactingFilename << compacting.errorString();
+                compacting.resize(compactingSize);
+                open(_snapshotID);
+                return false;
+            }
+        }
+        journal.close();
+        journal.remove();
+    } else if (QFile::exists(_filename) && !QFile::rename(_filename, _compactingFilename)) {
+        qCWarning(octree) << "Couldn't move octree journal" << _filename << "aside for compaction";
+        open(_snapshotID);
+        return false;
+    }
+
+    return open(_snapshotID);
+}
+
+void OctreePersistJournal::endCompaction(bool snapshotWritten) {
+    if (snapshotWritten && QFile::exists(_compactingFilename) && !QFile::remove(_compactingFilename)) {
+        qCWarning(octree) << "Couldn't remove compacted octree journal" << _compactingFilename;
+    }
+}
+
+int OctreePersistJournal::replay(QVariantMap& entityDescription, const QUuid& snapshotID) const {
+    if (snapshotID.isNull()) {
+        qCWarning(octree) << "Not replaying the octree journal over a snapshot without an ID";
+        return 0;
+    }
+
+    DescriptionEditor editor(entityDescription);
+    int numRecords = 0;
+
+    for (const auto& filename : { _compactingFilename, _filename }) {
+        QFile file(filename);
+        if (!file.open(QIODevice::ReadOnly)) {
+            continue;
+        }
+
+        QUuid journalID;
+        if (!readHeader(file, journalID)) {
+            qCWarning(octree) << "Skipping octree journal" << filename << "with an invalid header";
+            continue;
+        }
+        if (journalID != snapshotID) {
+            qCWarning(octree) << "Skipping octree journal" << filename << "written over snapshot" << journalID
+                << "rather than" << snapshotID;
+            continue;
+        }
+
+        QByteArray payload;
+        while (readRecord(file, payload)) {
+            QDataStream stream(payload);
+            stream.setVersion(JOURNAL_STREAM_VERSION);
+            QVariantMap changes;
+            stream >> changes;
+            if (stream.status() != QDataStream::Ok) {
+                break;
+            }
+
+            editor.apply(changes);
+            ++numRecords;
+        }
+    }
+
+    return numRecords;
+}
+
+int OctreePersistJournal::replayOverSnapshot(const QByteArray& snapshotJSON, QVariantMap& entityDescription) const {
+    if (snapshotJSON.isEmpty()) {
+        qCCritical(octree) << "Octree journal" << _filename << "has no snapshot to be replayed over";
+        return -1;
+    }
+
+    OctreeEntitiesFileParser octreeParser;
+    octreeParser.setEntitiesString(snapshotJSON);
+    if (!octreeParser.parseEntities(entityDescription)) {
+        qCCritical(octree) << "Couldn't parse the snapshot for octree journal" << _filename << ":"
+            << octreeParser.getErrorString().c_str();
+        return -1;
+    }
+
+    QUuid snapshotID(entityDescription["Id"].toString());
+    if (snapshotID.isNull()) {
+        qCCritical(octree) << "Octree journal" << _filename << "has a snapshot without an ID to be replayed over";
+        return -1;
+    }
+
+    return replay(entityDescription, snapshotID);
+}
+
+void OctreePersistJournal::discard() {
+    close();
+    for (const auto& filename : { _filename, _compactingFilename }) {
+        if (QFile::exists(filename) && !QFile::remove(filename)) {
+            qCWarning(octree) << "Couldn't remove octree journal" << filename;
+        }
+    }
+}
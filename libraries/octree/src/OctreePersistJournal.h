@@ -0,0 +1,83 @@
+//
+//  OctreePersistJournal.h
+//  libraries/octree/src
+//
+//  Created on 2026-10-16.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_OctreePersistJournal_h
+#define hifi_OctreePersistJournal_h
+
+#include <QFile>
+#include <QString>
+#include <QUuid>
+#include <QVariantMap>
+
+// Append-only binary journal of the changes made to an octree since its last persisted snapshot.
+//   Each record is a map of changed items, in the same form as the snapshot's description map: an "Entities" list of
+//   the complete, current properties of items that were added or edited, and a "Deleted" list of item IDs. Replaying
+//   a record replaces or removes whole items, so records can be replayed over any snapshot at least as old as them.
+//   While a new snapshot is being written the journal is moved aside, and only removed once the snapshot is safely
+//   on disk, so a failed or interrupted compaction loses nothing.
+//   OctreePersistJournal is not thread-safe! It should be instantiated and used from a single thread.
+class OctreePersistJournal {
+public:
+    static const QString JOURNAL_EXTENSION;
+    static const QString COMPACTING_EXTENSION;
+
+    OctreePersistJournal(const QString& snapshotFilename);
+    ~OctreePersistJournal() { close(); }
+
+    bool exists() const;
+
+    // opens the journal for appending, continuing the existing one if it was written over the same snapshot,
+    // after dropping any record left half written by a crash
+    bool open(const QUuid& snapshotID);
+    void close();
+    bool isOpen() const { return _file.isOpen(); }
+
+    // writes and flushes a single record
+    bool append(const QVariantMap& changes);
+
+    // moves the journal aside while a new snapshot is written, and starts a new one
+    bool beginCompaction();
+    // removes the journal that was moved aside once its changes are in the snapshot on disk, otherwise keeps it
+    // to be folded into the next compaction
+    void endCompaction(bool snapshotWritten);
+
+    // applies the journaled changes over a snapshot, oldest first, skipping any journal written over another snapshot,
+    // and every journal if snapshotID is null
+    // \return the number of records applied
+    int replay(QVariantMap& entityDescription, const QUuid& snapshotID) const;
+
+    // parses a snapshot's JSON into entityDescription and replays the journal over it
+    // \return the number of records applied, or -1 if the snapshot is missing, can't be parsed or has no ID, since the
+    // journal can't then be known to go with it and the changes in it would be replayed over nothing
+    int replayOverSnapshot(const QByteArray& snapshotJSON, QVariantMap& entityDescription) const;
+
+    // removes the journal, e.g. when the snapshot has been replaced
+    void discard();
+
+    qint64 getSize() const { return _size; }
+    int getNumRecords() const { return _numRecords; }
+
+private:
+    static bool writeHeader(QFile& file, const QUuid& snapshotID);
+    static bool readHeader(QFile& file, QUuid& snapshotID);
+    static bool readRecord(QFile& file, QByteArray& payload);
+
+    const QString _filename;
+    const QString _compactingFilename;
+    QFile _file;
+    QUuid _snapshotID;
+    qint64 _size { 0 };
+    int _numRecords { 0 };
+};
+
+#endif // hifi_OctreePersistJournal_h
@@ -27,10 +27,12 @@
 #include <QJsonObject>
 #include <QJsonDocument>
 #include <QRegExp>
+#include <QSaveFile>
 
 #include <NumericalConstants.h>
 #include <PerfStat.h>
 #include <PathUtils.h>
+#include <SharedUtil.h>
 #include <Gzip.h>
 
 #include "OctreeLogging.h"
@@ -38,13 +40,15 @@
 #include "OctreeDataUtils.h"
 
 const std::chrono::seconds OctreePersistThread::DEFAULT_PERSIST_INTERVAL { 30 };
+const std::chrono::seconds OctreePersistThread::DEFAULT_COMPACTION_INTERVAL { 10 * 60 };
 constexpr std::chrono::milliseconds TIME_BETWEEN_PROCESSING { 10 };
 
 constexpr int MAX_OCTREE_REPLACEMENT_BACKUP_FILES_COUNT { 20 };
 constexpr int64_t MAX_OCTREE_REPLACEMENT_BACKUP_FILES_SIZE_BYTES { 50 * 1000 * 1000 };
 
 OctreePersistThread::OctreePersistThread(OctreePointer tree, const QString& filename, std::chrono::milliseconds persistInterval,
-                                         bool debugTimestampNow, QString persistAsFileType) :
+                                         bool debugTimestampNow, QString persistAsFileType,
+                                         std::chrono::milliseconds compactionInterval) :
     _tree(tree),
     _filename(filename),
     _persistInterval(persistInterval),
@@ -53,11 +57,22 @@ OctreePersistThread::OctreePersistThread(OctreePointer tree, const QString& file
     _loadTimeUSecs(0),
     _debugTimestampNow(debugTimestampNow),
     _lastTimeDebug(0),
-    _persistAsFileType(persistAsFileType)
+    _persistAsFileType(persistAsFileType),
+    _compactionInterval(compactionInterval)
 {
     // in case the persist filename has an extension that doesn't match the file type
     QString sansExt = fileNameWithoutExtension(_filename, PERSIST_EXTENSIONS);
     _filename = sansExt + "." + _persistAsFileType;
+
+    // the journal is kept even when journaling is off, so that one left from when it was on can still be replayed
+    _journal.reset(new OctreePersistJournal(_filename));
+}
+
+OctreePersistThread::~OctreePersistThread() {
+    // let a snapshot that's being written finish, rather than leave its journal to be replayed at the next start
+    if (_compaction.valid()) {
+        _journal->endCompaction(!_compaction.get().isEmpty());
+    }
 }
 
 void OctreePersistThread::start() {
@@ -117,6 +132,8 @@ void OctreePersistThread::handleOctreeDataFileReply(QSharedPointer<ReceivedMessa
         _cachedJSONData.clear();
         replacementData = message->readAll();
         replaceData(replacementData);
+        // the journal has the changes to the data that was replaced
+        _journal->discard();
         hasValidOctreeData = data.readOctreeDataInfoFromFile(_filename);
         qDebug() << "Got OctreeDataFileReply, new data sent";
     } else {
@@ -150,15 +167,35 @@ void OctreePersistThread::handleOctreeDataFileReply(QSharedPointer<ReceivedMessa
     }
 
     bool persistentFileRead;
+    int numJournalRecords = 0;
 
     _tree->withWriteLock([&] {
         PerformanceWarning warn(true, "Loading Octree File", true);
 
-        if (_cachedJSONData.isEmpty()) {
+        if (_journal->exists()) {
+            // bring the snapshot up to date with the journal before loading it
+            QVariantMap entityDescription;
+            numJournalRecords = _journal->replayOverSnapshot(_cachedJSONData, entityDescription);
+            if (numJournalRecords < 0) {
+                // neither the snapshot nor the journal can be trusted to be overwritten now, so leave both for repair
+                qCCritical(octree) << "Not loading or persisting" << _filename << "- it and its journal are left as they are";
+                _persistenceDisabled = true;
+                persistentFileRead = false;
+                numJournalRecords = 0;
+            } else {
+                quint64 readStarted = usecTimestampNow();
+                persistentFileRead = _tree->readFromMap(entityDescription);
+                _loadStats.numItems = entityDescription["Entities"].toList().size();
+                _loadStats.numThreads = 1;
+                _loadStats.usecs = usecTimestampNow() - readStarted;
+            }
+        } else if (_cachedJSONData.isEmpty()) {
             persistentFileRead = _tree->readFromFile(_filename.toLocal8Bit().constData());
+            _loadStats = _tree->getLastReadStats();
         } else {
             QDataStream jsonStream(_cachedJSONData);
             persistentFileRead = _tree->readFromStream(-1, jsonStream);
+            _loadStats = _tree->getLastReadStats();
         }
         _tree->pruneTree();
     });
@@ -167,8 +204,37 @@ void OctreePersistThread::handleOctreeDataFileReply(QSharedPointer<ReceivedMessa
     quint64 loadDone = usecTimestampNow();
     _loadTimeUSecs = loadDone - loadStarted;
 
+    const uint64_t BYTES_PER_MEGABYTE = 1024 * 1024;
+    MemoryInfo memoryInfo;
+    if (getMemoryInfo(memoryInfo)) {
+        _loadPeakMemoryBytes = memoryInfo.processPeakUsedMemoryBytes;
+    }
+    qCDebug(octree) << "Loaded" << _loadStats.numItems << "items from" << _filename << "in"
+        << _loadTimeUSecs / USECS_PER_MSEC << "ms, peak memory" << _loadPeakMemoryBytes / BYTES_PER_MEGABYTE << "MB";
+
     _tree->clearDirtyBit(); // the tree is clean since we just loaded it
 
+    if (numJournalRecords > 0) {
+        qCDebug(octree) << "Replayed" << numJournalRecords << "journal records over" << _filename;
+
+        // fold the journal into a new snapshot at the first chance
+        _tree->setDirtyBit();
+        _changedSinceCompaction = true;
+    } else {
+        _lastCompaction = std::chrono::steady_clock::now();
+    }
+
+    if (_compactionInterval.count() > 0 && !_persistenceDisabled) {
+        _tree->setTrackPersistChanges(true);
+        QVariantMap changes;
+        if (_tree->takePersistChanges(changes) && _journal->open(_tree->getPersistID())) {
+            qCDebug(octree) << "Journaling octree changes to" << _filename << "between snapshots";
+            _journaling = true;
+        } else {
+            _tree->setTrackPersistChanges(false);
+        }
+    }
+
     unsigned long nodeCount = OctreeElement::getNodeCount();
     unsigned long internalNodeCount = OctreeElement::getInternalNodeCount();
     unsigned long leafNodeCount = OctreeElement::getLeafNodeCount();
@@ -192,7 +258,7 @@ void OctreePersistThread::handleOctreeDataFileReply(QSharedPointer<ReceivedMessa
     // Since we just loaded the persistent file, we can consider ourselves as having just persisted
     _lastPersistCheck = std::chrono::steady_clock::now();
 
-    if (replacementData.isNull()) {
+    if (replacementData.isNull() && !_persistenceDisabled) {
         sendLatestEntityDataToDS();
     }
 
@@ -246,6 +312,8 @@ void OctreePersistThread::process() {
     _tree->preUpdate();
     _tree->update();
 
+    finishCompaction(false);
+
     auto now = std::chrono::steady_clock::now();
     auto timeSinceLastPersist = now - _lastPersistCheck;
 
@@ -259,7 +327,9 @@ void OctreePersistThread::process() {
 
 void OctreePersistThread::aboutToFinish() {
     qCDebug(octree) << "Persist thread about to finish...";
+    finishCompaction(true);
     persist();
+    finishCompaction(true);
     qCDebug(octree) << "Persist thread done with about to finish...";
 }
 
@@ -303,6 +373,15 @@ void OctreePersistThread::cleanupOldReplacementBackups() {
 }
 
 void OctreePersistThread::persist() {
+    if (_persistenceDisabled) {
+        return;
+    }
+
+    if (_journaling) {
+        journal();
+        return;
+    }
+
     if (_tree->isDirty() && _initialLoadComplete) {
 
         _tree->withWriteLock([&] {
@@ -316,6 +395,7 @@ void OctreePersistThread::persist() {
         qCDebug(octree) << "Saving Octree data to:" << _filename;
         if (_tree->writeToFile(_filename.toLocal8Bit().constData(), nullptr, _persistAsFileType)) {
             _tree->clearDirtyBit(); // tree is clean after saving
+            _journal->discard(); // anything replayed from it is in the snapshot now
             qCDebug(octree) << "DONE persisting Octree data to" << _filename;
         } else {
             qCWarning(octree) << "Failed to persist Octree data to" << _filename;
@@ -325,17 +405,109 @@ void OctreePersistThread::persist() {
     }
 }
 
-void OctreePersistThread::sendLatestEntityDataToDS() {
-    qDebug() << "Sending latest entity data to DS";
-    auto nodeList = DependencyManager::get<NodeList>();
-    const DomainHandler& domainHandler = nodeList->getDomainHandler();
+void OctreePersistThread::journal() {
+    // the dirty bit isn't relied on here, changes are only lost track of when the tree says so
+    _tree->clearDirtyBit();
+
+    QVariantMap changes;
+    if (_tree->takePersistChanges(changes)) {
+        if (!changes["Entities"].toList().isEmpty() || !changes["Deleted"].toList().isEmpty()) {
+            _changedSinceCompaction = true;
+            if (!_journal->append(changes)) {
+                // the changes only survive in the tree now, so get them into a snapshot as soon as possible
+                _lastCompaction = std::chrono::steady_clock::time_point();
+            }
+        }
+    } else {
+        qCDebug(octree) << "Octree lost track of its changes, writing a new snapshot";
+        _changedSinceCompaction = true;
+        _lastCompaction = std::chrono::steady_clock::time_point();
+    }
+
+    auto timeSinceLastCompaction = std::chrono::steady_clock::now() - _lastCompaction;
+    if (_changedSinceCompaction && !_compaction.valid() && timeSinceLastCompaction > _compactionInterval) {
+        startCompaction();
+    }
+}
 
+void OctreePersistThread::startCompaction() {
+    _tree->withWriteLock([&] {
+        _tree->pruneTree();
+    });
+
+    _tree->incrementPersistDataVersion();
+
+    // the snapshot has all the changes journaled so far, and any made while it's being written are journaled again after
+    if (!_journal->beginCompaction()) {
+        return;
+    }
+    QVariantMap changes;
+    _tree->takePersistChanges(changes);
+
+    _changedSinceCompaction = false;
+    _lastCompaction = std::chrono::steady_clock::now();
+
+    qCDebug(octree) << "Saving Octree data to:" << _filename;
+    auto tree = _tree;
+    auto filename = _filename;
+    bool doGzip = _persistAsFileType == "json.gz";
+    _compaction = std::async(std::launch::async, [tree, filename, doGzip] {
+        QByteArray data;
+        if (!tree->toJSON(&data, nullptr, doGzip)) {
+            return QByteArray();
+        }
+
+        QSaveFile persistFile(filename);
+        if (!persistFile.open(QIODevice::WriteOnly) || persistFile.write(data) != data.size() || !persistFile.commit()) {
+            qCWarning(octree) << "Failed to write Octree data to" << filename << persistFile.errorString();
+            return QByteArray();
+        }
+
+        // the domain server is always sent gzipped data
+        QByteArray gzippedData;
+        if (!doGzip && !gzip(data, gzippedData, -1)) {
+            return QByteArray();
+        }
+        return doGzip ? data : gzippedData;
+    });
+}
+
+void OctreePersistThread::finishCompaction(bool wait) {
+    if (!_compaction.valid()) {
+        return;
+    }
+    if (!wait && _compaction.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        return;
+    }
+
+    QByteArray data = _compaction.get();
+    _journal->endCompaction(!data.isEmpty());
+
+    if (data.isEmpty()) {
+        // the journal that was moved aside is kept and folded into the next attempt
+        qCWarning(octree) << "Failed to persist Octree data to" << _filename;
+        _changedSinceCompaction = true;
+    } else {
+        qCDebug(octree) << "DONE persisting Octree data to" << _filename;
+        sendEntityDataToDS(data);
+    }
+}
+
+void OctreePersistThread::sendLatestEntityDataToDS() {
     QByteArray data;
     if (_tree->toJSON(&data, nullptr, true)) {
-        auto message = NLPacketList::create(PacketType::OctreeDataPersist, QByteArray(), true, true);
-        message->write(data);
-        nodeList->sendPacketList(std::move(message), domainHandler.getSockAddr());
+        sendEntityDataToDS(data);
     } else {
         qCWarning(octree) << "Failed to persist octree to DS";
     }
 }
+
+void OctreePersistThread::sendEntityDataToDS(const QByteArray& data) {
+    qDebug() << "Sending latest entity data to DS";
+    auto nodeList = DependencyManager::get<NodeList>();
+    const DomainHandler& domainHandler = nodeList->getDomainHandler();
+
+    auto message = NLPacketList::create(PacketType::OctreeDataPersist, QByteArray(), true, true);
+    message->write(data);
+    nodeList->sendPacketList(std::move(message), domainHandler.getSockAddr());
+}
@@ -14,10 +14,14 @@
 #ifndef hifi_OctreePersistThread_h
 #define hifi_OctreePersistThread_h
 
+#include <future>
+#include <memory>
+
 #include <QString>
 #include <QtCore/QSharedPointer>
 #include <GenericThread.h>
 #include "Octree.h"
+#include "OctreePersistJournal.h"
 
 class OctreePersistThread : public QObject {
     Q_OBJECT
@@ -32,15 +36,22 @@ public:
     };
 
     static const std::chrono::seconds DEFAULT_PERSIST_INTERVAL;
+    static const std::chrono::seconds DEFAULT_COMPACTION_INTERVAL;
 
+    /// \param compactionInterval If the tree can track its changes, they are appended to a journal each persist interval
+    /// and only folded into a new snapshot this often, otherwise, or if zero, a snapshot is written each persist interval.
     OctreePersistThread(OctreePointer tree,
                         const QString& filename,
                         std::chrono::milliseconds persistInterval = DEFAULT_PERSIST_INTERVAL,
                         bool debugTimestampNow = false,
-                        QString persistAsFileType = "json.gz");
+                        QString persistAsFileType = "json.gz",
+                        std::chrono::milliseconds compactionInterval = DEFAULT_COMPACTION_INTERVAL);
+    ~OctreePersistThread();
 
     bool isInitialLoadComplete() const { return _initialLoadComplete; }
     quint64 getLoadElapsedTime() const { return _loadTimeUSecs; }
+    Octree::ReadStats getLoadStats() const { return _loadStats; }
+    uint64_t getLoadPeakMemoryBytes() const { return _loadPeakMemoryBytes; }
 
     QString getPersistFilename() const { return _filename; }
     QString getPersistFileMimeType() const;
@@ -60,11 +71,15 @@ protected slots:
 
 protected:
     void persist();
+    void journal();
+    void startCompaction();
+    void finishCompaction(bool wait);
     bool backupCurrentFile();
     void cleanupOldReplacementBackups();
 
     void replaceData(QByteArray data);
     void sendLatestEntityDataToDS();
+    void sendEntityDataToDS(const QByteArray& data);
 
 private:
     OctreePointer _tree;
@@ -72,14 +87,25 @@ private:
     std::chrono::milliseconds _persistInterval;
     std::chrono::steady_clock::time_point _lastPersistCheck;
     bool _initialLoadComplete;
+    bool _persistenceDisabled { false }; // the persisted data couldn't be loaded, and mustn't be overwritten
 
     quint64 _loadTimeUSecs;
+    Octree::ReadStats _loadStats;
+    uint64_t _loadPeakMemoryBytes { 0 };
 
     bool _debugTimestampNow;
     quint64 _lastTimeDebug;
 
     QString _persistAsFileType;
     QByteArray _cachedJSONData;
+
+    // incremental persistence
+    std::chrono::milliseconds _compactionInterval;
+    std::chrono::steady_clock::time_point _lastCompaction;
+    std::unique_ptr<OctreePersistJournal> _journal;
+    bool _journaling { false };
+    bool _changedSinceCompaction { false };
+    std::future<QByteArray> _compaction; // the gzipped snapshot, or empty if it couldn't be written
 };
 
 #endif // hifi_OctreePersistThread_h
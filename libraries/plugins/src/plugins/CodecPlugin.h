@@ -16,6 +16,9 @@ class Encoder {
 public:
     virtual ~Encoder() { }
     virtual void encode(const QByteArray& decodedBuffer, QByteArray& encodedBuffer) = 0;
+
+    // true if the encoded output depends only on the buffer passed in, not on previously encoded frames
+    virtual bool isStateless() const { return false; }
 };
 
 class Decoder {
@@ -1480,6 +1480,11 @@ void Model::simulate(float deltaTime, bool fullUpdate) {
     }
 }
 
+bool Model::canSimulateConcurrently() const {
+    return isLoaded() && !(_rig.jointStatesEmpty() && getHFMModel().joints.size() > 0) &&
+        !(_scaleToFit && !_scaledToFit) && !(_snapModelToRegistrationPoint && !_snappedToRegistrationPoint);
+}
+
 //virtual
 void Model::updateRig(float deltaTime, glm::mat4 parentTransform) {
     _needsUpdateClusterMatrices = true;
@@ -174,6 +174,9 @@ public:
     bool getSnappedToRegistrationPoint() { return _snappedToRegistrationPoint; }
 
     virtual void simulate(float deltaTime, bool fullUpdate = true);
+    // whether simulate would only update the state of this model, so that it can run off the main thread while other
+    // models are simulated, rather than setting up the joints, rescaling or resnapping the model first
+    bool canSimulateConcurrently() const;
     virtual void updateClusterMatrices();
     virtual void updateBlendshapes();
 
@@ -580,6 +580,9 @@ void CullShadowBounds::run(const render::RenderContextPointer& renderContext, co
         assert(lightStage);
         const auto globalLightDir = currentKeyLight->getDirection();
         auto castersFilter = render::ItemFilter::Builder(filter).withShadowCaster().build();
+        uint8_t tests = render::CullTest::FRUSTUM | render::CullTest::SOLID_ANGLE |
+            (antiFrustum ? render::CullTest::ANTI_FRUSTUM : 0);
+        std::vector<uint8_t> visible;
 
         for (auto& inItems : inShapes) {
             auto key = inItems.first;
@@ -591,34 +594,19 @@ void CullShadowBounds::run(const render::RenderContextPointer& renderContext, co
 
             details._considered += (int)inItems.second.size();
 
-            if (antiFrustum == nullptr) {
-                for (auto& item : inItems.second) {
-                    if (test.solidAngleTest(item.bound) && test.frustumTest(item.bound)) {
-                        const auto shapeKey = scene->getItem(item.id).getKey();
-                        if (castersFilter.test(shapeKey)) {
-                            outItems->second.emplace_back(item);
-                            outBounds += item.bound;
-                        } else {
-                            // Receivers are not rendered but they still increase the bounds of the shadow scene
-                            // although only in the direction of the light direction so as to have a correct far
-                            // distance without decreasing the near distance.
-                            merge(outBounds, item.bound, globalLightDir);
-                        }
-                    }
-                }
-            } else {
-                for (auto& item : inItems.second) {
-                    if (test.solidAngleTest(item.bound) && test.frustumTest(item.bound) && test.antiFrustumTest(item.bound)) {
-                        const auto shapeKey = scene->getItem(item.id).getKey();
-                        if (castersFilter.test(shapeKey)) {
-                            outItems->second.emplace_back(item);
-                            outBounds += item.bound;
-                        } else {
-                            // Receivers are not rendered but they still increase the bounds of the shadow scene
-                            // although only in the direction of the light direction so as to have a correct far
-                            // distance without decreasing the near distance.
-                            merge(outBounds, item.bound, globalLightDir);
-                        }
+            test.cull(inItems.second, tests, visible);
+            for (size_t i = 0; i < inItems.second.size(); ++i) {
+                if (visible[i]) {
+                    const auto& item = inItems.second[i];
+                    const auto shapeKey = scene->getItem(item.id).getKey();
+                    if (castersFilter.test(shapeKey)) {
+                        outItems->second.emplace_back(item);
+                        outBounds += item.bound;
+                    } else {
+                        // Receivers are not rendered but they still increase the bounds of the shadow scene
+                        // although only in the direction of the light direction so as to have a correct far
+                        // distance without decreasing the near distance.
+                        merge(outBounds, item.bound, globalLightDir);
                     }
                 }
             }
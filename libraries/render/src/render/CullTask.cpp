@@ -13,12 +13,19 @@
 
 #include <algorithm>
 #include <assert.h>
+#include <atomic>
+
+#include <tbb/parallel_for.h>
 
 #include <PerfStat.h>
 #include <OctreeUtils.h>
 
 using namespace render;
 
+// below this many bounds, culling is cheaper than handing it out to other threads
+const size_t PARALLEL_CULL_THRESHOLD = 4096;
+const size_t PARALLEL_CULL_GRAIN_SIZE = 1024;
+
 std::unordered_set<QUuid> CullTest::_containingZones = std::unordered_set<QUuid>();
 std::unordered_set<QUuid> CullTest::_prevContainingZones = std::unordered_set<QUuid>();
 
@@ -71,6 +78,79 @@ bool CullTest::zoneOcclusionTest(const render::Item& item) {
     return item.passesZoneOcclusionTest(_containingZones);
 }
 
+void CullTest::cull(const ItemBounds& bounds, uint8_t tests, std::vector<uint8_t>& visible) {
+    assert(!(tests & ANTI_FRUSTUM) || _antiFrustum);
+    const size_t numBounds = bounds.size();
+    visible.assign(numBounds, 1);
+    if (numBounds == 0 || tests == 0) {
+        return;
+    }
+
+    const ViewFrustum& frustum = _args->getViewFrustum();
+    ViewFrustum::Boxes boxes;
+    if (tests & (FRUSTUM | ANTI_FRUSTUM)) {
+        boxes.resize(numBounds);
+    }
+    std::atomic<int> numOutOfView { 0 };
+    std::atomic<int> numTooSmall { 0 };
+
+    auto cullRange = [&](size_t begin, size_t end) {
+        uint8_t* results = visible.data() + begin;
+        size_t count = end - begin;
+        int outOfView = 0;
+        int tooSmall = 0;
+
+        if (tests & (FRUSTUM | ANTI_FRUSTUM)) {
+            for (size_t i = begin; i < end; ++i) {
+                boxes.set(i, bounds[i].bound);
+            }
+        }
+
+        if (tests & FRUSTUM) {
+            frustum.boxesIntersectFrustum(boxes, begin, end, results);
+            for (size_t i = 0; i < count; ++i) {
+                outOfView += 1 - results[i];
+            }
+        }
+
+        // the functor is opaque, so it is only called on what is left
+        if (tests & SOLID_ANGLE) {
+            for (size_t i = 0; i < count; ++i) {
+                if (results[i] && !_functor(_args, bounds[begin + i].bound)) {
+                    results[i] = 0;
+                    ++tooSmall;
+                }
+            }
+        }
+
+        // the anti frustum removes what is entirely inside of it
+        if (tests & ANTI_FRUSTUM) {
+            std::vector<uint8_t> inside(count);
+            _antiFrustum->boxesInsideFrustum(boxes, begin, end, inside.data());
+            for (size_t i = 0; i < count; ++i) {
+                uint8_t culled = results[i] & inside[i];
+                results[i] -= culled;
+                outOfView += culled;
+            }
+        }
+
+        numOutOfView += outOfView;
+        numTooSmall += tooSmall;
+    };
+
+    if (numBounds >= PARALLEL_CULL_THRESHOLD) {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, numBounds, PARALLEL_CULL_GRAIN_SIZE),
+            [&](const tbb::blocked_range<size_t>& range) {
+                cullRange(range.begin(), range.end());
+            });
+    } else {
+        cullRange(0, numBounds);
+    }
+
+    _renderDetails._outOfView += numOutOfView;
+    _renderDetails._tooSmall += numTooSmall;
+}
+
 void FetchNonspatialItems::run(const RenderContextPointer& renderContext, const ItemFilter& filter, ItemBounds& outItems) {
     assert(renderContext->args);
     assert(renderContext->args->hasViewFrustum());
@@ -181,135 +261,42 @@ void CullSpatialSelection::run(const RenderContextPointer& renderContext,
         // filter individually against the _filter
         // visibility cull if partially selected ( octree cell contianing it was partial)
         // distance cull if was a subcell item ( octree cell is way bigger than the item bound itself, so now need to test per item)
-        if (_skipCulling || _overrideSkipCulling) {
-            // inside & fit items: filter only, culling is disabled
-            {
-                PerformanceTimer perfTimer("insideFitItems");
-                for (auto id : inSelection.insideItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey()) && test.zoneOcclusionTest(item)) {
-                        ItemBound itemBound(id, item.getBound(args));
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene), args);
-                        }
-                    }
+        bool skipCulling = _skipCulling || _overrideSkipCulling;
+        ItemBounds candidates;
+        std::vector<uint8_t> visible;
+        auto cullItems = [&](const char* name, const ItemIDs& ids, uint8_t tests) {
+            PerformanceTimer perfTimer(name);
+
+            candidates.clear();
+            candidates.reserve(ids.size());
+            for (auto id : ids) {
+                auto& item = scene->getItem(id);
+                if (filter.test(item.getKey()) && test.zoneOcclusionTest(item)) {
+                    candidates.emplace_back(id, item.getBound(args));
                 }
             }
 
-            // inside & subcell items: filter only, culling is disabled
-            {
-                PerformanceTimer perfTimer("insideSmallItems");
-                for (auto id : inSelection.insideSubcellItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey()) && test.zoneOcclusionTest(item)) {
-                        ItemBound itemBound(id, item.getBound(args));
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene), args);
-                        }
-                    }
-                }
-            }
+            test.cull(candidates, skipCulling ? 0 : tests, visible);
 
-            // partial & fit items: filter only, culling is disabled
-            {
-                PerformanceTimer perfTimer("partialFitItems");
-                for (auto id : inSelection.partialItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey()) && test.zoneOcclusionTest(item)) {
-                        ItemBound itemBound(id, item.getBound(args));
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene), args);
-                        }
+            for (size_t i = 0; i < candidates.size(); ++i) {
+                if (visible[i]) {
+                    outItems.emplace_back(candidates[i]);
+                    auto& item = scene->getItem(candidates[i].id);
+                    if (item.getKey().isMetaCullGroup()) {
+                        item.fetchMetaSubItemBounds(outItems, (*scene), args);
                     }
                 }
             }
-
-            // partial & subcell items: filter only, culling is disabled
-            {
-                PerformanceTimer perfTimer("partialSmallItems");
-                for (auto id : inSelection.partialSubcellItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey()) && test.zoneOcclusionTest(item)) {
-                        ItemBound itemBound(id, item.getBound(args));
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene), args);
-                        }
-                    }
-                }
-            }
-
-        } else {
-
-            // inside & fit items: easy, just filter
-            {
-                PerformanceTimer perfTimer("insideFitItems");
-                for (auto id : inSelection.insideItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey()) && test.zoneOcclusionTest(item)) {
-                        ItemBound itemBound(id, item.getBound(args));
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene), args);
-                        }
-                    }
-                }
-            }
-
-            // inside & subcell items: filter & distance cull
-            {
-                PerformanceTimer perfTimer("insideSmallItems");
-                for (auto id : inSelection.insideSubcellItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey()) && test.zoneOcclusionTest(item)) {
-                        ItemBound itemBound(id, item.getBound(args));
-                        if (test.solidAngleTest(itemBound.bound)) {
-                            outItems.emplace_back(itemBound);
-                            if (item.getKey().isMetaCullGroup()) {
-                                item.fetchMetaSubItemBounds(outItems, (*scene), args);
-                            }
-                        }
-                    }
-                }
-            }
-
-            // partial & fit items: filter & frustum cull
-            {
-                PerformanceTimer perfTimer("partialFitItems");
-                for (auto id : inSelection.partialItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey()) && test.zoneOcclusionTest(item)) {
-                        ItemBound itemBound(id, item.getBound(args));
-                        if (test.frustumTest(itemBound.bound)) {
-                            outItems.emplace_back(itemBound);
-                            if (item.getKey().isMetaCullGroup()) {
-                                item.fetchMetaSubItemBounds(outItems, (*scene), args);
-                            }
-                        }
-                    }
-                }
-            }
-
-            // partial & subcell items:: filter & frutum cull & solidangle cull
-            {
-                PerformanceTimer perfTimer("partialSmallItems");
-                for (auto id : inSelection.partialSubcellItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey()) && test.zoneOcclusionTest(item)) {
-                        ItemBound itemBound(id, item.getBound(args));
-                        if (test.frustumTest(itemBound.bound) && test.solidAngleTest(itemBound.bound)) {
-                            outItems.emplace_back(itemBound);
-                            if (item.getKey().isMetaCullGroup()) {
-                                item.fetchMetaSubItemBounds(outItems, (*scene), args);
-                            }
-                        }
-                    }
-                }
-            }
-        }
+        };
+
+        // inside & fit items: easy, just filter
+        cullItems("insideFitItems", inSelection.insideItems, 0);
+        // inside & subcell items: filter & distance cull
+        cullItems("insideSmallItems", inSelection.insideSubcellItems, CullTest::SOLID_ANGLE);
+        // partial & fit items: filter & frustum cull
+        cullItems("partialFitItems", inSelection.partialItems, CullTest::FRUSTUM);
+        // partial & subcell items: filter & frustum cull & solidangle cull
+        cullItems("partialSmallItems", inSelection.partialSubcellItems, CullTest::FRUSTUM | CullTest::SOLID_ANGLE);
     }
 
     details._rendered += (int)outItems.size();
@@ -344,6 +331,8 @@ void CullShapeBounds::run(const RenderContextPointer& renderContext, const Input
         auto& details = args->_details.edit(_detailType);
         CullTest test(_cullFunctor, args, details, antiFrustum);
         auto scene = args->_scene;
+        uint8_t tests = CullTest::FRUSTUM | CullTest::SOLID_ANGLE | (antiFrustum ? CullTest::ANTI_FRUSTUM : 0);
+        std::vector<uint8_t> visible;
 
         for (auto& inItems : inShapes) {
             auto key = inItems.first;
@@ -355,28 +344,16 @@ void CullShapeBounds::run(const RenderContextPointer& renderContext, const Input
 
             details._considered += (int)inItems.second.size();
 
-            if (antiFrustum == nullptr) {
-                for (auto& item : inItems.second) {
-                    if (test.solidAngleTest(item.bound) && test.frustumTest(item.bound)) {
-                        const auto shapeKey = scene->getItem(item.id).getKey();
-                        if (cullFilter.test(shapeKey)) {
-                            outItems->second.emplace_back(item);
-                        }
-                        if (boundsFilter.test(shapeKey)) {
-                            outBounds += item.bound;
-                        }
+            test.cull(inItems.second, tests, visible);
+            for (size_t i = 0; i < inItems.second.size(); ++i) {
+                if (visible[i]) {
+                    const auto& item = inItems.second[i];
+                    const auto shapeKey = scene->getItem(item.id).getKey();
+                    if (cullFilter.test(shapeKey)) {
+                        outItems->second.emplace_back(item);
                     }
-                }
-            } else {
-                for (auto& item : inItems.second) {
-                    if (test.solidAngleTest(item.bound) && test.frustumTest(item.bound) && test.antiFrustumTest(item.bound)) {
-                        const auto shapeKey = scene->getItem(item.id).getKey();
-                        if (cullFilter.test(shapeKey)) {
-                            outItems->second.emplace_back(item);
-                        }
-                        if (boundsFilter.test(shapeKey)) {
-                            outBounds += item.bound;
-                        }
+                    if (boundsFilter.test(shapeKey)) {
+                        outBounds += item.bound;
                     }
                 }
             }
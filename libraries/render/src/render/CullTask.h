@@ -21,6 +21,13 @@ namespace render {
 
     // Culling Frustum / solidAngle test helper class
     struct CullTest {
+        // the tests that cull() can apply, in the order it applies them
+        enum Test : uint8_t {
+            FRUSTUM = 1 << 0,
+            SOLID_ANGLE = 1 << 1,
+            ANTI_FRUSTUM = 1 << 2,
+        };
+
         CullFunctor _functor;
         RenderArgs* _args;
         RenderDetails::Item& _renderDetails;
@@ -35,6 +42,12 @@ namespace render {
         bool solidAngleTest(const AABox& bound);
         bool zoneOcclusionTest(const render::Item& item);
 
+        // Applies the tests to many bounds at a time, setting visible[i] to whether bounds[i] passes all of them and
+        // counting those that don't in the render details, like the single tests above. The frustums are tested against
+        // batches of the bounds laid out as structure of arrays, and large sets of bounds are split across threads,
+        // so the functor must be safe to call concurrently.
+        void cull(const ItemBounds& bounds, uint8_t tests, std::vector<uint8_t>& visible);
+
         static std::unordered_set<QUuid> _containingZones;
         static std::unordered_set<QUuid> _prevContainingZones;
     };
@@ -38,14 +38,14 @@ Q_LOGGING_CATEGORY(trace_baker, "trace.baker")
 #define NSIGHT_TRACING
 #endif
 
-static bool tracingEnabled() {
+static tracing::Tracer* enabledTracer() {
     if (!DependencyManager::isSet<tracing::Tracer>()) {
-        return false;
+        return nullptr;
     }
 
     // Cheers, love! The cavalry's here!
     auto tracer = DependencyManager::get<tracing::Tracer>();
-    return (tracer && tracer->isEnabled());
+    return (tracer && tracer->isEnabled()) ? tracer.data() : nullptr;
 }
 
 DurationBase::DurationBase(const QLoggingCategory& category, const QString& name) : _name(name), _category(category) {
@@ -57,10 +57,15 @@ Duration::Duration(const QLoggingCategory& category,
                    uint64_t payload,
                    const QVariantMap& baseArgs) :
     DurationBase(category, name) {
-    if (tracingEnabled() && category.isDebugEnabled()) {
-        QVariantMap args = baseArgs;
-        args["nv_payload"] = QVariant::fromValue(payload);
-        tracing::traceEvent(_category, _name, tracing::DurationBegin, "", args);
+    auto tracer = enabledTracer();
+    if (tracer && category.isDebugEnabled()) {
+        if (tracer->isBinary() && baseArgs.empty()) {
+            tracer->traceBinaryEvent(_category, _name, tracing::DurationBegin, tracing::Tracer::now(), payload);
+        } else {
+            QVariantMap args = baseArgs;
+            args["nv_payload"] = QVariant::fromValue(payload);
+            tracing::traceEvent(_category, _name, tracing::DurationBegin, "", args);
+        }
 
 #if defined(NSIGHT_TRACING)
         nvtxEventAttributes_t eventAttrib{ 0 };
@@ -79,8 +84,13 @@ Duration::Duration(const QLoggingCategory& category,
 }
 
 Duration::~Duration() {
-    if (tracingEnabled() && _category.isDebugEnabled()) {
-        tracing::traceEvent(_category, _name, tracing::DurationEnd);
+    auto tracer = enabledTracer();
+    if (tracer && _category.isDebugEnabled()) {
+        if (tracer->isBinary()) {
+            tracer->traceBinaryEvent(_category, _name, tracing::DurationEnd, tracing::Tracer::now());
+        } else {
+            tracing::traceEvent(_category, _name, tracing::DurationEnd);
+        }
 #ifdef NSIGHT_TRACING
         nvtxRangePop();
 #endif
@@ -90,7 +100,7 @@ Duration::~Duration() {
 // FIXME
 uint64_t Duration::beginRange(const QLoggingCategory& category, const char* name, uint32_t argbColor) {
 #ifdef NSIGHT_TRACING
-    if (tracingEnabled() && category.isDebugEnabled()) {
+    if (enabledTracer() && category.isDebugEnabled()) {
         nvtxEventAttributes_t eventAttrib = { 0 };
         eventAttrib.version = NVTX_VERSION;
         eventAttrib.size = NVTX_EVENT_ATTRIB_STRUCT_SIZE;
@@ -107,7 +117,7 @@ uint64_t Duration::beginRange(const QLoggingCategory& category, const char* name
 // FIXME
 void Duration::endRange(const QLoggingCategory& category, uint64_t rangeId) {
 #ifdef NSIGHT_TRACING
-    if (tracingEnabled() && category.isDebugEnabled()) {
+    if (enabledTracer() && category.isDebugEnabled()) {
         nvtxRangeEnd(rangeId);
     }
 #endif
@@ -118,12 +128,18 @@ ConditionalDuration::ConditionalDuration(const QLoggingCategory& category, const
 }
 
 ConditionalDuration::~ConditionalDuration() {
-    if (tracingEnabled() && _category.isDebugEnabled()) {
+    auto tracer = enabledTracer();
+    if (tracer && _category.isDebugEnabled()) {
         auto endTime = tracing::Tracer::now();
         auto duration = endTime - _startTime;
         if (duration >= _minTime) {
-            tracing::traceEvent(_category, _startTime, _name, tracing::DurationBegin);
-            tracing::traceEvent(_category, endTime, _name, tracing::DurationEnd);
+            if (tracer->isBinary()) {
+                tracer->traceBinaryEvent(_category, _name, tracing::DurationBegin, _startTime);
+                tracer->traceBinaryEvent(_category, _name, tracing::DurationEnd, endTime);
+            } else {
+                tracing::traceEvent(_category, _startTime, _name, tracing::DurationBegin);
+                tracing::traceEvent(_category, endTime, _name, tracing::DurationEnd);
+            }
         }
     }
 }
@@ -51,6 +51,12 @@ extern "C" FILE * __cdecl __iob_func(void) {
 #include <cerrno>
 #endif
 
+#ifdef Q_OS_LINUX
+#include <sys/resource.h>
+#include <sys/sysinfo.h>
+#include <unistd.h>
+#endif
+
 #include <QtCore/QDebug>
 #include <QDateTime>
 #include <QElapsedTimer>
@@ -881,6 +887,37 @@ bool getMemoryInfo(MemoryInfo& info) {
     info.processUsedMemoryBytes = pmc.PrivateUsage;
     info.processPeakUsedMemoryBytes = pmc.PeakPagefileUsage;
 
+    return true;
+#elif defined(Q_OS_LINUX)
+    struct sysinfo si;
+    if (sysinfo(&si) != 0) {
+        return false;
+    }
+
+    info.totalMemoryBytes = (uint64_t)si.totalram * si.mem_unit;
+    info.availMemoryBytes = (uint64_t)(si.freeram + si.bufferram) * si.mem_unit;
+    info.usedMemoryBytes = info.totalMemoryBytes - info.availMemoryBytes;
+
+    // resident set size, in pages
+    unsigned long size = 0;
+    unsigned long resident = 0;
+    FILE* statm = fopen("/proc/self/statm", "r");
+    if (!statm) {
+        return false;
+    }
+    int numRead = fscanf(statm, "%lu %lu", &size, &resident);
+    fclose(statm);
+    if (numRead != 2) {
+        return false;
+    }
+    info.processUsedMemoryBytes = (uint64_t)resident * sysconf(_SC_PAGESIZE);
+
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return false;
+    }
+    info.processPeakUsedMemoryBytes = (uint64_t)usage.ru_maxrss * 1024; // KB
+
     return true;
 #endif
 
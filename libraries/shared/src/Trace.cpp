@@ -8,7 +8,9 @@
 
 #include "Trace.h"
 
+#include <algorithm>
 #include <chrono>
+#include <cstring>
 
 #include <QtCore/QDebug>
 #include <QtCore/QCoreApplication>
@@ -36,6 +38,74 @@
 
 using namespace tracing;
 
+namespace tracing {
+
+// The binary events of a single thread, which only that thread writes. Once full, each event overwrites the oldest.
+class TraceRing {
+public:
+    TraceRing(int capacity, int64_t threadID) : _threadID(threadID) {
+        // round up to a power of two so that positions wrap with a mask
+        _capacity = 1;
+        while (_capacity < (uint64_t)std::max(capacity, 1)) {
+            _capacity <<= 1;
+        }
+        _events.reset(new BinaryTraceEvent[_capacity]);
+    }
+
+    int64_t getThreadID() const { return _threadID; }
+
+    void push(const BinaryTraceEvent& event) {
+        auto head = _head.load(std::memory_order_relaxed);
+        _events[head & (_capacity - 1)] = event;
+        _head.store(head + 1, std::memory_order_release);
+    }
+
+    // copies the events still in the ring, oldest first, without stopping the thread that writes them
+    void copy(std::vector<BinaryTraceEvent>& events) const {
+        auto head = _head.load(std::memory_order_acquire);
+        uint64_t begin = head > _capacity ? head - _capacity : 0;
+        size_t offset = events.size();
+        for (auto i = begin; i < head; ++i) {
+            events.push_back(_events[i & (_capacity - 1)]);
+        }
+
+        // drop whatever the thread overwrote while it was being copied, including the event it may be writing now,
+        // if it has written anything since the copy began
+        auto newHead = _head.load(std::memory_order_acquire);
+        if (newHead == head) {
+            return;
+        }
+        uint64_t firstIntact = newHead + 1 > _capacity ? newHead + 1 - _capacity : 0;
+        if (firstIntact > begin) {
+            auto numOverwritten = std::min(firstIntact - begin, head - begin);
+            events.erase(events.begin() + offset, events.begin() + offset + numOverwritten);
+        }
+    }
+
+private:
+    const int64_t _threadID;
+    uint64_t _capacity;
+    std::unique_ptr<BinaryTraceEvent[]> _events;
+    std::atomic<uint64_t> _head { 0 };
+};
+
+}
+
+namespace {
+
+struct ThreadTraceState {
+    uint64_t generation { 0 };
+    std::shared_ptr<TraceRing> ring;
+    QHash<QString, uint32_t> nameIDs; // cache of the interned names, to skip the Tracer's lock
+};
+
+thread_local ThreadTraceState threadTraceState;
+
+// shared by all Tracers, so that a thread never mistakes the ring of one capture for another's
+std::atomic<uint64_t> lastRingGeneration { 0 };
+
+}
+
 bool tracing::enabled() {
     return DependencyManager::get<Tracer>()->isEnabled();
 }
@@ -48,6 +118,25 @@ void Tracer::startTracing() {
     }
 
     _events.clear();
+    _binary = false;
+    _enabled = true;
+}
+
+void Tracer::startBinaryTracing(int eventsPerThread) {
+    std::lock_guard<std::mutex> guard(_eventsMutex);
+    if (_enabled) {
+        qWarning() << "Tried to enable tracer, but already enabled";
+        return;
+    }
+
+    _events.clear();
+    {
+        std::lock_guard<std::mutex> ringsGuard(_ringsMutex);
+        _rings.clear();
+        _eventsPerThread = eventsPerThread;
+        _ringGeneration = ++lastRingGeneration;
+    }
+    _binary = true;
     _enabled = true;
 }
 
@@ -120,6 +209,9 @@ void Tracer::serialize(const QString& filename) {
             currentEvents.push_back(event);
         }
     }
+    if (_binary) {
+        collectBinaryEvents(currentEvents);
+    }
 
     // If we can't open a temp file for writing, fail early
     QByteArray data;
@@ -176,6 +268,98 @@ void Tracer::serialize(const QString& filename) {
 #endif
 }
 
+TraceRing& Tracer::threadRing() {
+    auto& state = threadTraceState;
+    auto generation = _ringGeneration.load(std::memory_order_acquire);
+    if (state.generation != generation || !state.ring) {
+        std::lock_guard<std::mutex> guard(_ringsMutex);
+        state.generation = generation;
+        state.nameIDs.clear();
+        state.ring = std::make_shared<TraceRing>(_eventsPerThread, int64_t(QThread::currentThreadId()));
+        _rings.push_back(state.ring);
+    }
+    return *state.ring;
+}
+
+uint32_t Tracer::internName(const QString& name) {
+    auto& nameIDs = threadTraceState.nameIDs;
+    auto itr = nameIDs.constFind(name);
+    if (itr != nameIDs.constEnd()) {
+        return itr.value();
+    }
+
+    uint32_t nameID;
+    {
+        std::lock_guard<std::mutex> guard(_namesMutex);
+        auto globalItr = _nameIDs.constFind(name);
+        if (globalItr != _nameIDs.constEnd()) {
+            nameID = globalItr.value();
+        } else {
+            nameID = (uint32_t)_names.size();
+            _names.push_back(name);
+            _nameIDs.insert(name, nameID);
+        }
+    }
+    nameIDs.insert(name, nameID);
+    return nameID;
+}
+
+void Tracer::traceBinaryEvent(const QLoggingCategory& category, const QString& name, EventType type, int64_t timestamp,
+                              uint64_t payload) {
+    if (!_enabled) {
+        return;
+    }
+
+    auto& ring = threadRing();
+    ring.push({ timestamp, payload, &category, internName(name), 0, type, 0 });
+}
+
+void Tracer::collectBinaryEvents(std::list<TraceEvent>& events) {
+    // later events go into new rings, so that the next serialize doesn't repeat these ones
+    std::vector<std::shared_ptr<TraceRing>> rings;
+    {
+        std::lock_guard<std::mutex> guard(_ringsMutex);
+        rings.swap(_rings);
+        _ringGeneration = ++lastRingGeneration;
+    }
+
+    std::vector<std::vector<BinaryTraceEvent>> ringEvents(rings.size());
+    for (size_t i = 0; i < rings.size(); ++i) {
+        rings[i]->copy(ringEvents[i]);
+    }
+
+    // every name in the copied events was interned before they were recorded
+    std::vector<QString> names;
+    {
+        std::lock_guard<std::mutex> guard(_namesMutex);
+        names = _names;
+    }
+
+    auto processID = QCoreApplication::applicationPid();
+    for (size_t i = 0; i < rings.size(); ++i) {
+        auto threadID = rings[i]->getThreadID();
+        for (const auto& event : ringEvents[i]) {
+            QString id;
+            QVariantMap args;
+            QVariantMap extra;
+            if (event.type == Counter) {
+                double value;
+                memcpy(&value, &event.payload, sizeof(value));
+                args[names[event.argNameID]] = value;
+            } else if (event.flags & BinaryTraceEvent::HasID) {
+                id = QString::number(event.payload, 16);
+            } else if (event.type == Instant) {
+                extra["s"] = names[event.argNameID];
+            } else if (event.type == DurationBegin) {
+                args["nv_payload"] = QVariant::fromValue(event.payload);
+            }
+
+            events.push_back({ id, names[event.nameID], event.type, event.timestamp, processID, threadID,
+                               *event.category, args, extra });
+        }
+    }
+}
+
 int64_t Tracer::now() {
     return std::chrono::duration_cast<std::chrono::microseconds>(p_high_resolution_clock::now().time_since_epoch()).count();
 }
@@ -185,6 +369,31 @@ void Tracer::traceEvent(const QLoggingCategory& category,
     qint64 timestamp, qint64 processID, qint64 threadID,
     const QString& id,
     const QVariantMap& args, const QVariantMap& extra) {
+    // binary tracing keeps only what the trace viewer shows of the args, in a fixed-size event
+    if (_binary && type != Metadata) {
+        if (!_enabled) {
+            return;
+        }
+
+        auto& ring = threadRing();
+        BinaryTraceEvent event { timestamp, 0, &category, internName(name), 0, type, 0 };
+        if (type == Counter) {
+            // only the first value of a counter is kept
+            double value = args.empty() ? 0.0 : args.first().toDouble();
+            memcpy(&event.payload, &value, sizeof(value));
+            event.argNameID = args.empty() ? event.nameID : internName(args.firstKey());
+        } else if (!id.isEmpty()) {
+            event.payload = qHash(id);
+            event.flags |= BinaryTraceEvent::HasID;
+        } else if (type == Instant) {
+            event.argNameID = internName(extra.value("s", "t").toString());
+        } else {
+            event.payload = args.value("nv_payload").toULongLong();
+        }
+        ring.push(event);
+        return;
+    }
+
     std::lock_guard<std::mutex> guard(_eventsMutex);
 
     // We always want to store metadata events even if tracing is not enabled so that when
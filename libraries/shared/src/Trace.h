@@ -10,8 +10,11 @@
 #ifndef hifi_Trace_h
 #define hifi_Trace_h
 
+#include <atomic>
 #include <cstdint>
+#include <memory>
 #include <mutex>
+#include <vector>
 
 #include <QtCore/QString>
 #include <QtCore/QVariantMap>
@@ -76,6 +79,23 @@ struct TraceEvent {
     void writeJson(QTextStream& out) const;
 };
 
+// Fixed-size event recorded by binary tracing, with its strings interned by the Tracer
+struct BinaryTraceEvent {
+    enum Flags : uint8_t {
+        HasID = 1 // payload is the hash of the event's id
+    };
+
+    int64_t timestamp;
+    uint64_t payload; // the nv_payload of a duration, the value of a counter as a double or the hash of an id
+    const QLoggingCategory* category;
+    uint32_t nameID;
+    uint32_t argNameID; // the name of a counter's value, or the scope of an instant event
+    EventType type;
+    uint8_t flags;
+};
+
+class TraceRing;
+
 class Tracer : public Dependency {
 public:
     static int64_t now();
@@ -90,10 +110,20 @@ public:
         const QString& id = "", 
         const QVariantMap& args = QVariantMap(), const QVariantMap& extra = QVariantMap());
 
+    static const int DEFAULT_BINARY_EVENTS_PER_THREAD = 1 << 16;
+
     void startTracing();
+    // records fixed-size events into a lock-free ring per thread instead, keeping only the latest eventsPerThread
+    // events of each thread, which are only turned into trace JSON by serialize
+    void startBinaryTracing(int eventsPerThread = DEFAULT_BINARY_EVENTS_PER_THREAD);
     void stopTracing();
     void serialize(const QString& file);
     bool isEnabled() const { return _enabled; }
+    bool isBinary() const { return _binary; }
+
+    // records a duration event into the calling thread's ring, without building any QVariantMap
+    void traceBinaryEvent(const QLoggingCategory& category, const QString& name, EventType type, int64_t timestamp,
+                          uint64_t payload = 0);
 
 private:
     void traceEvent(const QLoggingCategory& category, 
@@ -102,10 +132,24 @@ private:
         const QString& id = "",
         const QVariantMap& args = QVariantMap(), const QVariantMap& extra = QVariantMap());
 
-    bool _enabled { false };
+    TraceRing& threadRing();
+    uint32_t internName(const QString& name);
+    void collectBinaryEvents(std::list<TraceEvent>& events);
+
+    std::atomic<bool> _enabled { false };
     std::list<TraceEvent> _events;
     std::list<TraceEvent> _metadataEvents;
     std::mutex _eventsMutex;
+
+    // binary tracing
+    std::atomic<bool> _binary { false };
+    std::atomic<uint64_t> _ringGeneration { 0 }; // threads start a new ring when it changes
+    int _eventsPerThread { DEFAULT_BINARY_EVENTS_PER_THREAD };
+    std::vector<std::shared_ptr<TraceRing>> _rings; // guarded by _ringsMutex
+    std::mutex _ringsMutex;
+    QHash<QString, uint32_t> _nameIDs; // guarded by _namesMutex
+    std::vector<QString> _names; // guarded by _namesMutex
+    std::mutex _namesMutex;
 };
 
 inline void traceEvent(const QLoggingCategory& category, int64_t timestamp, const QString& name, EventType type, const QString& id = "", const QVariantMap& args = {}, const QVariantMap& extra = {}) {
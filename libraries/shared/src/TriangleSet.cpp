@@ -11,9 +11,9 @@
 
 #include "TriangleSet.h"
 
-#include "GLMHelpers.h"
+#include <algorithm>
 
-#include <list>
+#include "GLMHelpers.h"
 
 void TriangleSet::insert(const Triangle& t) {
     _isBalanced = false;
@@ -29,7 +29,8 @@ void TriangleSet::clear() {
     _bounds.clear();
     _isBalanced = false;
 
-    _triangleTree.clear();
+    _nodes.clear();
+    _packets.clear();
 }
 
 bool TriangleSet::convexHullContains(const glm::vec3& point) const {
@@ -52,17 +53,98 @@ bool TriangleSet::convexHullContains(const glm::vec3& point) const {
 void TriangleSet::debugDump() {
     qDebug() << __FUNCTION__;
     qDebug() << "bounds:" << getBounds();
-    qDebug() << "triangles:" << size() << "at top level....";
-    qDebug() << "----- _triangleTree -----";
-    _triangleTree.debugDump();
+    qDebug() << "triangles:" << size() << "nodes:" << _nodes.size() << "packets:" << _packets.size();
+}
+
+struct TriangleSet::BuildTriangle {
+    glm::vec3 minimum;
+    glm::vec3 maximum;
+    glm::vec3 centroid;
+    uint32_t index;
+};
+
+namespace {
+
+// leaves deeper than this hold all of their triangles, in as many packets as it takes
+const int MAX_DEPTH = 48;
+// depth first traversal keeps at most one pending sibling per level
+const int MAX_STACK_SIZE = MAX_DEPTH + 2;
+
+const int NUM_BINS = 12;
+// the cost of visiting an inner node, relative to testing a packet
+const float NODE_COST = 1.0f;
+
+struct Bounds {
+    glm::vec3 minimum { FLT_MAX };
+    glm::vec3 maximum { -FLT_MAX };
+
+    void grow(const glm::vec3& point) {
+        minimum = glm::min(minimum, point);
+        maximum = glm::max(maximum, point);
+    }
+    void grow(const Bounds& other) {
+        minimum = glm::min(minimum, other.minimum);
+        maximum = glm::max(maximum, other.maximum);
+    }
+
+    // half the surface area, which is all the heuristic needs
+    float getArea() const {
+        if (minimum.x > maximum.x) {
+            return 0.0f;
+        }
+        glm::vec3 dimensions = maximum - minimum;
+        return dimensions.x * dimensions.y + dimensions.y * dimensions.z + dimensions.z * dimensions.x;
+    }
+};
+
+struct StackEntry {
+    uint32_t node;
+    float distance;
+};
+
+// the cost of testing a leaf, in packets of four triangles
+float getNumPackets(size_t numTriangles) {
+    return (float)((numTriangles + 3) / 4);
+}
+
+// \return the distance at which the ray enters the box, 0 if it starts inside it, or FLT_MAX if it misses the box
+// or enters it further away than maxDistance
+inline float findRayBoxEntry(const glm::vec3& minimum, const glm::vec3& maximum, const glm::vec3& origin,
+                             const glm::vec3& invDirection, float maxDistance) {
+    glm::vec3 t1 = (minimum - origin) * invDirection;
+    glm::vec3 t2 = (maximum - origin) * invDirection;
+    glm::vec3 tNear = glm::min(t1, t2);
+    glm::vec3 tFar = glm::max(t1, t2);
+    float entry = glm::max(glm::max(tNear.x, tNear.y), glm::max(tNear.z, 0.0f));
+    // rounding can put the exit a hair before the entry for a ray through an edge or corner of the box, where it may
+    // still hit a triangle, so the exit is pushed out a little
+    const float EXIT_SCALE = 1.0f + 4.0f * FLT_EPSILON;
+    float exit = glm::min(glm::min(tFar.x, tFar.y), tFar.z) * EXIT_SCALE;
+    return entry <= glm::min(exit, maxDistance) ? entry : FLT_MAX;
+}
+
 }
 
 void TriangleSet::balanceTree() {
-    _triangleTree.reset(_bounds);
+    _nodes.clear();
+    _packets.clear();
+
+    if (!_triangles.empty()) {
+        std::vector<BuildTriangle> buildTriangles;
+        buildTriangles.reserve(_triangles.size());
+        for (size_t i = 0; i < _triangles.size(); i++) {
+            const Triangle& triangle = _triangles[i];
+            BuildTriangle buildTriangle;
+            buildTriangle.minimum = glm::min(triangle.v0, glm::min(triangle.v1, triangle.v2));
+            buildTriangle.maximum = glm::max(triangle.v0, glm::max(triangle.v1, triangle.v2));
+            buildTriangle.centroid = 0.5f * (buildTriangle.minimum + buildTriangle.maximum);
+            buildTriangle.index = (uint32_t)i;
+            buildTriangles.push_back(buildTriangle);
+        }
 
-    // insert all the triangles
-    for (size_t i = 0; i < _triangles.size(); i++) {
-        _triangleTree.insert(i);
+        _nodes.reserve(2 * (_triangles.size() / PACKET_SIZE) + 1);
+        _packets.reserve(_triangles.size() / PACKET_SIZE + 1);
+        buildNode(buildTriangles, 0, buildTriangles.size(), 0);
     }
 
     _isBalanced = true;
@@ -72,257 +154,244 @@ void TriangleSet::balanceTree() {
 #endif
 }
 
-// With an octree: 8 ^ MAX_DEPTH = 4096 leaves
-//static const int MAX_DEPTH = 4;
-// With a k-d tree: 2 ^ MAX_DEPTH = 4096 leaves
-static const int MAX_DEPTH = 12;
+uint32_t TriangleSet::buildNode(std::vector<BuildTriangle>& buildTriangles, size_t begin, size_t end, int depth) {
+    uint32_t index = (uint32_t)_nodes.size();
+    _nodes.emplace_back();
 
-TriangleSet::TriangleTreeCell::TriangleTreeCell(std::vector<Triangle>& allTriangles, const AABox& bounds, int depth) :
-    _allTriangles(allTriangles)
-{
-    reset(bounds, depth);
-}
+    Bounds bounds;
+    Bounds centroidBounds;
+    for (size_t i = begin; i < end; i++) {
+        bounds.grow(buildTriangles[i].minimum);
+        bounds.grow(buildTriangles[i].maximum);
+        centroidBounds.grow(buildTriangles[i].centroid);
+    }
+    _nodes[index].minimum = bounds.minimum;
+    _nodes[index].maximum = bounds.maximum;
 
-void TriangleSet::TriangleTreeCell::clear() {
-    _population = 0;
-    _triangleIndices.clear();
-    _bounds.clear();
-    _children.first.reset();
-    _children.second.reset();
-}
+    size_t numTriangles = end - begin;
+    if (numTriangles <= PACKET_SIZE || depth >= MAX_DEPTH) {
+        makeLeaf(_nodes[index], buildTriangles, begin, end);
+        return index;
+    }
 
-void TriangleSet::TriangleTreeCell::reset(const AABox& bounds, int depth) {
-    clear();
-    _bounds = bounds;
-    _depth = depth;
-}
+    // find the split with the lowest cost by the surface area heuristic, among the boundaries of bins of the
+    // triangle centroids along each axis
+    float bestCost = FLT_MAX;
+    int bestAxis = -1;
+    int bestSplit = 0;
+    glm::vec3 extent = centroidBounds.maximum - centroidBounds.minimum;
+    for (int axis = 0; axis < 3; axis++) {
+        if (extent[axis] <= 0.0f) {
+            continue;
+        }
 
-void TriangleSet::TriangleTreeCell::debugDump() {
-    qDebug() << __FUNCTION__;
-    qDebug() << "               bounds:" << getBounds();
-    qDebug() << "                depth:" << _depth;
-    qDebug() << "           population:" << _population << "this level or below"
-             << " ---- triangleIndices:" << _triangleIndices.size() << "in this cell";
-
-    int numChildren = 0;
-    if (_children.first) {
-        numChildren++;
-    } else if (_children.second) {
-        numChildren++;
-    }
-    qDebug() << "child cells:" << numChildren;
-    if (_depth < MAX_DEPTH) {
-        if (_children.first) {
-            qDebug() << "child: 0";
-            _children.first->debugDump();
+        Bounds bins[NUM_BINS];
+        size_t binCounts[NUM_BINS] = {};
+        float binScale = NUM_BINS / extent[axis];
+        for (size_t i = begin; i < end; i++) {
+            int bin = std::min((int)((buildTriangles[i].centroid[axis] - centroidBounds.minimum[axis]) * binScale), NUM_BINS - 1);
+            binCounts[bin]++;
+            bins[bin].grow(buildTriangles[i].minimum);
+            bins[bin].grow(buildTriangles[i].maximum);
         }
-        if (_children.second) {
-            qDebug() << "child: 1";
-            _children.second->debugDump();
+
+        // sweep from the right for the cost of everything right of each boundary, then from the left
+        float rightCosts[NUM_BINS];
+        Bounds rightBounds;
+        size_t rightCount = 0;
+        for (int bin = NUM_BINS - 1; bin > 0; bin--) {
+            rightBounds.grow(bins[bin]);
+            rightCount += binCounts[bin];
+            rightCosts[bin] = rightBounds.getArea() * getNumPackets(rightCount);
+        }
+        Bounds leftBounds;
+        size_t leftCount = 0;
+        for (int bin = 0; bin < NUM_BINS - 1; bin++) {
+            leftBounds.grow(bins[bin]);
+            leftCount += binCounts[bin];
+            if (leftCount == 0 || leftCount == numTriangles) {
+                continue;
+            }
+            float cost = leftBounds.getArea() * getNumPackets(leftCount) + rightCosts[bin + 1];
+            if (cost < bestCost) {
+                bestCost = cost;
+                bestAxis = axis;
+                bestSplit = bin + 1;
+            }
         }
     }
-}
 
-std::pair<AABox, AABox> TriangleSet::TriangleTreeCell::getTriangleTreeCellChildBounds() {
-    std::pair<AABox, AABox> toReturn;
-    int axis = 0;
-    // find biggest axis
-    glm::vec3 dimensions = _bounds.getDimensions();
-    for (int i = 0; i < 3; i++) {
-        if (dimensions[i] >= dimensions[(i + 1) % 3] && dimensions[i] >= dimensions[(i + 2) % 3]) {
-            axis = i;
-            break;
-        }
+    float area = bounds.getArea();
+    if (bestAxis < 0 || (area > 0.0f && NODE_COST + bestCost / area >= getNumPackets(numTriangles))) {
+        // the centroids are all in the same place, or splitting them costs more than testing them all
+        makeLeaf(_nodes[index], buildTriangles, begin, end);
+        return index;
     }
 
-    // The new boxes are half the size in the largest dimension
-    glm::vec3 newDimensions = dimensions;
-    newDimensions[axis] *= 0.5f;
-    toReturn.first.setBox(_bounds.getCorner(), newDimensions);
-    glm::vec3 offset = glm::vec3(0.0f);
-    offset[axis] = newDimensions[axis];
-    toReturn.second.setBox(_bounds.getCorner() + offset, newDimensions);
-    return toReturn;
+    float binScale = NUM_BINS / extent[bestAxis];
+    float binMinimum = centroidBounds.minimum[bestAxis];
+    auto middle = std::partition(buildTriangles.begin() + begin, buildTriangles.begin() + end, [&](const BuildTriangle& triangle) {
+        return std::min((int)((triangle.centroid[bestAxis] - binMinimum) * binScale), NUM_BINS - 1) < bestSplit;
+    });
+    size_t split = middle - buildTriangles.begin();
+
+    // the first child goes right after this node
+    buildNode(buildTriangles, begin, split, depth + 1);
+    uint32_t secondChild = buildNode(buildTriangles, split, end, depth + 1);
+    _nodes[index].offset = secondChild;
+    _nodes[index].numTriangles = 0;
+    return index;
 }
 
-void TriangleSet::TriangleTreeCell::insert(size_t triangleIndex) {
-    _population++;
-
-    // if we're not yet at the max depth, then check which child the triangle fits in
-    if (_depth < MAX_DEPTH) {
-        const Triangle& triangle = _allTriangles[triangleIndex];
-        auto childBounds = getTriangleTreeCellChildBounds();
-
-        auto insertOperator = [&](const AABox& childBound, std::shared_ptr<TriangleTreeCell>& child) {
-            // if the child AABox would contain the triangle...
-            if (childBound.contains(triangle)) {
-                // if the child cell doesn't yet exist, create it...
-                if (!child) {
-                    child = std::make_shared<TriangleTreeCell>(_allTriangles, childBound, _depth + 1);
-                }
-
-                // insert the triangleIndex in the child cell
-                child->insert(triangleIndex);
-                return true;
+void TriangleSet::makeLeaf(Node& node, const std::vector<BuildTriangle>& buildTriangles, size_t begin, size_t end) {
+    node.offset = (uint32_t)_packets.size();
+    node.numTriangles = (uint32_t)(end - begin);
+
+    for (size_t first = begin; first < end; first += PACKET_SIZE) {
+        // triangles past the end of the leaf are left degenerate, which never hits
+        Packet packet {};
+        for (int lane = 0; lane < PACKET_SIZE; lane++) {
+            if (first + lane >= end) {
+                packet.triangles[lane] = INVALID_TRIANGLE;
+                continue;
             }
-            return false;
-        };
-        if (insertOperator(childBounds.first, _children.first) || insertOperator(childBounds.second, _children.second)) {
-            return;
+            uint32_t triangleIndex = buildTriangles[first + lane].index;
+            const Triangle& triangle = _triangles[triangleIndex];
+            glm::vec3 firstSide = triangle.v1 - triangle.v0;
+            glm::vec3 secondSide = triangle.v2 - triangle.v0;
+            for (int i = 0; i < 3; i++) {
+                packet.v0[i][lane] = triangle.v0[i];
+                packet.firstSide[i][lane] = firstSide[i];
+                packet.secondSide[i][lane] = secondSide[i];
+            }
+            packet.triangles[lane] = triangleIndex;
         }
+        _packets.push_back(packet);
     }
-    // either we're at max depth, or the triangle doesn't fit in one of our
-    // children and so we want to just record it here
-    _triangleIndices.push_back(triangleIndex);
 }
 
-bool TriangleSet::findRayIntersection(const glm::vec3& origin, const glm::vec3& direction, const glm::vec3& invDirection, float& distance,
-                                      BoxFace& face, Triangle& triangle, bool precision, bool allowBackface) {
-    if (!_isBalanced) {
-        balanceTree();
-    }
-
-    float localDistance = distance;
-    int trianglesTouched = 0;
-    bool hit = _triangleTree.findRayIntersection(origin, direction, invDirection, localDistance, face, triangle, precision, trianglesTouched, allowBackface);
-    if (hit) {
-        distance = localDistance;
+uint32_t TriangleSet::findRayPacketIntersection(const Packet& packet, const glm::vec3& origin, const glm::vec3& direction,
+                                                float& distance, bool allowBackface) const {
+    // the same test as findRayTriangleIntersection, on every lane of the packet at once
+    float distances[PACKET_SIZE];
+    bool hits[PACKET_SIZE];
+    for (int i = 0; i < PACKET_SIZE; i++) {
+        const float firstSide[3] = { packet.firstSide[0][i], packet.firstSide[1][i], packet.firstSide[2][i] };
+        const float secondSide[3] = { packet.secondSide[0][i], packet.secondSide[1][i], packet.secondSide[2][i] };
+
+        // P = cross(direction, secondSide)
+        float px = direction.y * secondSide[2] - secondSide[1] * direction.z;
+        float py = direction.z * secondSide[0] - secondSide[2] * direction.x;
+        float pz = direction.x * secondSide[1] - secondSide[0] * direction.y;
+        float det = firstSide[0] * px + firstSide[1] * py + firstSide[2] * pz;
+        bool isFacing = allowBackface ? fabsf(det) >= EPSILON : det >= EPSILON;
+        float invDet = 1.0f / det;
+
+        // T = origin - v0
+        float tx = origin.x - packet.v0[0][i];
+        float ty = origin.y - packet.v0[1][i];
+        float tz = origin.z - packet.v0[2][i];
+        float u = (tx * px + ty * py + tz * pz) * invDet;
+
+        // Q = cross(T, firstSide)
+        float qx = ty * firstSide[2] - firstSide[1] * tz;
+        float qy = tz * firstSide[0] - firstSide[2] * tx;
+        float qz = tx * firstSide[1] - firstSide[0] * ty;
+        float v = (direction.x * qx + direction.y * qy + direction.z * qz) * invDet;
+
+        distances[i] = (secondSide[0] * qx + secondSide[1] * qy + secondSide[2] * qz) * invDet;
+        hits[i] = isFacing & (u >= 0.0f) & (u <= 1.0f) & (v >= 0.0f) & (u + v <= 1.0f) & (distances[i] > EPSILON);
     }
 
-#if WANT_DEBUGGING
-    if (precision) {
-        qDebug() << "trianglesTouched :" << trianglesTouched << "out of:" << _triangleTree._population << "_triangles.size:" << _triangles.size();
+    uint32_t closest = INVALID_TRIANGLE;
+    for (int i = 0; i < PACKET_SIZE; i++) {
+        if (hits[i] && distances[i] < distance) {
+            distance = distances[i];
+            closest = packet.triangles[i];
+        }
     }
-#endif
-    return hit;
+    return closest;
 }
 
 // Determine of the given ray (origin/direction) in model space intersects with any triangles
 // in the set. If an intersection occurs, the distance and surface normal will be provided.
-bool TriangleSet::TriangleTreeCell::findRayIntersectionInternal(const glm::vec3& origin, const glm::vec3& direction,
-                                                                  float& distance, BoxFace& face, Triangle& triangle, bool precision,
-                                                                  int& trianglesTouched, bool allowBackface) {
-    bool intersectedSomething = false;
-    float bestDistance = FLT_MAX;
-    Triangle bestTriangle;
-
-    if (precision) {
-        for (const auto& triangleIndex : _triangleIndices) {
-            const auto& thisTriangle = _allTriangles[triangleIndex];
-            float thisTriangleDistance;
-            trianglesTouched++;
-            if (findRayTriangleIntersection(origin, direction, thisTriangle, thisTriangleDistance, allowBackface)) {
-                if (thisTriangleDistance < bestDistance) {
-                    bestDistance = thisTriangleDistance;
-                    bestTriangle = thisTriangle;
-                    intersectedSomething = true;
-                }
-            }
-        }
-    } else {
-        intersectedSomething = true;
-        bestDistance = distance;
+// Without precision, the distance is that to the bounds of the closest leaf of the hierarchy hit by the ray, if that is
+// closer than the distance passed in.
+bool TriangleSet::findRayIntersection(const glm::vec3& origin, const glm::vec3& direction, const glm::vec3& invDirection, float& distance,
+                                      BoxFace& face, Triangle& triangle, bool precision, bool allowBackface) {
+    if (!_isBalanced) {
+        balanceTree();
     }
-
-    if (intersectedSomething) {
-        distance = bestDistance;
-        triangle = bestTriangle;
+    if (_nodes.empty()) {
+        return false;
     }
 
-    return intersectedSomething;
-}
+    float bestDistance = precision ? FLT_MAX : distance;
+    uint32_t bestTriangle = INVALID_TRIANGLE;
 
-bool TriangleSet::TriangleTreeCell::findRayIntersection(const glm::vec3& origin, const glm::vec3& direction, const glm::vec3& invDirection,
-                                                        float& distance, BoxFace& face, Triangle& triangle, bool precision, int& trianglesTouched,
-                                                        bool allowBackface) {
-    if (_population < 1) {
-        return false; // no triangles below here, so we can't intersect
+    StackEntry stack[MAX_STACK_SIZE];
+    int stackSize = 0;
+    float rootDistance = findRayBoxEntry(_nodes[0].minimum, _nodes[0].maximum, origin, invDirection, bestDistance);
+    if (rootDistance < FLT_MAX) {
+        stack[stackSize++] = { 0, rootDistance };
     }
 
-    float bestLocalDistance = FLT_MAX;
-    BoxFace bestLocalFace;
-    Triangle bestLocalTriangle;
-    bool intersects = false;
-
-    // Check our local triangle set first
-    // The distance passed in here is the distance to our bounding box.  If !precision, that distance is used
-    {
-        float internalDistance = distance;
-        BoxFace internalFace { UNKNOWN_FACE };
-        Triangle internalTriangle;
-        if (findRayIntersectionInternal(origin, direction, internalDistance, internalFace, internalTriangle, precision, trianglesTouched, allowBackface)) {
-            bestLocalDistance = internalDistance;
-            bestLocalFace = internalFace;
-            bestLocalTriangle = internalTriangle;
-            intersects = true;
+    while (stackSize > 0) {
+        StackEntry entry = stack[--stackSize];
+        // We can skip this node once it's further than the closest hit so far
+        if (entry.distance > bestDistance) {
+            continue;
         }
-    }
 
-    // if we're not yet at the max depth, then check our children
-    if (_depth < MAX_DEPTH) {
-        std::list<SortedTriangleCell> sortedTriangleCells;
-        auto sortingOperator = [&](std::shared_ptr<TriangleTreeCell>& child) {
-            if (child) {
-                float priority = FLT_MAX;
-                if (child->getBounds().contains(origin)) {
-                    priority = 0.0f;
-                } else {
-                    float childBoundDistance = FLT_MAX;
-                    BoxFace childBoundFace;
-                    glm::vec3 childBoundNormal;
-                    if (child->getBounds().findRayIntersection(origin, direction, invDirection, childBoundDistance, childBoundFace, childBoundNormal)) {
-                        // We only need to add this cell if it's closer than the local triangle set intersection (if there was one)
-                        if (childBoundDistance < bestLocalDistance) {
-                            priority = childBoundDistance;
-                        }
+        const Node& node = _nodes[entry.node];
+        if (node.numTriangles > 0) {
+            if (precision) {
+                uint32_t numPackets = (node.numTriangles + PACKET_SIZE - 1) / PACKET_SIZE;
+                for (uint32_t i = node.offset; i < node.offset + numPackets; i++) {
+                    uint32_t hit = findRayPacketIntersection(_packets[i], origin, direction, bestDistance, allowBackface);
+                    if (hit != INVALID_TRIANGLE) {
+                        bestTriangle = hit;
                     }
                 }
-
-                if (priority < FLT_MAX) {
-                    if (sortedTriangleCells.size() > 0 && priority < sortedTriangleCells.front().first) {
-                        sortedTriangleCells.emplace_front(priority, child);
-                    } else {
-                        sortedTriangleCells.emplace_back(priority, child);
-                    }
-                }
-            }
-        };
-        sortingOperator(_children.first);
-        sortingOperator(_children.second);
-
-        for (auto it = sortedTriangleCells.begin(); it != sortedTriangleCells.end(); ++it) {
-            const SortedTriangleCell& sortedTriangleCell = *it;
-            float childDistance = sortedTriangleCell.first;
-            // We can exit once childDistance > bestLocalDistance
-            if (childDistance > bestLocalDistance) {
-                break;
-            }
-            // If we're inside the child cell and !precision, we need the actual distance to the cell bounds
-            if (!precision && childDistance < EPSILON) {
-                BoxFace childBoundFace;
-                glm::vec3 childBoundNormal;
-                sortedTriangleCell.second->getBounds().findRayIntersection(origin, direction, invDirection, childDistance, childBoundFace, childBoundNormal);
-            }
-            BoxFace childFace;
-            Triangle childTriangle;
-            if (sortedTriangleCell.second->findRayIntersection(origin, direction, invDirection, childDistance, childFace, childTriangle, precision, trianglesTouched)) {
-                if (childDistance < bestLocalDistance) {
-                    bestLocalDistance = childDistance;
-                    bestLocalFace = childFace;
-                    bestLocalTriangle = childTriangle;
-                    intersects = true;
-                    break;
+            } else {
+                float leafDistance;
+                BoxFace leafFace;
+                glm::vec3 leafNormal;
+                if (findRayAABoxIntersection(origin, direction, invDirection, node.minimum, node.maximum - node.minimum,
+                                             leafDistance, leafFace, leafNormal) && leafDistance < bestDistance) {
+                    bestDistance = leafDistance;
                 }
             }
+            continue;
+        }
+
+        // visit the closer child first
+        StackEntry first = { entry.node + 1, 0.0f };
+        StackEntry second = { node.offset, 0.0f };
+        first.distance = findRayBoxEntry(_nodes[first.node].minimum, _nodes[first.node].maximum, origin, invDirection, bestDistance);
+        second.distance = findRayBoxEntry(_nodes[second.node].minimum, _nodes[second.node].maximum, origin, invDirection, bestDistance);
+        if (second.distance < first.distance) {
+            std::swap(first, second);
+        }
+        if (second.distance < FLT_MAX) {
+            stack[stackSize++] = second;
+        }
+        if (first.distance < FLT_MAX) {
+            stack[stackSize++] = first;
         }
     }
 
-    if (intersects) {
-        distance = bestLocalDistance;
-        face = bestLocalFace;
-        triangle = bestLocalTriangle;
+    if (!precision) {
+        distance = bestDistance;
+        return true;
     }
-    return intersects;
+    if (bestTriangle == INVALID_TRIANGLE) {
+        return false;
+    }
+    distance = bestDistance;
+    face = UNKNOWN_FACE;
+    triangle = _triangles[bestTriangle];
+    return true;
 }
 
 bool TriangleSet::findParabolaIntersection(const glm::vec3& origin, const glm::vec3& velocity, const glm::vec3& acceleration,
@@ -330,146 +399,87 @@ bool TriangleSet::findParabolaIntersection(const glm::vec3& origin, const glm::v
     if (!_isBalanced) {
         balanceTree();
     }
-
-    float localDistance = parabolicDistance;
-    int trianglesTouched = 0;
-    bool hit = _triangleTree.findParabolaIntersection(origin, velocity, acceleration, localDistance, face, triangle, precision, trianglesTouched, allowBackface);
-    if (hit) {
-        parabolicDistance = localDistance;
+    if (_nodes.empty()) {
+        return false;
     }
 
-#if WANT_DEBUGGING
-    if (precision) {
-        qDebug() << "trianglesTouched :" << trianglesTouched << "out of:" << _triangleTree._population << "_triangles.size:" << _triangles.size();
-    }
-#endif
-    return hit;
-}
+    float bestDistance = precision ? FLT_MAX : parabolicDistance;
+    uint32_t bestTriangle = INVALID_TRIANGLE;
 
-bool TriangleSet::TriangleTreeCell::findParabolaIntersectionInternal(const glm::vec3& origin, const glm::vec3& velocity,
-                                                                       const glm::vec3& acceleration, float& parabolicDistance,
-                                                                       BoxFace& face, Triangle& triangle, bool precision,
-                                                                       int& trianglesTouched, bool allowBackface) {
-    bool intersectedSomething = false;
-    float bestDistance = FLT_MAX;
-    Triangle bestTriangle;
-
-    if (precision) {
-        for (const auto& triangleIndex : _triangleIndices) {
-            const auto& thisTriangle = _allTriangles[triangleIndex];
-            float thisTriangleDistance;
-            trianglesTouched++;
-            if (findParabolaTriangleIntersection(origin, velocity, acceleration, thisTriangle, thisTriangleDistance, allowBackface)) {
-                if (thisTriangleDistance < bestDistance) {
-                    bestDistance = thisTriangleDistance;
-                    bestTriangle = thisTriangle;
-                    intersectedSomething = true;
-                }
-            }
+    auto findNodeDistance = [&](const Node& node, bool zeroIfInside) {
+        AABox bounds(node.minimum, node.maximum - node.minimum);
+        if (zeroIfInside && bounds.contains(origin)) {
+            return 0.0f;
         }
-    } else {
-        intersectedSomething = true;
-        bestDistance = parabolicDistance;
-    }
-
-    if (intersectedSomething) {
-        parabolicDistance = bestDistance;
-        triangle = bestTriangle;
-    }
-
-    return intersectedSomething;
-}
-
-bool TriangleSet::TriangleTreeCell::findParabolaIntersection(const glm::vec3& origin, const glm::vec3& velocity,
-                                                               const glm::vec3& acceleration, float& parabolicDistance,
-                                                               BoxFace& face, Triangle& triangle, bool precision,
-                                                               int& trianglesTouched, bool allowBackface) {
-    if (_population < 1) {
-        return false; // no triangles below here, so we can't intersect
+        float nodeDistance;
+        BoxFace nodeFace;
+        glm::vec3 nodeNormal;
+        if (bounds.findParabolaIntersection(origin, velocity, acceleration, nodeDistance, nodeFace, nodeNormal) &&
+            nodeDistance < bestDistance) {
+            return nodeDistance;
+        }
+        return FLT_MAX;
+    };
+
+    StackEntry stack[MAX_STACK_SIZE];
+    int stackSize = 0;
+    float rootDistance = findNodeDistance(_nodes[0], true);
+    if (rootDistance < FLT_MAX) {
+        stack[stackSize++] = { 0, rootDistance };
     }
 
-    float bestLocalDistance = FLT_MAX;
-    BoxFace bestLocalFace;
-    Triangle bestLocalTriangle;
-    bool intersects = false;
-
-    // Check our local triangle set first
-    // The distance passed in here is the distance to our bounding box.  If !precision, that distance is used
-    {
-        float internalDistance = parabolicDistance;
-        BoxFace internalFace;
-        Triangle internalTriangle;
-        if (findParabolaIntersectionInternal(origin, velocity, acceleration, internalDistance, internalFace, internalTriangle, precision, trianglesTouched, allowBackface)) {
-            bestLocalDistance = internalDistance;
-            bestLocalFace = internalFace;
-            bestLocalTriangle = internalTriangle;
-            intersects = true;
+    while (stackSize > 0) {
+        StackEntry entry = stack[--stackSize];
+        // We can skip this node once it's further than the closest hit so far
+        if (entry.distance > bestDistance) {
+            continue;
         }
-    }
 
-    // if we're not yet at the max depth, then check our children
-    if (_depth < MAX_DEPTH) {
-        std::list<SortedTriangleCell> sortedTriangleCells;
-        auto sortingOperator = [&](std::shared_ptr<TriangleTreeCell>& child) {
-            if (child) {
-                float priority = FLT_MAX;
-                if (child->getBounds().contains(origin)) {
-                    priority = 0.0f;
-                } else {
-                    float childBoundDistance = FLT_MAX;
-                    BoxFace childBoundFace;
-                    glm::vec3 childBoundNormal;
-                    if (child->getBounds().findParabolaIntersection(origin, velocity, acceleration, childBoundDistance, childBoundFace, childBoundNormal)) {
-                        // We only need to add this cell if it's closer than the local triangle set intersection (if there was one)
-                        if (childBoundDistance < bestLocalDistance) {
-                            priority = childBoundDistance;
+        const Node& node = _nodes[entry.node];
+        if (node.numTriangles > 0) {
+            if (precision) {
+                uint32_t numPackets = (node.numTriangles + PACKET_SIZE - 1) / PACKET_SIZE;
+                for (uint32_t i = node.offset; i < node.offset + numPackets; i++) {
+                    for (uint32_t triangleIndex : _packets[i].triangles) {
+                        float thisTriangleDistance;
+                        if (triangleIndex != INVALID_TRIANGLE &&
+                            findParabolaTriangleIntersection(origin, velocity, acceleration, _triangles[triangleIndex],
+                                                             thisTriangleDistance, allowBackface) &&
+                            thisTriangleDistance < bestDistance) {
+                            bestDistance = thisTriangleDistance;
+                            bestTriangle = triangleIndex;
                         }
                     }
                 }
-
-                if (priority < FLT_MAX) {
-                    if (sortedTriangleCells.size() > 0 && priority < sortedTriangleCells.front().first) {
-                        sortedTriangleCells.emplace_front(priority, child);
-                    } else {
-                        sortedTriangleCells.emplace_back(priority, child);
-                    }
-                }
-            }
-        };
-        sortingOperator(_children.first);
-        sortingOperator(_children.second);
-
-        for (auto it = sortedTriangleCells.begin(); it != sortedTriangleCells.end(); ++it) {
-            const SortedTriangleCell& sortedTriangleCell = *it;
-            float childDistance = sortedTriangleCell.first;
-            // We can exit once childDistance > bestLocalDistance
-            if (childDistance > bestLocalDistance) {
-                break;
-            }
-            // If we're inside the child cell and !precision, we need the actual distance to the cell bounds
-            if (!precision && childDistance < EPSILON) {
-                BoxFace childBoundFace;
-                glm::vec3 childBoundNormal;
-                sortedTriangleCell.second->getBounds().findParabolaIntersection(origin, velocity, acceleration, childDistance, childBoundFace, childBoundNormal);
-            }
-            BoxFace childFace;
-            Triangle childTriangle;
-            if (sortedTriangleCell.second->findParabolaIntersection(origin, velocity, acceleration, childDistance, childFace, childTriangle, precision, trianglesTouched)) {
-                if (childDistance < bestLocalDistance) {
-                    bestLocalDistance = childDistance;
-                    bestLocalFace = childFace;
-                    bestLocalTriangle = childTriangle;
-                    intersects = true;
-                    break;
-                }
+            } else {
+                bestDistance = std::min(bestDistance, findNodeDistance(node, false));
             }
+            continue;
+        }
+
+        // visit the closer child first
+        StackEntry first = { entry.node + 1, findNodeDistance(_nodes[entry.node + 1], true) };
+        StackEntry second = { node.offset, findNodeDistance(_nodes[node.offset], true) };
+        if (second.distance < first.distance) {
+            std::swap(first, second);
+        }
+        if (second.distance < FLT_MAX) {
+            stack[stackSize++] = second;
+        }
+        if (first.distance < FLT_MAX) {
+            stack[stackSize++] = first;
         }
     }
 
-    if (intersects) {
-        parabolicDistance = bestLocalDistance;
-        face = bestLocalFace;
-        triangle = bestLocalTriangle;
+    if (!precision) {
+        parabolicDistance = bestDistance;
+        return true;
+    }
+    if (bestTriangle == INVALID_TRIANGLE) {
+        return false;
     }
-    return intersects;
+    parabolicDistance = bestDistance;
+    face = UNKNOWN_FACE;
+    triangle = _triangles[bestTriangle];
+    return true;
 }
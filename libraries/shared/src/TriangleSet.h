@@ -12,58 +12,18 @@
 #pragma once
 
 #include <vector>
-#include <memory>
 
 #include "AABox.h"
 #include "GeometryUtil.h"
 
+// Triangles of a mesh part, with a bounding volume hierarchy for finding the first one hit by a ray or a parabola.
+//   The hierarchy is built with the surface area heuristic the first time the set is picked after it changes, and is
+//   kept in two flat arrays: the nodes, depth first with the first child of each inner node right after it, and the
+//   triangles of the leaves, in packets of four laid out by component so that a ray is tested against the four at
+//   once.
 class TriangleSet {
-
-    class TriangleTreeCell {
-    public:
-        TriangleTreeCell(std::vector<Triangle>& allTriangles) : _allTriangles(allTriangles) {}
-        TriangleTreeCell(std::vector<Triangle>& allTriangles, const AABox& bounds, int depth);
-
-        void insert(size_t triangleIndex);
-        void reset(const AABox& bounds, int depth = 0);
-        void clear();
-
-        bool findRayIntersection(const glm::vec3& origin, const glm::vec3& direction, const glm::vec3& invDirection,
-            float& distance, BoxFace& face, Triangle& triangle, bool precision, int& trianglesTouched,
-            bool allowBackface = false);
-        bool findParabolaIntersection(const glm::vec3& origin, const glm::vec3& velocity, const glm::vec3& acceleration,
-            float& parabolicDistance, BoxFace& face, Triangle& triangle, bool precision, int& trianglesTouched,
-            bool allowBackface = false);
-
-        const AABox& getBounds() const { return _bounds; }
-
-        void debugDump();
-
-    protected:
-        // checks our internal list of triangles
-        bool findRayIntersectionInternal(const glm::vec3& origin, const glm::vec3& direction,
-            float& distance, BoxFace& face, Triangle& triangle, bool precision, int& trianglesTouched,
-            bool allowBackface = false);
-        bool findParabolaIntersectionInternal(const glm::vec3& origin, const glm::vec3& velocity, const glm::vec3& acceleration,
-            float& parabolicDistance, BoxFace& face, Triangle& triangle, bool precision, int& trianglesTouched,
-            bool allowBackface = false);
-
-        std::pair<AABox, AABox> getTriangleTreeCellChildBounds();
-
-        std::vector<Triangle>& _allTriangles;
-        std::pair<std::shared_ptr<TriangleTreeCell>, std::shared_ptr<TriangleTreeCell>> _children;
-        int _depth { 0 };
-        int _population { 0 };
-        AABox _bounds;
-        std::vector<size_t> _triangleIndices;
-
-        friend class TriangleSet;
-    };
-
-    using SortedTriangleCell = std::pair<float, std::shared_ptr<TriangleTreeCell>>;
-
 public:
-    TriangleSet() : _triangleTree(_triangles) {}
+    TriangleSet() {}
 
     void debugDump();
 
@@ -87,8 +47,35 @@ public:
     const AABox& getBounds() const { return _bounds; }
 
 protected:
+    static const int PACKET_SIZE = 4;
+    static const uint32_t INVALID_TRIANGLE = (uint32_t)-1;
+
+    struct Node {
+        glm::vec3 minimum;
+        uint32_t offset; // the first packet of a leaf, or the second child of an inner node
+        glm::vec3 maximum;
+        uint32_t numTriangles; // 0 for an inner node
+    };
+
+    // up to PACKET_SIZE triangles of a leaf, as their first vertex and the two edges from it
+    struct Packet {
+        float v0[3][PACKET_SIZE];
+        float firstSide[3][PACKET_SIZE];
+        float secondSide[3][PACKET_SIZE];
+        uint32_t triangles[PACKET_SIZE]; // INVALID_TRIANGLE past the end of the leaf
+    };
+
+    struct BuildTriangle;
+    uint32_t buildNode(std::vector<BuildTriangle>& buildTriangles, size_t begin, size_t end, int depth);
+    void makeLeaf(Node& node, const std::vector<BuildTriangle>& buildTriangles, size_t begin, size_t end);
+
+    // \return the index of the closest triangle of the packet hit by the ray, or INVALID_TRIANGLE
+    uint32_t findRayPacketIntersection(const Packet& packet, const glm::vec3& origin, const glm::vec3& direction,
+        float& distance, bool allowBackface) const;
+
     bool _isBalanced { false };
     std::vector<Triangle> _triangles;
-    TriangleTreeCell _triangleTree;
+    std::vector<Node> _nodes;
+    std::vector<Packet> _packets;
     AABox _bounds;
 };
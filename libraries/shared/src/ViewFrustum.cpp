@@ -11,6 +11,7 @@
 
 #include "ViewFrustum.h"
 
+#include <assert.h>
 #include <algorithm>
 #include <array>
 
@@ -231,6 +232,89 @@ bool ViewFrustum::boxInsideFrustum(const AABox& box) const {
     return true;
 }
 
+void ViewFrustum::Boxes::resize(size_t size) {
+    for (int i = 0; i < 3; ++i) {
+        _minimum[i].resize(size);
+        _maximum[i].resize(size);
+    }
+}
+
+void ViewFrustum::Boxes::set(size_t index, const AABox& box) {
+    glm::vec3 minimum = box.getCorner();
+    glm::vec3 maximum = box.getCorner() + box.getScale();
+    for (int i = 0; i < 3; ++i) {
+        _minimum[i][index] = minimum[i];
+        _maximum[i][index] = maximum[i];
+    }
+}
+
+void ViewFrustum::boxesIntersectFrustum(const Boxes& boxes, size_t begin, size_t end, uint8_t* results) const {
+    testBoxVertices(boxes, begin, end, false, results);
+}
+
+void ViewFrustum::boxesInsideFrustum(const Boxes& boxes, size_t begin, size_t end, uint8_t* results) const {
+    testBoxVertices(boxes, begin, end, true, results);
+}
+
+// results[i] &= whether the vertex (x[i], y[i], z[i]) is on the inside of the plane
+static void testVerticesAgainstPlane_ref(const float* x, const float* y, const float* z, float normalX, float normalY, float normalZ,
+                                         float d, uint8_t* results, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        results[i] &= (uint8_t)(d + (normalX * x[i] + normalY * y[i] + normalZ * z[i]) >= 0.0f);
+    }
+}
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+//
+// Runtime CPU dispatch
+//
+#include "CPUDetect.h"
+
+size_t testVerticesAgainstPlane_AVX2(const float* x, const float* y, const float* z, float normalX, float normalY, float normalZ,
+                                     float d, uint8_t* results, size_t count);
+size_t testVerticesAgainstPlane_AVX512(const float* x, const float* y, const float* z, float normalX, float normalY, float normalZ,
+                                       float d, uint8_t* results, size_t count);
+
+static size_t testVerticesAgainstPlane_none(const float* x, const float* y, const float* z, float normalX, float normalY,
+                                            float normalZ, float d, uint8_t* results, size_t count) {
+    return 0;
+}
+
+static void testVerticesAgainstPlane(const float* x, const float* y, const float* z, float normalX, float normalY, float normalZ,
+                                     float d, uint8_t* results, size_t count) {
+    // the wide versions only test whole blocks, and leave the rest to the portable loop
+#ifndef STACK_PROTECTOR
+    static auto f = cpuSupportsAVX512() ? testVerticesAgainstPlane_AVX512 :
+        (cpuSupportsAVX2() ? testVerticesAgainstPlane_AVX2 : testVerticesAgainstPlane_none);
+#else
+    static auto f = cpuSupportsAVX2() ? testVerticesAgainstPlane_AVX2 : testVerticesAgainstPlane_none;
+#endif
+    size_t i = (*f)(x, y, z, normalX, normalY, normalZ, d, results, count); // dispatch
+    testVerticesAgainstPlane_ref(x + i, y + i, z + i, normalX, normalY, normalZ, d, results + i, count - i);
+}
+
+#else   // portable reference code
+static auto& testVerticesAgainstPlane = testVerticesAgainstPlane_ref;
+#endif
+
+void ViewFrustum::testBoxVertices(const Boxes& boxes, size_t begin, size_t end, bool nearest, uint8_t* results) const {
+    assert(begin <= end && end <= boxes.size());
+    size_t count = end - begin;
+    std::fill(results, results + count, (uint8_t)1);
+
+    for (int i = 0; i < NUM_FRUSTUM_PLANES; i++) {
+        // the farthest (or nearest) vertex along a plane normal is the same corner of every box, so testing a plane
+        // against all of the boxes is a single multiply-add over the arrays
+        const glm::vec3& normal = _planes[i].getNormal();
+        float d = _planes[i].getDCoefficient();
+        glm::bvec3 useMaximum = nearest ? glm::lessThan(normal, glm::vec3(0.0f)) : glm::greaterThan(normal, glm::vec3(0.0f));
+        const float* x = (useMaximum.x ? boxes._maximum[0] : boxes._minimum[0]).data() + begin;
+        const float* y = (useMaximum.y ? boxes._maximum[1] : boxes._minimum[1]).data() + begin;
+        const float* z = (useMaximum.z ? boxes._maximum[2] : boxes._minimum[2]).data() + begin;
+        testVerticesAgainstPlane(x, y, z, normal.x, normal.y, normal.z, d, results, count);
+    }
+}
+
 bool ViewFrustum::sphereIntersectsKeyhole(const glm::vec3& center, float radius) const {
     // check positive touch against central sphere
     if (glm::length(center - _position) <= (radius + _centerSphereRadius)) {
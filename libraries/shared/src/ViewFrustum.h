@@ -14,6 +14,8 @@
 #ifndef hifi_ViewFrustum_h
 #define hifi_ViewFrustum_h
 
+#include <vector>
+
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
 
@@ -107,6 +109,24 @@ public:
     bool boxIntersectsFrustum(const AABox& box) const;
     bool boxInsideFrustum(const AABox& box) const;
 
+    // Boxes laid out as a structure of arrays of their minimum and maximum corners, to be tested many at a time
+    class Boxes {
+    public:
+        void resize(size_t size);
+        size_t size() const { return _minimum[0].size(); }
+        void set(size_t index, const AABox& box);
+
+    private:
+        friend class ViewFrustum;
+        std::vector<float> _minimum[3];
+        std::vector<float> _maximum[3];
+    };
+
+    // batched versions of boxIntersectsFrustum and boxInsideFrustum, with the same results, which set results[i]
+    // to 1 or 0 for box begin + i of [begin, end)
+    void boxesIntersectFrustum(const Boxes& boxes, size_t begin, size_t end, uint8_t* results) const;
+    void boxesInsideFrustum(const Boxes& boxes, size_t begin, size_t end, uint8_t* results) const;
+
     bool sphereIntersectsKeyhole(const glm::vec3& center, float radius) const;
     bool cubeIntersectsKeyhole(const AACube& cube) const;
     bool boxIntersectsKeyhole(const AABox& box) const;
@@ -149,6 +169,9 @@ public:
     void invalidate(); // causes all reasonable intersection tests to fail
 
 private:
+    // sets results[i] to whether the farthest, or nearest, vertex of each box is on the inside of every plane
+    void testBoxVertices(const Boxes& boxes, size_t begin, size_t end, bool nearest, uint8_t* results) const;
+
     glm::mat4 _view;
     glm::mat4 _projection;
 
@@ -0,0 +1,65 @@
+//
+//  ViewFrustum_avx2.cpp
+//  libraries/shared/src
+//
+//  Created on 2026-10-16.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifdef __AVX2__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <immintrin.h>
+
+// the distances must round exactly as Plane::distance() does, so that the batched tests match the single box tests
+#if defined(__clang__)
+#pragma clang fp contract(off)
+#elif defined(__GNUC__)
+#pragma GCC optimize("fp-contract=off")
+#endif
+
+// results[i] &= whether the vertex (x[i], y[i], z[i]) is on the inside of the plane, for the whole blocks of count,
+// returning the number of vertices tested
+size_t testVerticesAgainstPlane_AVX2(const float* x, const float* y, const float* z, float normalX, float normalY, float normalZ,
+                                     float d, uint8_t* results, size_t count) {
+
+    __m256 nx = _mm256_set1_ps(normalX);
+    __m256 ny = _mm256_set1_ps(normalY);
+    __m256 nz = _mm256_set1_ps(normalZ);
+    __m256 dc = _mm256_set1_ps(d);
+    __m256 zero = _mm256_setzero_ps();
+    __m256i one = _mm256_set1_epi8(1);
+    __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+
+    // summed in the same order as Plane::distance()
+    auto inside = [&](size_t i) {
+        __m256 t = _mm256_add_ps(_mm256_mul_ps(nx, _mm256_loadu_ps(&x[i])), _mm256_mul_ps(ny, _mm256_loadu_ps(&y[i])));
+        t = _mm256_add_ps(t, _mm256_mul_ps(nz, _mm256_loadu_ps(&z[i])));
+        return _mm256_castps_si256(_mm256_cmp_ps(_mm256_add_ps(dc, t), zero, _CMP_GE_OQ));
+    };
+
+    size_t i = 0;
+    for (; i + 32 <= count; i += 32) {  // blocks of 32
+
+        __m256i m0 = inside(i + 0);
+        __m256i m1 = inside(i + 8);
+        __m256i m2 = inside(i + 16);
+        __m256i m3 = inside(i + 24);
+
+        // narrow the 32-bit masks to bytes, which packs them per 128-bit lane, then put the 4-byte groups back in order
+        __m256i m = _mm256_packs_epi16(_mm256_packs_epi32(m0, m1), _mm256_packs_epi32(m2, m3));
+        m = _mm256_permutevar8x32_epi32(m, order);
+
+        __m256i r = _mm256_loadu_si256((__m256i*)&results[i]);
+        _mm256_storeu_si256((__m256i*)&results[i], _mm256_and_si256(r, _mm256_and_si256(m, one)));
+    }
+
+    _mm256_zeroupper();
+    return i;
+}
+
+#endif
@@ -0,0 +1,55 @@
+//
+//  ViewFrustum_avx512.cpp
+//  libraries/shared/src
+//
+//  Created on 2026-10-16.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifdef __AVX512F__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <immintrin.h>
+
+// the distances must round exactly as Plane::distance() does, so that the batched tests match the single box tests
+#if defined(__clang__)
+#pragma clang fp contract(off)
+#elif defined(__GNUC__)
+#pragma GCC optimize("fp-contract=off")
+#endif
+
+// results[i] &= whether the vertex (x[i], y[i], z[i]) is on the inside of the plane, for the whole blocks of count,
+// returning the number of vertices tested
+size_t testVerticesAgainstPlane_AVX512(const float* x, const float* y, const float* z, float normalX, float normalY, float normalZ,
+                                       float d, uint8_t* results, size_t count) {
+
+    __m512 nx = _mm512_set1_ps(normalX);
+    __m512 ny = _mm512_set1_ps(normalY);
+    __m512 nz = _mm512_set1_ps(normalZ);
+    __m512 dc = _mm512_set1_ps(d);
+    __m512 zero = _mm512_setzero_ps();
+
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {  // blocks of 16
+
+        // summed in the same order as Plane::distance()
+        __m512 t = _mm512_add_ps(_mm512_mul_ps(nx, _mm512_loadu_ps(&x[i])), _mm512_mul_ps(ny, _mm512_loadu_ps(&y[i])));
+        t = _mm512_add_ps(t, _mm512_mul_ps(nz, _mm512_loadu_ps(&z[i])));
+        __mmask16 inside = _mm512_cmp_ps_mask(_mm512_add_ps(dc, t), zero, _CMP_GE_OQ);
+
+        // 1 or 0 per vertex, narrowed to bytes
+        __m128i m = _mm512_cvtepi32_epi8(_mm512_maskz_set1_epi32(inside, 1));
+
+        __m128i r = _mm_loadu_si128((__m128i*)&results[i]);
+        _mm_storeu_si128((__m128i*)&results[i], _mm_and_si128(r, m));
+    }
+
+    _mm256_zeroupper();
+    return i;
+}
+
+#endif
@@ -0,0 +1,104 @@
+//
+//  LockWaitHistogram.cpp
+//  libraries/shared/src/shared
+//
+//  Created on 2026-10-16.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "LockWaitHistogram.h"
+
+#include <algorithm>
+#include <cmath>
+
+int LockWaitHistogram::getBucket(uint64_t waitUsecs) {
+    int bucket = 0;
+    while (waitUsecs > 0 && bucket < NUM_BUCKETS - 1) {
+        waitUsecs >>= 1;
+        ++bucket;
+    }
+    return bucket;
+}
+
+uint64_t LockWaitHistogram::getBucketLimit(int bucket) {
+    return (uint64_t)1 << bucket;
+}
+
+void LockWaitHistogram::record(uint64_t waitUsecs) {
+    _counts[getBucket(waitUsecs)].fetch_add(1, std::memory_order_relaxed);
+    _totalWaitUsecs.fetch_add(waitUsecs, std::memory_order_relaxed);
+}
+
+void LockWaitHistogram::reset() {
+    for (auto& count : _counts) {
+        count.store(0, std::memory_order_relaxed);
+    }
+    _totalWaitUsecs.store(0, std::memory_order_relaxed);
+}
+
+LockWaitHistogram::Counts LockWaitHistogram::getCounts() const {
+    Counts counts;
+    for (int i = 0; i < NUM_BUCKETS; ++i) {
+        counts[i] = _counts[i].load(std::memory_order_relaxed);
+    }
+    return counts;
+}
+
+uint64_t LockWaitHistogram::getTotalCount() const {
+    uint64_t total = 0;
+    for (const auto& count : _counts) {
+        total += count.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+uint64_t LockWaitHistogram::getPercentileLimit(const Counts& counts, double fraction) {
+    uint64_t total = 0;
+    for (auto count : counts) {
+        total += count;
+    }
+    if (total == 0) {
+        return 0;
+    }
+
+    // allow for the fraction not being exact, so that e.g. 0.99 of 100 counts is 99 of them rather than 100
+    const double EPSILON = 1.0e-9;
+    uint64_t target = std::max((uint64_t)1, (uint64_t)std::ceil(fraction * (double)total - EPSILON));
+    uint64_t cumulative = 0;
+    for (int i = 0; i < NUM_BUCKETS; ++i) {
+        cumulative += counts[i];
+        if (cumulative >= target) {
+            return getBucketLimit(i);
+        }
+    }
+    return getBucketLimit(NUM_BUCKETS - 1);
+}
+
+QString LockWaitHistogram::toString() const {
+    Counts counts = getCounts();
+    uint64_t total = 0;
+    int maxBucket = 0;
+    for (int i = 0; i < NUM_BUCKETS; ++i) {
+        total += counts[i];
+        if (counts[i] > 0) {
+            maxBucket = i;
+        }
+    }
+    uint64_t average = total == 0 ? 0 : getTotalWaitUsecs() / total;
+
+    // the last bucket has no limit, so it's shown by where it starts
+    auto bucketString = [](uint64_t limit) {
+        return limit >= getBucketLimit(NUM_BUCKETS - 1) ?
+            QString(">= %1").arg(getBucketLimit(NUM_BUCKETS - 2)) : QString("< %1").arg(limit);
+    };
+    return QString("n: %1, avg: %2 usecs, 50%: %3, 90%: %4, 99%: %5, max: %6")
+        .arg(total)
+        .arg(average)
+        .arg(bucketString(getPercentileLimit(counts, 0.5)))
+        .arg(bucketString(getPercentileLimit(counts, 0.9)))
+        .arg(bucketString(getPercentileLimit(counts, 0.99)))
+        .arg(bucketString(total == 0 ? 0 : getBucketLimit(maxBucket)));
+}
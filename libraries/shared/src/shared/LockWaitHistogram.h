@@ -0,0 +1,60 @@
+//
+//  LockWaitHistogram.h
+//  libraries/shared/src/shared
+//
+//  Created on 2026-10-16.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_LockWaitHistogram_h
+#define hifi_LockWaitHistogram_h
+
+#include <array>
+#include <atomic>
+#include <stdint.h>
+
+#include <QtCore/QString>
+
+// A histogram of how long acquiring a lock waited, in power-of-two buckets of microseconds.
+//   Bucket 0 counts the acquisitions that waited less than a microsecond, which includes every uncontended one, and
+//   bucket i > 0 those that waited from 2^(i - 1) up to 2^i usecs. The last bucket also counts every longer wait.
+//   LockWaitHistogram is thread-safe.
+class LockWaitHistogram {
+public:
+    static const int NUM_BUCKETS = 22;
+    using Counts = std::array<uint64_t, NUM_BUCKETS>;
+
+    static int getBucket(uint64_t waitUsecs);
+    // the least wait in usecs that's past a bucket
+    static uint64_t getBucketLimit(int bucket);
+
+    void record(uint64_t waitUsecs);
+    void reset();
+
+    Counts getCounts() const;
+    uint64_t getTotalCount() const;
+    uint64_t getTotalWaitUsecs() const { return _totalWaitUsecs.load(std::memory_order_relaxed); }
+
+    // the limit of the bucket within which a fraction of the waits counted fall, or 0 if there are none
+    static uint64_t getPercentileLimit(const Counts& counts, double fraction);
+
+    // e.g. "n: 1200, avg: 3 usecs, 50%: < 1, 90%: < 8, 99%: < 256, max: < 1024"
+    QString toString() const;
+
+private:
+    std::array<std::atomic<uint64_t>, NUM_BUCKETS> _counts {};
+    std::atomic<uint64_t> _totalWaitUsecs { 0 };
+};
+
+// The waits to read and to write through a ReadWriteLockable.
+struct LockWaitHistograms {
+    LockWaitHistogram read;
+    LockWaitHistogram write;
+};
+
+#endif // hifi_LockWaitHistogram_h
@@ -10,10 +10,12 @@
 #ifndef hifi_ReadWriteLockable_h
 #define hifi_ReadWriteLockable_h
 
+#include <chrono>
 #include <utility>
 
 #include <QtCore/QReadWriteLock>
 
+#include "LockWaitHistogram.h"
 #include "QTryReadLocker.h"
 #include "QTryWriteLocker.h"
 
@@ -53,14 +55,61 @@ public:
 
     QReadWriteLock& getLock() const { return _lock; }
 
+protected:
+    // records how long the blocking read and write locks wait, into histograms that must outlive this
+    void setLockWaitHistograms(LockWaitHistograms* histograms) { _lockWaitHistograms = histograms; }
+
 private:
+    class Unlocker {
+    public:
+        Unlocker(QReadWriteLock& lock) : _lock(lock) { }
+        ~Unlocker() { _lock.unlock(); }
+    private:
+        QReadWriteLock& _lock;
+    };
+
+    void lockForRead() const;
+    void lockForWrite() const;
+    static uint64_t usecsSince(std::chrono::steady_clock::time_point start);
+
     mutable QReadWriteLock _lock { QReadWriteLock::Recursive };
+    LockWaitHistograms* _lockWaitHistograms { nullptr };
 };
 
+inline uint64_t ReadWriteLockable::usecsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+// only the acquisitions that can't lock right away are timed
+inline void ReadWriteLockable::lockForRead() const {
+    if (!_lockWaitHistograms) {
+        _lock.lockForRead();
+    } else if (_lock.tryLockForRead()) {
+        _lockWaitHistograms->read.record(0);
+    } else {
+        auto start = std::chrono::steady_clock::now();
+        _lock.lockForRead();
+        _lockWaitHistograms->read.record(usecsSince(start));
+    }
+}
+
+inline void ReadWriteLockable::lockForWrite() const {
+    if (!_lockWaitHistograms) {
+        _lock.lockForWrite();
+    } else if (_lock.tryLockForWrite()) {
+        _lockWaitHistograms->write.record(0);
+    } else {
+        auto start = std::chrono::steady_clock::now();
+        _lock.lockForWrite();
+        _lockWaitHistograms->write.record(usecsSince(start));
+    }
+}
+
 // ReadWriteLockable
 template <typename F>
 inline void ReadWriteLockable::withWriteLock(F&& f) const {
-    QWriteLocker locker(&_lock);
+    lockForWrite();
+    Unlocker unlocker(_lock);
     f();
 }
 
@@ -105,7 +154,8 @@ inline bool ReadWriteLockable::withTryWriteLock(F&& f, int timeout) const {
 
 template <typename F>
 inline void ReadWriteLockable::withReadLock(F&& f) const {
-    QReadLocker locker(&_lock);
+    lockForRead();
+    Unlocker unlocker(_lock);
     f();
 }
 
@@ -40,6 +40,8 @@ public:
         encodedBuffer = decodedBuffer;
     }
 
+    virtual bool isStateless() const override { return true; }
+
     virtual void decode(const QByteArray& encodedBuffer, QByteArray& decodedBuffer) override {
         decodedBuffer = encodedBuffer;
     }
@@ -78,6 +80,8 @@ public:
         encodedBuffer = qCompress(decodedBuffer);
     }
 
+    virtual bool isStateless() const override { return true; }
+
     virtual void decode(const QByteArray& encodedBuffer, QByteArray& decodedBuffer) override {
         decodedBuffer = qUncompress(encodedBuffer);
     }
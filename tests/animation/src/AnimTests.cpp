@@ -15,6 +15,9 @@
 #include <AnimVariant.h>
 #include <AnimExpression.h>
 #include <AnimUtil.h>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
 #include <ExternalResource.h>
 #include <NodeList.h>
 #include <AddressManager.h>
@@ -271,6 +274,45 @@ void AnimTests::testVariant() {
     QVERIFY(q.z == 4.0f);
 }
 
+void AnimTests::testVariantKeys() {
+    AnimVariantKey foo("testVariantKeysFoo");
+    AnimVariantKey bar("testVariantKeysBar");
+    QVERIFY(!foo.isEmpty());
+    QVERIFY(foo.getSlot() == AnimVariantKey::slotOf("testVariantKeysFoo"));
+    QVERIFY(foo.getSlot() != bar.getSlot());
+    QVERIFY(AnimVariantKey::nameOf(foo.getSlot()) == "testVariantKeysFoo");
+    QVERIFY(AnimVariantKey("").isEmpty());
+
+    // keys and names find the same values
+    AnimVariantMap vars;
+    vars.set(foo, 3.0f);
+    QVERIFY(vars.hasKey("testVariantKeysFoo"));
+    QVERIFY(vars.lookup("testVariantKeysFoo", 0.0f) == 3.0f);
+    vars.set("testVariantKeysFoo", 4);
+    QVERIFY(vars.lookup(foo, 0) == 4);
+    QVERIFY(vars.lookup(bar, 5) == 5);
+    QVERIFY(vars.size() == 1);
+
+    // empty names are never set
+    vars.set("", true);
+    QVERIFY(!vars.hasKey(""));
+    QVERIFY(vars.size() == 1);
+
+    AnimVariantMap other;
+    other.set(bar, glm::vec3(1.0f, 2.0f, 3.0f));
+    vars.copyVariantsFrom(other);
+    QVERIFY(vars.size() == 2);
+    QVERIFY(vars.lookupRaw("testVariantKeysBar", Vectors::ZERO) == glm::vec3(1.0f, 2.0f, 3.0f));
+
+    auto debugMap = vars.toDebugMap();
+    QVERIFY(debugMap.size() == 2);
+    QVERIFY(debugMap["testVariantKeysFoo"] == "4");
+
+    vars.unset(foo);
+    QVERIFY(!vars.hasKey(foo));
+    QVERIFY(vars.size() == 1);
+}
+
 void AnimTests::testAccumulateTime() {
 
     float startFrame = 0.0f;
@@ -567,7 +609,7 @@ void AnimTests::testExpressionParser() {
     QVERIFY(e._opCodes.size() == 1);
     if (e._opCodes.size() == 1) {
         QVERIFY(e._opCodes[0].type == AnimExpression::OpCode::Identifier);
-        QVERIFY(e._opCodes[0].strVal == "twenty");
+        QVERIFY(e._opCodes[0].var.getName() == "twenty");
     }
 
     e = AnimExpression("true || false");
@@ -708,4 +750,76 @@ void AnimTests::testExpressionEvaluator() {
     TEST_BOOL_EXPR(!(true && f) && true);
 }
 
+// the name of every var read by the nodes of the default avatar anim graph, once per read
+static void collectGraphVarNames(const QJsonValue& value, QStringList& names) {
+    if (value.isObject()) {
+        QJsonObject object = value.toObject();
+        for (auto iter = object.begin(); iter != object.end(); ++iter) {
+            if (iter.value().isString() && (iter.key().endsWith("Var") || iter.key() == "var")) {
+                names.push_back(iter.value().toString());
+            } else {
+                collectGraphVarNames(iter.value(), names);
+            }
+        }
+    } else if (value.isArray()) {
+        for (const auto& element : value.toArray()) {
+            collectGraphVarNames(element, names);
+        }
+    }
+}
+
+void AnimTests::benchmarkDefaultGraphVars_data() {
+    QTest::addColumn<int>("lookupType");
+    QTest::newRow("slots") << (int)VarLookup::Slots;
+    QTest::newRow("names") << (int)VarLookup::Names;
+    QTest::newRow("std::map") << (int)VarLookup::StdMap;
+}
+
+void AnimTests::benchmarkDefaultGraphVars() {
+    QFETCH(int, lookupType);
+    const int NUM_RIGS = 200;
+
+    QFile file(QFINDTESTDATA("../../../interface/resources/avatar/avatar-animation.json"));
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QStringList names;
+    collectGraphVarNames(QJsonDocument::fromJson(file.readAll()).object(), names);
+    QVERIFY(!names.isEmpty());
+
+    // the keys the graph resolves when it is loaded
+    std::vector<AnimVariantKey> keys(names.begin(), names.end());
+
+    // every rig has set every var the graph reads, as a stand in for the vars set by Rig and scripts
+    std::vector<AnimVariantMap> rigVars(NUM_RIGS);
+    std::vector<std::map<QString, AnimVariant>> rigMaps(NUM_RIGS);
+    for (int i = 0; i < NUM_RIGS; ++i) {
+        for (int j = 0; j < names.size(); ++j) {
+            rigVars[i].set(names[j], (float)j);
+            rigMaps[i][names[j]] = AnimVariant((float)j);
+        }
+    }
 
+    float sum = 0.0f;
+    QBENCHMARK {
+        for (int i = 0; i < NUM_RIGS; ++i) {
+            switch ((VarLookup)lookupType) {
+            case VarLookup::Slots:
+                for (const auto& key : keys) {
+                    sum += rigVars[i].lookup(key, 0.0f);
+                }
+                break;
+            case VarLookup::Names:
+                for (const auto& name : names) {
+                    sum += rigVars[i].lookup(name, 0.0f);
+                }
+                break;
+            case VarLookup::StdMap:
+                for (const auto& name : names) {
+                    auto iter = rigMaps[i].find(name);
+                    sum += iter != rigMaps[i].end() ? iter->second.getFloat() : 0.0f;
+                }
+                break;
+            }
+        }
+    }
+    QVERIFY(sum > 0.0f);
+}
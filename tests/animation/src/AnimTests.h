@@ -25,11 +25,17 @@ private slots:
     void testClipEvaulateWithVars();
     void testLoader();
     void testVariant();
+    void testVariantKeys();
     void testAccumulateTime();
     void testAnimPose();
     void testExpressionTokenizer();
     void testExpressionParser();
     void testExpressionEvaluator();
+    void benchmarkDefaultGraphVars_data();
+    void benchmarkDefaultGraphVars();
+
+private:
+    enum class VarLookup { Slots, Names, StdMap };
 };
 
 #endif // hifi_AnimTests_h
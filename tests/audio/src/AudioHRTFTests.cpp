@@ -0,0 +1,148 @@
+//
+//  AudioHRTFTests.cpp
+//  tests/audio/src
+//
+//  Created on 2026-10-16.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioHRTFTests.h"
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <AudioHRTF.h>
+#include <NumericalConstants.h>
+
+QTEST_MAIN(AudioHRTFTests)
+
+namespace {
+
+const int HRTF_INDEX = 1;
+
+// A listener's sources - each has its own HRTF state, input block and parameters
+struct SourceSet {
+    SourceSet(int numSources, unsigned int seed) : random(seed), inputs(numSources * HRTF_BLOCK) {
+        for (int i = 0; i < numSources; i++) {
+            hrtfs.emplace_back(new AudioHRTF());
+            sources.push_back({ hrtfs.back().get(), &inputs[i * HRTF_BLOCK], 0.0f, 1.0f, 1.0f, LPF_DISTANCE_REF });
+            move(i);
+        }
+    }
+
+    void move(int i) {
+        std::uniform_real_distribution<float> azimuth(0.0f, TWO_PI);
+        std::uniform_real_distribution<float> distance(0.1f, 20.0f);
+        sources[i].azimuth = azimuth(random);
+        sources[i].distance = distance(random);
+        sources[i].gain = 1.0f / sources[i].distance;
+    }
+
+    // new input for every source, and new parameters for about one in movingRatio of them
+    void nextFrame(int movingRatio) {
+        std::uniform_int_distribution<int> sample(-8192, 8192);
+        for (auto& value : inputs) {
+            value = (int16_t)sample(random);
+        }
+        for (int i = 0; i < (int)sources.size(); i++) {
+            if (movingRatio > 0 && random() % movingRatio == 0) {
+                move(i);
+            }
+        }
+    }
+
+    std::mt19937 random;
+    std::vector<int16_t> inputs;
+    std::vector<std::unique_ptr<AudioHRTF>> hrtfs;
+    std::vector<AudioHRTF::RenderSource> sources;
+};
+
+void addSourceCounts() {
+    QTest::addColumn<int>("numSources");
+    QTest::addColumn<int>("movingRatio");
+
+    for (int numSources : { 16, 64, 256 }) {
+        QTest::newRow(qPrintable(QString("%1 steady").arg(numSources))) << numSources << 0;
+        QTest::newRow(qPrintable(QString("%1 with 1 in 4 moving").arg(numSources))) << numSources << 4;
+    }
+}
+
+}
+
+void AudioHRTFTests::renderBatchMatchesRenderTest() {
+    const int NUM_SOURCES = 37;
+    const int NUM_FRAMES = 100;
+    const int MOVING_RATIO = 3;
+    const float MAX_ERROR = 1.0e-5f;
+
+    // same seed, so the same inputs and parameters each frame
+    SourceSet single(NUM_SOURCES, 7);
+    SourceSet batched(NUM_SOURCES, 7);
+
+    for (int frame = 0; frame < NUM_FRAMES; frame++) {
+        single.nextFrame(MOVING_RATIO);
+        batched.nextFrame(MOVING_RATIO);
+
+        if (frame % 10 == 5) {
+            for (int i = 0; i < NUM_SOURCES; i += 5) {
+                single.hrtfs[i]->reset();
+                batched.hrtfs[i]->reset();
+            }
+        }
+
+        float singleOutput[2 * HRTF_BLOCK] = {};
+        float batchedOutput[2 * HRTF_BLOCK] = {};
+
+        for (auto& source : single.sources) {
+            source.hrtf->render(source.input, singleOutput, HRTF_INDEX, source.azimuth, source.distance, source.gain,
+                                HRTF_BLOCK, source.lpfDistance);
+        }
+        AudioHRTF::renderBatch(batched.sources.data(), NUM_SOURCES, batchedOutput, HRTF_INDEX, HRTF_BLOCK);
+
+        // only the order in which the sources are accumulated differs
+        for (int i = 0; i < 2 * HRTF_BLOCK; i++) {
+            QVERIFY(fabsf(singleOutput[i] - batchedOutput[i]) < MAX_ERROR);
+        }
+    }
+}
+
+void AudioHRTFTests::renderBenchmark_data() {
+    addSourceCounts();
+}
+
+void AudioHRTFTests::renderBenchmark() {
+    QFETCH(int, numSources);
+    QFETCH(int, movingRatio);
+
+    SourceSet set(numSources, 11);
+    float output[2 * HRTF_BLOCK] = {};
+
+    QBENCHMARK {
+        set.nextFrame(movingRatio);
+        for (auto& source : set.sources) {
+            source.hrtf->render(source.input, output, HRTF_INDEX, source.azimuth, source.distance, source.gain,
+                                HRTF_BLOCK, source.lpfDistance);
+        }
+    }
+}
+
+void AudioHRTFTests::renderBatchBenchmark_data() {
+    addSourceCounts();
+}
+
+void AudioHRTFTests::renderBatchBenchmark() {
+    QFETCH(int, numSources);
+    QFETCH(int, movingRatio);
+
+    SourceSet set(numSources, 11);
+    float output[2 * HRTF_BLOCK] = {};
+
+    QBENCHMARK {
+        set.nextFrame(movingRatio);
+        AudioHRTF::renderBatch(set.sources.data(), numSources, output, HRTF_INDEX, HRTF_BLOCK);
+    }
+}
@@ -0,0 +1,34 @@
+//
+//  AudioHRTFTests.h
+//  tests/audio/src
+//
+//  Created on 2026-10-16.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioHRTFTests_h
+#define hifi_AudioHRTFTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class AudioHRTFTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that a batched render matches rendering each source on its own, with steady, moving and reset sources
+    void renderBatchMatchesRenderTest();
+
+    // Benchmark one listener's mix of 16, 64 and 256 sources rendered one at a time
+    void renderBenchmark_data();
+    void renderBenchmark();
+
+    // Benchmark the same mixes with a single batched render
+    void renderBatchBenchmark_data();
+    void renderBatchBenchmark();
+};
+
+#endif // hifi_AudioHRTFTests_h
@@ -0,0 +1,175 @@
+//
+//  AvatarEncodingCacheTests.cpp
+//  tests/avatars/src
+//
+//  Created on 2026-10-16.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AvatarEncodingCacheTests.h"
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <AvatarEncodingCache.h>
+
+QTEST_MAIN(AvatarEncodingCacheTests)
+
+namespace {
+
+const int NUM_JOINTS = 60;
+const int BULK_PACKET_CAPACITY = 1200;
+
+// Synthetic avatars standing on a grid, each encoded for every other avatar's listener the way the avatar mixer does
+struct SyntheticCrowd {
+    SyntheticCrowd(int numAvatars, unsigned int seed) : random(seed), lastSentTimes(numAvatars * numAvatars, 0),
+        lastSentJoints(numAvatars * numAvatars) {
+        const float SPACING = 4.0f;
+        int side = (int)ceilf(sqrtf((float)numAvatars));
+        for (int i = 0; i < numAvatars; ++i) {
+            avatars.emplace_back(new AvatarData());
+            avatars.back()->setSessionUUID(QUuid::createUuid());
+            avatars.back()->setWorldPosition(glm::vec3((i % side) * SPACING, 0.0f, (i / side) * SPACING));
+            caches.emplace_back(new AvatarEncodingCache());
+        }
+    }
+
+    // moves some of the joints of each avatar, as a new frame of avatar data would
+    void nextFrame() {
+        std::uniform_real_distribution<float> angle(-0.2f, 0.2f);
+        std::uniform_int_distribution<int> joint(0, NUM_JOINTS - 1);
+        for (auto& avatar : avatars) {
+            for (int i = 0; i < NUM_JOINTS / 4; ++i) {
+                glm::quat rotation = glm::quat(glm::vec3(angle(random), angle(random), angle(random)));
+                avatar->setJointData(joint(random), rotation, glm::vec3(0.0f, 0.1f, 0.0f));
+            }
+        }
+        frame = p_high_resolution_clock::now();
+    }
+
+    AvatarData::AvatarDataDetail pickDetail() {
+        std::uniform_real_distribution<float> distribution;
+        return distribution(random) < AVATAR_SEND_FULL_UPDATE_RATIO ? AvatarData::SendAllData : AvatarData::CullSmallData;
+    }
+
+    std::mt19937 random;
+    std::vector<std::unique_ptr<AvatarData>> avatars;
+    std::vector<std::unique_ptr<AvatarEncodingCache>> caches;
+    AvatarEncodingCache::HRCTime frame;
+
+    // per listener and source, as kept by the listener's AvatarMixerClientData
+    std::vector<quint64> lastSentTimes;
+    std::vector<QVector<JointData>> lastSentJoints;
+};
+
+}
+
+void AvatarEncodingCacheTests::sharedEncodingMatchesTest() {
+    const int NUM_AVATARS = 12;
+    const int NUM_FRAMES = 10;
+
+    SyntheticCrowd crowd(NUM_AVATARS, 3);
+    int numShared = 0;
+
+    for (int frame = 0; frame < NUM_FRAMES; ++frame) {
+        crowd.nextFrame();
+        quint64 now = usecTimestampNow();
+
+        for (int listener = 0; listener < NUM_AVATARS; ++listener) {
+            glm::vec3 listenerPosition = crowd.avatars[listener]->getWorldPosition();
+
+            for (int source = 0; source < NUM_AVATARS; ++source) {
+                if (source == listener) {
+                    continue;
+                }
+
+                int pair = listener * NUM_AVATARS + source;
+                auto detail = (frame % 3 == 0) ? AvatarData::MinimumData : crowd.pickDetail();
+                auto& avatar = *crowd.avatars[source];
+
+                QVector<JointData> expectedJoints = crowd.lastSentJoints[pair];
+                AvatarDataPacket::SendStatus expectedStatus;
+                expectedStatus.sendUUID = true;
+                QByteArray expected = avatar.toByteArray(detail, crowd.lastSentTimes[pair], expectedJoints, expectedStatus,
+                    false, true, listenerPosition, &expectedJoints, BULK_PACKET_CAPACITY);
+
+                AvatarDataPacket::SendStatus sendStatus;
+                sendStatus.sendUUID = true;
+                bool isShared = false;
+                QByteArray encoding = crowd.caches[source]->encode(avatar, crowd.frame, detail, crowd.lastSentTimes[pair],
+                    listenerPosition, crowd.lastSentJoints[pair], sendStatus, BULK_PACKET_CAPACITY, isShared);
+
+                QCOMPARE(encoding, expected);
+                QCOMPARE(sendStatus.itemFlags, expectedStatus.itemFlags);
+                QCOMPARE(crowd.lastSentJoints[pair].size(), expectedJoints.size());
+                for (int i = 0; i < expectedJoints.size(); ++i) {
+                    QVERIFY(crowd.lastSentJoints[pair][i].rotation == expectedJoints[i].rotation);
+                    QVERIFY(crowd.lastSentJoints[pair][i].translation == expectedJoints[i].translation);
+                    QCOMPARE(crowd.lastSentJoints[pair][i].rotationIsDefaultPose, expectedJoints[i].rotationIsDefaultPose);
+                    QCOMPARE(crowd.lastSentJoints[pair][i].translationIsDefaultPose,
+                             expectedJoints[i].translationIsDefaultPose);
+                }
+
+                crowd.lastSentTimes[pair] = now;
+                numShared += isShared ? 1 : 0;
+            }
+        }
+    }
+
+    // listeners at the same distance band with the same history get the same encodings
+    QVERIFY(numShared > 0);
+}
+
+void AvatarEncodingCacheTests::broadcastBenchmark_data() {
+    QTest::addColumn<int>("numAvatars");
+    QTest::addColumn<bool>("shared");
+
+    for (int numAvatars : { 16, 64, 128 }) {
+        QTest::newRow(qPrintable(QString("%1 per listener").arg(numAvatars))) << numAvatars << false;
+        QTest::newRow(qPrintable(QString("%1 shared").arg(numAvatars))) << numAvatars << true;
+    }
+}
+
+void AvatarEncodingCacheTests::broadcastBenchmark() {
+    QFETCH(int, numAvatars);
+    QFETCH(bool, shared);
+
+    SyntheticCrowd crowd(numAvatars, 5);
+
+    QBENCHMARK {
+        crowd.nextFrame();
+        quint64 now = usecTimestampNow();
+
+        for (int listener = 0; listener < numAvatars; ++listener) {
+            glm::vec3 listenerPosition = crowd.avatars[listener]->getWorldPosition();
+
+            for (int source = 0; source < numAvatars; ++source) {
+                if (source == listener) {
+                    continue;
+                }
+
+                int pair = listener * numAvatars + source;
+                auto detail = crowd.pickDetail();
+                auto& avatar = *crowd.avatars[source];
+
+                AvatarDataPacket::SendStatus sendStatus;
+                sendStatus.sendUUID = true;
+                QByteArray encoding;
+                if (shared) {
+                    bool isShared = false;
+                    encoding = crowd.caches[source]->encode(avatar, crowd.frame, detail, crowd.lastSentTimes[pair],
+                        listenerPosition, crowd.lastSentJoints[pair], sendStatus, BULK_PACKET_CAPACITY, isShared);
+                } else {
+                    encoding = avatar.toByteArray(detail, crowd.lastSentTimes[pair], crowd.lastSentJoints[pair], sendStatus,
+                        false, true, listenerPosition, &crowd.lastSentJoints[pair], BULK_PACKET_CAPACITY);
+                }
+
+                crowd.lastSentTimes[pair] = now;
+            }
+        }
+    }
+}
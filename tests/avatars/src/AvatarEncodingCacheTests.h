@@ -0,0 +1,30 @@
+//
+//  AvatarEncodingCacheTests.h
+//  tests/avatars/src
+//
+//  Created on 2026-10-16.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AvatarEncodingCacheTests_h
+#define hifi_AvatarEncodingCacheTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class AvatarEncodingCacheTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that shared encodings and sent joints match encoding for each listener, over frames of moving avatars
+    void sharedEncodingMatchesTest();
+
+    // Benchmark the avatar mixer's broadcast encoding of N moving avatars to each other, per listener and shared
+    void broadcastBenchmark_data();
+    void broadcastBenchmark();
+};
+
+#endif // hifi_AvatarEncodingCacheTests_h
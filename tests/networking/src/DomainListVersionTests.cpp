@@ -0,0 +1,84 @@
+//
+//  DomainListVersionTests.cpp
+//  tests/networking/src
+//
+//  Created on 2026-10-16.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "DomainListVersionTests.h"
+
+#include <DomainListVersion.h>
+
+QTEST_MAIN(DomainListVersionTests)
+
+void DomainListVersionTests::deltaTest() {
+    DomainListVersion version;
+    QCOMPARE(version.get(), (quint64)0);
+
+    // the whole list, as sent to a node that has just connected
+    QVERIFY(version.processPacket(1, 1, 10, 0, true));
+    QCOMPARE(version.get(), (quint64)10);
+
+    // what changed since
+    QVERIFY(version.processPacket(2, 1, 12, 10, false));
+    QCOMPARE(version.get(), (quint64)12);
+
+    // nothing changed since
+    QVERIFY(!version.processPacket(3, 1, 12, 12, false));
+    QCOMPARE(version.get(), (quint64)12);
+
+    // a whole list is sent again to a node whose version is too old to be sent what changed since
+    QVERIFY(version.processPacket(4, 1, 2000, 0, false));
+    QCOMPARE(version.get(), (quint64)2000);
+}
+
+void DomainListVersionTests::multiplePacketsTest() {
+    DomainListVersion version;
+    QVERIFY(!version.processPacket(1, 3, 10, 0, true));
+    QVERIFY(!version.processPacket(1, 3, 10, 0, true));
+    QCOMPARE(version.get(), (quint64)0);
+    QVERIFY(version.processPacket(1, 3, 10, 0, true));
+    QCOMPARE(version.get(), (quint64)10);
+
+    // a packet of the next list is lost, so the node still asks for what changed since the version before
+    QVERIFY(!version.processPacket(2, 2, 15, 10, false));
+    QVERIFY(!version.processPacket(3, 2, 16, 10, false));
+    QCOMPARE(version.get(), (quint64)10);
+    QVERIFY(version.processPacket(3, 2, 16, 10, false));
+    QCOMPARE(version.get(), (quint64)16);
+}
+
+void DomainListVersionTests::staleListTest() {
+    DomainListVersion version;
+    QVERIFY(version.processPacket(1, 1, 10, 0, true));
+
+    // a list of what changed since a version this node doesn't have, which would leave out what changed in between
+    QVERIFY(!version.processPacket(2, 1, 20, 15, false));
+    QCOMPARE(version.get(), (quint64)10);
+
+    // a list that arrives after a newer one was had
+    QVERIFY(version.processPacket(4, 1, 30, 10, false));
+    QVERIFY(!version.processPacket(3, 1, 20, 10, false));
+    QCOMPARE(version.get(), (quint64)30);
+}
+
+void DomainListVersionTests::newConnectionTest() {
+    DomainListVersion version;
+    QVERIFY(version.processPacket(1, 1, 50, 0, true));
+
+    // the node connected again, so is sent the whole list, whose version can be older than the one it had
+    QVERIFY(!version.processPacket(2, 2, 40, 0, true));
+    QCOMPARE(version.get(), (quint64)0);
+    QVERIFY(version.processPacket(2, 2, 40, 0, true));
+    QCOMPARE(version.get(), (quint64)40);
+
+    // a new domain-server counts its lists and versions from the start again
+    version.reset();
+    QCOMPARE(version.get(), (quint64)0);
+    QVERIFY(version.processPacket(1, 1, 3, 0, true));
+    QCOMPARE(version.get(), (quint64)3);
+}
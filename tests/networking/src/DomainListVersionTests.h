@@ -0,0 +1,35 @@
+//
+//  DomainListVersionTests.h
+//  tests/networking/src
+//
+//  Created on 2026-10-16.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_DomainListVersionTests_h
+#define hifi_DomainListVersionTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class DomainListVersionTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test a whole list, then lists of what changed that follow on from it
+    void deltaTest();
+
+    // Test that a list split over several packets only counts once all of them are had
+    void multiplePacketsTest();
+
+    // Test that lists which don't follow on from the version had are ignored
+    void staleListTest();
+
+    // Test that a new connection, or a reset, starts again from a whole list
+    void newConnectionTest();
+};
+
+#endif // hifi_DomainListVersionTests_h
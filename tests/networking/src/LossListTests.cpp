@@ -0,0 +1,236 @@
+//
+//  LossListTests.cpp
+//  tests/networking/src
+//
+//  Created on 2026-10-16.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "LossListTests.h"
+
+#include <list>
+#include <random>
+
+#include <udt/LossList.h>
+
+QTEST_MAIN(LossListTests)
+
+using namespace udt;
+
+namespace {
+
+// The std::list based loss list that udt::LossList replaced, kept as a reference for behaviour and speed
+class ListLossList {
+public:
+    void clear() { _length = 0; _lossList.clear(); }
+
+    void append(SequenceNumber seq) { append(seq, seq); }
+    void append(SequenceNumber start, SequenceNumber end) {
+        if (getLength() > 0 && _lossList.back().second + 1 == start) {
+            _lossList.back().second = end;
+        } else {
+            _lossList.push_back(std::make_pair(start, end));
+        }
+        _length += seqlen(start, end);
+    }
+
+    void insert(SequenceNumber start, SequenceNumber end) {
+        auto it = std::find_if_not(_lossList.begin(), _lossList.end(), [&start](std::pair<SequenceNumber, SequenceNumber> pair) {
+            return pair.second < start;
+        });
+
+        if (it == _lossList.end() || end < it->first) {
+            _length += seqlen(start, end);
+            _lossList.insert(it, std::make_pair(start, end));
+        } else {
+            if (start < it->first) {
+                _length += seqlen(start, it->first - 1);
+                it->first = start;
+            }
+            if (end > it->second) {
+                _length += seqlen(it->second + 1, end);
+                it->second = end;
+            }
+            auto it2 = it;
+            ++it2;
+            while (it2 != _lossList.end() && it->second >= it2->first - 1) {
+                if (it->second < it2->second) {
+                    _length += seqlen(it->second + 1, it2->second);
+                    it->second = it2->second;
+                }
+                _length -= seqlen(it2->first, it2->second);
+                it2 = _lossList.erase(it2);
+            }
+        }
+    }
+
+    bool remove(SequenceNumber seq) {
+        auto it = std::find_if(_lossList.begin(), _lossList.end(), [&seq](std::pair<SequenceNumber, SequenceNumber> pair) {
+            return pair.first <= seq && seq <= pair.second;
+        });
+        if (it == _lossList.end()) {
+            return false;
+        }
+        if (it->first == it->second) {
+            _lossList.erase(it);
+        } else if (seq == it->first) {
+            ++it->first;
+        } else if (seq == it->second) {
+            --it->second;
+        } else {
+            auto temp = it->second;
+            it->second = seq - 1;
+            _lossList.insert(++it, std::make_pair(seq + 1, temp));
+        }
+        _length -= 1;
+        return true;
+    }
+
+    void remove(SequenceNumber start, SequenceNumber end) {
+        auto it = std::find_if(_lossList.begin(), _lossList.end(), [&start, &end](std::pair<SequenceNumber, SequenceNumber> pair) {
+            return (pair.first <= start && start <= pair.second) || (start <= pair.first && pair.first <= end);
+        });
+        if (it == _lossList.end()) {
+            return;
+        }
+        while (it != _lossList.end() && end >= it->second) {
+            if (start <= it->first) {
+                _length -= seqlen(it->first, it->second);
+                it = _lossList.erase(it);
+            } else {
+                _length -= seqlen(start, it->second);
+                it->second = start - 1;
+                ++it;
+            }
+        }
+        if (it != _lossList.end() && it->first <= end) {
+            if (start <= it->first) {
+                _length -= seqlen(it->first, end);
+                it->first = end + 1;
+            } else {
+                _length -= seqlen(start, end);
+                auto temp = it->second;
+                it->second = start - 1;
+                _lossList.insert(++it, std::make_pair(end + 1, temp));
+            }
+        }
+    }
+
+    int getLength() const { return _length; }
+    bool isEmpty() const { return _length == 0; }
+    SequenceNumber getFirstSequenceNumber() const { return _lossList.front().first; }
+    SequenceNumber popFirstSequenceNumber() {
+        auto front = getFirstSequenceNumber();
+        remove(front);
+        return front;
+    }
+
+private:
+    std::list<std::pair<SequenceNumber, SequenceNumber>> _lossList;
+    int _length { 0 };
+};
+
+const int NUM_BURSTS = 64;
+const int MAX_BURST_LENGTH = 64;
+const int MAX_GAP_LENGTH = 16;
+
+// Drives a loss list the way Connection (receiver) and SendQueue (sender) do during heavy bursty loss:
+// bursts of lost packets are appended as gaps open up, retransmissions arrive out of order, NAKs are merged in
+// and resends are popped from the front until an ACK clears everything up to it.
+template <typename List>
+int simulateLossBursts(List& lossList, uint32_t seed, SequenceNumber start) {
+    std::mt19937 generator(seed);
+    int checksum = 0;
+
+    SequenceNumber next = start;
+    for (int burst = 0; burst < NUM_BURSTS; ++burst) {
+        // receiver - a run of gaps in the incoming sequence numbers
+        SequenceNumber burstStart = next;
+        for (int gap = 0; gap < MAX_GAP_LENGTH; ++gap) {
+            int lost = 1 + generator() % MAX_BURST_LENGTH;
+            lossList.append(next, next + (lost - 1));
+            next = next + (lost + 1 + (int)(generator() % 4));
+        }
+
+        // receiver - some retransmissions arrive, in any order
+        int span = seqlen(burstStart, next - 1);
+        for (int i = 0; i < span / 2; ++i) {
+            checksum += lossList.remove(burstStart + (int)(generator() % span)) ? 1 : 0;
+        }
+
+        // sender - NAKs for older ranges get merged back in
+        for (int i = 0; i < MAX_GAP_LENGTH; ++i) {
+            SequenceNumber nakStart = burstStart + (int)(generator() % (span - 8));
+            lossList.insert(nakStart, nakStart + (int)(generator() % 8));
+        }
+
+        // sender - resend from the front, then an ACK clears part of the burst
+        for (int i = 0; i < MAX_GAP_LENGTH && !lossList.isEmpty(); ++i) {
+            checksum += (int32_t)lossList.popFirstSequenceNumber();
+        }
+        if (!lossList.isEmpty()) {
+            SequenceNumber first = lossList.getFirstSequenceNumber();
+            lossList.remove(first, first + (int)(generator() % span));
+        }
+
+        checksum += lossList.getLength();
+    }
+
+    while (!lossList.isEmpty()) {
+        checksum += (int32_t)lossList.popFirstSequenceNumber();
+    }
+    return checksum;
+}
+
+}
+
+void LossListTests::matchesListImplementationTest() {
+    for (uint32_t seed = 1; seed <= 20; ++seed) {
+        LossList lossList;
+        ListLossList listLossList;
+        SequenceNumber start { (SequenceNumber::Type)(seed * 1000) };
+
+        QCOMPARE(simulateLossBursts(lossList, seed, start), simulateLossBursts(listLossList, seed, start));
+        QVERIFY(lossList.isEmpty());
+    }
+}
+
+void LossListTests::wrapAroundTest() {
+    LossList lossList;
+    SequenceNumber start { SequenceNumber::MAX - 2 };
+
+    lossList.append(start, start + 5);
+    QCOMPARE(lossList.getLength(), 6);
+    QCOMPARE(lossList.getFirstSequenceNumber(), start);
+
+    QVERIFY(lossList.remove(SequenceNumber(0)));
+    QCOMPARE(lossList.getLength(), 5);
+    QVERIFY(!lossList.remove(SequenceNumber(0)));
+
+    lossList.insert(SequenceNumber(0), SequenceNumber(0));
+    QCOMPARE(lossList.getLength(), 6);
+
+    lossList.remove(start, SequenceNumber(1));
+    QCOMPARE(lossList.getLength(), 1);
+    QCOMPARE(lossList.popFirstSequenceNumber(), SequenceNumber(2));
+    QVERIFY(lossList.isEmpty());
+}
+
+void LossListTests::listLossBurstBenchmark() {
+    ListLossList listLossList;
+    QBENCHMARK {
+        listLossList.clear();
+        simulateLossBursts(listLossList, 42, SequenceNumber(0));
+    }
+}
+
+void LossListTests::ringLossBurstBenchmark() {
+    LossList lossList;
+    QBENCHMARK {
+        lossList.clear();
+        simulateLossBursts(lossList, 42, SequenceNumber(0));
+    }
+}
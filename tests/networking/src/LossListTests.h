@@ -0,0 +1,35 @@
+//
+//  LossListTests.h
+//  tests/networking/src
+//
+//  Created on 2026-10-16.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_LossListTests_h
+#define hifi_LossListTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class LossListTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test appends, inserts, removes and pops against the previous std::list implementation
+    void matchesListImplementationTest();
+
+    // Test ranges that wrap around the maximum sequence number
+    void wrapAroundTest();
+
+    // Benchmark receiver and sender loss bursts with the previous std::list implementation
+    void listLossBurstBenchmark();
+
+    // Benchmark receiver and sender loss bursts with the ring buffer implementation
+    void ringLossBurstBenchmark();
+};
+
+#endif // hifi_LossListTests_h
@@ -0,0 +1,167 @@
+//
+//  SentPacketWindowTests.cpp
+//  tests/networking/src
+//
+//  Created on 2026-10-16.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SentPacketWindowTests.h"
+
+#include <atomic>
+#include <cstring>
+#include <thread>
+
+#include <udt/SentPacketWindow.h>
+
+QTEST_MAIN(SentPacketWindowTests)
+
+using namespace udt;
+
+namespace {
+
+std::unique_ptr<Packet> makePacket(uint32_t value) {
+    auto packet = Packet::create(sizeof(value), true);
+    packet->writePrimitive(value);
+    return packet;
+}
+
+uint32_t valueOf(const Packet& packet) {
+    uint32_t value;
+    memcpy(&value, packet.getPayload(), sizeof(value));
+    return value;
+}
+
+bool resendValue(SentPacketWindow& window, SequenceNumber sequenceNumber, uint32_t& value, uint8_t& resendCount) {
+    return window.resend(sequenceNumber, [&](Packet& packet, uint8_t count) {
+        value = valueOf(packet);
+        resendCount = count;
+    });
+}
+
+}
+
+void SentPacketWindowTests::insertResendEraseTest() {
+    SentPacketWindow window;
+    QCOMPARE(window.getNumChunks(), 0);
+
+    uint32_t value = 0;
+    uint8_t resendCount = 0;
+    QVERIFY(!resendValue(window, SequenceNumber(1), value, resendCount));
+
+    for (uint32_t i = 0; i < 10; ++i) {
+        window.insert(SequenceNumber(i), makePacket(i));
+    }
+    QVERIFY(resendValue(window, SequenceNumber(3), value, resendCount));
+    QCOMPARE(value, (uint32_t)3);
+    QCOMPARE(resendCount, (uint8_t)1);
+    QVERIFY(resendValue(window, SequenceNumber(3), value, resendCount));
+    QCOMPARE(resendCount, (uint8_t)2);
+
+    window.erase(SequenceNumber(3));
+    QVERIFY(!resendValue(window, SequenceNumber(3), value, resendCount));
+    // erasing twice, or what was never inserted, does nothing
+    window.erase(SequenceNumber(3));
+    window.erase(SequenceNumber(20));
+    QVERIFY(resendValue(window, SequenceNumber(4), value, resendCount));
+    QCOMPARE(value, (uint32_t)4);
+
+    // the same slot a whole window later replaces the packet that is still there
+    SequenceNumber later(4 + SentPacketWindow::CAPACITY);
+    window.insert(later, makePacket(1234));
+    QVERIFY(!resendValue(window, SequenceNumber(4), value, resendCount));
+    window.erase(SequenceNumber(4));
+    QVERIFY(resendValue(window, later, value, resendCount));
+    QCOMPARE(value, (uint32_t)1234);
+    QCOMPARE(resendCount, (uint8_t)1);
+}
+
+void SentPacketWindowTests::freesChunksTest() {
+    SentPacketWindow window;
+    const uint32_t NUM_PACKETS = 4 * SentPacketWindow::CHUNK_SIZE;
+    for (uint32_t i = 0; i < NUM_PACKETS; ++i) {
+        window.insert(SequenceNumber(i), makePacket(i));
+    }
+    QCOMPARE(window.getNumChunks(), 4);
+
+    // nothing is ACKed yet, so moving on to the next chunk frees none
+    window.insert(SequenceNumber(NUM_PACKETS), makePacket(NUM_PACKETS));
+    QCOMPARE(window.getNumChunks(), 5);
+
+    for (uint32_t i = 0; i < 3 * SentPacketWindow::CHUNK_SIZE + 1; ++i) {
+        window.erase(SequenceNumber(i));
+    }
+    // chunks are only freed by the send thread, when it moves on to the next one
+    QCOMPARE(window.getNumChunks(), 5);
+    for (uint32_t i = NUM_PACKETS + 1; i <= NUM_PACKETS + SentPacketWindow::CHUNK_SIZE; ++i) {
+        window.insert(SequenceNumber(i), makePacket(i));
+    }
+    // the first three chunks are all ACKed, the fourth isn't
+    QCOMPARE(window.getNumChunks(), 3);
+
+    uint32_t value = 0;
+    uint8_t resendCount = 0;
+    QVERIFY(!resendValue(window, SequenceNumber(0), value, resendCount));
+    QVERIFY(resendValue(window, SequenceNumber(3 * SentPacketWindow::CHUNK_SIZE + 1), value, resendCount));
+    QCOMPARE(value, (uint32_t)(3 * SentPacketWindow::CHUNK_SIZE + 1));
+}
+
+void SentPacketWindowTests::concurrentAckTest() {
+    SentPacketWindow window;
+    const uint32_t NUM_PACKETS = 20 * SentPacketWindow::CAPACITY;
+    const uint32_t FLOW_WINDOW = MAX_PACKETS_IN_FLIGHT;
+
+    std::atomic<uint32_t> numInserted { 0 };
+    std::atomic<uint32_t> numACKed { 0 };
+    std::thread ackThread([&] {
+        while (numACKed < NUM_PACKETS) {
+            uint32_t inserted = numInserted;
+            // ACK a few at a time, as the ACKs would come in
+            uint32_t ack = std::min(inserted, numACKed + 1 + inserted % 64);
+            for (uint32_t i = numACKed; i < ack; ++i) {
+                window.erase(SequenceNumber(i));
+            }
+            numACKed = ack;
+        }
+    });
+
+    int numResent = 0;
+    int maxNumChunks = 0;
+    bool allMatched = true;
+    for (uint32_t i = 0; i < NUM_PACKETS; ++i) {
+        while (i - numACKed >= FLOW_WINDOW) {
+            std::this_thread::yield();
+        }
+        window.insert(SequenceNumber(i), makePacket(i));
+        numInserted = i + 1;
+
+        // resend something that may or may not have been ACKed by now
+        uint32_t resendIndex = i - (i * 7919) % std::min(i + 1, FLOW_WINDOW);
+        window.resend(SequenceNumber(resendIndex), [&](Packet& packet, uint8_t resendCount) {
+            allMatched = allMatched && valueOf(packet) == resendIndex;
+            ++numResent;
+        });
+        maxNumChunks = std::max(maxNumChunks, window.getNumChunks());
+    }
+    ackThread.join();
+
+    QVERIFY(allMatched);
+    QVERIFY(numResent > 0);
+    // never more than the flow window, and the chunk either side of it
+    QVERIFY(maxNumChunks <= FLOW_WINDOW / SentPacketWindow::CHUNK_SIZE + 2);
+
+    uint32_t value = 0;
+    uint8_t resendCount = 0;
+    for (uint32_t i = NUM_PACKETS - SentPacketWindow::CAPACITY; i < NUM_PACKETS; ++i) {
+        QVERIFY(!resendValue(window, SequenceNumber(i), value, resendCount));
+    }
+    // everything is ACKed, so the next chunk the send thread moves to is the only one left
+    for (uint32_t i = NUM_PACKETS; i <= NUM_PACKETS + SentPacketWindow::CHUNK_SIZE; ++i) {
+        window.insert(SequenceNumber(i), makePacket(i));
+        window.erase(SequenceNumber(i));
+    }
+    QCOMPARE(window.getNumChunks(), 1);
+}
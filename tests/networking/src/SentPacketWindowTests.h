@@ -0,0 +1,32 @@
+//
+//  SentPacketWindowTests.h
+//  tests/networking/src
+//
+//  Created on 2026-10-16.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SentPacketWindowTests_h
+#define hifi_SentPacketWindowTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class SentPacketWindowTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test insert, resend and erase from a single thread, including sequence numbers a whole window apart
+    void insertResendEraseTest();
+
+    // Test that chunks are freed once all their packets are ACKed
+    void freesChunksTest();
+
+    // Test the send thread inserting and resending while another thread ACKs, as SendQueue does
+    void concurrentAckTest();
+};
+
+#endif // hifi_SentPacketWindowTests_h
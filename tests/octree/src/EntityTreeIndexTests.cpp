@@ -0,0 +1,160 @@
+//
+//  EntityTreeIndexTests.cpp
+//  tests/octree/src
+//
+//  Created on 2026-10-16.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityTreeIndexTests.h"
+
+#include <algorithm>
+
+#include <EntityItem.h>
+#include <EntityItemProperties.h>
+#include <EntityTreeIndex.h>
+#include <EntityTypes.h>
+
+QTEST_MAIN(EntityTreeIndexTests)
+
+namespace {
+
+const int NUM_BENCHMARK_ENTITIES = 100000;
+
+EntityItemPointer makeEntity(EntityTypes::EntityType type, const QString& name, const QUuid& parentID = QUuid()) {
+    EntityItemProperties properties;
+    properties.setName(name);
+    if (!parentID.isNull()) {
+        properties.setParentID(parentID);
+    }
+    return EntityTypes::constructEntityItem(type, QUuid::createUuid(), properties);
+}
+
+QVector<EntityItemID> sorted(QVector<EntityItemID> ids) {
+    std::sort(ids.begin(), ids.end());
+    return ids;
+}
+
+QVector<EntityItemID> idsOf(std::initializer_list<EntityItemPointer> entities) {
+    QVector<EntityItemID> ids;
+    for (const auto& entity : entities) {
+        ids.push_back(entity->getEntityItemID());
+    }
+    return sorted(ids);
+}
+
+}
+
+void EntityTreeIndexTests::findTest() {
+    QUuid parentID = QUuid::createUuid();
+    auto door = makeEntity(EntityTypes::Box, "Door");
+    auto otherDoor = makeEntity(EntityTypes::Sphere, "door");
+    auto handle = makeEntity(EntityTypes::Sphere, "Handle", parentID);
+    auto unnamed = makeEntity(EntityTypes::Box, "", parentID);
+    QVERIFY(door && otherDoor && handle && unnamed);
+
+    EntityTreeIndex index;
+    for (const auto& entity : { door, otherDoor, handle, unnamed }) {
+        index.add(entity);
+    }
+    QCOMPARE(index.size(), 4);
+
+    QCOMPARE(sorted(index.findByName("Door", true)), idsOf({ door }));
+    QCOMPARE(sorted(index.findByName("DOOR", false)), idsOf({ door, otherDoor }));
+    QVERIFY(index.findByName("DOOR", true).isEmpty());
+    QVERIFY(index.findByName("", true).isEmpty());
+
+    QCOMPARE(sorted(index.findByType(EntityTypes::Box)), idsOf({ door, unnamed }));
+    QCOMPARE(sorted(index.findByType(EntityTypes::Sphere)), idsOf({ otherDoor, handle }));
+    QVERIFY(index.findByType(EntityTypes::Model).isEmpty());
+    QCOMPARE(index.countByType(EntityTypes::Sphere), 2);
+
+    QCOMPARE(sorted(index.findByParent(parentID)), idsOf({ handle, unnamed }));
+    QVERIFY(index.findByParent(QUuid()).isEmpty());
+}
+
+void EntityTreeIndexTests::updateTest() {
+    QUuid avatarID = QUuid::createUuid();
+    QUuid parentID = QUuid::createUuid();
+    auto entity = makeEntity(EntityTypes::Box, "Car");
+    auto otherEntity = makeEntity(EntityTypes::Box, "Car");
+
+    EntityTreeIndex index;
+    index.add(entity);
+    index.add(otherEntity);
+
+    // an entity's tree re-indexes it whenever one of these changes
+    entity->setName("Truck");
+    entity->setOwningAvatarID(avatarID);
+    entity->setParentID(parentID);
+    index.update(entity);
+
+    QCOMPARE(index.findByName("Car", true), idsOf({ otherEntity }));
+    QCOMPARE(index.findByName("truck", false), idsOf({ entity }));
+    QCOMPARE(index.findByOwningAvatar(avatarID), idsOf({ entity }));
+    QCOMPARE(index.findByParent(parentID), idsOf({ entity }));
+
+    entity->setParentID(QUuid());
+    index.update(entity);
+    QVERIFY(index.findByParent(parentID).isEmpty());
+
+    index.remove(entity->getEntityItemID());
+    QCOMPARE(index.size(), 1);
+    QVERIFY(index.findByName("Truck", true).isEmpty());
+    QVERIFY(index.findByOwningAvatar(avatarID).isEmpty());
+    QCOMPARE(sorted(index.findByType(EntityTypes::Box)), idsOf({ otherEntity }));
+
+    // entities that weren't added stay out of the index
+    index.update(entity);
+    QCOMPARE(index.size(), 1);
+
+    index.clear();
+    QCOMPARE(index.size(), 0);
+    QVERIFY(index.findByType(EntityTypes::Box).isEmpty());
+}
+
+void EntityTreeIndexTests::benchmarkFind_data() {
+    QTest::addColumn<bool>("indexed");
+    QTest::addColumn<bool>("byName");
+    QTest::newRow("name, every entity") << false << true;
+    QTest::newRow("name, indexed") << true << true;
+    QTest::newRow("type, every entity") << false << false;
+    QTest::newRow("type, indexed") << true << false;
+}
+
+void EntityTreeIndexTests::benchmarkFind() {
+    QFETCH(bool, indexed);
+    QFETCH(bool, byName);
+
+    // a few entities of a rare type share each name, as in a domain of many small scripted objects
+    const int NUM_NAMES = NUM_BENCHMARK_ENTITIES / 4;
+    const int RARE_TYPE_INTERVAL = 1000;
+    std::vector<EntityItemPointer> entities;
+    entities.reserve(NUM_BENCHMARK_ENTITIES);
+    EntityTreeIndex index;
+    for (int i = 0; i < NUM_BENCHMARK_ENTITIES; ++i) {
+        auto type = i % RARE_TYPE_INTERVAL == 0 ? EntityTypes::Light : EntityTypes::Box;
+        entities.push_back(makeEntity(type, QString("Object %1").arg(i % NUM_NAMES)));
+        index.add(entities.back());
+    }
+
+    const QString name = "object 1234";
+    int numFound = 0;
+    QBENCHMARK {
+        if (indexed) {
+            numFound = byName ? index.findByName(name, false).size() : index.findByType(EntityTypes::Light).size();
+        } else {
+            // what a search of the tree does for each entity, without the tree
+            numFound = 0;
+            for (const auto& entity : entities) {
+                if (byName ? name.toLower() == entity->getName().toLower() : entity->getType() == EntityTypes::Light) {
+                    ++numFound;
+                }
+            }
+        }
+    }
+    QCOMPARE(numFound, byName ? NUM_BENCHMARK_ENTITIES / NUM_NAMES : NUM_BENCHMARK_ENTITIES / RARE_TYPE_INTERVAL);
+}
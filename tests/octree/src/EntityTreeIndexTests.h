@@ -0,0 +1,27 @@
+//
+//  EntityTreeIndexTests.h
+//  tests/octree/src
+//
+//  Created on 2026-10-16.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityTreeIndexTests_h
+#define hifi_EntityTreeIndexTests_h
+
+#include <QtTest/QtTest>
+
+class EntityTreeIndexTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void findTest();
+    void updateTest();
+    void benchmarkFind_data();
+    void benchmarkFind();
+};
+
+#endif // hifi_EntityTreeIndexTests_h
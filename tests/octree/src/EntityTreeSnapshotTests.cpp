@@ -0,0 +1,267 @@
+//
+//  EntityTreeSnapshotTests.cpp
+//  tests/octree/src
+//
+//  Created on 2026-10-16.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityTreeSnapshotTests.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#include <AddressManager.h>
+#include <DependencyManager.h>
+#include <EntityItemProperties.h>
+#include <EntityTree.h>
+#include <EntityTreeElement.h>
+#include <EntityTypes.h>
+#include <NodeList.h>
+#include <PickFilter.h>
+#include <SharedUtil.h>
+
+QTEST_MAIN(EntityTreeSnapshotTests)
+
+namespace {
+
+const int NUM_ENTITIES = 200;
+const float SPREAD = 100.0f;
+const PickFilter SEARCH_FILTER(PickFilter::getBitMask(PickFilter::FlagBit::DOMAIN_ENTITIES));
+
+EntityTreePointer makeTree() {
+    auto tree = std::make_shared<EntityTree>();
+    tree->setIsServer(true);
+    tree->createRootElement();
+    return tree;
+}
+
+EntityItemPointer addEntity(const EntityTreePointer& tree, const glm::vec3& position,
+                            EntityTypes::EntityType type = EntityTypes::Box) {
+    EntityItemProperties properties;
+    properties.setType(type);
+    properties.setPosition(position);
+    properties.setDimensions(glm::vec3(0.5f));
+    return tree->addEntity(EntityItemID(QUuid::createUuid()), properties);
+}
+
+glm::vec3 randomPosition() {
+    return glm::vec3(randFloatInRange(-SPREAD, SPREAD), randFloatInRange(-SPREAD, SPREAD), randFloatInRange(-SPREAD, SPREAD));
+}
+
+QVector<QUuid> sorted(QVector<QUuid> ids) {
+    std::sort(ids.begin(), ids.end());
+    return ids;
+}
+
+// every element of the tree itself, without pruning, so that a wrong snapshot can't hide a wrong search
+QVector<QUuid> findInSphereInTree(const EntityTreePointer& tree, const glm::vec3& center, float radius) {
+    QVector<QUuid> found;
+    tree->withReadLock([&] {
+        tree->recurseTreeWithOperation([&](const OctreeElementPointer& element, void*) {
+            auto entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
+            EntityTreeElement::evalEntitiesInSphere(entityTreeElement->getEntityItems(), center, radius,
+                                                    SEARCH_FILTER, found);
+            return true;
+        });
+    });
+    return sorted(found);
+}
+
+QVector<QUuid> findInSphere(const EntityTreePointer& tree, const glm::vec3& center, float radius) {
+    QVector<QUuid> found;
+    tree->evalEntitiesInSphere(center, radius, SEARCH_FILTER, found);
+    return sorted(found);
+}
+
+void compareWithTree(const EntityTreePointer& tree) {
+    for (int i = 0; i < 20; ++i) {
+        glm::vec3 center = randomPosition();
+        float radius = randFloatInRange(1.0f, SPREAD);
+        QCOMPARE(findInSphere(tree, center, radius), findInSphereInTree(tree, center, radius));
+    }
+    QCOMPARE(findInSphere(tree, glm::vec3(0.0f), 2.0f * SPREAD).size(), tree->getSnapshot()->getNumEntities());
+}
+
+}
+
+void EntityTreeSnapshotTests::initTestCase() {
+    // EntityTree::addEntity() checks the rez permissions of this node
+    DependencyManager::set<AddressManager>();
+    DependencyManager::registerInheritance<LimitedNodeList, NodeList>();
+    DependencyManager::set<NodeList>(NodeType::Agent, INVALID_PORT);
+}
+
+void EntityTreeSnapshotTests::matchesTreeTest() {
+    auto tree = makeTree();
+    QVector<EntityItemPointer> entities;
+    for (int i = 0; i < NUM_ENTITIES; ++i) {
+        entities.push_back(addEntity(tree, randomPosition()));
+        QVERIFY(entities.back());
+    }
+    compareWithTree(tree);
+    QCOMPARE(tree->getSnapshot()->getNumEntities(), NUM_ENTITIES);
+
+    // each change is only copied into the next snapshot along its own path, so check the result after a few of each
+    for (int i = 0; i < NUM_ENTITIES / 4; ++i) {
+        tree->deleteEntity(entities[i]->getEntityItemID(), true);
+    }
+    compareWithTree(tree);
+
+    for (int i = NUM_ENTITIES / 4; i < NUM_ENTITIES / 2; ++i) {
+        EntityItemProperties properties;
+        properties.setPosition(randomPosition());
+        QVERIFY(tree->updateEntity(entities[i]->getEntityItemID(), properties));
+    }
+    compareWithTree(tree);
+
+    for (int i = 0; i < NUM_ENTITIES / 4; ++i) {
+        QVERIFY(addEntity(tree, randomPosition()));
+    }
+    compareWithTree(tree);
+    QCOMPARE(tree->getSnapshot()->getNumEntities(), NUM_ENTITIES);
+
+    tree->eraseAllOctreeElements();
+    QCOMPARE(tree->getSnapshot()->getNumEntities(), 0);
+    QVERIFY(addEntity(tree, randomPosition()));
+    compareWithTree(tree);
+}
+
+void EntityTreeSnapshotTests::sharesUnchangedElementsTest() {
+    auto tree = makeTree();
+    auto near = addEntity(tree, glm::vec3(-SPREAD));
+    auto far = addEntity(tree, glm::vec3(SPREAD));
+    QVERIFY(near && far);
+
+    auto before = tree->getSnapshot();
+    QVERIFY(addEntity(tree, glm::vec3(SPREAD + 1.0f)));
+    auto after = tree->getSnapshot();
+    QVERIFY(after != before);
+    QCOMPARE(after->getNumEntities(), before->getNumEntities() + 1);
+
+    // the root is copied, but the branch holding only the entity near the other corner is shared
+    QVERIFY(after->getRoot() != before->getRoot());
+    int numShared = 0;
+    for (const auto& child : after->getRoot()->children) {
+        const auto& children = before->getRoot()->children;
+        if (std::find(children.begin(), children.end(), child) != children.end()) {
+            ++numShared;
+        }
+    }
+    QVERIFY(numShared > 0);
+
+    // and nothing is copied when nothing changed
+    QCOMPARE(tree->getSnapshot(), after);
+}
+
+void EntityTreeSnapshotTests::deadEntitiesTest() {
+    auto tree = makeTree();
+    auto entity = addEntity(tree, glm::vec3(1.0f));
+    QVERIFY(entity);
+    auto snapshot = tree->getSnapshot();
+
+    tree->deleteEntity(entity->getEntityItemID(), true);
+    QVERIFY(entity->isDead());
+
+    // the old snapshot still holds the deleted entity, but no search of it returns it
+    QCOMPARE(snapshot->getNumEntities(), 1);
+    QVector<QUuid> found;
+    snapshot->recurseWithOperation([&](const EntityTreeSnapshot::Element& element, void*) {
+        EntityTreeElement::evalEntitiesInSphere(element.entities, glm::vec3(1.0f), 10.0f, SEARCH_FILTER, found);
+        return true;
+    });
+    QVERIFY(found.isEmpty());
+
+    QCOMPARE(tree->getSnapshot()->getNumEntities(), 0);
+    QVERIFY(findInSphere(tree, glm::vec3(1.0f), 10.0f).isEmpty());
+}
+
+void EntityTreeSnapshotTests::tryLockTest() {
+    auto tree = makeTree();
+    auto entity = addEntity(tree, glm::vec3(1.0f));
+    QVERIFY(entity);
+    auto before = tree->getSnapshot();
+    auto added = addEntity(tree, glm::vec3(2.0f));
+    QVERIFY(added);
+
+    std::atomic<bool> locked { false };
+    std::atomic<bool> release { false };
+    std::thread writer([&] {
+        tree->withWriteLock([&] {
+            locked = true;
+            while (!release) {
+                std::this_thread::yield();
+            }
+        });
+    });
+    while (!locked) {
+        std::this_thread::yield();
+    }
+
+    // can't take a new snapshot while the tree is being written, so get the last one
+    bool accurateResult = true;
+    auto stale = tree->getSnapshot(Octree::TryLock, &accurateResult);
+    QVERIFY(!accurateResult);
+    QCOMPARE(stale, before);
+    QCOMPARE(stale->getNumEntities(), 1);
+
+    release = true;
+    writer.join();
+
+    auto current = tree->getSnapshot(Octree::TryLock, &accurateResult);
+    QVERIFY(accurateResult);
+    QCOMPARE(current->getNumEntities(), 2);
+}
+
+void EntityTreeSnapshotTests::concurrentIndexedQueryTest() {
+    // few enough spheres among the boxes that searching for them looks them up through the index
+    auto tree = makeTree();
+    for (int i = 0; i < NUM_ENTITIES; ++i) {
+        QVERIFY(addEntity(tree, randomPosition()));
+    }
+    const int NUM_SPHERES = 10;
+    QVector<QUuid> spheres;
+    for (int i = 0; i < NUM_SPHERES; ++i) {
+        auto sphere = addEntity(tree, randomPosition(), EntityTypes::Sphere);
+        QVERIFY(sphere);
+        spheres.push_back(sphere->getEntityItemID());
+    }
+
+    // add and delete other spheres while searching for them without locking the tree
+    std::atomic<bool> done { false };
+    std::thread writer([&] {
+        while (!done) {
+            QVector<EntityItemID> added;
+            tree->withWriteLock([&] {
+                for (int i = 0; i < NUM_SPHERES; ++i) {
+                    added.push_back(addEntity(tree, randomPosition(), EntityTypes::Sphere)->getEntityItemID());
+                }
+            });
+            for (const auto& entityID : added) {
+                tree->deleteEntity(entityID, true);
+            }
+        }
+    });
+
+    // the writer is joined before checking, so that a failure can't return while it's running
+    bool foundAll = true;
+    int maxFound = 0;
+    for (int i = 0; i < 1000 && foundAll; ++i) {
+        QVector<QUuid> found;
+        tree->evalEntitiesInSphereWithType(glm::vec3(0.0f), 2.0f * SPREAD, EntityTypes::Sphere, SEARCH_FILTER, found);
+        maxFound = std::max(maxFound, found.size());
+        for (const auto& sphere : spheres) {
+            foundAll = foundAll && found.contains(sphere);
+        }
+    }
+
+    done = true;
+    writer.join();
+
+    QVERIFY(foundAll);
+    QVERIFY(maxFound <= 2 * NUM_SPHERES);
+}
@@ -0,0 +1,29 @@
+//
+//  EntityTreeSnapshotTests.h
+//  tests/octree/src
+//
+//  Created on 2026-10-16.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityTreeSnapshotTests_h
+#define hifi_EntityTreeSnapshotTests_h
+
+#include <QtTest/QtTest>
+
+class EntityTreeSnapshotTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void matchesTreeTest();
+    void sharesUnchangedElementsTest();
+    void deadEntitiesTest();
+    void tryLockTest();
+    void concurrentIndexedQueryTest();
+};
+
+#endif // hifi_EntityTreeSnapshotTests_h
@@ -0,0 +1,87 @@
+//
+//  OctreeEntitiesFileParserTests.cpp
+//  tests/octree/src
+//
+//  Created on 2026-10-16.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreeEntitiesFileParserTests.h"
+
+#include <QJsonDocument>
+
+#include <OctreeEntitiesFileParser.h>
+
+QTEST_MAIN(OctreeEntitiesFileParserTests)
+
+namespace {
+
+// the entities come before the version, as they do in the files written by the entity server
+const QByteArray ENTITIES_JSON = R"({
+    "DataVersion": 3,
+    "Entities": [
+        { "id": "{1b7a2c5e-4b4f-4c43-9c8e-0f7d9c1f2a11}", "name": "first", "userData": "{ \"brace\": \"}\" }" },
+        { "id": "{6d2f8e47-0a43-4c8a-b6a5-5e39a5e0c0d2}", "name": "second", "modelURL": "./models/box.fbx" }
+    ],
+    "Id": "{3e1f4d0c-7a6b-4f2e-8b1d-2c9a6e5f4b3a}",
+    "Version": 120
+})";
+
+}
+
+void OctreeEntitiesFileParserTests::parseTest() {
+    OctreeEntitiesFileParser parser;
+    parser.setEntitiesString(ENTITIES_JSON);
+    QVariantMap map;
+    QVERIFY(parser.parseEntities(map));
+
+    QCOMPARE(map["DataVersion"].toInt(), 3);
+    QCOMPARE(map["Version"].toInt(), 120);
+    QVariantList entities = map["Entities"].toList();
+    QCOMPARE(entities.size(), 2);
+    QCOMPARE(entities[0].toMap()["name"].toString(), QString("first"));
+    QCOMPARE(entities[1].toMap()["name"].toString(), QString("second"));
+}
+
+void OctreeEntitiesFileParserTests::entityHandlerTest() {
+    OctreeEntitiesFileParser parser;
+    parser.setEntitiesString(ENTITIES_JSON);
+    QVariantMap map;
+    QList<QByteArray> entityJSONs;
+    QVERIFY(parser.parseEntities(map, [&](const QByteArray& entityJSON) {
+        // the handler is given slices of the parser's text, which it must copy to keep
+        entityJSONs.push_back(QByteArray(entityJSON.constData(), entityJSON.size()));
+    }));
+
+    // the rest of the description is still parsed, but the entities are left to the handler
+    QCOMPARE(map["Version"].toInt(), 120);
+    QVERIFY(!map.contains("Entities"));
+
+    QCOMPARE(entityJSONs.size(), 2);
+    QJsonObject first = QJsonDocument::fromJson(entityJSONs[0]).object();
+    QCOMPARE(first["name"].toString(), QString("first"));
+    QCOMPARE(first["userData"].toString(), QString("{ \"brace\": \"}\" }"));
+    QJsonObject second = QJsonDocument::fromJson(entityJSONs[1]).object();
+    QCOMPARE(second["name"].toString(), QString("second"));
+}
+
+void OctreeEntitiesFileParserTests::relativeURLTest() {
+    const QUrl RELATIVE_URL("http://example.com/content/");
+
+    OctreeEntitiesFileParser parser;
+    parser.setEntitiesString(ENTITIES_JSON);
+    parser.setRelativeURL(RELATIVE_URL);
+    QVariantMap map;
+    QVERIFY(parser.parseEntities(map));
+    QCOMPARE(map["Entities"].toList()[1].toMap()["modelURL"].toString(),
+             QString("http://example.com/content/models/box.fbx"));
+
+    // entities handed out unparsed are resolved the same way once they are
+    QJsonObject entity = QJsonDocument::fromJson(R"({ "modelURL": "./models/box.fbx", "script": "../a.js" })").object();
+    parser.resolveRelativeURLs(entity);
+    QCOMPARE(entity["modelURL"].toString(), QString("http://example.com/content/models/box.fbx"));
+    QCOMPARE(entity["script"].toString(), QString("http://example.com/a.js"));
+}
@@ -0,0 +1,226 @@
+//
+//  OctreePersistJournalTests.cpp
+//  tests/octree/src
+//
+//  Created on 2026-10-16.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreePersistJournalTests.h"
+
+#include <QTemporaryDir>
+
+#include <OctreePersistJournal.h>
+
+QTEST_MAIN(OctreePersistJournalTests)
+
+namespace {
+
+QVariantMap makeEntity(const QUuid& id, const QString& name) {
+    QVariantMap entity;
+    entity["id"] = id.toString();
+    entity["name"] = name;
+    return entity;
+}
+
+QVariantMap makeChanges(const QVariantList& entities, const QVariantList& deleted = QVariantList()) {
+    QVariantMap changes;
+    changes["Entities"] = entities;
+    changes["Deleted"] = deleted;
+    return changes;
+}
+
+// entity names by ID
+QMap<QUuid, QString> names(const QVariantMap& entityDescription) {
+    QMap<QUuid, QString> names;
+    for (const auto& entity : entityDescription["Entities"].toList()) {
+        names[QUuid(entity.toMap()["id"].toString())] = entity.toMap()["name"].toString();
+    }
+    return names;
+}
+
+}
+
+void OctreePersistJournalTests::replayTest() {
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QString snapshot = dir.filePath("models.json.gz");
+    QUuid snapshotID = QUuid::createUuid();
+
+    QUuid kept = QUuid::createUuid();
+    QUuid edited = QUuid::createUuid();
+    QUuid deleted = QUuid::createUuid();
+    QUuid added = QUuid::createUuid();
+    QUuid addedThenDeleted = QUuid::createUuid();
+
+    QVariantMap entityDescription;
+    entityDescription["Id"] = snapshotID;
+    entityDescription["Entities"] = QVariantList {
+        makeEntity(kept, "kept"), makeEntity(edited, "before"), makeEntity(deleted, "deleted")
+    };
+
+    {
+        OctreePersistJournal journal(snapshot);
+        QVERIFY(!journal.exists());
+        QVERIFY(journal.open(snapshotID));
+        QVERIFY(journal.append(makeChanges({ makeEntity(edited, "during"), makeEntity(addedThenDeleted, "gone") })));
+        QVERIFY(journal.append(makeChanges({ makeEntity(added, "added") }, { deleted.toString() })));
+        QVERIFY(journal.append(makeChanges({ makeEntity(edited, "after") }, { addedThenDeleted.toString() })));
+        QCOMPARE(journal.getNumRecords(), 3);
+    }
+
+    OctreePersistJournal journal(snapshot);
+    QVERIFY(journal.exists());
+    QCOMPARE(journal.replay(entityDescription, snapshotID), 3);
+
+    QMap<QUuid, QString> expected;
+    expected[kept] = "kept";
+    expected[edited] = "after";
+    expected[added] = "added";
+    QCOMPARE(names(entityDescription), expected);
+    QCOMPARE(entityDescription["Id"].toUuid(), snapshotID);
+
+    // reopening continues the journal
+    QVERIFY(journal.open(snapshotID));
+    QCOMPARE(journal.getNumRecords(), 3);
+    QVERIFY(journal.append(makeChanges({}, { kept.toString() })));
+    QCOMPARE(journal.replay(entityDescription, snapshotID), 4);
+    expected.remove(kept);
+    QCOMPARE(names(entityDescription), expected);
+
+    journal.discard();
+    QVERIFY(!journal.exists());
+}
+
+void OctreePersistJournalTests::incompleteRecordTest() {
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QString snapshot = dir.filePath("models.json.gz");
+    QUuid snapshotID = QUuid::createUuid();
+    QUuid first = QUuid::createUuid();
+    QUuid second = QUuid::createUuid();
+
+    {
+        OctreePersistJournal journal(snapshot);
+        QVERIFY(journal.open(snapshotID));
+        QVERIFY(journal.append(makeChanges({ makeEntity(first, "first") })));
+    }
+
+    // cut a second record short, as if the server went down while writing it
+    {
+        OctreePersistJournal journal(snapshot);
+        QVERIFY(journal.open(snapshotID));
+        QVERIFY(journal.append(makeChanges({ makeEntity(second, "second") })));
+    }
+    QFile file(snapshot + OctreePersistJournal::JOURNAL_EXTENSION);
+    QVERIFY(file.resize(file.size() - 3));
+
+    OctreePersistJournal journal(snapshot);
+    QVariantMap entityDescription;
+    QCOMPARE(journal.replay(entityDescription, snapshotID), 1);
+    QCOMPARE(names(entityDescription).keys(), QList<QUuid>({ first }));
+
+    // records appended after reopening follow on from the last complete one
+    QVERIFY(journal.open(snapshotID));
+    QCOMPARE(journal.getNumRecords(), 1);
+    QVERIFY(journal.append(makeChanges({ makeEntity(second, "second") })));
+    entityDescription.clear();
+    QCOMPARE(journal.replay(entityDescription, snapshotID), 2);
+    QCOMPARE(names(entityDescription).size(), 2);
+}
+
+void OctreePersistJournalTests::otherSnapshotTest() {
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QString snapshot = dir.filePath("models.json.gz");
+    QUuid snapshotID = QUuid::createUuid();
+    QUuid otherSnapshotID = QUuid::createUuid();
+
+    OctreePersistJournal journal(snapshot);
+    QVERIFY(journal.open(otherSnapshotID));
+    QVERIFY(journal.append(makeChanges({ makeEntity(QUuid::createUuid(), "other") })));
+
+    QVariantMap entityDescription;
+    QCOMPARE(journal.replay(entityDescription, snapshotID), 0);
+    QVERIFY(entityDescription["Entities"].toList().isEmpty());
+
+    // nor is any journal replayed over a snapshot without an ID
+    QCOMPARE(journal.replay(entityDescription, QUuid()), 0);
+    QVERIFY(entityDescription["Entities"].toList().isEmpty());
+
+    // reopening over another snapshot starts the journal again
+    QVERIFY(journal.open(snapshotID));
+    QCOMPARE(journal.getNumRecords(), 0);
+    entityDescription.clear();
+    QCOMPARE(journal.replay(entityDescription, snapshotID), 0);
+}
+
+void OctreePersistJournalTests::unusableSnapshotTest() {
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QString snapshot = dir.filePath("models.json.gz");
+    QUuid snapshotID = QUuid::createUuid();
+
+    OctreePersistJournal journal(snapshot);
+    QVERIFY(journal.open(snapshotID));
+    QVERIFY(journal.append(makeChanges({ makeEntity(QUuid::createUuid(), "journaled") })));
+    journal.close();
+    QFile journalFile(snapshot + OctreePersistJournal::JOURNAL_EXTENSION);
+    qint64 journalSize = journalFile.size();
+
+    const QByteArray SNAPSHOT_JSON = QString(R"({ "Entities": [ { "id": "%1", "name": "saved" } ], "Id": "%2" })")
+        .arg(QUuid::createUuid().toString(), snapshotID.toString()).toUtf8();
+    const QByteArray SNAPSHOT_WITHOUT_ID_JSON = R"({ "Entities": [ ] })";
+
+    // a missing, corrupt or unidentified snapshot isn't replayed over, which would leave only the journaled changes
+    // to be compacted over the saved world
+    for (const auto& snapshotJSON : { QByteArray(), SNAPSHOT_JSON.left(SNAPSHOT_JSON.size() / 2), SNAPSHOT_WITHOUT_ID_JSON }) {
+        QVariantMap entityDescription;
+        QCOMPARE(journal.replayOverSnapshot(snapshotJSON, entityDescription), -1);
+        QVERIFY(journal.exists());
+        QCOMPARE(journalFile.size(), journalSize);
+    }
+
+    QVariantMap entityDescription;
+    QCOMPARE(journal.replayOverSnapshot(SNAPSHOT_JSON, entityDescription), 1);
+    QCOMPARE(names(entityDescription).size(), 2);
+}
+
+void OctreePersistJournalTests::compactionTest() {
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QString snapshot = dir.filePath("models.json.gz");
+    QUuid snapshotID = QUuid::createUuid();
+    QUuid first = QUuid::createUuid();
+    QUuid second = QUuid::createUuid();
+    QUuid third = QUuid::createUuid();
+
+    OctreePersistJournal journal(snapshot);
+    QVERIFY(journal.open(snapshotID));
+    QVERIFY(journal.append(makeChanges({ makeEntity(first, "first") })));
+
+    // a failed compaction keeps the journal it moved aside...
+    QVERIFY(journal.beginCompaction());
+    QCOMPARE(journal.getNumRecords(), 0);
+    QVERIFY(journal.append(makeChanges({ makeEntity(second, "second") })));
+    journal.endCompaction(false);
+
+    QVariantMap entityDescription;
+    QCOMPARE(journal.replay(entityDescription, snapshotID), 2);
+
+    // ...and folds it into the next one
+    QVERIFY(journal.beginCompaction());
+    QVERIFY(journal.append(makeChanges({ makeEntity(third, "third") })));
+    entityDescription.clear();
+    QCOMPARE(journal.replay(entityDescription, snapshotID), 3);
+    QCOMPARE(names(entityDescription).size(), 3);
+
+    // once the snapshot is written only the changes since it was started are left
+    journal.endCompaction(true);
+    entityDescription.clear();
+    QCOMPARE(journal.replay(entityDescription, snapshotID), 1);
+    QCOMPARE(names(entityDescription).keys(), QList<QUuid>({ third }));
+}
@@ -0,0 +1,28 @@
+//
+//  OctreePersistJournalTests.h
+//  tests/octree/src
+//
+//  Created on 2026-10-16.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_OctreePersistJournalTests_h
+#define hifi_OctreePersistJournalTests_h
+
+#include <QtTest/QtTest>
+
+class OctreePersistJournalTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void replayTest();
+    void incompleteRecordTest();
+    void otherSnapshotTest();
+    void unusableSnapshotTest();
+    void compactionTest();
+};
+
+#endif // hifi_OctreePersistJournalTests_h
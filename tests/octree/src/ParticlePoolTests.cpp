@@ -0,0 +1,208 @@
+//
+//  ParticlePoolTests.cpp
+//  tests/octree/src
+//
+//  Created on 2026-10-16.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ParticlePoolTests.h"
+
+#include <deque>
+#include <random>
+
+#include <NumericalConstants.h>
+#include <ParticlePool.h>
+
+#include <test-utils/GLMTestUtils.h>
+#include <test-utils/QTestExtensions.h>
+
+QTEST_MAIN(ParticlePoolTests)
+
+namespace {
+
+const float ACCEPTABLE_POSITION_ERROR = 1.0e-4f;
+const uint64_t FRAME_USECS = USECS_PER_SECOND / 60;
+
+// a particle as it was stepped one at a time, before the pool
+struct ReferenceParticle {
+    float seed { 0.0f };
+    uint64_t expiration { 0 };
+    float lifetime { 0.0f };
+    glm::vec3 basePosition;
+    glm::vec3 relativePosition;
+    glm::vec3 velocity;
+    glm::vec3 acceleration;
+
+    void integrate(float deltaTime) {
+        glm::vec3 atSquared = (0.5f * deltaTime * deltaTime) * acceleration;
+        relativePosition += velocity * deltaTime + atSquared;
+        velocity += acceleration * deltaTime;
+        lifetime += deltaTime;
+    }
+};
+
+glm::vec3 randomVector(std::mt19937& generator, float range) {
+    std::uniform_real_distribution<float> distribution(-range, range);
+    return glm::vec3(distribution(generator), distribution(generator), distribution(generator));
+}
+
+void emit(particle::Pool& particles, std::mt19937& generator, uint64_t lifespanUsecs) {
+    std::uniform_real_distribution<float> seed(-1.0f, 1.0f);
+    particles.emit(seed(generator), lifespanUsecs, randomVector(generator, 100.0f), randomVector(generator, 1.0f),
+        randomVector(generator, 5.0f), randomVector(generator, 10.0f));
+}
+
+std::vector<float> getSeeds(const particle::Pool& particles) {
+    const float* seeds = particles.get(particle::Pool::SEED);
+    return std::vector<float>(seeds, seeds + particles.size());
+}
+
+}
+
+void ParticlePoolTests::integrateTest() {
+    const size_t MAX_PARTICLES = 500;
+    const int NUM_EMITTED_PER_STEP = 23;
+    const uint64_t LIFESPAN_USECS = 40 * FRAME_USECS;
+    const glm::vec3 emitterPosition(3.0f, -2.0f, 1.0f);
+
+    std::mt19937 generator(7);
+    particle::Pool particles;
+    std::deque<ReferenceParticle> reference;
+
+    for (int step = 0; step < 60; ++step) {
+        // the emitter stops trailing half way through
+        bool trail = step < 30;
+        if (step == 30) {
+            particles.rebase(emitterPosition, true);
+            for (auto& expected : reference) {
+                expected.relativePosition = expected.relativePosition + expected.basePosition - emitterPosition;
+                expected.basePosition = emitterPosition;
+            }
+        }
+
+        for (int i = 0; i < NUM_EMITTED_PER_STEP; ++i) {
+            emit(particles, generator, LIFESPAN_USECS);
+            size_t last = particles.size() - 1;
+            ReferenceParticle expected;
+            expected.seed = particles.get(particle::Pool::SEED)[last];
+            expected.expiration = LIFESPAN_USECS;
+            for (int j = 0; j < 3; ++j) {
+                expected.basePosition[j] = particles.get((particle::Pool::Field)(particle::Pool::BASE_X + j))[last];
+                expected.relativePosition[j] = particles.get((particle::Pool::Field)(particle::Pool::POSITION_X + j))[last];
+                expected.velocity[j] = particles.get((particle::Pool::Field)(particle::Pool::VELOCITY_X + j))[last];
+                expected.acceleration[j] = particles.get((particle::Pool::Field)(particle::Pool::ACCELERATION_X + j))[last];
+            }
+            reference.push_back(expected);
+        }
+
+        particles.removeExpired(MAX_PARTICLES);
+        while (reference.size() > MAX_PARTICLES || (!reference.empty() && reference.front().expiration == 0)) {
+            reference.pop_front();
+        }
+
+        particles.integrate(FRAME_USECS);
+        for (auto& expected : reference) {
+            expected.expiration = expected.expiration >= FRAME_USECS ? expected.expiration - FRAME_USECS : 0;
+            expected.integrate((float)FRAME_USECS / (float)USECS_PER_SECOND);
+        }
+
+        std::vector<particle::Instance> instances(particles.size());
+        particles.writeInstances(instances.data(), trail, emitterPosition);
+
+        QCOMPARE(particles.size(), reference.size());
+        for (size_t i = 0; i < reference.size(); ++i) {
+            const auto& expected = reference[i];
+            glm::vec3 position = expected.relativePosition + (trail ? expected.basePosition : emitterPosition);
+            QCOMPARE(particles.getExpiration()[i], expected.expiration);
+            QCOMPARE(instances[i].uv.x, expected.lifetime);
+            QCOMPARE(instances[i].uv.y, expected.seed);
+            QCOMPARE_WITH_ABS_ERROR(instances[i].xyz, position, ACCEPTABLE_POSITION_ERROR);
+        }
+    }
+}
+
+void ParticlePoolTests::removeExpiredTest() {
+    particle::Pool particles;
+    const uint64_t lifespans[] = { 100, 50, 100, 50, 100, 100 };
+    for (int i = 0; i < 6; ++i) {
+        particles.emit((float)i, lifespans[i], glm::vec3(), glm::vec3((float)i), glm::vec3(), glm::vec3());
+    }
+
+    // nothing has expired until it has been stepped past its lifespan
+    particles.removeExpired(10);
+    QCOMPARE(particles.size(), (size_t)6);
+
+    particles.integrate(60);
+    QCOMPARE(particles.getExpiration()[1], (uint64_t)0);
+    particles.removeExpired(10);
+    QCOMPARE(getSeeds(particles), std::vector<float>({ 0.0f, 2.0f, 4.0f, 5.0f }));
+    QCOMPARE(particles.get(particle::Pool::POSITION_Y)[2], 4.0f);
+    QCOMPARE(particles.getExpiration()[3], (uint64_t)40);
+
+    // the oldest go first when there are too many
+    particles.removeExpired(3);
+    QCOMPARE(getSeeds(particles), std::vector<float>({ 2.0f, 4.0f, 5.0f }));
+
+    particles.integrate(40);
+    particles.removeExpired(3);
+    QVERIFY(particles.empty());
+}
+
+void ParticlePoolTests::rebaseTest() {
+    particle::Pool particles;
+    particles.emit(0.0f, 100, glm::vec3(1.0f, 2.0f, 3.0f), glm::vec3(0.5f), glm::vec3(), glm::vec3());
+    particles.emit(1.0f, 100, glm::vec3(-1.0f, 0.0f, 4.0f), glm::vec3(-0.5f), glm::vec3(), glm::vec3());
+    const glm::vec3 basePosition(10.0f, 20.0f, 30.0f);
+
+    std::vector<particle::Instance> trailing(particles.size());
+    particles.writeInstances(trailing.data(), true, glm::vec3());
+
+    // trailing particles stay where they are in the world
+    particles.rebase(basePosition, true);
+    std::vector<particle::Instance> rebased(particles.size());
+    particles.writeInstances(rebased.data(), true, glm::vec3());
+    for (size_t i = 0; i < particles.size(); ++i) {
+        QCOMPARE_WITH_ABS_ERROR(rebased[i].xyz, trailing[i].xyz, ACCEPTABLE_POSITION_ERROR);
+        QCOMPARE(particles.get(particle::Pool::BASE_Z)[i], basePosition.z);
+    }
+
+    // the others keep their position relative to the emitter
+    particles.rebase(glm::vec3(), false);
+    particles.writeInstances(rebased.data(), true, glm::vec3());
+    for (size_t i = 0; i < particles.size(); ++i) {
+        QCOMPARE_WITH_ABS_ERROR(rebased[i].xyz, trailing[i].xyz - basePosition, ACCEPTABLE_POSITION_ERROR);
+    }
+}
+
+void ParticlePoolTests::benchmarkStep_data() {
+    QTest::addColumn<int>("numParticles");
+    QTest::newRow("1000") << 1000;
+    QTest::newRow("10000") << 10000;
+    QTest::newRow("100000") << 100000;
+}
+
+void ParticlePoolTests::benchmarkStep() {
+    QFETCH(int, numParticles);
+
+    // long lived enough that none expire while benchmarking, as in a full emitter
+    const uint64_t LIFESPAN_USECS = (uint64_t)1.0e12;
+
+    std::mt19937 generator(11);
+    particle::Pool particles;
+    particles.reserve(numParticles);
+    for (int i = 0; i < numParticles; ++i) {
+        emit(particles, generator, LIFESPAN_USECS);
+    }
+    std::vector<particle::Instance> instances(numParticles);
+
+    QBENCHMARK {
+        particles.removeExpired(numParticles);
+        particles.integrate(FRAME_USECS);
+        particles.writeInstances(instances.data(), true, glm::vec3());
+    }
+    QCOMPARE(particles.size(), (size_t)numParticles);
+}
@@ -0,0 +1,28 @@
+//
+//  ParticlePoolTests.h
+//  tests/octree/src
+//
+//  Created on 2026-10-16.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ParticlePoolTests_h
+#define hifi_ParticlePoolTests_h
+
+#include <QtTest/QtTest>
+
+class ParticlePoolTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void integrateTest();
+    void removeExpiredTest();
+    void rebaseTest();
+    void benchmarkStep_data();
+    void benchmarkStep();
+};
+
+#endif // hifi_ParticlePoolTests_h
@@ -0,0 +1,165 @@
+//
+//  PolyVoxBricksTests.cpp
+//  tests/octree/src
+//
+//  Created on 2026-10-16.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PolyVoxBricksTests.h"
+
+#include <algorithm>
+
+#include <PolyVoxBricks.h>
+#include <PolyVoxEntityItem.h>
+
+QTEST_MAIN(PolyVoxBricksTests)
+
+namespace {
+
+// not a whole number of bricks along any axis
+const glm::ivec3 VOLUME_SIZE { 20, 13, 9 };
+
+void setSphere(PolyVoxBricks& bricks, const glm::ivec3& center, int radius, uint8_t toValue) {
+    const glm::ivec3& size = bricks.getVoxelVolumeSize();
+    for (int z = 0; z < size.z; ++z) {
+        for (int y = 0; y < size.y; ++y) {
+            for (int x = 0; x < size.x; ++x) {
+                glm::ivec3 offset = glm::ivec3(x, y, z) - center;
+                if (offset.x * offset.x + offset.y * offset.y + offset.z * offset.z <= radius * radius) {
+                    bricks.setVoxel({ x, y, z }, toValue);
+                }
+            }
+        }
+    }
+}
+
+}
+
+void PolyVoxBricksTests::voxelDataTest() {
+    PolyVoxBricks bricks;
+    QVERIFY(bricks.fromVoxelData(PolyVoxEntityItem::makeEmptyVoxelData(VOLUME_SIZE.x, VOLUME_SIZE.y, VOLUME_SIZE.z)));
+    QCOMPARE(bricks.getVoxelVolumeSize(), VOLUME_SIZE);
+    QCOMPARE(bricks.getNumBricks(), glm::ivec3(3, 2, 2));
+    QCOMPARE(bricks.getNumStoredBricks(), 0);
+
+    // voxels outside of the volume can't be set
+    QVERIFY(!bricks.setVoxel(VOLUME_SIZE, 1));
+    QVERIFY(!bricks.setVoxel({ -1, 0, 0 }, 1));
+
+    QVERIFY(bricks.setVoxel({ 19, 12, 8 }, 1));
+    QVERIFY(!bricks.setVoxel({ 19, 12, 8 }, 1));
+    setSphere(bricks, { 4, 4, 4 }, 3, 2);
+    QCOMPARE(bricks.getNumStoredBricks(), 2);
+
+    // the dense form is x-major, as it always has been
+    QByteArray voxels = bricks.toDense();
+    QCOMPARE(voxels.size(), VOLUME_SIZE.x * VOLUME_SIZE.y * VOLUME_SIZE.z);
+    QCOMPARE((uint8_t)voxels[(8 * VOLUME_SIZE.y + 12) * VOLUME_SIZE.x + 19], (uint8_t)1);
+    QCOMPARE((uint8_t)voxels[(4 * VOLUME_SIZE.y + 4) * VOLUME_SIZE.x + 7], (uint8_t)2);
+    QCOMPARE((uint8_t)voxels[(4 * VOLUME_SIZE.y + 4) * VOLUME_SIZE.x + 8], (uint8_t)0);
+
+    PolyVoxBricks copy;
+    QVERIFY(copy.fromVoxelData(bricks.toVoxelData()));
+    QCOMPARE(copy.getVoxelVolumeSize(), VOLUME_SIZE);
+    QVERIFY(copy.diff(bricks).empty());
+    QCOMPARE(copy.toDense(), voxels);
+
+    QVERIFY(!copy.fromVoxelData(QByteArray("not voxel data")));
+    QCOMPARE(copy.getNumStoredBricks(), 0);
+}
+
+void PolyVoxBricksTests::deltaTest() {
+    PolyVoxBricks edited(VOLUME_SIZE);
+    setSphere(edited, { 10, 6, 4 }, 5, 1);
+    PolyVoxBricks original = edited;
+
+    // only the bricks that were touched are carried
+    setSphere(edited, { 18, 11, 7 }, 1, 3);
+    edited.setVoxel({ 10, 6, 4 }, 0);
+    std::vector<int> changed = edited.diff(original);
+    std::vector<int> expected { edited.getBrickIndex({ 8, 0, 0 }), edited.getBrickIndex({ 16, 8, 0 }),
+                                edited.getBrickIndex({ 16, 8, 8 }) };
+    std::sort(expected.begin(), expected.end());
+    QCOMPARE(changed, expected);
+
+    QByteArray delta = edited.makeDelta(changed);
+
+    std::vector<int> applied;
+    PolyVoxBricks received = original;
+    QVERIFY(received.applyDelta(delta, &applied));
+    QCOMPARE(applied, changed);
+    QVERIFY(received.diff(edited).empty());
+    QCOMPARE(received.toVoxelData(), edited.toVoxelData());
+
+    // applying the same bricks again changes nothing
+    applied.clear();
+    QVERIFY(received.applyDelta(delta, &applied));
+    QVERIFY(applied.empty());
+
+    // clearing every voxel of a brick drops it
+    PolyVoxBricks cleared = edited;
+    setSphere(cleared, { 18, 11, 7 }, 1, 0);
+    QVERIFY(received.applyDelta(cleared.makeDelta(cleared.diff(edited))));
+    QCOMPARE(received.getNumStoredBricks(), edited.getNumStoredBricks() - 2);
+    QVERIFY(received.diff(cleared).empty());
+}
+
+void PolyVoxBricksTests::rejectedDeltaTest() {
+    PolyVoxBricks bricks(VOLUME_SIZE);
+    setSphere(bricks, { 10, 6, 4 }, 5, 1);
+    QByteArray voxelData = bricks.toVoxelData();
+
+    // a delta for another size of volume
+    PolyVoxBricks other(VOLUME_SIZE + 1);
+    other.setVoxel({ 0, 0, 0 }, 1);
+    QVERIFY(!bricks.applyDelta(other.makeDelta({ 0 })));
+    QCOMPARE(bricks.toVoxelData(), voxelData);
+
+    // a truncated delta
+    PolyVoxBricks edited = bricks;
+    edited.setVoxel({ 0, 0, 0 }, 1);
+    QByteArray delta = edited.makeDelta(edited.diff(bricks));
+    QVERIFY(!bricks.applyDelta(delta.left(delta.size() / 2)));
+    QVERIFY(!bricks.applyDelta(QByteArray()));
+    QCOMPARE(bricks.toVoxelData(), voxelData);
+}
+
+void PolyVoxBricksTests::entityDeltaTest() {
+    PolyVoxBricks bricks(VOLUME_SIZE);
+    setSphere(bricks, { 10, 6, 4 }, 5, 1);
+    auto entity = std::make_shared<PolyVoxEntityItem>(EntityItemID(QUuid::createUuid()));
+    entity->setVoxelData(bricks.toVoxelData());
+
+    // a run of deltas, only compressed into the voxel data when it is asked for
+    PolyVoxBricks edited = bricks;
+    for (int i = 0; i < 3; ++i) {
+        PolyVoxBricks before = edited;
+        edited.setVoxel({ i, 0, 0 }, 2);
+        setSphere(edited, { 18 - i, 11, 7 }, 1, (uint8_t)(3 + i));
+        entity->applyVoxelDelta(edited.makeDelta(edited.diff(before)));
+    }
+    PolyVoxBricks received;
+    QVERIFY(received.fromVoxelData(entity->getVoxelData()));
+    QVERIFY(received.diff(edited).empty());
+    QCOMPARE(entity->getVoxelData(), entity->getVoxelData());
+
+    // a delta that doesn't fit changes nothing
+    PolyVoxBricks other(VOLUME_SIZE + 1);
+    other.setVoxel({ 0, 0, 0 }, 1);
+    entity->applyVoxelDelta(other.makeDelta({ 0 }));
+    QVERIFY(received.fromVoxelData(entity->getVoxelData()));
+    QVERIFY(received.diff(edited).empty());
+
+    // whole voxel data replaces the volume the deltas were applied to
+    entity->setVoxelData(bricks.toVoxelData());
+    QCOMPARE(entity->getVoxelData(), bricks.toVoxelData());
+    PolyVoxBricks edge = bricks;
+    edge.setVoxel({ 19, 12, 8 }, 4);
+    entity->applyVoxelDelta(edge.makeDelta(edge.diff(bricks)));
+    QVERIFY(received.fromVoxelData(entity->getVoxelData()));
+    QVERIFY(received.diff(edge).empty());
+}
@@ -0,0 +1,27 @@
+//
+//  PolyVoxBricksTests.h
+//  tests/octree/src
+//
+//  Created on 2026-10-16.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PolyVoxBricksTests_h
+#define hifi_PolyVoxBricksTests_h
+
+#include <QtTest/QtTest>
+
+class PolyVoxBricksTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void voxelDataTest();
+    void deltaTest();
+    void rejectedDeltaTest();
+    void entityDeltaTest();
+};
+
+#endif // hifi_PolyVoxBricksTests_h
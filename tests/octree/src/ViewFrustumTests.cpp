@@ -11,6 +11,9 @@
 
 #include "ViewFrustumTests.h"
 
+#include <algorithm>
+#include <random>
+
 #include <glm/glm.hpp>
 
 #include <GLMHelpers.h>
@@ -1345,3 +1348,91 @@ void ViewFrustumTests::testBoxIntersectsKeyhole() {
     box.setBox(boxCenter - halfScaleOffset, boxScale);
     QCOMPARE(view.boxIntersectsKeyhole(box), false); // outside back
 }
+
+namespace {
+
+ViewFrustum makeCullingView() {
+    ViewFrustum view;
+    view.setProjection(glm::perspective(PI / 3.0f, 16.0f / 9.0f, 0.1f, 500.0f));
+    view.setPosition(glm::vec3(12.3f, 4.56f, 89.7f));
+    view.setOrientation(glm::angleAxis(PI / 7.0f, glm::normalize(glm::vec3(1.0f, 2.0f, 3.0f))));
+    view.calculate();
+    return view;
+}
+
+// boxes of all sizes scattered around the view, some inside, some outside and many straddling its planes
+std::vector<AABox> makeCullingBoxes(size_t numBoxes) {
+    std::mt19937 generator(7);
+    std::uniform_real_distribution<float> position(-600.0f, 600.0f);
+    std::uniform_real_distribution<float> logSize(-3.0f, 2.5f);
+    std::vector<AABox> boxes;
+    boxes.reserve(numBoxes);
+    for (size_t i = 0; i < numBoxes; ++i) {
+        glm::vec3 scale(powf(10.0f, logSize(generator)), powf(10.0f, logSize(generator)), powf(10.0f, logSize(generator)));
+        boxes.emplace_back(glm::vec3(position(generator), position(generator), position(generator)), scale);
+    }
+    return boxes;
+}
+
+}
+
+void ViewFrustumTests::testBoxesIntersectFrustum() {
+    ViewFrustum view = makeCullingView();
+    std::vector<AABox> boxes = makeCullingBoxes(10007);
+    ViewFrustum::Boxes batch;
+    batch.resize(boxes.size());
+    for (size_t i = 0; i < boxes.size(); ++i) {
+        batch.set(i, boxes[i]);
+    }
+
+    // uneven ranges, to catch anything off at the ends of a batch
+    const std::vector<std::pair<size_t, size_t>> ranges = { { 0, boxes.size() }, { 3, 20 }, { 1001, 1001 }, { 5, 6 } };
+    int numIntersecting = 0;
+    int numInside = 0;
+    for (const auto& range : ranges) {
+        std::vector<uint8_t> intersects(range.second - range.first, 2);
+        std::vector<uint8_t> inside(range.second - range.first, 2);
+        view.boxesIntersectFrustum(batch, range.first, range.second, intersects.data());
+        view.boxesInsideFrustum(batch, range.first, range.second, inside.data());
+        for (size_t i = range.first; i < range.second; ++i) {
+            QCOMPARE(intersects[i - range.first], (uint8_t)view.boxIntersectsFrustum(boxes[i]));
+            QCOMPARE(inside[i - range.first], (uint8_t)view.boxInsideFrustum(boxes[i]));
+            numIntersecting += intersects[i - range.first];
+            numInside += inside[i - range.first];
+        }
+    }
+
+    // make sure the boxes had something to test
+    QVERIFY(numIntersecting > numInside);
+    QVERIFY(numInside > 0);
+}
+
+void ViewFrustumTests::benchmarkBoxesIntersectFrustum_data() {
+    QTest::addColumn<bool>("batched");
+    QTest::newRow("one at a time") << false;
+    QTest::newRow("batched") << true;
+}
+
+void ViewFrustumTests::benchmarkBoxesIntersectFrustum() {
+    QFETCH(bool, batched);
+
+    ViewFrustum view = makeCullingView();
+    std::vector<AABox> boxes = makeCullingBoxes(100000);
+    ViewFrustum::Boxes batch;
+    batch.resize(boxes.size());
+    for (size_t i = 0; i < boxes.size(); ++i) {
+        batch.set(i, boxes[i]);
+    }
+    std::vector<uint8_t> intersects(boxes.size());
+
+    QBENCHMARK {
+        if (batched) {
+            view.boxesIntersectFrustum(batch, 0, boxes.size(), intersects.data());
+        } else {
+            for (size_t i = 0; i < boxes.size(); ++i) {
+                intersects[i] = (uint8_t)view.boxIntersectsFrustum(boxes[i]);
+            }
+        }
+    }
+    QVERIFY(std::count(intersects.begin(), intersects.end(), (uint8_t)1) > 0);
+}
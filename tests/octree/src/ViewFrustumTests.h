@@ -27,6 +27,9 @@ private slots:
     void testSphereIntersectsKeyhole();
     void testCubeIntersectsKeyhole();
     void testBoxIntersectsKeyhole();
+    void testBoxesIntersectFrustum();
+    void benchmarkBoxesIntersectFrustum_data();
+    void benchmarkBoxesIntersectFrustum();
 };
 
 #endif // hifi_ViewFruxtumTests_h
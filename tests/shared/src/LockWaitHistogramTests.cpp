@@ -0,0 +1,82 @@
+//
+//  LockWaitHistogramTests.cpp
+//  tests/shared/src
+//
+//  Created on 2026-10-16.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "LockWaitHistogramTests.h"
+
+#include <shared/LockWaitHistogram.h>
+#include <shared/ReadWriteLockable.h>
+
+QTEST_MAIN(LockWaitHistogramTests)
+
+namespace {
+
+class Lockable : public ReadWriteLockable {
+public:
+    Lockable() { setLockWaitHistograms(&histograms); }
+
+    LockWaitHistograms histograms;
+};
+
+}
+
+void LockWaitHistogramTests::bucketTest() {
+    QCOMPARE(LockWaitHistogram::getBucket(0), 0);
+    QCOMPARE(LockWaitHistogram::getBucket(1), 1);
+    QCOMPARE(LockWaitHistogram::getBucket(2), 2);
+    QCOMPARE(LockWaitHistogram::getBucket(3), 2);
+    QCOMPARE(LockWaitHistogram::getBucket(4), 3);
+    QCOMPARE(LockWaitHistogram::getBucket(1000), 10);
+    QCOMPARE(LockWaitHistogram::getBucket(UINT64_MAX), LockWaitHistogram::NUM_BUCKETS - 1);
+
+    // every wait is less than the limit of its bucket
+    for (uint64_t wait : { 0, 1, 7, 8, 999, 65536 }) {
+        QVERIFY(wait < LockWaitHistogram::getBucketLimit(LockWaitHistogram::getBucket(wait)));
+    }
+}
+
+void LockWaitHistogramTests::percentileTest() {
+    LockWaitHistogram histogram;
+    QCOMPARE(LockWaitHistogram::getPercentileLimit(histogram.getCounts(), 0.5), (uint64_t)0);
+
+    for (int i = 0; i < 90; ++i) {
+        histogram.record(0);
+    }
+    for (int i = 0; i < 9; ++i) {
+        histogram.record(100);
+    }
+    histogram.record(5000);
+    QCOMPARE(histogram.getTotalCount(), (uint64_t)100);
+    QCOMPARE(histogram.getTotalWaitUsecs(), (uint64_t)5900);
+
+    auto counts = histogram.getCounts();
+    QCOMPARE(LockWaitHistogram::getPercentileLimit(counts, 0.5), (uint64_t)1);
+    QCOMPARE(LockWaitHistogram::getPercentileLimit(counts, 0.9), (uint64_t)1);
+    QCOMPARE(LockWaitHistogram::getPercentileLimit(counts, 0.99), (uint64_t)128);
+    QCOMPARE(LockWaitHistogram::getPercentileLimit(counts, 1.0), (uint64_t)8192);
+    QCOMPARE(histogram.toString(), QString("n: 100, avg: 59 usecs, 50%: < 1, 90%: < 1, 99%: < 128, max: < 8192"));
+
+    histogram.reset();
+    QCOMPARE(histogram.getTotalCount(), (uint64_t)0);
+    QCOMPARE(histogram.getTotalWaitUsecs(), (uint64_t)0);
+}
+
+void LockWaitHistogramTests::readWriteLockableTest() {
+    Lockable lockable;
+    lockable.withReadLock([] {});
+    lockable.withReadLock([] {});
+    lockable.withWriteLock([] {});
+    QCOMPARE(lockable.histograms.read.getTotalCount(), (uint64_t)2);
+    QCOMPARE(lockable.histograms.write.getTotalCount(), (uint64_t)1);
+
+    // a lock that's only tried isn't waited for
+    QVERIFY(lockable.withTryReadLock([] {}));
+    QCOMPARE(lockable.histograms.read.getTotalCount(), (uint64_t)2);
+}
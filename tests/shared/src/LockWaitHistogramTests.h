@@ -0,0 +1,25 @@
+//
+//  LockWaitHistogramTests.h
+//  tests/shared/src
+//
+//  Created on 2026-10-16.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_LockWaitHistogramTests_h
+#define hifi_LockWaitHistogramTests_h
+
+#include <QtTest/QtTest>
+
+class LockWaitHistogramTests : public QObject {
+    Q_OBJECT
+private slots:
+    void bucketTest();
+    void percentileTest();
+    void readWriteLockableTest();
+};
+
+#endif // hifi_LockWaitHistogramTests_h
@@ -11,6 +11,14 @@
 #include <QtTest/QtTest>
 #include <QtGui/QDesktopServices>
 
+#include <thread>
+
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QTemporaryDir>
+
+#include <Gzip.h>
 #include <Profile.h>
 
 #include <NumericalConstants.h>
@@ -45,3 +53,61 @@ void TraceTests::testTraceSerialization() {
     qDebug() << "Done";
 }
 
+
+void TraceTests::testBinaryTraceSerialization() {
+    const int EVENTS_PER_THREAD = 64;
+    const int NUM_RANGES = 1000;
+
+    auto tracer = DependencyManager::set<tracing::Tracer>();
+    tracer->startBinaryTracing(EVENTS_PER_THREAD);
+    QVERIFY(tracer->isBinary());
+    {
+        auto start = usecTimestampNow();
+        auto record = [&] {
+            for (int i = 0; i < NUM_RANGES; ++i) {
+                PROFILE_RANGE(test, "BinaryEvent")
+            }
+            PROFILE_COUNTER(test, "BinaryCounter", { { "value", 42 } })
+        };
+        std::thread other(record);
+        record();
+        other.join();
+        auto duration = usecTimestampNow() - start;
+        qDebug() << "Binary recording took " << duration << "usecs";
+    }
+    tracer->stopTracing();
+
+    QTemporaryDir dir;
+    QString filename = dir.filePath("binaryTrace.json.gz");
+    tracer->serialize(filename);
+
+    auto readEvents = [&] {
+        QFile file(filename);
+        QByteArray data;
+        if (file.open(QIODevice::ReadOnly)) {
+            gunzip(file.readAll(), data);
+        }
+        return QJsonDocument::fromJson(data).array();
+    };
+    auto events = readEvents();
+
+    // each thread only keeps its latest events, ending with the counter
+    QCOMPARE(events.size(), 2 * EVENTS_PER_THREAD);
+    int numCounters = 0;
+    for (const auto& value : events) {
+        auto event = value.toObject();
+        QCOMPARE(event["cat"].toString(), QString("trace.test"));
+        if (event["ph"].toString() == "C") {
+            QCOMPARE(event["name"].toString(), QString("BinaryCounter"));
+            QCOMPARE(event["args"].toObject()["value"].toDouble(), 42.0);
+            ++numCounters;
+        } else {
+            QCOMPARE(event["name"].toString(), QString("BinaryEvent"));
+        }
+    }
+    QCOMPARE(numCounters, 2);
+
+    // the events were taken out of the rings by the first serialize
+    tracer->serialize(filename);
+    QCOMPARE(readEvents().size(), 0);
+}
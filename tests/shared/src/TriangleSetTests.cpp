@@ -0,0 +1,276 @@
+//
+//  TriangleSetTests.cpp
+//  tests/shared/src
+//
+//  Created on 2026-10-16.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TriangleSetTests.h"
+
+#include <random>
+
+#include <GLMHelpers.h>
+#include <NumericalConstants.h>
+#include <TriangleSet.h>
+
+QTEST_MAIN(TriangleSetTests)
+
+namespace {
+
+enum class Mesh { Sphere, Terrain };
+
+// a UV sphere of radius 1, wound to face out
+std::vector<Triangle> makeSphere(int numRings) {
+    int numSegments = 2 * numRings;
+    auto vertex = [&](int ring, int segment) {
+        float theta = PI * ring / numRings;
+        float phi = TWO_PI * segment / numSegments;
+        return glm::vec3(sinf(theta) * cosf(phi), cosf(theta), sinf(theta) * sinf(phi));
+    };
+
+    std::vector<Triangle> triangles;
+    for (int ring = 0; ring < numRings; ring++) {
+        for (int segment = 0; segment < numSegments; segment++) {
+            glm::vec3 v00 = vertex(ring, segment);
+            glm::vec3 v01 = vertex(ring, segment + 1);
+            glm::vec3 v10 = vertex(ring + 1, segment);
+            glm::vec3 v11 = vertex(ring + 1, segment + 1);
+            if (ring > 0) {
+                triangles.push_back({ v00, v01, v10 });
+            }
+            if (ring < numRings - 1) {
+                triangles.push_back({ v01, v11, v10 });
+            }
+        }
+    }
+    return triangles;
+}
+
+// a bumpy 2x2 height field centered on the origin, wound to face up
+std::vector<Triangle> makeTerrain(int numCells) {
+    auto vertex = [&](int x, int z) {
+        float u = 2.0f * x / numCells - 1.0f;
+        float v = 2.0f * z / numCells - 1.0f;
+        return glm::vec3(u, 0.1f * sinf(7.0f * u) * cosf(5.0f * v) + 0.05f * sinf(23.0f * u * v), v);
+    };
+
+    std::vector<Triangle> triangles;
+    for (int x = 0; x < numCells; x++) {
+        for (int z = 0; z < numCells; z++) {
+            triangles.push_back({ vertex(x, z), vertex(x, z + 1), vertex(x + 1, z) });
+            triangles.push_back({ vertex(x + 1, z), vertex(x, z + 1), vertex(x + 1, z + 1) });
+        }
+    }
+    return triangles;
+}
+
+// about numTriangles triangles of the given kind of mesh
+std::vector<Triangle> makeMesh(Mesh mesh, int numTriangles) {
+    if (mesh == Mesh::Sphere) {
+        return makeSphere(std::max((int)sqrtf(numTriangles / 4.0f), 2));
+    } else {
+        return makeTerrain(std::max((int)sqrtf(numTriangles / 2.0f), 1));
+    }
+}
+
+void insert(TriangleSet& set, const std::vector<Triangle>& triangles) {
+    set.reserve(triangles.size());
+    for (const auto& triangle : triangles) {
+        set.insert(triangle);
+    }
+}
+
+struct Ray {
+    glm::vec3 origin;
+    glm::vec3 direction;
+    glm::vec3 invDirection;
+};
+
+// rays from above and below the meshes toward random points around them, and some from inside them
+std::vector<Ray> makeRays(int numRays) {
+    std::mt19937 random(42);
+    std::uniform_real_distribution<float> distribution(-1.2f, 1.2f);
+    std::vector<Ray> rays;
+    for (int i = 0; i < numRays; i++) {
+        glm::vec3 target(distribution(random), distribution(random), distribution(random));
+        glm::vec3 origin = 4.0f * glm::vec3(distribution(random), (i % 2 == 0) ? 1.0f : -1.0f, distribution(random));
+        if (i % 8 == 0) {
+            origin = 0.1f * target;
+            target = -target;
+        }
+        glm::vec3 direction = glm::normalize(target - origin);
+        rays.push_back({ origin, direction, 1.0f / direction });
+    }
+    return rays;
+}
+
+bool findBruteForceRayIntersection(const std::vector<Triangle>& triangles, const Ray& ray, bool allowBackface,
+                                   float& distance) {
+    bool hit = false;
+    distance = FLT_MAX;
+    for (const auto& triangle : triangles) {
+        float triangleDistance;
+        if (findRayTriangleIntersection(ray.origin, ray.direction, triangle, triangleDistance, allowBackface) &&
+            triangleDistance < distance) {
+            distance = triangleDistance;
+            hit = true;
+        }
+    }
+    return hit;
+}
+
+}
+
+void TriangleSetTests::testRayIntersection_data() {
+    QTest::addColumn<int>("mesh");
+    QTest::addColumn<int>("numTriangles");
+    QTest::addColumn<bool>("allowBackface");
+    QTest::newRow("small sphere") << (int)Mesh::Sphere << 20 << false;
+    QTest::newRow("sphere") << (int)Mesh::Sphere << 5000 << false;
+    QTest::newRow("sphere with backfaces") << (int)Mesh::Sphere << 5000 << true;
+    QTest::newRow("terrain") << (int)Mesh::Terrain << 5000 << false;
+    QTest::newRow("terrain with backfaces") << (int)Mesh::Terrain << 5000 << true;
+}
+
+void TriangleSetTests::testRayIntersection() {
+    QFETCH(int, mesh);
+    QFETCH(int, numTriangles);
+    QFETCH(bool, allowBackface);
+
+    auto triangles = makeMesh((Mesh)mesh, numTriangles);
+    TriangleSet set;
+    insert(set, triangles);
+
+    int numHits = 0;
+    for (const auto& ray : makeRays(1000)) {
+        float expectedDistance;
+        bool expectedHit = findBruteForceRayIntersection(triangles, ray, allowBackface, expectedDistance);
+
+        float distance = FLT_MAX;
+        BoxFace face;
+        Triangle triangle;
+        bool hit = set.findRayIntersection(ray.origin, ray.direction, ray.invDirection, distance, face, triangle, true,
+                                           allowBackface);
+        QCOMPARE(hit, expectedHit);
+        if (hit) {
+            QVERIFY(fabsf(distance - expectedDistance) < EPSILON);
+
+            // the triangle is the one that was hit
+            float triangleDistance;
+            QVERIFY(findRayTriangleIntersection(ray.origin, ray.direction, triangle, triangleDistance, allowBackface));
+            QVERIFY(fabsf(triangleDistance - distance) < EPSILON);
+            numHits++;
+        }
+    }
+    QVERIFY(numHits > 0);
+}
+
+void TriangleSetTests::testParabolaIntersection() {
+    auto triangles = makeMesh(Mesh::Terrain, 2000);
+    TriangleSet set;
+    insert(set, triangles);
+
+    std::mt19937 random(7);
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    const glm::vec3 ACCELERATION(0.0f, -9.8f, 0.0f);
+    int numHits = 0;
+    for (int i = 0; i < 200; i++) {
+        glm::vec3 origin(distribution(random), 1.0f, distribution(random));
+        glm::vec3 velocity(distribution(random), 2.0f * distribution(random), distribution(random));
+
+        bool expectedHit = false;
+        float expectedDistance = FLT_MAX;
+        for (const auto& triangle : triangles) {
+            float triangleDistance;
+            if (findParabolaTriangleIntersection(origin, velocity, ACCELERATION, triangle, triangleDistance) &&
+                triangleDistance < expectedDistance) {
+                expectedDistance = triangleDistance;
+                expectedHit = true;
+            }
+        }
+
+        float distance = FLT_MAX;
+        BoxFace face;
+        Triangle triangle;
+        bool hit = set.findParabolaIntersection(origin, velocity, ACCELERATION, distance, face, triangle, true);
+        QCOMPARE(hit, expectedHit);
+        if (hit) {
+            QVERIFY(fabsf(distance - expectedDistance) < EPSILON);
+            numHits++;
+        }
+    }
+    QVERIFY(numHits > 0);
+}
+
+void TriangleSetTests::testEmpty() {
+    TriangleSet set;
+    glm::vec3 direction(0.0f, -1.0f, 0.0f);
+    float distance = FLT_MAX;
+    BoxFace face;
+    Triangle triangle;
+    QVERIFY(!set.findRayIntersection(Vectors::UP, direction, 1.0f / direction, distance, face, triangle, true));
+
+    // the hierarchy is rebuilt after the set changes
+    insert(set, makeMesh(Mesh::Terrain, 200));
+    QVERIFY(set.findRayIntersection(Vectors::UP, direction, 1.0f / direction, distance, face, triangle, true));
+    set.clear();
+    QVERIFY(!set.findRayIntersection(Vectors::UP, direction, 1.0f / direction, distance, face, triangle, true));
+}
+
+void TriangleSetTests::benchmarkBalanceTree_data() {
+    QTest::addColumn<int>("mesh");
+    QTest::addColumn<int>("numTriangles");
+    QTest::newRow("sphere 100k") << (int)Mesh::Sphere << 100000;
+    QTest::newRow("terrain 100k") << (int)Mesh::Terrain << 100000;
+}
+
+void TriangleSetTests::benchmarkBalanceTree() {
+    QFETCH(int, mesh);
+    QFETCH(int, numTriangles);
+
+    auto triangles = makeMesh((Mesh)mesh, numTriangles);
+    TriangleSet set;
+    insert(set, triangles);
+
+    QBENCHMARK {
+        set.balanceTree();
+    }
+}
+
+void TriangleSetTests::benchmarkRayIntersection_data() {
+    QTest::addColumn<int>("mesh");
+    QTest::addColumn<int>("numTriangles");
+    QTest::newRow("sphere 1k") << (int)Mesh::Sphere << 1000;
+    QTest::newRow("sphere 100k") << (int)Mesh::Sphere << 100000;
+    QTest::newRow("terrain 1k") << (int)Mesh::Terrain << 1000;
+    QTest::newRow("terrain 100k") << (int)Mesh::Terrain << 100000;
+}
+
+// 1000 precise ray picks, as done each frame by the picks of hand controllers and mouse against high poly models
+void TriangleSetTests::benchmarkRayIntersection() {
+    QFETCH(int, mesh);
+    QFETCH(int, numTriangles);
+
+    auto triangles = makeMesh((Mesh)mesh, numTriangles);
+    TriangleSet set;
+    insert(set, triangles);
+    set.balanceTree();
+    auto rays = makeRays(1000);
+
+    int numHits = 0;
+    QBENCHMARK {
+        for (const auto& ray : rays) {
+            float distance = FLT_MAX;
+            BoxFace face;
+            Triangle triangle;
+            if (set.findRayIntersection(ray.origin, ray.direction, ray.invDirection, distance, face, triangle, true)) {
+                numHits++;
+            }
+        }
+    }
+    QVERIFY(numHits > 0);
+}
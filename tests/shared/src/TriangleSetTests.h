@@ -0,0 +1,30 @@
+//
+//  TriangleSetTests.h
+//  tests/shared/src
+//
+//  Created on 2026-10-16.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_TriangleSetTests_h
+#define hifi_TriangleSetTests_h
+
+#include <QtTest/QtTest>
+
+class TriangleSetTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testRayIntersection_data();
+    void testRayIntersection();
+    void testParabolaIntersection();
+    void testEmpty();
+    void benchmarkBalanceTree_data();
+    void benchmarkBalanceTree();
+    void benchmarkRayIntersection_data();
+    void benchmarkRayIntersection();
+};
+
+#endif // hifi_TriangleSetTests_h
@@ -13,11 +13,19 @@
 
 #include <QObject>
 #include <QImageReader>
+#include <QtCore/QBuffer>
 #include <QtCore/QDebug>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFileInfo>
 #include <QFile>
 
+#include <algorithm>
+#include <atomic>
+#include <iostream>
 #include <unordered_map>
 
+#include <NumericalConstants.h>
+
 #include "OvenCLIApplication.h"
 #include "ModelBakingLoggingCategory.h"
 #include "baking/BakerLibrary.h"
@@ -25,6 +33,34 @@
 #include "TextureBaker.h"
 #include "MaterialBaker.h"
 
+static bool getTextureUsageType(const QString& name, image::TextureUsage::Type& type) {
+    static const std::unordered_map<QString, image::TextureUsage::Type> STRING_TO_TEXTURE_USAGE_TYPE_MAP {
+        { "default", image::TextureUsage::DEFAULT_TEXTURE },
+        { "strict", image::TextureUsage::STRICT_TEXTURE },
+        { "albedo", image::TextureUsage::ALBEDO_TEXTURE },
+        { "normal", image::TextureUsage::NORMAL_TEXTURE },
+        { "bump", image::TextureUsage::BUMP_TEXTURE },
+        { "specular", image::TextureUsage::SPECULAR_TEXTURE },
+        { "metallic", image::TextureUsage::METALLIC_TEXTURE },
+        { "roughness", image::TextureUsage::ROUGHNESS_TEXTURE },
+        { "gloss", image::TextureUsage::GLOSS_TEXTURE },
+        { "emissive", image::TextureUsage::EMISSIVE_TEXTURE },
+        { "cube", image::TextureUsage::SKY_TEXTURE },
+        { "skybox", image::TextureUsage::SKY_TEXTURE },
+        { "ambient", image::TextureUsage::AMBIENT_TEXTURE },
+        { "occlusion", image::TextureUsage::OCCLUSION_TEXTURE },
+        { "scattering", image::TextureUsage::SCATTERING_TEXTURE },
+        { "lightmap", image::TextureUsage::LIGHTMAP_TEXTURE },
+    };
+
+    auto it = STRING_TO_TEXTURE_USAGE_TYPE_MAP.find(name);
+    if (it == STRING_TO_TEXTURE_USAGE_TYPE_MAP.end()) {
+        return false;
+    }
+    type = it->second;
+    return true;
+}
+
 BakerCLI::BakerCLI(OvenCLIApplication* parent) : QObject(parent) {
     
 }
@@ -69,31 +105,13 @@ void BakerCLI::bakeFile(QUrl inputUrl, const QString& outputPath, const QString&
         auto extension = idx >= 0 ? url.mid(idx + 1).toLower() : "";
 
         if (QImageReader::supportedImageFormats().contains(extension.toLatin1())) {
-            static const std::unordered_map<QString, image::TextureUsage::Type> STRING_TO_TEXTURE_USAGE_TYPE_MAP {
-                { "default", image::TextureUsage::DEFAULT_TEXTURE },
-                { "strict", image::TextureUsage::STRICT_TEXTURE },
-                { "albedo", image::TextureUsage::ALBEDO_TEXTURE },
-                { "normal", image::TextureUsage::NORMAL_TEXTURE },
-                { "bump", image::TextureUsage::BUMP_TEXTURE },
-                { "specular", image::TextureUsage::SPECULAR_TEXTURE },
-                { "metallic", image::TextureUsage::METALLIC_TEXTURE },
-                { "roughness", image::TextureUsage::ROUGHNESS_TEXTURE },
-                { "gloss", image::TextureUsage::GLOSS_TEXTURE },
-                { "emissive", image::TextureUsage::EMISSIVE_TEXTURE },
-                { "cube", image::TextureUsage::SKY_TEXTURE },
-                { "skybox", image::TextureUsage::SKY_TEXTURE },
-                { "ambient", image::TextureUsage::AMBIENT_TEXTURE },
-                { "occlusion", image::TextureUsage::OCCLUSION_TEXTURE },
-                { "scattering", image::TextureUsage::SCATTERING_TEXTURE },
-                { "lightmap", image::TextureUsage::LIGHTMAP_TEXTURE },
-            };
-
-            auto it = STRING_TO_TEXTURE_USAGE_TYPE_MAP.find(type);
-            if (it == STRING_TO_TEXTURE_USAGE_TYPE_MAP.end()) {
+            image::TextureUsage::Type textureType;
+            if (!getTextureUsageType(type, textureType)) {
                 qCDebug(model_baking) << "Unknown texture usage type:" << type;
                 QCoreApplication::exit(OVEN_STATUS_CODE_FAIL);
+                return;
             }
-            _baker = std::unique_ptr<Baker> { new TextureBaker(inputUrl, it->second, outputPath) };
+            _baker = std::unique_ptr<Baker> { new TextureBaker(inputUrl, textureType, outputPath) };
             _baker->moveToThread(Oven::instance().getNextWorkerThread());
         }
     }
@@ -111,6 +129,78 @@ void BakerCLI::bakeFile(QUrl inputUrl, const QString& outputPath, const QString&
     connect(_baker.get(), &Baker::finished, this, &BakerCLI::handleFinishedBaker);
 }
 
+void BakerCLI::benchmarkTextures(QUrl inputUrl, const QString& type, int numPasses) {
+    image::TextureUsage::Type textureType = image::TextureUsage::DEFAULT_TEXTURE;
+    if (!type.isEmpty() && !getTextureUsageType(type, textureType)) {
+        qCDebug(model_baking) << "Unknown texture usage type:" << type;
+        QCoreApplication::exit(OVEN_STATUS_CODE_FAIL);
+        return;
+    }
+
+    // read every texture up front, so that only processing them is timed
+    QString inputPath = inputUrl.isLocalFile() ? inputUrl.toLocalFile() : inputUrl.toString();
+    QStringList filePaths;
+    if (QFileInfo(inputPath).isDir()) {
+        QDir inputDir(inputPath);
+        for (const auto& fileName : inputDir.entryList(QDir::Files, QDir::Name)) {
+            auto extension = QFileInfo(fileName).suffix().toLower().toLatin1();
+            if (QImageReader::supportedImageFormats().contains(extension)) {
+                filePaths << inputDir.absoluteFilePath(fileName);
+            }
+        }
+    } else {
+        filePaths << inputPath;
+    }
+
+    std::vector<std::pair<std::string, QByteArray>> textures;
+    for (const auto& filePath : filePaths) {
+        QFile file(filePath);
+        if (!file.open(QIODevice::ReadOnly)) {
+            qCDebug(model_baking) << "Could not read texture" << filePath;
+            QCoreApplication::exit(OVEN_STATUS_CODE_FAIL);
+            return;
+        }
+        textures.emplace_back(filePath.toStdString(), file.readAll());
+    }
+    if (textures.empty()) {
+        qCDebug(model_baking) << "No textures to benchmark in" << inputPath;
+        QCoreApplication::exit(OVEN_STATUS_CODE_FAIL);
+        return;
+    }
+
+    bool compress = TextureBaker::isCompressionEnabled();
+    std::atomic<bool> abortProcessing { false };
+    int numTextures = 0;
+    qint64 numPixels = 0;
+    QElapsedTimer timer;
+    timer.start();
+    for (int pass = 0; pass < numPasses; ++pass) {
+        for (const auto& texture : textures) {
+            auto buffer = std::make_shared<QBuffer>();
+            buffer->setData(texture.second);
+            buffer->open(QIODevice::ReadOnly);
+            auto processedTextureAndSize = image::processImage(buffer, texture.first, image::ColorChannel::NONE,
+                                                               ABSOLUTE_MAX_TEXTURE_NUM_PIXELS, textureType, compress,
+                                                               gpu::BackendTarget::GL45, abortProcessing);
+            if (!processedTextureAndSize.first) {
+                qCDebug(model_baking) << "Could not process texture" << QString::fromStdString(texture.first);
+                QCoreApplication::exit(OVEN_STATUS_CODE_FAIL);
+                return;
+            }
+            ++numTextures;
+            numPixels += (qint64)processedTextureAndSize.first->getWidth() * processedTextureAndSize.first->getHeight();
+        }
+    }
+    double seconds = std::max(timer.nsecsElapsed() / (double)NSECS_PER_SECOND, 1.0e-9);
+
+    // Avoid Qt log spam
+    std::cout << "Processed " << numTextures << " textures (" << numPixels / 1.0e6 << " megapixels) in " << seconds
+        << " s using " << image::getTextureCompressionConcurrency() << " compression threads" << std::endl;
+    std::cout << numTextures / seconds << " textures/s, " << numPixels / 1.0e6 / seconds << " megapixels/s" << std::endl;
+
+    QCoreApplication::exit(OVEN_STATUS_CODE_SUCCESS);
+}
+
 void BakerCLI::handleFinishedBaker() {
     qCDebug(model_baking) << "Finished baking file.";
     int exitCode = OVEN_STATUS_CODE_SUCCESS;
@@ -35,6 +35,9 @@ public:
 
 public slots:
     void bakeFile(QUrl inputUrl, const QString& outputPath, const QString& type = QString());
+    // processes the texture, or every texture in the folder, at inputUrl the given number of times and reports the
+    // throughput, without writing anything out
+    void benchmarkTextures(QUrl inputUrl, const QString& type, int numPasses);
 
 private slots:
     void handleFinishedBaker();  
@@ -25,17 +25,25 @@ static const QString CLI_INPUT_PARAMETER = "i";
 static const QString CLI_OUTPUT_PARAMETER = "o";
 static const QString CLI_TYPE_PARAMETER = "t";
 static const QString CLI_DISABLE_TEXTURE_COMPRESSION_PARAMETER = "disable-texture-compression";
+static const QString CLI_TEXTURE_COMPRESSION_THREADS_PARAMETER = "texture-compression-threads";
+static const QString CLI_BENCHMARK_TEXTURES_PARAMETER = "benchmark-textures";
 
 QUrl OvenCLIApplication::_inputUrlParameter;
 QUrl OvenCLIApplication::_outputUrlParameter;
 QString OvenCLIApplication::_typeParameter;
+int OvenCLIApplication::_benchmarkPassesParameter { 0 };
 
 OvenCLIApplication::OvenCLIApplication(int argc, char* argv[]) :
     QCoreApplication(argc, argv)
 {
     BakerCLI* cli = new BakerCLI(this);
-    QMetaObject::invokeMethod(cli, "bakeFile", Qt::QueuedConnection, Q_ARG(QUrl, _inputUrlParameter),
-                              Q_ARG(QString, _outputUrlParameter.toString()), Q_ARG(QString, _typeParameter));
+    if (_benchmarkPassesParameter > 0) {
+        QMetaObject::invokeMethod(cli, "benchmarkTextures", Qt::QueuedConnection, Q_ARG(QUrl, _inputUrlParameter),
+                                  Q_ARG(QString, _typeParameter), Q_ARG(int, _benchmarkPassesParameter));
+    } else {
+        QMetaObject::invokeMethod(cli, "bakeFile", Qt::QueuedConnection, Q_ARG(QUrl, _inputUrlParameter),
+                                  Q_ARG(QString, _outputUrlParameter.toString()), Q_ARG(QString, _typeParameter));
+    }
 }
 
 void OvenCLIApplication::parseCommandLine(int argc, char* argv[]) {
@@ -47,7 +55,11 @@ void OvenCLIApplication::parseCommandLine(int argc, char* argv[]) {
         { CLI_INPUT_PARAMETER, "Path to file that you would like to bake.", "input" },
         { CLI_OUTPUT_PARAMETER, "Path to folder that will be used as output.", "output" },
         { CLI_TYPE_PARAMETER, "Type of asset. [model|material]"/*|js]"*/, "type" },
-        { CLI_DISABLE_TEXTURE_COMPRESSION_PARAMETER, "Disable texture compression." }
+        { CLI_DISABLE_TEXTURE_COMPRESSION_PARAMETER, "Disable texture compression." },
+        { CLI_TEXTURE_COMPRESSION_THREADS_PARAMETER, "Number of threads compressing each texture. [default: all cores]",
+            "threads" },
+        { CLI_BENCHMARK_TEXTURES_PARAMETER, "Process the input texture, or every texture in the input folder, this many "
+            "times without writing anything and report how many textures were processed per second.", "passes" }
     });
 
     auto versionOption = parser.addVersionOption();
@@ -75,7 +87,15 @@ void OvenCLIApplication::parseCommandLine(int argc, char* argv[]) {
         Q_UNREACHABLE();
     }
 
-    if (!parser.isSet(CLI_INPUT_PARAMETER) || !parser.isSet(CLI_OUTPUT_PARAMETER)) {
+    if (parser.isSet(CLI_BENCHMARK_TEXTURES_PARAMETER)) {
+        _benchmarkPassesParameter = parser.value(CLI_BENCHMARK_TEXTURES_PARAMETER).toInt();
+        if (_benchmarkPassesParameter <= 0 || !parser.isSet(CLI_INPUT_PARAMETER)) {
+            std::cout << "Error: Benchmark needs an input and a number of passes" << std::endl; // Avoid Qt log spam
+            QCoreApplication mockApp(argc, argv); // required for call to showHelp()
+            parser.showHelp();
+            Q_UNREACHABLE();
+        }
+    } else if (!parser.isSet(CLI_INPUT_PARAMETER) || !parser.isSet(CLI_OUTPUT_PARAMETER)) {
         std::cout << "Error: Input and Output not set" << std::endl; // Avoid Qt log spam
         QCoreApplication mockApp(argc, argv); // required for call to showHelp()
         parser.showHelp();
@@ -91,4 +111,8 @@ void OvenCLIApplication::parseCommandLine(int argc, char* argv[]) {
         qDebug() << "Disabling texture compression";
         TextureBaker::setCompressionEnabled(false);
     }
+
+    if (parser.isSet(CLI_TEXTURE_COMPRESSION_THREADS_PARAMETER)) {
+        image::setTextureCompressionConcurrency(parser.value(CLI_TEXTURE_COMPRESSION_THREADS_PARAMETER).toInt());
+    }
 }
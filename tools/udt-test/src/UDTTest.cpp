@@ -13,6 +13,8 @@
 
 #include "UDTTest.h"
 
+#include <ctime>
+
 #include <QtCore/QDebug>
 
 #include <udt/Constants.h>
@@ -57,6 +59,9 @@ const QCommandLineOption MESSAGE_SEED {
 const QCommandLineOption STATS_INTERVAL {
     "stats-interval", "stats output interval (default is 100ms)", "milliseconds"
 };
+const QCommandLineOption BATCHED_RECEIVE {
+    "batched-receive", "receive with recvmmsg batches, on Linux (default is on)", "on|off"
+};
 
 const QStringList CLIENT_STATS_TABLE_HEADERS {
     "Send (Mb/s)", "Est. Max (Mb/s)", "RTT (ms)", "CW (P)", "Period (us)",
@@ -65,7 +70,7 @@ const QStringList CLIENT_STATS_TABLE_HEADERS {
 
 const QStringList SERVER_STATS_TABLE_HEADERS {
     "  Mb/s  ", "Recv Mb/s", "Est. Max (Mb/s)", "RTT (ms)", "CW (P)",
-    "Sent ACK", "Duplicates (P)"
+    "Sent ACK", "Duplicates (P)", "Recv (P/s)", "P/s per core"
 };
 
 UDTTest::UDTTest(int& argc, char** argv) :
@@ -76,8 +81,13 @@ UDTTest::UDTTest(int& argc, char** argv) :
     // randomize the seed for packet size randomization
     srand(time(NULL));
 
-    _socket.bind(QHostAddress::AnyIPv4, _argumentParser.value(PORT_OPTION).toUInt());
-    qDebug() << "Test socket is listening on" << _socket.localPort();
+    _socket.bind(SocketType::UDP, QHostAddress::AnyIPv4, _argumentParser.value(PORT_OPTION).toUInt());
+    qDebug() << "Test socket is listening on" << _socket.localPort(SocketType::UDP);
+
+    if (_argumentParser.isSet(BATCHED_RECEIVE)) {
+        _socket.setBatchedReceiveEnabled(_argumentParser.value(BATCHED_RECEIVE) != "off");
+    }
+    qDebug() << "Batched receive is" << (_socket.isBatchedReceiveEnabled() ? "on" : "off");
     
     if (_argumentParser.isSet(TARGET_OPTION)) {
         // parse the IP and port combination for this target
@@ -92,7 +102,7 @@ UDTTest::UDTTest(int& argc, char** argv) :
             
             QMetaObject::invokeMethod(this, "quit", Qt::QueuedConnection);
         } else {
-            _target = SockAddr(address, port);
+            _target = SockAddr(SocketType::UDP, address, port);
             qDebug() << "Packets will be sent to" << _target;
         }
     }
@@ -226,7 +236,7 @@ void UDTTest::parseArguments() {
     _argumentParser.addOptions({
         PORT_OPTION, TARGET_OPTION, PACKET_SIZE, MIN_PACKET_SIZE, MAX_PACKET_SIZE,
         MAX_SEND_BYTES, MAX_SEND_PACKETS, UNRELIABLE_PACKETS, ORDERED_PACKETS,
-        MESSAGE_SIZE, MESSAGE_SEED, STATS_INTERVAL
+        MESSAGE_SIZE, MESSAGE_SEED, STATS_INTERVAL, BATCHED_RECEIVE
     });
     
     if (!_argumentParser.parse(arguments())) {
@@ -407,6 +417,21 @@ void UDTTest::sampleStats() {
             int headerIndex = -1;
             
             double megabitsPerSecond = (stats.receivedBytes * MEGABITS_PER_BYTE * MS_PER_SECOND) / _statsInterval;
+
+            // packets per second per core is the number of packets received for each second of process CPU time,
+            // which is what bounds how many packets a single mixer thread can ingest
+            uint64_t receivedPackets = stats.receivedPackets + stats.receivedUnreliablePackets;
+            for (size_t i = 1; i < sockets.size(); ++i) {
+                auto otherStats = _socket.sampleStatsForConnection(sockets[i]);
+                receivedPackets += otherStats.receivedPackets + otherStats.receivedUnreliablePackets;
+            }
+
+            std::clock_t cpuTime = std::clock();
+            double cpuSeconds = (double)(cpuTime - _lastSampleCPUTime) / CLOCKS_PER_SEC;
+            _lastSampleCPUTime = cpuTime;
+
+            double packetsPerSecond = (receivedPackets * MS_PER_SECOND) / _statsInterval;
+            double packetsPerCoreSecond = cpuSeconds > 0.0 ? receivedPackets / cpuSeconds : 0.0;
             
             // setup a list of left justified values
             QStringList values {
@@ -416,7 +441,9 @@ void UDTTest::sampleStats() {
                 QString::number(stats.rtt / USECS_PER_MSEC, 'f', 2).rightJustified(SERVER_STATS_TABLE_HEADERS[++headerIndex].size()),
                 QString::number(stats.congestionWindowSize).rightJustified(SERVER_STATS_TABLE_HEADERS[++headerIndex].size()),
                 QString::number(stats.events[udt::ConnectionStats::Stats::SentACK]).rightJustified(SERVER_STATS_TABLE_HEADERS[++headerIndex].size()),
-                QString::number(stats.events[udt::ConnectionStats::Stats::Duplicate]).rightJustified(SERVER_STATS_TABLE_HEADERS[++headerIndex].size())
+                QString::number(stats.duplicatePackets).rightJustified(SERVER_STATS_TABLE_HEADERS[++headerIndex].size()),
+                QString::number(packetsPerSecond, 'f', 0).rightJustified(SERVER_STATS_TABLE_HEADERS[++headerIndex].size()),
+                QString::number(packetsPerCoreSecond, 'f', 0).rightJustified(SERVER_STATS_TABLE_HEADERS[++headerIndex].size())
             };
             
             // output this line of values
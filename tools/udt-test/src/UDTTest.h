@@ -17,6 +17,7 @@
 #define hifi_UDTTest_h
 
 
+#include <ctime>
 #include <random>
 
 #include <QtCore/QCoreApplication>
@@ -73,6 +74,7 @@ private:
     int _totalQueuedBytes { 0 }; // keeps track of the number of bytes we have already queued
     
     int _statsInterval { 100 }; // recording interval for stats in milliseconds
+    std::clock_t _lastSampleCPUTime { std::clock() }; // process CPU time at the last stats sample
 };
 
 #endif // hifi_UDTTest_h